@@ -0,0 +1,79 @@
+#include "AllocationCounter.h"
+#include <atomic>
+#include <cstdlib>
+
+#if defined(__GLIBC__)
+
+namespace
+{
+    std::atomic<size_t> AllocCount{ 0 };
+
+    thread_local size_t ThreadAllocCount = 0;
+
+    inline void CountAllocation()
+    {
+        AllocCount.fetch_add(1, std::memory_order_relaxed);
+        ++ThreadAllocCount;
+    }
+}
+
+extern "C"
+{
+    void* __libc_malloc(size_t size);
+
+    void* __libc_calloc(size_t count, size_t size);
+
+    void* __libc_realloc(void *ptr, size_t size);
+
+    void* malloc(size_t size)
+    {
+        CountAllocation();
+        return __libc_malloc(size);
+    }
+
+    void* calloc(size_t count, size_t size)
+    {
+        CountAllocation();
+        return __libc_calloc(count, size);
+    }
+
+    void* realloc(void *ptr, size_t size)
+    {
+        CountAllocation();
+        return __libc_realloc(ptr, size);
+    }
+}
+
+bool AllocationCounter::IsSupported()
+{
+    return true;
+}
+
+size_t AllocationCounter::Count()
+{
+    return AllocCount.load(std::memory_order_relaxed);
+}
+
+size_t AllocationCounter::ThreadCount()
+{
+    return ThreadAllocCount;
+}
+
+#else
+
+bool AllocationCounter::IsSupported()
+{
+    return false;
+}
+
+size_t AllocationCounter::Count()
+{
+    return 0;
+}
+
+size_t AllocationCounter::ThreadCount()
+{
+    return 0;
+}
+
+#endif
@@ -0,0 +1,35 @@
+#ifndef ALLOCATIONCOUNTER_H
+#define ALLOCATIONCOUNTER_H
+
+#include <cstddef>
+
+/**
+ * Heap allocation counter of the benchmark process(counts malloc/calloc/realloc calls of all threads).
+ */
+class AllocationCounter
+{
+public:
+
+    /**
+     * Query if allocation counting is supported on current platform(glibc only).
+     *
+     * @return True if supported, false if not.
+     */
+    static bool IsSupported();
+
+    /**
+     * Gets the number of heap allocations since process started.
+     *
+     * @return Allocation count.
+     */
+    static size_t Count();
+
+    /**
+     * Gets the number of heap allocations made by current thread.
+     *
+     * @return Allocation count of current thread.
+     */
+    static size_t ThreadCount();
+};
+
+#endif /* ALLOCATIONCOUNTER_H */
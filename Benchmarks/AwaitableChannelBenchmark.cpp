@@ -0,0 +1,198 @@
+#include "Channel/Common/AwaitableChannel.h"
+
+#if defined(BOOST_ASIO_HAS_CO_AWAIT) && defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
+
+#include <chrono>
+#include <boost/test/unit_test.hpp>
+#include <boost/asio/co_spawn.hpp>
+#include "Concurrent/ThreadPool.h"
+#include "Concurrent/WaitEvent.h"
+#include "Channel/Unix/UnixStreamPassiveChannel.h"
+#include "AllocationCounter.h"
+
+namespace
+{
+    const size_t PingSize = 64;
+
+    const size_t PingCount = 50000;
+
+    /**
+     * Writes back everything it reads.
+     */
+    class EchoHandler :public std::enable_shared_from_this<EchoHandler>, public IAsyncChannelHandler
+    {
+    public:
+        IAsyncChannel::ptr_t m_channel;
+
+        us8 m_readBuf[PingSize];
+
+        void BeginRead()
+        {
+            BufDescriptor buf = { m_readBuf, sizeof(m_readBuf) };
+            m_channel->AsyncReadSome(&buf, 1, shared_from_this());
+        }
+
+        virtual void EndOpen(const boost::system::error_code &err) override
+        {
+        }
+
+        virtual void EndRead(const boost::system::error_code &err, std::size_t bytesTransferred, void *ctx) override
+        {
+            if (!err)
+            {
+                m_channel->AsyncWriteCopy(m_readBuf, bytesTransferred, shared_from_this());
+                BeginRead();
+            }
+        }
+
+        virtual void EndWrite(const boost::system::error_code &err, std::size_t bytesTransferred, void *ctx) override
+        {
+        }
+
+        virtual void EndClose(const boost::system::error_code &err) override
+        {
+        }
+    };
+
+    /**
+     * Ping-pong client implemented by the handler interface.
+     */
+    class PingHandler :public std::enable_shared_from_this<PingHandler>, public IAsyncChannelHandler
+    {
+    public:
+        IAsyncChannel::ptr_t m_channel;
+
+        us8 m_buf[PingSize] = { 0 };
+
+        size_t m_read{ 0 };
+
+        size_t m_count{ 0 };
+
+        WaitEvent m_finished;
+
+        void Ping()
+        {
+            m_channel->AsyncWriteCopy(m_buf, sizeof(m_buf), shared_from_this());
+        }
+
+        virtual void EndOpen(const boost::system::error_code &err) override
+        {
+        }
+
+        virtual void EndRead(const boost::system::error_code &err, std::size_t bytesTransferred, void *ctx) override
+        {
+            if (err)
+            {
+                m_finished.Signal();
+                return;
+            }
+            m_read += bytesTransferred;
+            if (m_read < PingSize)
+            {
+                BufDescriptor buf = { m_buf + m_read, PingSize - m_read };
+                m_channel->AsyncReadSome(&buf, 1, shared_from_this());
+            }
+            else if (m_read = 0, ++m_count == PingCount)
+            {
+                m_finished.Signal();
+            }
+            else
+            {
+                Ping();
+            }
+        }
+
+        virtual void EndWrite(const boost::system::error_code &err, std::size_t bytesTransferred, void *ctx) override
+        {
+            //reads after the write completes like the coroutine does,so both clients run the same operations.
+            BufDescriptor buf = { m_buf, sizeof(m_buf) };
+            m_channel->AsyncReadSome(&buf, 1, shared_from_this());
+        }
+
+        virtual void EndClose(const boost::system::error_code &err) override
+        {
+        }
+    };
+
+    /**
+     * Ping-pong client implemented by the coroutine facade.
+     *
+     * @param channel The client side channel.
+     */
+    boost::asio::awaitable<void> PingCoroutine(AwaitableChannel &channel)
+    {
+        us8 buf[PingSize] = { 0 };
+        for (size_t count = 0; count < PingCount; ++count)
+        {
+            co_await channel.WriteCopy(buf, sizeof(buf));
+            for (size_t read = 0; read < PingSize;)
+            {
+                BufDescriptor desc = { buf + read, PingSize - read };
+                read += co_await channel.ReadSome(&desc, 1);
+            }
+        }
+    }
+
+    /**
+     * Creates an echo server channel and returns the connected client side socket.
+     *
+     * @param [out] echo The echo handler.
+     *
+     * @return The client side socket.
+     */
+    std::shared_ptr<UnixStreamTraits::StreamType> CreateEchoPair(std::shared_ptr<EchoHandler> &echo)
+    {
+        std::shared_ptr<UnixStreamTraits::StreamType> clientSock(new UnixStreamTraits::StreamType(ThreadPool::Instance().Context()));
+        std::shared_ptr<UnixStreamTraits::StreamType> serverSock(new UnixStreamTraits::StreamType(ThreadPool::Instance().Context()));
+        boost::asio::local::connect_pair(*clientSock, *serverSock);
+        echo.reset(new EchoHandler());
+        echo->m_channel.reset(new UnixStreamPassiveChannel(serverSock));
+        echo->BeginRead();
+        return clientSock;
+    }
+}
+
+BOOST_AUTO_TEST_SUITE(AwaitableChannelBenchmark)
+
+BOOST_AUTO_TEST_CASE(PingPongBench)
+{
+    ThreadPool::Instance();
+    std::shared_ptr<EchoHandler> echo;
+
+    std::shared_ptr<UnixStreamTraits::StreamType> sock = CreateEchoPair(echo);
+    std::shared_ptr<PingHandler> ping(new PingHandler());
+    ping->m_channel.reset(new UnixStreamPassiveChannel(sock));
+    size_t allocCount = AllocationCounter::Count();
+    auto beg = std::chrono::steady_clock::now();
+    ping->Ping();
+    ping->m_finished.Wait();
+    double handlerUs = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - beg).count() / PingCount;
+    double handlerAllocs = static_cast<double>(AllocationCounter::Count() - allocCount) / PingCount;
+    ping->m_channel->AsyncClose(ping);
+    echo->m_channel->AsyncClose(echo);
+
+    sock = CreateEchoPair(echo);
+    AwaitableChannel channel(std::make_shared<UnixStreamPassiveChannel>(sock));
+    WaitEvent finished;
+    allocCount = AllocationCounter::Count();
+    beg = std::chrono::steady_clock::now();
+    boost::asio::co_spawn(ThreadPool::Instance().Context(), PingCoroutine(channel), [&finished](std::exception_ptr e)
+        {
+            BOOST_TEST(!e);
+            finished.Signal();
+        });
+    finished.Wait();
+    double coroutineUs = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - beg).count() / PingCount;
+    double coroutineAllocs = static_cast<double>(AllocationCounter::Count() - allocCount) / PingCount;
+    channel.Channel()->AsyncClose(echo);
+    echo->m_channel->AsyncClose(echo);
+
+    BOOST_TEST_MESSAGE("Ping-pong average,handler:" << handlerUs << " us(" << handlerAllocs << " allocations per ping),coroutine:"
+        << coroutineUs << " us(" << coroutineAllocs << " allocations per ping)");
+    ThreadPool::Instance().Stop();
+    ThreadPool::Destory();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+#endif
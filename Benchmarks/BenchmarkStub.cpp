@@ -0,0 +1,2 @@
+#define BOOST_TEST_MODULE UtilsBenchmark
+#include <boost/test/unit_test.hpp>
\ No newline at end of file
@@ -0,0 +1,115 @@
+#include <boost/test/unit_test.hpp>
+#include <boost/timer/timer.hpp>
+#include "Buffer/BinaryHelper.h"
+
+namespace
+{
+    const size_t BenchBufferSize = 4096;
+
+    const size_t BenchLoopCount = 20000;
+
+    /**
+     * Fills a circular buffer whose content wraps around the end of the underlying storage.
+     *
+     * @param [in,out] buf The buffer.
+     */
+    void FillWrappedBuffer(CircularBuffer &buf)
+    {
+        BufDescriptor bufs[2];
+        buf.free_buffers(bufs);
+        buf.inc_size(bufs[0].m_size);
+        buf.pop_front(buf.capacity() / 2 + 1);
+        buf.free_buffers(bufs);
+        buf.inc_size(bufs[0].m_size);
+        for (size_t i = 0; i < buf.size(); ++i)
+        {
+            buf[i] = static_cast<us8>(i * 31);
+        }
+    }
+
+    /**
+     * The per-byte decoding path used before @ref CircularBufferReader was introduced.
+     */
+    us32 ReadBinDataPerByte(CircularBuffer &buf, size_t offset, us8 size, bool isLittleEndian)
+    {
+        us32 ret = 0;
+        if (isLittleEndian)
+        {
+            for (us8 i = size; i > 0; --i)
+            {
+                ret = (ret << 8) | buf[offset + i - 1];
+            }
+        }
+        else
+        {
+            for (us8 i = 0; i < size; ++i)
+            {
+                ret = (ret << 8) | buf[offset + i];
+            }
+        }
+        return ret;
+    }
+
+    template<typename Func> void RunBench(const char *name, Func func)
+    {
+        us32 sum = 0;
+        boost::timer::cpu_timer timer;
+        for (size_t loop = 0; loop < BenchLoopCount; ++loop)
+        {
+            sum += func();
+        }
+        timer.stop();
+        BOOST_TEST_MESSAGE(name << ":" << timer.format(6, "%w s wall, %u s user") << ",checksum:" << sum);
+    }
+}
+
+BOOST_AUTO_TEST_SUITE(BinaryHelperBenchmark)
+
+BOOST_AUTO_TEST_CASE(CircularBufferReadBench)
+{
+    CircularBuffer buf(BenchBufferSize);
+    FillWrappedBuffer(buf);
+    const us8 sizes[] = { 1, 2, 4 };
+    for (us8 size : sizes)
+    {
+        us32 expect = 0, actual = 0;
+        for (size_t offset = 0; offset + size <= buf.size(); offset += size)
+        {
+            expect += ReadBinDataPerByte(buf, offset, size, false);
+            actual += BinaryHelper::ReadBinData(buf, offset, size, false);
+        }
+        BOOST_TEST(expect == actual);
+
+        BOOST_TEST_MESSAGE("field size:" << +size);
+        RunBench("    per-byte operator[]", [&buf, size]()
+        {
+            us32 sum = 0;
+            for (size_t offset = 0; offset + size <= buf.size(); offset += size)
+            {
+                sum += ReadBinDataPerByte(buf, offset, size, false);
+            }
+            return sum;
+        });
+        RunBench("    BinaryHelper::ReadBinData", [&buf, size]()
+        {
+            us32 sum = 0;
+            for (size_t offset = 0; offset + size <= buf.size(); offset += size)
+            {
+                sum += BinaryHelper::ReadBinData(buf, offset, size, false);
+            }
+            return sum;
+        });
+        RunBench("    CircularBufferReader", [&buf, size]()
+        {
+            us32 sum = 0;
+            CircularBufferReader reader(buf);
+            while (reader.Remain() >= size)
+            {
+                sum += reader.ReadBinData(size, false);
+            }
+            return sum;
+        });
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,422 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <vector>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <boost/program_options.hpp>
+#include <boost/timer/timer.hpp>
+#include "Concurrent/ThreadPool.h"
+#include "Concurrent/WaitEvent.h"
+#include "Channel/Tcp/TcpV4Listener.h"
+#include "Channel/Tcp/TcpV4Channel.h"
+#include "Channel/Tcp/TcpV4PassiveChannel.h"
+
+namespace
+{
+    /**
+     * Settings of a run.
+     */
+    struct ScaleSettings
+    {
+        size_t m_connections;   /**< Number of connections. */
+
+        size_t m_active;    /**< Number of connections which run the echo phase. */
+
+        size_t m_messages;  /**< Ping-pong round trips per active connection. */
+
+        size_t m_messageSize;   /**< Size of a message. */
+
+        size_t m_connectWindow; /**< Max number of connects in progress. */
+
+        size_t m_connectionsPerPort;    /**< Connections per listen port(bounded by the ephemeral port range of a destination). */
+
+        us16 m_basePort;    /**< The first listen port. */
+    };
+
+    ScaleSettings Settings;
+
+    std::atomic<size_t> AcceptCount{ 0 };
+
+    std::atomic<size_t> ServerClosedCount{ 0 };
+
+    WaitEvent AllAccepted;
+
+    WaitEvent AllServersClosed;
+
+    /**
+     * Gets the resident set size of this process.
+     *
+     * @return RSS in bytes(0 if /proc is not available).
+     */
+    size_t GetResidentBytes()
+    {
+        size_t pages = 0, residentPages = 0;
+        FILE *file = fopen("/proc/self/statm", "r");
+        if (file)
+        {
+            if (fscanf(file, "%zu %zu", &pages, &residentPages) != 2)
+            {
+                residentPages = 0;
+            }
+            fclose(file);
+        }
+        return residentPages * static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    }
+
+    /**
+     * Server handler which writes back everything it reads.
+     */
+    class EchoHandler :public std::enable_shared_from_this<EchoHandler>, public IAsyncChannelHandler
+    {
+    public:
+        IAsyncChannel::ptr_t m_channel;
+
+        std::vector<us8> m_readBuf = std::vector<us8>(Settings.m_messageSize);
+
+        void BeginRead()
+        {
+            BufDescriptor buf = { m_readBuf.data(), m_readBuf.size() };
+            m_channel->AsyncReadSome(&buf, 1, shared_from_this());
+        }
+
+        virtual void EndOpen(const boost::system::error_code &err) override
+        {
+            BeginRead();
+        }
+
+        virtual void EndRead(const boost::system::error_code &err, std::size_t bytesTransferred, void *ctx) override
+        {
+            if (err)
+            {
+                m_channel->AsyncClose(shared_from_this());
+                return;
+            }
+            m_channel->AsyncWriteCopy(m_readBuf.data(), bytesTransferred, shared_from_this());
+            BeginRead();
+        }
+
+        virtual void EndWrite(const boost::system::error_code &err, std::size_t bytesTransferred, void *ctx) override
+        {
+        }
+
+        virtual void EndClose(const boost::system::error_code &err) override
+        {
+            m_channel.reset();
+            if (++ServerClosedCount == Settings.m_connections)
+            {
+                AllServersClosed.Signal();
+            }
+        }
+    };
+
+    void ScaleAcceptFunc(std::shared_ptr<boost::asio::ip::tcp::endpoint> &remoteEndPoint, std::shared_ptr<boost::asio::ip::tcp::socket> &sock)
+    {
+        std::shared_ptr<EchoHandler> handler(new EchoHandler());
+        handler->m_channel.reset(new TcpV4PassiveChannel(sock, *remoteEndPoint));
+        handler->m_channel->AsyncOpen(handler);
+        if (++AcceptCount == Settings.m_connections)
+        {
+            AllAccepted.Signal();
+        }
+    }
+
+    /**
+     * Client side handler,connects and runs the ping-pong round trips when started.
+     */
+    class ClientHandler :public std::enable_shared_from_this<ClientHandler>, public IAsyncChannelHandler
+    {
+    public:
+        static std::atomic<size_t> ConnectingCount;
+
+        static std::atomic<size_t> ConnectErrCount;
+
+        static std::atomic<size_t> EchoingCount;
+
+        static WaitEvent ConnectSlotFreed;
+
+        static WaitEvent AllEchoed;
+
+        IAsyncChannel::ptr_t m_channel;
+
+        std::vector<us8> m_buf = std::vector<us8>(Settings.m_messageSize);
+
+        size_t m_received{ 0 };
+
+        std::vector<float> m_latencies;
+
+        std::chrono::steady_clock::time_point m_sendTime;
+
+        void StartEcho()
+        {
+            m_latencies.reserve(Settings.m_messages);
+            SendPing();
+        }
+
+        virtual void EndOpen(const boost::system::error_code &err) override
+        {
+            if (err)
+            {
+                ++ConnectErrCount;
+            }
+            --ConnectingCount;
+            ConnectSlotFreed.Signal();
+        }
+
+        virtual void EndRead(const boost::system::error_code &err, std::size_t bytesTransferred, void *ctx) override
+        {
+            if (err)
+            {
+                FinishEcho();
+                return;
+            }
+            m_received += bytesTransferred;
+            if (m_received < m_buf.size())
+            {
+                BeginRead();
+                return;
+            }
+            m_latencies.push_back(std::chrono::duration<float, std::micro>(std::chrono::steady_clock::now() - m_sendTime).count());
+            if (m_latencies.size() < Settings.m_messages)
+            {
+                SendPing();
+            }
+            else
+            {
+                FinishEcho();
+            }
+        }
+
+        virtual void EndWrite(const boost::system::error_code &err, std::size_t bytesTransferred, void *ctx) override
+        {
+        }
+
+        virtual void EndClose(const boost::system::error_code &err) override
+        {
+        }
+
+    private:
+        void BeginRead()
+        {
+            BufDescriptor buf = { m_buf.data() + m_received, m_buf.size() - m_received };
+            m_channel->AsyncReadSome(&buf, 1, shared_from_this());
+        }
+
+        void SendPing()
+        {
+            m_received = 0;
+            m_sendTime = std::chrono::steady_clock::now();
+            m_channel->AsyncWriteCopy(m_buf.data(), m_buf.size(), shared_from_this());
+            BeginRead();
+        }
+
+        void FinishEcho()
+        {
+            if (--EchoingCount == 0)
+            {
+                AllEchoed.Signal();
+            }
+        }
+    };
+
+    std::atomic<size_t> ClientHandler::ConnectingCount{ 0 };
+
+    std::atomic<size_t> ClientHandler::ConnectErrCount{ 0 };
+
+    std::atomic<size_t> ClientHandler::EchoingCount{ 0 };
+
+    WaitEvent ClientHandler::ConnectSlotFreed;
+
+    WaitEvent ClientHandler::AllEchoed;
+
+    /**
+     * Raises the open file limit for both ends of all connections.
+     *
+     * @param required Number of file descriptors required.
+     *
+     * @return False if the hard limit is too low.
+     */
+    bool RaiseFileLimit(size_t required)
+    {
+        rlimit limit;
+        if (getrlimit(RLIMIT_NOFILE, &limit) != 0)
+        {
+            return false;
+        }
+        if (limit.rlim_cur >= required)
+        {
+            return true;
+        }
+        if (limit.rlim_max != RLIM_INFINITY && limit.rlim_max < required)
+        {
+            return false;
+        }
+        limit.rlim_cur = required;
+        return setrlimit(RLIMIT_NOFILE, &limit) == 0;
+    }
+
+    /**
+     * Gets a percentile of sorted samples.
+     *
+     * @param samples The sorted samples.
+     * @param ratio The percentile(0.5 for p50).
+     *
+     * @return The percentile,0 if there is no sample.
+     */
+    double Percentile(const std::vector<float> &samples, double ratio)
+    {
+        if (samples.empty())
+        {
+            return 0;
+        }
+        return samples[std::min(samples.size() - 1, static_cast<size_t>(samples.size() * ratio))];
+    }
+}
+
+/**
+ * Connection scale benchmark:opens many loopback TcpV4Channels against an in-process TcpV4Listener,keeps them all connected and runs
+ * ping-pong echoes on a subset of them.The result is printed to stdout as a single JSON object:
+ *
+ * @code
+ * {"connections":100000,"active":1000,"messages_per_active":100,"message_size":64,"connect_errors":0,"accept_seconds":...
+ *  ,"accepts_per_second":...,"rss_bytes_per_connection":...,"echo_messages":...,"echo_messages_per_second":...,"echo_p50_us":...
+ *  ,"echo_p99_us":...,"echo_p999_us":...,"cpu_us_per_message":...}
+ * @endcode
+ *
+ * Both ends of every connection live in this process,so the RSS per connection covers a client channel and a passive channel(socket
+ * buffers are kernel memory and are not included),and the CPU per message covers both the request and the echo.
+ */
+int main(int argc, char *argv[])
+{
+    boost::program_options::options_description desc("Connection scale benchmark options");
+    desc.add_options()
+        ("help,h", "print this message")
+        ("connections,c", boost::program_options::value<size_t>(&Settings.m_connections)->default_value(100000), "number of connections")
+        ("active,a", boost::program_options::value<size_t>(&Settings.m_active)->default_value(1000), "number of connections which run ping-pong echoes")
+        ("messages,m", boost::program_options::value<size_t>(&Settings.m_messages)->default_value(100), "round trips per active connection")
+        ("size,s", boost::program_options::value<size_t>(&Settings.m_messageSize)->default_value(64), "message size in bytes")
+        ("window,w", boost::program_options::value<size_t>(&Settings.m_connectWindow)->default_value(1000), "max number of connects in progress")
+        ("per-port", boost::program_options::value<size_t>(&Settings.m_connectionsPerPort)->default_value(20000), "connections per listen port")
+        ("port,p", boost::program_options::value<us16>(&Settings.m_basePort)->default_value(8201), "the first listen port");
+    boost::program_options::variables_map vm;
+    try
+    {
+        boost::program_options::store(boost::program_options::parse_command_line(argc, argv, desc), vm);
+        boost::program_options::notify(vm);
+    }
+    catch (const std::exception &ex)
+    {
+        std::cerr << ex.what() << std::endl << desc << std::endl;
+        return 1;
+    }
+    if (vm.count("help"))
+    {
+        std::cout << desc << std::endl;
+        return 0;
+    }
+    if (!Settings.m_connections || !Settings.m_messageSize || !Settings.m_connectWindow || !Settings.m_connectionsPerPort)
+    {
+        std::cerr << "connections,size,window and per-port must be greater than 0" << std::endl;
+        return 1;
+    }
+    Settings.m_active = std::min(Settings.m_active, Settings.m_connections);
+    if (!RaiseFileLimit(Settings.m_connections * 2 + 1024))
+    {
+        std::cerr << "open file limit is lower than " << Settings.m_connections * 2 + 1024 << ",raise the hard limit(ulimit -Hn)" << std::endl;
+        return 1;
+    }
+
+    ThreadPool::Instance();
+    SetListenerAcceptFunc(ScaleAcceptFunc);
+    TcpListenerSettings listenerSettings = TcpV4Listener::Instance().GetListenerSettings();
+    listenerSettings.m_maxAcceptPerWakeup = 16;
+    listenerSettings.m_socketOptions = SocketOptions::LowLatency();
+    TcpV4Listener::Instance().SetListenerSettings(listenerSettings);
+    size_t portCount = (Settings.m_connections + Settings.m_connectionsPerPort - 1) / Settings.m_connectionsPerPort;
+    for (size_t i = 0; i < portCount; ++i)
+    {
+        boost::asio::ip::tcp::endpoint ep(boost::asio::ip::address_v4::loopback(), static_cast<us16>(Settings.m_basePort + i));
+        if (!TcpV4Listener::Instance().AddListenEndPoint(ep))
+        {
+            std::cerr << "listen on port " << ep.port() << " failed" << std::endl;
+            return 1;
+        }
+    }
+
+    //connect phase:the connects in progress are limited,so the listen backlog does not overflow.
+    size_t baseResident = GetResidentBytes();
+    std::vector<std::shared_ptr<ClientHandler>> clients;
+    clients.reserve(Settings.m_connections);
+    auto beg = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < Settings.m_connections; ++i)
+    {
+        while (ClientHandler::ConnectingCount >= Settings.m_connectWindow)
+        {
+            ClientHandler::ConnectSlotFreed.TimedWait(100);
+        }
+        std::shared_ptr<ClientHandler> client(new ClientHandler());
+        std::shared_ptr<TcpV4Channel> channel(new TcpV4Channel(boost::asio::ip::address_v4::loopback()
+            , static_cast<us16>(Settings.m_basePort + i / Settings.m_connectionsPerPort), false));
+        boost::system::error_code err;
+        channel->SetSocketOptions(SocketOptions::LowLatency(), err);
+        client->m_channel = channel;
+        ++ClientHandler::ConnectingCount;
+        client->m_channel->AsyncOpen(client);
+        clients.push_back(std::move(client));
+    }
+    while (ClientHandler::ConnectingCount)
+    {
+        ClientHandler::ConnectSlotFreed.TimedWait(100);
+    }
+    size_t connectErrCount = ClientHandler::ConnectErrCount;
+    bool allAccepted = connectErrCount == 0 && AllAccepted.TimedWait(30000);
+    double acceptSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - beg).count();
+    size_t connectedResident = GetResidentBytes();
+
+    //echo phase.
+    ClientHandler::EchoingCount = Settings.m_active;
+    boost::timer::cpu_timer timer;
+    beg = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < Settings.m_active; ++i)
+    {
+        clients[i]->StartEcho();
+    }
+    if (Settings.m_active && Settings.m_messages)
+    {
+        ClientHandler::AllEchoed.Wait();
+    }
+    timer.stop();
+    double echoSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - beg).count();
+    std::vector<float> latencies;
+    latencies.reserve(Settings.m_active * Settings.m_messages);
+    for (size_t i = 0; i < Settings.m_active; ++i)
+    {
+        latencies.insert(latencies.end(), clients[i]->m_latencies.begin(), clients[i]->m_latencies.end());
+    }
+    std::sort(latencies.begin(), latencies.end());
+    double cpuUs = static_cast<double>(timer.elapsed().user + timer.elapsed().system) / 1000;
+
+    std::cout << "{\"connections\":" << Settings.m_connections << ",\"active\":" << Settings.m_active << ",\"messages_per_active\":"
+        << Settings.m_messages << ",\"message_size\":" << Settings.m_messageSize
+        << ",\"connect_errors\":" << connectErrCount << ",\"accepted\":" << AcceptCount << ",\"all_accepted\":" << (allAccepted ? "true" : "false")
+        << ",\"accept_seconds\":" << acceptSeconds << ",\"accepts_per_second\":" << AcceptCount / acceptSeconds
+        << ",\"rss_bytes_per_connection\":" << (connectedResident > baseResident ? connectedResident - baseResident : 0) / Settings.m_connections
+        << ",\"echo_messages\":" << latencies.size() << ",\"echo_messages_per_second\":" << (echoSeconds > 0 ? latencies.size() / echoSeconds : 0)
+        << ",\"echo_p50_us\":" << Percentile(latencies, 0.5) << ",\"echo_p99_us\":" << Percentile(latencies, 0.99)
+        << ",\"echo_p999_us\":" << Percentile(latencies, 0.999)
+        << ",\"cpu_us_per_message\":" << (latencies.empty() ? 0 : cpuUs / latencies.size()) << "}" << std::endl;
+
+    //the passive channels close when they get end of stream.
+    for (auto &client : clients)
+    {
+        client->m_channel->AsyncClose(client);
+    }
+    AllServersClosed.TimedWait(30000);
+    clients.clear();
+    TcpV4Listener::Destory();
+    ThreadPool::Instance().Stop();
+    ThreadPool::Destory();
+    return allAccepted ? 0 : 2;
+}
@@ -0,0 +1,132 @@
+#include <thread>
+#include <boost/test/unit_test.hpp>
+#include <boost/timer/timer.hpp>
+#include "AllocationCounter.h"
+#include "Concurrent/ThreadPool.h"
+#include "Concurrent/WaitEvent.h"
+#include "Channel/Tcp/TcpV4PassiveChannel.h"
+#include "Buffer/InlineLinearBuffer.h"
+
+namespace
+{
+    const size_t MessageSize = 32;
+
+    const size_t MessageCount = 20000;
+
+    /**
+     * Handler which signals an event on each finished write.
+     */
+    class WriteBenchHandler :public IAsyncChannelHandler
+    {
+    public:
+        WaitEvent m_writeFinished;
+
+        virtual void EndOpen(const boost::system::error_code &err) override
+        {
+        }
+
+        virtual void EndRead(const boost::system::error_code &err, std::size_t bytesTransferred, void *ctx) override
+        {
+        }
+
+        virtual void EndWrite(const boost::system::error_code &err, std::size_t bytesTransferred, void *ctx) override
+        {
+            BOOST_TEST(!err);
+            m_writeFinished.Signal();
+        }
+
+        virtual void EndClose(const boost::system::error_code &err) override
+        {
+        }
+    };
+
+    /**
+     * Writes MessageCount messages one by one and reports time and heap allocations per message.
+     *
+     * All allocations of the write path(buffer,shared_ptr control block,write request and asio operation) are made by the writer
+     * thread,so the writer thread's count is reported besides the process wide count(which includes the thread pool's own work).
+     *
+     * @param name Name of the case.
+     * @param handler The write handler.
+     * @param writeFunc Function which issues one write.
+     */
+    template<typename Func> void RunWriteBench(const char *name, const std::shared_ptr<WriteBenchHandler> &handler, Func writeFunc)
+    {
+        for (size_t i = 0; i < 100; ++i)
+        {
+            writeFunc();
+            handler->m_writeFinished.Wait();
+        }
+        size_t allocCount = AllocationCounter::Count();
+        size_t threadAllocCount = AllocationCounter::ThreadCount();
+        boost::timer::cpu_timer timer;
+        for (size_t i = 0; i < MessageCount; ++i)
+        {
+            writeFunc();
+            handler->m_writeFinished.Wait();
+        }
+        timer.stop();
+        allocCount = AllocationCounter::Count() - allocCount;
+        threadAllocCount = AllocationCounter::ThreadCount() - threadAllocCount;
+        if (AllocationCounter::IsSupported())
+        {
+            BOOST_TEST_MESSAGE(name << ":" << timer.format(6, "%w s wall") << ",allocations per message(writer thread):"
+                << static_cast<double>(threadAllocCount) / MessageCount << ",allocations per message(process):"
+                << static_cast<double>(allocCount) / MessageCount);
+        }
+        else
+        {
+            BOOST_TEST_MESSAGE(name << ":" << timer.format(6, "%w s wall") << ",allocations per message:n/a");
+        }
+    }
+}
+
+BOOST_AUTO_TEST_SUITE(InlineLinearBufferBenchmark)
+
+BOOST_AUTO_TEST_CASE(SmallMessageWriteBench)
+{
+    boost::asio::io_context &context = ThreadPool::Instance().Context();
+    boost::asio::ip::tcp::acceptor acceptor(context, boost::asio::ip::tcp::endpoint(boost::asio::ip::address_v4::loopback(), 0));
+    boost::asio::ip::tcp::socket client(context);
+    client.connect(acceptor.local_endpoint());
+    std::shared_ptr<boost::asio::ip::tcp::socket> server(new boost::asio::ip::tcp::socket(context));
+    acceptor.accept(*server);
+    std::thread drainThread([&client]()
+        {
+            us8 buf[4096];
+            boost::system::error_code err;
+            while (!err)
+            {
+                client.read_some(boost::asio::buffer(buf), err);
+            }
+        });
+
+    IAsyncChannel::ptr_t channel(new TcpV4PassiveChannel(server, server->remote_endpoint()));
+    std::shared_ptr<WriteBenchHandler> handler(new WriteBenchHandler());
+    us8 payload[MessageSize] = { 0 };
+    RunWriteBench("shared_ptr<LinearBuffer>(new LinearBuffer)", handler, [&channel, &handler, &payload]()
+        {
+            std::shared_ptr<LinearBuffer> buf(new LinearBuffer(MessageSize));
+            buf->append(payload, sizeof(payload));
+            channel->AsyncWrite(buf, 0, buf->size(), handler);
+        });
+    RunWriteBench("make_shared<LinearBuffer>", handler, [&channel, &handler, &payload]()
+        {
+            std::shared_ptr<LinearBuffer> buf = std::make_shared<LinearBuffer>(MessageSize);
+            buf->append(payload, sizeof(payload));
+            channel->AsyncWrite(buf, 0, buf->size(), handler);
+        });
+    RunWriteBench("InlineLinearBuffer<64>", handler, [&channel, &handler, &payload]()
+        {
+            InlineLinearBuffer<64> buf;
+            buf.append(payload, sizeof(payload));
+            channel->AsyncWrite(buf, 0, buf.size(), handler);
+        });
+
+    channel.reset();
+    drainThread.join();
+    ThreadPool::Instance().Stop();
+    ThreadPool::Destory();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,237 @@
+#ifdef USE_IO_URING_CHANNEL
+
+#include <chrono>
+#include <vector>
+#include <boost/test/unit_test.hpp>
+#include "Concurrent/ThreadPool.h"
+#include "Concurrent/WaitEvent.h"
+#include "Channel/Unix/UnixStreamPassiveChannel.h"
+
+namespace
+{
+    const size_t PingSize = 64;
+
+    const size_t PingCount = 20000;
+
+    const size_t BulkChunkSize = 64 * 1024;
+
+    const size_t BulkSize = 128 * 1024 * 1024;
+
+    /**
+     * Writes back everything it reads.
+     */
+    class EchoHandler :public std::enable_shared_from_this<EchoHandler>, public IAsyncChannelHandler
+    {
+    public:
+        IAsyncChannel::ptr_t m_channel;
+
+        us8 m_readBuf[PingSize];
+
+        void BeginRead()
+        {
+            BufDescriptor buf = { m_readBuf, sizeof(m_readBuf) };
+            m_channel->AsyncReadSome(&buf, 1, shared_from_this());
+        }
+
+        virtual void EndOpen(const boost::system::error_code &err) override
+        {
+        }
+
+        virtual void EndRead(const boost::system::error_code &err, std::size_t bytesTransferred, void *ctx) override
+        {
+            if (!err)
+            {
+                m_channel->AsyncWriteCopy(m_readBuf, bytesTransferred, shared_from_this());
+                BeginRead();
+            }
+        }
+
+        virtual void EndWrite(const boost::system::error_code &err, std::size_t bytesTransferred, void *ctx) override
+        {
+        }
+
+        virtual void EndClose(const boost::system::error_code &err) override
+        {
+        }
+    };
+
+    /**
+     * Sends PingCount pings one by one and waits for each echo.
+     */
+    class PingHandler :public std::enable_shared_from_this<PingHandler>, public IAsyncChannelHandler
+    {
+    public:
+        IAsyncChannel::ptr_t m_channel;
+
+        us8 m_buf[PingSize] = { 0 };
+
+        size_t m_read{ 0 };
+
+        size_t m_count{ 0 };
+
+        WaitEvent m_finished;
+
+        void Ping()
+        {
+            m_channel->AsyncWriteCopy(m_buf, sizeof(m_buf), shared_from_this());
+            BufDescriptor buf = { m_buf, sizeof(m_buf) };
+            m_channel->AsyncReadSome(&buf, 1, shared_from_this());
+        }
+
+        virtual void EndOpen(const boost::system::error_code &err) override
+        {
+        }
+
+        virtual void EndRead(const boost::system::error_code &err, std::size_t bytesTransferred, void *ctx) override
+        {
+            if (err)
+            {
+                m_finished.Signal();
+                return;
+            }
+            m_read += bytesTransferred;
+            if (m_read < PingSize)
+            {
+                BufDescriptor buf = { m_buf + m_read, PingSize - m_read };
+                m_channel->AsyncReadSome(&buf, 1, shared_from_this());
+            }
+            else if (m_read = 0, ++m_count == PingCount)
+            {
+                m_finished.Signal();
+            }
+            else
+            {
+                Ping();
+            }
+        }
+
+        virtual void EndWrite(const boost::system::error_code &err, std::size_t bytesTransferred, void *ctx) override
+        {
+        }
+
+        virtual void EndClose(const boost::system::error_code &err) override
+        {
+        }
+    };
+
+    /**
+     * Reads and drops BulkSize bytes.
+     */
+    class SinkHandler :public std::enable_shared_from_this<SinkHandler>, public IAsyncChannelHandler
+    {
+    public:
+        IAsyncChannel::ptr_t m_channel;
+
+        std::vector<us8> m_readBuf = std::vector<us8>(BulkChunkSize);
+
+        size_t m_received{ 0 };
+
+        WaitEvent m_finished;
+
+        void BeginRead()
+        {
+            BufDescriptor buf = { m_readBuf.data(), m_readBuf.size() };
+            m_channel->AsyncReadSome(&buf, 1, shared_from_this());
+        }
+
+        virtual void EndOpen(const boost::system::error_code &err) override
+        {
+        }
+
+        virtual void EndRead(const boost::system::error_code &err, std::size_t bytesTransferred, void *ctx) override
+        {
+            m_received += bytesTransferred;
+            if (err || m_received >= BulkSize)
+            {
+                m_finished.Signal();
+                return;
+            }
+            BeginRead();
+        }
+
+        virtual void EndWrite(const boost::system::error_code &err, std::size_t bytesTransferred, void *ctx) override
+        {
+        }
+
+        virtual void EndClose(const boost::system::error_code &err) override
+        {
+        }
+    };
+
+    /**
+     * Creates a pair of connected channels.
+     *
+     * @param [out] first The first channel.
+     * @param [out] second The second channel.
+     */
+    void CreateChannelPair(IAsyncChannel::ptr_t &first, IAsyncChannel::ptr_t &second)
+    {
+        std::shared_ptr<UnixStreamTraits::StreamType> firstSock(new UnixStreamTraits::StreamType(ThreadPool::Instance().Context()));
+        std::shared_ptr<UnixStreamTraits::StreamType> secondSock(new UnixStreamTraits::StreamType(ThreadPool::Instance().Context()));
+        boost::asio::local::connect_pair(*firstSock, *secondSock);
+        first.reset(new UnixStreamPassiveChannel(firstSock));
+        second.reset(new UnixStreamPassiveChannel(secondSock));
+    }
+
+    /**
+     * Measures channel to channel ping-pong latency and streaming throughput.
+     *
+     * @param name Name of the case.
+     */
+    void RunChannelBench(const char *name)
+    {
+        std::shared_ptr<EchoHandler> echo(new EchoHandler());
+        std::shared_ptr<PingHandler> ping(new PingHandler());
+        CreateChannelPair(echo->m_channel, ping->m_channel);
+        echo->BeginRead();
+        auto beg = std::chrono::steady_clock::now();
+        ping->Ping();
+        ping->m_finished.Wait();
+        double pingUs = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - beg).count() / ping->m_count;
+        echo->m_channel->AsyncClose(echo);
+        ping->m_channel->AsyncClose(ping);
+
+        std::shared_ptr<SinkHandler> sink(new SinkHandler());
+        std::shared_ptr<EchoHandler> source(new EchoHandler());
+        CreateChannelPair(sink->m_channel, source->m_channel);
+        std::shared_ptr<LinearBuffer> chunk(new LinearBuffer(BulkChunkSize));
+        chunk->resize(BulkChunkSize);
+        sink->BeginRead();
+        beg = std::chrono::steady_clock::now();
+        for (size_t sent = 0; sent < BulkSize; sent += BulkChunkSize)
+        {
+            source->m_channel->AsyncWrite(chunk, 0, chunk->size(), source);
+        }
+        sink->m_finished.Wait();
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - beg).count();
+        sink->m_channel->AsyncClose(sink);
+        source->m_channel->AsyncClose(source);
+
+        BOOST_TEST_MESSAGE(name << ":ping-pong average:" << pingUs << " us,stream throughput:" << sink->m_received / seconds / (1024 * 1024)
+            << " MB/s");
+    }
+}
+
+BOOST_AUTO_TEST_SUITE(IoUringChannelBenchmark)
+
+BOOST_AUTO_TEST_CASE(BackendCompareBench)
+{
+    ThreadPool::Instance();
+    if (!boost::asio::use_service<IoUringService>(ThreadPool::Instance().Context()).Available())
+    {
+        BOOST_TEST_MESSAGE("io_uring is not available,skipped.");
+    }
+    else
+    {
+        IoUringService::SetEnabled(false);
+        RunChannelBench("epoll reactor");
+        IoUringService::SetEnabled(true);
+        RunChannelBench("io_uring multishot receive");
+    }
+    ThreadPool::Instance().Stop();
+    ThreadPool::Destory();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+#endif
\ No newline at end of file
@@ -0,0 +1,196 @@
+#include <algorithm>
+#include <chrono>
+#include <deque>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <boost/test/unit_test.hpp>
+#include "Concurrent/RingQueue.h"
+#include "Concurrent/WaitEvent.h"
+
+namespace
+{
+    const int MessagesPerProducer = 200000;
+
+    const size_t QueueCapacity = 1024;
+
+    const int RoundTripCount = 20000;
+
+    /**
+     * The mutex+deque producer/consumer queue which the ring queues replace.
+     */
+    class MutexQueue
+    {
+    public:
+        explicit MutexQueue(size_t capacity) :m_capacity(capacity)
+        {
+        }
+
+        void Push(int value)
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_notFull.wait(lock, [this]() { return m_queue.size() < m_capacity; });
+            m_queue.push_back(value);
+            m_notEmpty.notify_one();
+        }
+
+        void Pop(int &value)
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_notEmpty.wait(lock, [this]() { return !m_queue.empty(); });
+            value = m_queue.front();
+            m_queue.pop_front();
+            m_notFull.notify_one();
+        }
+
+    private:
+        size_t m_capacity;
+
+        std::mutex m_mutex;
+
+        std::condition_variable m_notEmpty;
+
+        std::condition_variable m_notFull;
+
+        std::deque<int> m_queue;
+    };
+
+    /**
+     * Runs producers and consumers over a queue and reports the throughput.
+     *
+     * @param name Name of the case.
+     * @param threadCount Number of producers(and of consumers).
+     * @param queue The queue.
+     */
+    template<typename Queue> void RunThroughputBench(const char *name, int threadCount, Queue &queue)
+    {
+        auto beg = std::chrono::steady_clock::now();
+        std::vector<std::thread> threads;
+        for (int i = 0; i < threadCount; ++i)
+        {
+            threads.emplace_back([&queue]()
+            {
+                for (int j = 0; j < MessagesPerProducer; ++j)
+                {
+                    queue.Push(j);
+                }
+            });
+            threads.emplace_back([&queue]()
+            {
+                int value;
+                for (int j = 0; j < MessagesPerProducer; ++j)
+                {
+                    queue.Pop(value);
+                }
+            });
+        }
+        for (auto &thread : threads)
+        {
+            thread.join();
+        }
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - beg).count();
+        BOOST_TEST_MESSAGE(name << "(" << threadCount << "p/" << threadCount << "c):" << MessagesPerProducer * threadCount / seconds / 1e6
+            << " M msg/s");
+    }
+
+    /**
+     * Bounces a message between two threads over a pair of queues and reports the round trip latency percentiles.
+     *
+     * @param name Name of the case.
+     * @param request The request queue.
+     * @param response The response queue.
+     */
+    template<typename Queue> void RunLatencyBench(const char *name, Queue &request, Queue &response)
+    {
+        std::thread echo([&]()
+        {
+            int value;
+            for (int i = 0; i < RoundTripCount; ++i)
+            {
+                request.Pop(value);
+                response.Push(value);
+            }
+        });
+        std::vector<double> latencies;
+        latencies.reserve(RoundTripCount);
+        int value;
+        for (int i = 0; i < RoundTripCount; ++i)
+        {
+            auto beg = std::chrono::steady_clock::now();
+            request.Push(i);
+            response.Pop(value);
+            latencies.push_back(std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - beg).count());
+        }
+        echo.join();
+        std::sort(latencies.begin(), latencies.end());
+        BOOST_TEST_MESSAGE(name << " round trip:p50 " << latencies[latencies.size() / 2] << " us,p99 "
+            << latencies[latencies.size() * 99 / 100] << " us");
+    }
+
+    /**
+     * Ring queue which spins on the non-blocking functions instead of waiting.
+     */
+    template<typename Queue> class SpinningQueue
+    {
+    public:
+        explicit SpinningQueue(size_t capacity) :m_queue(capacity)
+        {
+        }
+
+        void Push(int value)
+        {
+            while (!m_queue.TryPush(value))
+            {
+            }
+        }
+
+        void Pop(int &value)
+        {
+            while (!m_queue.TryPop(value))
+            {
+            }
+        }
+
+    private:
+        Queue m_queue;
+    };
+}
+
+BOOST_AUTO_TEST_SUITE(RingQueueBenchmark)
+
+BOOST_AUTO_TEST_CASE(ThroughputBench)
+{
+    for (int threadCount : { 1, 2, 4, 8 })
+    {
+        MutexQueue mutexQueue(QueueCapacity);
+        RunThroughputBench("mutex+deque", threadCount, mutexQueue);
+        MpmcRingQueue<int> mpmcQueue(QueueCapacity);
+        RunThroughputBench("MpmcRingQueue", threadCount, mpmcQueue);
+    }
+    SpscRingQueue<int> spscQueue(QueueCapacity);
+    RunThroughputBench("SpscRingQueue", 1, spscQueue);
+}
+
+BOOST_AUTO_TEST_CASE(LatencyBench)
+{
+    {
+        MutexQueue request(QueueCapacity), response(QueueCapacity);
+        RunLatencyBench("mutex+deque", request, response);
+    }
+    {
+        MpmcRingQueue<int> request(QueueCapacity), response(QueueCapacity);
+        RunLatencyBench("MpmcRingQueue(blocking)", request, response);
+    }
+    {
+        SpscRingQueue<int> request(QueueCapacity), response(QueueCapacity);
+        RunLatencyBench("SpscRingQueue(blocking)", request, response);
+    }
+    if (std::thread::hardware_concurrency() > 1)
+    {
+        SpinningQueue<SpscRingQueue<int>> request(QueueCapacity), response(QueueCapacity);
+        RunLatencyBench("SpscRingQueue(spinning)", request, response);
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
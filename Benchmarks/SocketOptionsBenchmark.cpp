@@ -0,0 +1,145 @@
+#include <algorithm>
+#include <chrono>
+#include <vector>
+#include <boost/test/unit_test.hpp>
+#include "Concurrent/ThreadPool.h"
+#include "Channel/Tcp/TcpV4Listener.h"
+#include "Channel/Tcp/TcpV4PassiveChannel.h"
+
+namespace
+{
+    const size_t RequestSize = 64;
+
+    const size_t ResponseHeaderSize = 8;
+
+    const size_t RoundTripCount = 200;
+
+    /**
+     * Server handler which answers each request with a header write followed by a body write(the write-write-read pattern which
+     * makes the Nagle algorithm wait for the delayed ACK of the peer).
+     */
+    class EchoHandler :public std::enable_shared_from_this<EchoHandler>, public IAsyncChannelHandler
+    {
+    public:
+        IAsyncChannel::ptr_t m_channel;
+
+        us8 m_request[RequestSize];
+
+        size_t m_received{ 0 };
+
+        void BeginRead()
+        {
+            BufDescriptor buf = { m_request + m_received, RequestSize - m_received };
+            m_channel->AsyncReadSome(&buf, 1, shared_from_this());
+        }
+
+        virtual void EndOpen(const boost::system::error_code &err) override
+        {
+            BeginRead();
+        }
+
+        virtual void EndRead(const boost::system::error_code &err, std::size_t bytesTransferred, void *ctx) override
+        {
+            if (err)
+            {
+                m_channel->AsyncClose(shared_from_this());
+                return;
+            }
+            m_received += bytesTransferred;
+            if (m_received == RequestSize)
+            {
+                m_received = 0;
+                m_channel->AsyncWriteCopy(m_request, ResponseHeaderSize, shared_from_this());
+                m_channel->AsyncWriteCopy(m_request + ResponseHeaderSize, RequestSize - ResponseHeaderSize, shared_from_this());
+            }
+            BeginRead();
+        }
+
+        virtual void EndWrite(const boost::system::error_code &err, std::size_t bytesTransferred, void *ctx) override
+        {
+        }
+
+        virtual void EndClose(const boost::system::error_code &err) override
+        {
+            m_channel.reset();
+        }
+    };
+
+    void EchoAcceptFunc(std::shared_ptr<boost::asio::ip::tcp::endpoint> &remoteEndPoint, std::shared_ptr<boost::asio::ip::tcp::socket> &sock)
+    {
+        std::shared_ptr<EchoHandler> handler(new EchoHandler());
+        handler->m_channel.reset(new TcpV4PassiveChannel(sock, *remoteEndPoint));
+        handler->m_channel->AsyncOpen(handler);
+    }
+
+    /**
+     * Measures request/response round trips over loopback with the same socket options on both sides.
+     *
+     * @param name Name of the case.
+     * @param options The socket options.
+     * @param port Listen port.
+     */
+    void RunLatencyBench(const char *name, const SocketOptions &options, us16 port)
+    {
+        TcpListenerSettings settings = TcpV4Listener::Instance().GetListenerSettings();
+        settings.m_socketOptions = options;
+        TcpV4Listener::Instance().SetListenerSettings(settings);
+        boost::asio::ip::tcp::endpoint ep(boost::asio::ip::address_v4::loopback(), port);
+        BOOST_TEST_REQUIRE(TcpV4Listener::Instance().AddListenEndPoint(ep));
+
+        boost::asio::io_context context;
+        boost::asio::ip::tcp::socket client(context);
+        client.open(boost::asio::ip::tcp::v4());
+        boost::system::error_code err;
+        options.ApplyTo(client, err);
+        BOOST_TEST(!err);
+        client.connect(ep);
+        us8 request[RequestSize] = { 0 };
+        us8 response[RequestSize];
+        std::vector<double> latencies;
+        latencies.reserve(RoundTripCount);
+        for (size_t i = 0; i < RoundTripCount + 10; ++i)
+        {
+            auto beg = std::chrono::steady_clock::now();
+            boost::asio::write(client, boost::asio::buffer(request));
+            boost::asio::read(client, boost::asio::buffer(response));
+            auto end = std::chrono::steady_clock::now();
+            if (i >= 10)
+            {
+                latencies.push_back(std::chrono::duration<double, std::micro>(end - beg).count());
+            }
+        }
+        client.close();
+        TcpV4Listener::Instance().RemoveListenerEndPoint(ep);
+
+        std::sort(latencies.begin(), latencies.end());
+        double sum = 0;
+        for (double latency : latencies)
+        {
+            sum += latency;
+        }
+        BOOST_TEST_MESSAGE(name << ":average round trip:" << sum / latencies.size() << " us,p50:" << latencies[latencies.size() / 2]
+            << " us,p99:" << latencies[latencies.size() * 99 / 100] << " us");
+    }
+}
+
+BOOST_AUTO_TEST_SUITE(SocketOptionsBenchmark)
+
+BOOST_AUTO_TEST_CASE(RequestResponseLatencyBench)
+{
+    ThreadPool::Instance();
+    SetListenerAcceptFunc(EchoAcceptFunc);
+    SocketOptions noDelay;
+    noDelay.m_noDelay = 1;
+    SocketOptions notSentLowat = noDelay;
+    notSentLowat.m_notSentLowat = 16 * 1024;
+    RunLatencyBench("system default(Nagle on)", SocketOptions::Default(), 8111);
+    RunLatencyBench("TCP_NODELAY", noDelay, 8112);
+    RunLatencyBench("TCP_NODELAY+TCP_NOTSENT_LOWAT(16KB)", notSentLowat, 8113);
+    RunLatencyBench("SocketOptions::LowLatency()", SocketOptions::LowLatency(), 8114);
+    TcpV4Listener::Destory();
+    ThreadPool::Instance().Stop();
+    ThreadPool::Destory();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
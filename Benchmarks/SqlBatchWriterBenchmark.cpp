@@ -0,0 +1,120 @@
+#if defined(USE_ODBC_DATABASE_UTILS)
+
+#include <chrono>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+#include <boost/test/unit_test.hpp>
+#include "Database/SQL/Common/SqlConnectionPool.h"
+#include "Database/SQL/Common/SqlBatchWriter.hpp"
+
+namespace
+{
+    const char BenchPoolName[] = "SqlBatchWriterBenchmark";
+
+    const int ProducerCount = 8;
+
+    const int RowsPerProducer = 2000;
+
+    const char InsertSql[] = "insert into batch_writer_bench values(:id<int>,:name<char[32]>)";
+
+    /**
+     * A benchmark row.
+     */
+    struct BenchRow
+    {
+        int m_id;
+
+        std::string m_name;
+    };
+
+    /**
+     * Recreates the benchmark table.
+     */
+    bool RecreateTable()
+    {
+        auto db = SqlConnectionPool::Find(BenchPoolName)->Borrow();
+        if (!db)
+        {
+            return false;
+        }
+        db->Prepare("drop table if exists batch_writer_bench", 1) && db->FlushBuffer() && db->Commit();
+        return db->Prepare("create table batch_writer_bench(id int,name varchar(32))", 1) && db->FlushBuffer() && db->Commit();
+    }
+
+    /**
+     * Runs the producers and reports the throughput.
+     */
+    template<typename T> void RunProducers(const char *name, T &&produce)
+    {
+        auto beg = std::chrono::steady_clock::now();
+        std::vector<std::thread> producers;
+        for (int i = 0; i < ProducerCount; ++i)
+        {
+            producers.emplace_back([i, &produce]() { produce(i); });
+        }
+        for (auto &producer : producers)
+        {
+            producer.join();
+        }
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - beg).count();
+        BOOST_TEST_MESSAGE(name << ":" << ProducerCount * RowsPerProducer / seconds << " rows/s");
+    }
+}
+
+BOOST_AUTO_TEST_SUITE(SqlBatchWriterBenchmark)
+
+BOOST_AUTO_TEST_CASE(GroupCommitBench)
+{
+    const char *connStr = getenv("UTILS_TEST_ODBC_CONN");
+    BOOST_TEST_REQUIRE(static_cast<bool>(SqlConnectionPool::Create({ BenchPoolName, SqlDatabaseType::ODBC
+        , connStr ? connStr : "Driver=SQLite3;Database=/tmp/UtilsSqlBatchWriterBenchmark.db;", ProducerCount + 1, ProducerCount + 1, ""
+        , false, std::chrono::milliseconds(0), std::chrono::milliseconds(0), std::chrono::milliseconds(10000), std::chrono::milliseconds(1000) })));
+    BOOST_TEST_REQUIRE(RecreateTable());
+
+    //every producer borrows a connection and commits each row.
+    std::atomic<us64> totalCommitUs{ 0 };
+    RunProducers("commit per row", [&totalCommitUs](int producer)
+        {
+            auto db = SqlConnectionPool::Find(BenchPoolName)->Borrow();
+            for (int i = 0; i < RowsPerProducer; ++i)
+            {
+                int id = producer * RowsPerProducer + i;
+                db->Prepare(InsertSql, 1);
+                *db << id << std::to_string(id);
+                db->FlushBuffer();
+                auto beg = std::chrono::steady_clock::now();
+                db->Commit();
+                totalCommitUs += static_cast<us64>(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - beg).count());
+            }
+        });
+    BOOST_TEST_MESSAGE("commit per row:average commit " << totalCommitUs / (ProducerCount * RowsPerProducer) << " us");
+
+    BOOST_TEST_REQUIRE(RecreateTable());
+    for (int bufferSize : { 64, 512 })
+    {
+        SqlBatchWriter<BenchRow> writer(InsertSql, { BenchPoolName, bufferSize, std::chrono::milliseconds(10) }
+            , [](ISqlDatabase &db, const BenchRow &row) { db << row.m_id << row.m_name; });
+        std::string name = "group commit(buffer " + std::to_string(bufferSize) + ")";
+        RunProducers(name.c_str(), [&writer](int producer)
+            {
+                for (int i = 0; i < RowsPerProducer; ++i)
+                {
+                    int id = producer * RowsPerProducer + i;
+                    writer.Write(BenchRow{ id, std::to_string(id) });
+                }
+            });
+        auto beg = std::chrono::steady_clock::now();
+        writer.Stop();
+        SqlBatchWriterStats stats = writer.GetStats();
+        BOOST_TEST_MESSAGE(name << ":drained in " << std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - beg).count()
+            << " ms," << stats.m_rows << " rows in " << stats.m_groups << " groups,average commit "
+            << (stats.m_groups ? stats.m_totalCommitUs / stats.m_groups : 0) << " us,max commit " << stats.m_maxCommitUs << " us");
+    }
+
+    SqlConnectionPool::Destory(BenchPoolName);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+#endif
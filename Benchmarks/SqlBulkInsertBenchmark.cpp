@@ -0,0 +1,159 @@
+#if defined(USE_ODBC_DATABASE_UTILS)
+
+#include <chrono>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include <boost/test/unit_test.hpp>
+#include "Database/SQL/ODBC/ODBCSqlDatabase.h"
+
+namespace
+{
+    const size_t ColumnCount = 50;
+
+    const size_t RowCount = 20000;
+
+    const size_t BatchSize = 500;
+
+    /**
+     * Gets the type of a column of the audit table(int,double and varchar columns in turn).
+     */
+    SqlColumnType AuditColumnType(size_t column)
+    {
+        switch (column % 3)
+        {
+        case 0:
+            return SqlColumnType::Int32;
+        case 1:
+            return SqlColumnType::Double;
+        default:
+            return SqlColumnType::String;
+        }
+    }
+
+    /**
+     * Builds the create and insert statements of the audit table.
+     */
+    void BuildAuditSql(std::string &createSql, std::string &insertSql)
+    {
+        createSql = "create table bulk_insert_bench(";
+        insertSql = "insert into bulk_insert_bench values(";
+        for (size_t i = 0; i < ColumnCount; ++i)
+        {
+            std::string name = "c" + std::to_string(i);
+            const char *sep = i + 1 == ColumnCount ? ")" : ",";
+            switch (AuditColumnType(i))
+            {
+            case SqlColumnType::Int32:
+                createSql += name + " int" + sep;
+                insertSql += ":" + name + "<int>" + sep;
+                break;
+            case SqlColumnType::Double:
+                createSql += name + " double precision" + sep;
+                insertSql += ":" + name + "<double>" + sep;
+                break;
+            default:
+                createSql += name + " varchar(32)" + sep;
+                insertSql += ":" + name + "<char[32]>" + sep;
+                break;
+            }
+        }
+    }
+
+    bool RecreateTable(ISqlDatabase &db, const std::string &createSql)
+    {
+        db.Prepare("drop table if exists bulk_insert_bench", 1, false) && db.FlushBuffer() && db.Commit();
+        return db.Prepare(createSql.c_str(), 1, false) && db.FlushBuffer() && db.Commit();
+    }
+
+    void ReportRate(const char *name, std::chrono::steady_clock::time_point beg)
+    {
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - beg).count();
+        BOOST_TEST_MESSAGE(name << ":" << RowCount / seconds << " rows/s," << RowCount * ColumnCount / seconds << " values/s");
+    }
+}
+
+BOOST_AUTO_TEST_SUITE(SqlBulkInsertBenchmark)
+
+BOOST_AUTO_TEST_CASE(AuditTableBench)
+{
+    const char *connStr = getenv("UTILS_TEST_ODBC_CONN");
+    ODBCSqlDatabase odbc(connStr ? connStr : "Driver=SQLite3;Database=/tmp/UtilsSqlBulkInsertBenchmark.db;", true);
+    ISqlDatabase &db = odbc;
+    std::string createSql, insertSql;
+    BuildAuditSql(createSql, insertSql);
+    std::vector<std::string> names;
+    for (size_t i = 0; i < BatchSize; ++i)
+    {
+        names.push_back("value" + std::to_string(i));
+    }
+
+    //stream path:one virtual operator<< per value.
+    BOOST_TEST_REQUIRE(RecreateTable(db, createSql), "Create table error:" << db.LastError());
+    auto beg = std::chrono::steady_clock::now();
+    for (size_t row = 0; row < RowCount; row += BatchSize)
+    {
+        BOOST_TEST_REQUIRE(db.Prepare(insertSql.c_str(), static_cast<int>(BatchSize)));
+        for (size_t i = 0; i < BatchSize; ++i)
+        {
+            for (size_t column = 0; column < ColumnCount; ++column)
+            {
+                switch (AuditColumnType(column))
+                {
+                case SqlColumnType::Int32:
+                    db << static_cast<int>(row + i);
+                    break;
+                case SqlColumnType::Double:
+                    db << (row + i) * 0.5;
+                    break;
+                default:
+                    db << names[i];
+                    break;
+                }
+            }
+        }
+        BOOST_TEST_REQUIRE((db.FlushBuffer() && db.Commit()), "Insert error:" << db.LastError());
+    }
+    ReportRate("stream path", beg);
+
+    //columnar path:the batch is filled once per batch and written by InsertColumns.
+    BOOST_TEST_REQUIRE(RecreateTable(db, createSql), "Create table error:" << db.LastError());
+    std::vector<SqlColumnType> types;
+    for (size_t column = 0; column < ColumnCount; ++column)
+    {
+        types.push_back(AuditColumnType(column));
+    }
+    SqlColumnBatch batch(types, BatchSize);
+    SqlStatementId insertId = SqlStatementRegistry::Intern(insertSql);
+    beg = std::chrono::steady_clock::now();
+    for (size_t row = 0; row < RowCount; row += BatchSize)
+    {
+        batch.Clear();
+        for (size_t column = 0; column < ColumnCount; ++column)
+        {
+            for (size_t i = 0; i < BatchSize; ++i)
+            {
+                switch (types[column])
+                {
+                case SqlColumnType::Int32:
+                    batch.Int32s(column)[i] = static_cast<s32>(row + i);
+                    break;
+                case SqlColumnType::Double:
+                    batch.Doubles(column)[i] = (row + i) * 0.5;
+                    break;
+                default:
+                    batch.SetString(column, i, names[i].data(), names[i].size());
+                    break;
+                }
+            }
+        }
+        batch.SetRowCount(BatchSize);
+        BOOST_TEST_REQUIRE(db.PrepareStatement(insertId, static_cast<int>(BatchSize)));
+        BOOST_TEST_REQUIRE((db.InsertColumns(batch) && db.Commit()), "Insert error:" << db.LastError());
+    }
+    ReportRate("columnar path", beg);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+#endif
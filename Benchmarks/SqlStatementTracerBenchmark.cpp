@@ -0,0 +1,76 @@
+#if defined(USE_ODBC_DATABASE_UTILS)
+
+#include <chrono>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+#include <boost/test/unit_test.hpp>
+#include "Database/SQL/Common/SqlStatementTracer.h"
+#include "Database/SQL/ODBC/ODBCSqlDatabase.h"
+
+BOOST_AUTO_TEST_SUITE(SqlStatementTracerBenchmark)
+
+BOOST_AUTO_TEST_CASE(RecordBench)
+{
+    const int RecordsPerThread = 2000000;
+    SqlStatementId id = SqlStatementRegistry::Intern("select * from statement_tracer_bench where id = :id<int>");
+    for (int threadCount : { 1, 4 })
+    {
+        auto beg = std::chrono::steady_clock::now();
+        std::vector<std::thread> threads;
+        for (int i = 0; i < threadCount; ++i)
+        {
+            threads.emplace_back([id]()
+            {
+                for (int j = 0; j < RecordsPerThread; ++j)
+                {
+                    auto phaseBeg = std::chrono::steady_clock::now();
+                    SqlStatementTracer::Record(id, SqlPhase::Flush, SqlStatementTracer::ElapsedMicros(phaseBeg) + (j & 127), 1, 1);
+                }
+            });
+        }
+        for (auto &thread : threads)
+        {
+            thread.join();
+        }
+        double nanos = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - beg).count();
+        BOOST_TEST_MESSAGE("threads:" << threadCount << ",timed record:" << nanos / RecordsPerThread << " ns/op");
+    }
+    SqlStatementTrace trace;
+    BOOST_TEST_REQUIRE(SqlStatementTracer::Snapshot(id, trace));
+    BOOST_TEST(trace.m_phases[static_cast<size_t>(SqlPhase::Flush)].m_count == static_cast<us64>(RecordsPerThread) * 5);
+}
+
+BOOST_AUTO_TEST_CASE(PrepareBench)
+{
+    const int PrepareCount = 200000;
+    const char *connStr = getenv("UTILS_TEST_ODBC_CONN");
+    ODBCSqlDatabase db(connStr ? connStr : "Driver=SQLite3;Database=/tmp/UtilsSqlStatementTracerBenchmark.db;", true);
+    const char *sql = "select 1 where 1 = 1";
+    SqlStatementId id = SqlStatementRegistry::Intern(sql);
+    SqlStatementTracerSettings settings = SqlStatementTracer::Settings();
+    for (bool enabled : { false, true })
+    {
+        SqlStatementTracer::SetSettings(SqlStatementTracerSettings{ enabled, settings.m_slowThreshold, settings.m_maxSlowLogsPerSecond });
+        //the statements are cached,so the cache hits are measured.
+        auto beg = std::chrono::steady_clock::now();
+        for (int i = 0; i < PrepareCount; ++i)
+        {
+            BOOST_TEST_REQUIRE(db.Prepare(sql, 1), "Prepare error:" << db.LastError());
+        }
+        double textNanos = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - beg).count();
+        beg = std::chrono::steady_clock::now();
+        for (int i = 0; i < PrepareCount; ++i)
+        {
+            BOOST_TEST_REQUIRE(db.PrepareStatement(id, 1), "Prepare error:" << db.LastError());
+        }
+        double idNanos = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - beg).count();
+        BOOST_TEST_MESSAGE("tracing " << (enabled ? "on" : "off") << ",Prepare:" << textNanos / PrepareCount << " ns/op,PrepareStatement:"
+            << idNanos / PrepareCount << " ns/op");
+    }
+    SqlStatementTracer::SetSettings(settings);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+#endif
@@ -0,0 +1,225 @@
+#include <boost/asio.hpp>
+
+#if defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
+
+#include <chrono>
+#include <boost/test/unit_test.hpp>
+#include "Concurrent/ThreadPool.h"
+#include "Concurrent/WaitEvent.h"
+#include "Channel/Unix/UnixStreamPassiveChannel.h"
+#include "Channel/Common/StaticStreamChannel.hpp"
+#include "AllocationCounter.h"
+
+namespace
+{
+    const size_t MessageSize = 20;
+
+    const size_t PingCount = 50000;
+
+    const size_t StreamCount = 500000;
+
+    /**
+     * Counts received bytes(pings are echoed back) by the handler interface.
+     */
+    class VirtualPeer :public std::enable_shared_from_this<VirtualPeer>, public IAsyncChannelHandler
+    {
+    public:
+        IAsyncChannel::ptr_t m_channel;
+
+        bool m_echo{ false };
+
+        us8 m_readBuf[4096];
+
+        size_t m_received{ 0 };
+
+        size_t m_expected{ 0 };
+
+        WaitEvent m_finished;
+
+        void BeginRead()
+        {
+            BufDescriptor buf = { m_readBuf, m_echo ? MessageSize : sizeof(m_readBuf) };
+            m_channel->AsyncReadSome(&buf, 1, shared_from_this());
+        }
+
+        virtual void EndOpen(const boost::system::error_code &err) override
+        {
+        }
+
+        virtual void EndRead(const boost::system::error_code &err, std::size_t bytesTransferred, void *ctx) override
+        {
+            if (err)
+            {
+                m_finished.Signal();
+                return;
+            }
+            if (m_echo)
+            {
+                m_channel->AsyncWriteCopy(m_readBuf, bytesTransferred, shared_from_this());
+            }
+            m_received += bytesTransferred;
+            if (m_expected && m_received >= m_expected)
+            {
+                m_finished.Signal();
+                return;
+            }
+            BeginRead();
+        }
+
+        virtual void EndWrite(const boost::system::error_code &err, std::size_t bytesTransferred, void *ctx) override
+        {
+        }
+
+        virtual void EndClose(const boost::system::error_code &err) override
+        {
+        }
+    };
+
+    /**
+     * Same as VirtualPeer,implemented by StaticStreamChannel.
+     */
+    class StaticPeer :public StaticStreamChannel<UnixStreamTraits, StaticPeer>
+    {
+    public:
+        explicit StaticPeer(const std::shared_ptr<UnixStreamTraits::StreamType> &stream)
+            :StaticStreamChannel<UnixStreamTraits, StaticPeer>(stream)
+        {
+        }
+
+        bool m_echo{ false };
+
+        us8 m_readBuf[4096];
+
+        size_t m_received{ 0 };
+
+        size_t m_expected{ 0 };
+
+        WaitEvent m_finished;
+
+        void BeginRead()
+        {
+            AsyncReadSome(m_readBuf, m_echo ? MessageSize : sizeof(m_readBuf));
+        }
+
+        void EndRead(const boost::system::error_code &err, std::size_t bytesTransferred)
+        {
+            if (err)
+            {
+                m_finished.Signal();
+                return;
+            }
+            if (m_echo)
+            {
+                AsyncWriteCopy(m_readBuf, bytesTransferred);
+            }
+            m_received += bytesTransferred;
+            if (m_expected && m_received >= m_expected)
+            {
+                m_finished.Signal();
+                return;
+            }
+            BeginRead();
+        }
+
+        void EndWrite(const boost::system::error_code &err, std::size_t bytesTransferred)
+        {
+        }
+    };
+
+    /**
+     * Creates a pair of connected unix sockets.
+     *
+     * @param [out] first The first socket.
+     * @param [out] second The second socket.
+     */
+    void CreateSocketPair(std::shared_ptr<UnixStreamTraits::StreamType> &first, std::shared_ptr<UnixStreamTraits::StreamType> &second)
+    {
+        first.reset(new UnixStreamTraits::StreamType(ThreadPool::Instance().Context()));
+        second.reset(new UnixStreamTraits::StreamType(ThreadPool::Instance().Context()));
+        boost::asio::local::connect_pair(*first, *second);
+    }
+
+    /**
+     * Runs the ping-pong and the streaming case on a pair of peers.
+     *
+     * @tparam PeerType Type of the peers.
+     * @tparam PingFunc Type of the send function.
+     * @param name Name of the case.
+     * @param client The client peer.
+     * @param server The server peer.
+     * @param ping Function which sends a message from the client.
+     */
+    template<typename PeerType, typename PingFunc> void RunPeers(const char *name, PeerType &client, PeerType &server, PingFunc ping)
+    {
+        us8 message[MessageSize] = { 0 };
+        server.m_echo = true;
+        server.BeginRead();
+        size_t allocCount = AllocationCounter::Count();
+        auto beg = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < PingCount; ++i)
+        {
+            client.m_expected = (i + 1) * MessageSize;
+            client.BeginRead();
+            ping(message);
+            client.m_finished.Wait();
+        }
+        double pingUs = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - beg).count() / PingCount;
+        double pingAllocs = static_cast<double>(AllocationCounter::Count() - allocCount) / PingCount;
+
+        //the server side is still echoing,so the client side receives the stream back.
+        client.m_expected = (PingCount + StreamCount) * MessageSize;
+        client.BeginRead();
+        allocCount = AllocationCounter::Count();
+        beg = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < StreamCount; ++i)
+        {
+            ping(message);
+        }
+        client.m_finished.Wait();
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - beg).count();
+        double streamAllocs = static_cast<double>(AllocationCounter::Count() - allocCount) / StreamCount;
+
+        BOOST_TEST_MESSAGE(name << ":ping-pong average:" << pingUs << " us(" << pingAllocs << " allocations per ping),echo stream:"
+            << StreamCount / seconds << " messages/s(" << streamAllocs << " allocations per message)");
+    }
+}
+
+BOOST_AUTO_TEST_SUITE(StaticStreamChannelBenchmark)
+
+BOOST_AUTO_TEST_CASE(HandlerBindingBench)
+{
+    ThreadPool::Instance();
+    std::shared_ptr<UnixStreamTraits::StreamType> clientSock, serverSock;
+
+    CreateSocketPair(clientSock, serverSock);
+    std::shared_ptr<VirtualPeer> virtualClient(new VirtualPeer()), virtualServer(new VirtualPeer());
+    virtualClient->m_channel.reset(new UnixStreamPassiveChannel(clientSock));
+    virtualServer->m_channel.reset(new UnixStreamPassiveChannel(serverSock));
+    RunPeers("IAsyncChannelHandler", *virtualClient, *virtualServer, [&virtualClient](const us8 *message)
+        {
+            virtualClient->m_channel->AsyncWriteCopy(message, MessageSize, virtualClient);
+        });
+    virtualClient->m_channel->AsyncClose(virtualClient);
+    virtualServer->m_finished.Wait();
+    virtualServer->m_channel->AsyncClose(virtualServer);
+
+    CreateSocketPair(clientSock, serverSock);
+    {
+        StaticPeer staticClient(clientSock), staticServer(serverSock);
+        RunPeers("StaticStreamChannel", staticClient, staticServer, [&staticClient](const us8 *message)
+            {
+                staticClient.AsyncWriteCopy(message, MessageSize);
+            });
+        boost::system::error_code shutdownErr, closeErr;
+        staticClient.Close(shutdownErr, closeErr);
+        staticServer.m_finished.Wait();
+        staticServer.Close(shutdownErr, closeErr);
+    }
+
+    ThreadPool::Instance().Stop();
+    ThreadPool::Destory();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+#endif
@@ -0,0 +1,94 @@
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <boost/test/unit_test.hpp>
+#include <boost/timer/timer.hpp>
+#include "Concurrent/ThreadPool.h"
+#include "Concurrent/WaitEvent.h"
+#include "Channel/Tcp/TcpV4Listener.h"
+
+namespace
+{
+    const size_t ClientThreadCount = 4;
+
+    const size_t ConnectionCount = 20000;
+
+    std::atomic<size_t> AcceptCount{ 0 };
+
+    WaitEvent AllAccepted;
+
+    void BenchAcceptFunc(std::shared_ptr<boost::asio::ip::tcp::endpoint> &remoteEndPoint, std::shared_ptr<boost::asio::ip::tcp::socket> &sock)
+    {
+        if (++AcceptCount == ConnectionCount)
+        {
+            AllAccepted.Signal();
+        }
+    }
+
+    /**
+     * Connects ConnectionCount times to a loopback listener from ClientThreadCount threads and reports the accept rate.
+     *
+     * The clients close with SO_LINGER(0) so the run does not exhaust ephemeral ports with TIME_WAIT sockets.
+     *
+     * @param name Name of the case.
+     * @param settings Listener settings.
+     * @param port Listen port.
+     */
+    void RunAcceptBench(const char *name, const TcpListenerSettings &settings, us16 port)
+    {
+        AcceptCount = 0;
+        AllAccepted.Reset();
+        TcpV4Listener::Instance().SetListenerSettings(settings);
+        boost::asio::ip::tcp::endpoint ep(boost::asio::ip::address_v4::loopback(), port);
+        BOOST_TEST_REQUIRE(TcpV4Listener::Instance().AddListenEndPoint(ep));
+
+        std::atomic<size_t> connectErrCount{ 0 };
+        boost::timer::cpu_timer timer;
+        std::vector<std::thread> clients;
+        for (size_t i = 0; i < ClientThreadCount; ++i)
+        {
+            clients.emplace_back([&ep, &connectErrCount]()
+                {
+                    boost::asio::io_context context;
+                    for (size_t j = 0; j < ConnectionCount / ClientThreadCount; ++j)
+                    {
+                        boost::asio::ip::tcp::socket sock(context);
+                        boost::system::error_code err;
+                        sock.connect(ep, err);
+                        if (err)
+                        {
+                            ++connectErrCount;
+                            continue;
+                        }
+                        sock.set_option(boost::asio::socket_base::linger(true, 0), err);
+                    }
+                });
+        }
+        for (auto &client : clients)
+        {
+            client.join();
+        }
+        bool finished = connectErrCount == 0 && AllAccepted.TimedWait(10000);
+        timer.stop();
+        BOOST_TEST(finished);
+        BOOST_TEST_MESSAGE(name << ":" << timer.format(6, "%w s wall") << ",connections per second:"
+            << ConnectionCount / (timer.elapsed().wall / 1e9) << ",accepted:" << AcceptCount << ",connect errors:" << connectErrCount);
+        TcpV4Listener::Instance().RemoveListenerEndPoint(ep);
+    }
+}
+
+BOOST_AUTO_TEST_SUITE(TcpListenerBenchmark)
+
+BOOST_AUTO_TEST_CASE(ConnectionRateBench)
+{
+    ThreadPool::Instance();
+    SetListenerAcceptFunc(BenchAcceptFunc);
+    RunAcceptBench("single acceptor,one accept per wakeup", { boost::asio::socket_base::max_listen_connections, 1, 1 }, 8101);
+    RunAcceptBench("single acceptor,16 accepts per wakeup", { boost::asio::socket_base::max_listen_connections, 1, 16 }, 8102);
+    RunAcceptBench("4 SO_REUSEPORT acceptors,16 accepts per wakeup", { boost::asio::socket_base::max_listen_connections, 4, 16 }, 8103);
+    TcpV4Listener::Destory();
+    ThreadPool::Instance().Stop();
+    ThreadPool::Destory();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
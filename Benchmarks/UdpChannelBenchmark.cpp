@@ -0,0 +1,167 @@
+#if defined(linux) || defined(__linux)
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <sys/socket.h>
+#include <boost/test/unit_test.hpp>
+#include "Concurrent/ThreadPool.h"
+#include "Concurrent/WaitEvent.h"
+#include "Channel/Udp/UdpChannel.h"
+
+namespace
+{
+    const size_t DatagramSize = 64;
+
+    const size_t SenderBatchSize = 64;
+
+    const double BenchSeconds = 1.0;
+
+    const size_t ChannelSendCount = 500000;
+
+    /**
+     * Counts the received datagrams and the completed sends.
+     */
+    class CountHandler :public std::enable_shared_from_this<CountHandler>, public IDatagramChannelHandler
+    {
+    public:
+        UdpChannel::ptr_t m_channel;
+
+        WaitEvent m_event;
+
+        std::atomic<size_t> m_received{ 0 };
+
+        std::atomic<size_t> m_sent{ 0 };
+
+        virtual void EndOpen(const boost::system::error_code &err) override
+        {
+            m_event.Signal();
+        }
+
+        virtual void EndReceive(const boost::system::error_code &err, Datagram datagrams[], std::size_t count, void *ctx) override
+        {
+            if (!err)
+            {
+                m_received += count;
+                m_channel->AsyncReceive(shared_from_this());
+            }
+        }
+
+        virtual void EndSend(const boost::system::error_code &err, std::size_t bytesTransferred, void *ctx) override
+        {
+            if (++m_sent == ChannelSendCount)
+            {
+                m_event.Signal();
+            }
+        }
+
+        virtual void EndClose(const boost::system::error_code &err) override
+        {
+            m_event.Signal();
+        }
+    };
+
+    std::shared_ptr<CountHandler> OpenChannel(size_t receiveBatchSize)
+    {
+        UdpChannelSettings settings = { boost::asio::ip::udp::endpoint(boost::asio::ip::address_v4::loopback(), 0), 2048, receiveBatchSize
+            , SenderBatchSize, false };
+        std::shared_ptr<CountHandler> handler(new CountHandler());
+        handler->m_channel.reset(new UdpChannel(settings));
+        handler->m_channel->AsyncOpen(handler);
+        handler->m_event.Wait();
+        return handler;
+    }
+
+    void CloseChannel(std::shared_ptr<CountHandler> &handler)
+    {
+        handler->m_channel->AsyncClose(handler);
+        handler->m_event.Wait();
+        handler->m_channel.reset();
+    }
+
+    /**
+     * Blasts 64 byte datagrams with blocking sendmmsg for BenchSeconds and reports how many datagrams the channel received.
+     *
+     * @param name Name of the case.
+     * @param receiveBatchSize Receive batch size of the channel.
+     */
+    void RunReceiveBench(const char *name, size_t receiveBatchSize)
+    {
+        std::shared_ptr<CountHandler> receiver = OpenChannel(receiveBatchSize);
+        boost::system::error_code err;
+        boost::asio::ip::udp::endpoint ep = receiver->m_channel->LocalEndPoint(err);
+        receiver->m_channel->AsyncReceive(receiver);
+
+        boost::asio::io_context context;
+        boost::asio::ip::udp::socket sender(context, boost::asio::ip::udp::v4());
+        us8 payload[DatagramSize] = { 0 };
+        iovec iov = { payload, sizeof(payload) };
+        std::vector<mmsghdr> headers(SenderBatchSize);
+        for (auto &header : headers)
+        {
+            header.msg_hdr = msghdr();
+            header.msg_hdr.msg_name = ep.data();
+            header.msg_hdr.msg_namelen = static_cast<socklen_t>(ep.size());
+            header.msg_hdr.msg_iov = &iov;
+            header.msg_hdr.msg_iovlen = 1;
+        }
+        size_t sent = 0;
+        auto beg = std::chrono::steady_clock::now();
+        double elapsed = 0;
+        while (elapsed < BenchSeconds)
+        {
+            int ret = ::sendmmsg(sender.native_handle(), headers.data(), static_cast<unsigned int>(headers.size()), 0);
+            if (ret > 0)
+            {
+                sent += static_cast<size_t>(ret);
+            }
+            elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - beg).count();
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        size_t received = receiver->m_received;
+        BOOST_TEST_MESSAGE(name << ":received datagrams per second:" << received / elapsed << ",sent:" << sent << ",received:" << received
+            << ",dropped by kernel:" << sent - received);
+        CloseChannel(receiver);
+    }
+}
+
+BOOST_AUTO_TEST_SUITE(UdpChannelBenchmark)
+
+BOOST_AUTO_TEST_CASE(ReceiveRateBench)
+{
+    ThreadPool::Instance();
+    RunReceiveBench("one datagram per wakeup", 1);
+    RunReceiveBench("recvmmsg,64 datagrams per wakeup", 64);
+    ThreadPool::Instance().Stop();
+    ThreadPool::Destory();
+}
+
+BOOST_AUTO_TEST_CASE(SendRateBench)
+{
+    ThreadPool::Instance();
+    std::shared_ptr<CountHandler> receiver = OpenChannel(64);
+    std::shared_ptr<CountHandler> sender = OpenChannel(64);
+    boost::system::error_code err;
+    boost::asio::ip::udp::endpoint ep = receiver->m_channel->LocalEndPoint(err);
+    receiver->m_channel->AsyncReceive(receiver);
+    us8 payload[DatagramSize] = { 0 };
+    auto beg = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < ChannelSendCount; ++i)
+    {
+        sender->m_channel->AsyncSendCopy(payload, sizeof(payload), ep, sender);
+    }
+    sender->m_event.Wait();
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - beg).count();
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    BOOST_TEST_MESSAGE("AsyncSendCopy with sendmmsg flush:sent datagrams per second:" << ChannelSendCount / elapsed
+        << ",received:" << receiver->m_received);
+    CloseChannel(sender);
+    CloseChannel(receiver);
+    ThreadPool::Instance().Stop();
+    ThreadPool::Destory();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+#endif
\ No newline at end of file
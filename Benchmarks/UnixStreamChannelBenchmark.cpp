@@ -0,0 +1,274 @@
+#if defined(linux) || defined(__linux)
+
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <boost/test/unit_test.hpp>
+#include "Concurrent/ThreadPool.h"
+#include "Concurrent/WaitEvent.h"
+#include "Channel/Tcp/TcpV4Listener.h"
+#include "Channel/Tcp/TcpV4PassiveChannel.h"
+#include "Channel/Unix/UnixStreamListener.h"
+#include "Channel/Unix/UnixStreamPassiveChannel.h"
+
+namespace
+{
+    const char BenchUnixPath[] = "/tmp/UtilsUnixStreamChannelBenchmark.sock";
+
+    const us16 BenchTcpPort = 8121;
+
+    const size_t PingSize = 64;
+
+    const size_t PingCount = 5000;
+
+    const size_t BulkChunkSize = 64 * 1024;
+
+    const size_t BulkSize = 256 * 1024 * 1024;
+
+    const size_t SmallMessageSize = 64;
+
+    const size_t SmallMessageCount = 1000000;
+
+    /**
+     * Server handler which writes back everything it reads.
+     */
+    class EchoHandler :public std::enable_shared_from_this<EchoHandler>, public IAsyncChannelHandler
+    {
+    public:
+        IAsyncChannel::ptr_t m_channel;
+
+        std::vector<us8> m_readBuf = std::vector<us8>(BulkChunkSize);
+
+        void BeginRead()
+        {
+            BufDescriptor buf = { m_readBuf.data(), m_readBuf.size() };
+            m_channel->AsyncReadSome(&buf, 1, shared_from_this());
+        }
+
+        virtual void EndOpen(const boost::system::error_code &err) override
+        {
+            BeginRead();
+        }
+
+        virtual void EndRead(const boost::system::error_code &err, std::size_t bytesTransferred, void *ctx) override
+        {
+            if (err)
+            {
+                m_channel->AsyncClose(shared_from_this());
+                return;
+            }
+            m_channel->AsyncWriteCopy(m_readBuf.data(), bytesTransferred, shared_from_this());
+            BeginRead();
+        }
+
+        virtual void EndWrite(const boost::system::error_code &err, std::size_t bytesTransferred, void *ctx) override
+        {
+        }
+
+        virtual void EndClose(const boost::system::error_code &err) override
+        {
+            m_channel.reset();
+        }
+    };
+
+    void TcpEchoAcceptFunc(std::shared_ptr<boost::asio::ip::tcp::endpoint> &remoteEndPoint, std::shared_ptr<boost::asio::ip::tcp::socket> &sock)
+    {
+        std::shared_ptr<EchoHandler> handler(new EchoHandler());
+        handler->m_channel.reset(new TcpV4PassiveChannel(sock, *remoteEndPoint));
+        handler->m_channel->AsyncOpen(handler);
+    }
+
+    void UnixEchoAcceptFunc(std::shared_ptr<UnixStreamTraits::StreamType> &sock)
+    {
+        std::shared_ptr<EchoHandler> handler(new EchoHandler());
+        handler->m_channel.reset(new UnixStreamPassiveChannel(sock));
+        handler->m_channel->AsyncOpen(handler);
+    }
+
+    /**
+     * Receives a stream of small messages by AsyncReadSome or AsyncReadAvailable and counts the completions.
+     */
+    class SinkHandler :public std::enable_shared_from_this<SinkHandler>, public IAsyncChannelHandler
+    {
+    public:
+        IAsyncChannel::ptr_t m_channel;
+
+        bool m_readAvailable{ false };
+
+        std::vector<us8> m_readBuf = std::vector<us8>(BulkChunkSize);
+
+        size_t m_received{ 0 };
+
+        size_t m_readCount{ 0 };
+
+        WaitEvent m_finished;
+
+        void BeginRead()
+        {
+            BufDescriptor buf = { m_readBuf.data(), m_readBuf.size() };
+            if (m_readAvailable)
+            {
+                m_channel->AsyncReadAvailable(&buf, 1, shared_from_this());
+            }
+            else
+            {
+                m_channel->AsyncReadSome(&buf, 1, shared_from_this());
+            }
+        }
+
+        virtual void EndOpen(const boost::system::error_code &err) override
+        {
+        }
+
+        virtual void EndRead(const boost::system::error_code &err, std::size_t bytesTransferred, void *ctx) override
+        {
+            if (err)
+            {
+                m_finished.Signal();
+                return;
+            }
+            ++m_readCount;
+            m_received += bytesTransferred;
+            if (m_received >= SmallMessageSize * SmallMessageCount)
+            {
+                m_finished.Signal();
+                return;
+            }
+            BeginRead();
+        }
+
+        virtual void EndWrite(const boost::system::error_code &err, std::size_t bytesTransferred, void *ctx) override
+        {
+        }
+
+        virtual void EndClose(const boost::system::error_code &err) override
+        {
+        }
+    };
+
+    /**
+     * Writes small messages from another thread and measures the read completions of the receiving channel.
+     *
+     * @param name Name of the case.
+     * @param readAvailable True to read by AsyncReadAvailable.
+     */
+    void RunSinkBench(const char *name, bool readAvailable)
+    {
+        boost::asio::io_context context;
+        UnixStreamTraits::StreamType sender(context);
+        std::shared_ptr<UnixStreamTraits::StreamType> receiver(new UnixStreamTraits::StreamType(ThreadPool::Instance().Context()));
+        boost::asio::local::connect_pair(sender, *receiver);
+        std::shared_ptr<SinkHandler> handler(new SinkHandler());
+        handler->m_channel.reset(new UnixStreamPassiveChannel(receiver));
+        handler->m_readAvailable = readAvailable;
+        handler->BeginRead();
+
+        auto beg = std::chrono::steady_clock::now();
+        us8 message[SmallMessageSize] = { 0 };
+        for (size_t i = 0; i < SmallMessageCount; ++i)
+        {
+            boost::asio::write(sender, boost::asio::buffer(message));
+        }
+        handler->m_finished.Wait();
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - beg).count();
+        double mb = static_cast<double>(handler->m_received) / (1024 * 1024);
+
+        BOOST_TEST_MESSAGE(name << ":" << mb / seconds << " MB/s," << handler->m_readCount / mb << " read completions per MB");
+        sender.close();
+        handler->m_channel->AsyncClose(handler);
+    }
+
+    /**
+     * Measures ping-pong latency and echo throughput over a connected blocking socket.
+     *
+     * @tparam Socket Type of the socket.
+     * @param name Name of the case.
+     * @param [in,out] sock The connected socket.
+     */
+    template<typename Socket> void RunEchoBench(const char *name, Socket &sock)
+    {
+        us8 ping[PingSize] = { 0 };
+        std::vector<double> latencies;
+        latencies.reserve(PingCount);
+        for (size_t i = 0; i < PingCount; ++i)
+        {
+            auto beg = std::chrono::steady_clock::now();
+            boost::asio::write(sock, boost::asio::buffer(ping));
+            boost::asio::read(sock, boost::asio::buffer(ping));
+            latencies.push_back(std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - beg).count());
+        }
+        std::sort(latencies.begin(), latencies.end());
+        double sum = 0;
+        for (double latency : latencies)
+        {
+            sum += latency;
+        }
+
+        std::vector<us8> chunk(BulkChunkSize);
+        auto beg = std::chrono::steady_clock::now();
+        std::thread reader([&sock]()
+            {
+                std::vector<us8> buf(BulkChunkSize);
+                for (size_t received = 0; received < BulkSize;)
+                {
+                    received += sock.read_some(boost::asio::buffer(buf));
+                }
+            });
+        for (size_t sent = 0; sent < BulkSize; sent += BulkChunkSize)
+        {
+            boost::asio::write(sock, boost::asio::buffer(chunk));
+        }
+        reader.join();
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - beg).count();
+
+        BOOST_TEST_MESSAGE(name << ":ping-pong average:" << sum / latencies.size() << " us,p50:" << latencies[latencies.size() / 2]
+            << " us,p99:" << latencies[latencies.size() * 99 / 100] << " us,echo throughput:" << BulkSize / seconds / (1024 * 1024) << " MB/s");
+    }
+}
+
+BOOST_AUTO_TEST_SUITE(UnixStreamChannelBenchmark)
+
+BOOST_AUTO_TEST_CASE(LoopbackCompareBench)
+{
+    ThreadPool::Instance();
+    boost::asio::io_context context;
+    {
+        SetListenerAcceptFunc(TcpEchoAcceptFunc);
+        TcpListenerSettings settings = TcpV4Listener::Instance().GetListenerSettings();
+        settings.m_socketOptions.m_noDelay = 1;
+        TcpV4Listener::Instance().SetListenerSettings(settings);
+        boost::asio::ip::tcp::endpoint ep(boost::asio::ip::address_v4::loopback(), BenchTcpPort);
+        BOOST_TEST_REQUIRE(TcpV4Listener::Instance().AddListenEndPoint(ep));
+        boost::asio::ip::tcp::socket sock(context);
+        sock.connect(ep);
+        sock.set_option(boost::asio::ip::tcp::no_delay(true));
+        RunEchoBench("TCP loopback(TCP_NODELAY)", sock);
+        sock.close();
+        TcpV4Listener::Destory();
+    }
+    {
+        SetUnixListenerAcceptFunc(UnixEchoAcceptFunc);
+        BOOST_TEST_REQUIRE(UnixStreamListener::Instance().AddListenEndPoint(BenchUnixPath));
+        UnixStreamTraits::StreamType sock(context);
+        sock.connect(UnixStreamTraits::EndPointType(BenchUnixPath));
+        RunEchoBench("Unix domain stream socket", sock);
+        sock.close();
+        UnixStreamListener::Destory();
+    }
+    ThreadPool::Instance().Stop();
+    ThreadPool::Destory();
+}
+
+BOOST_AUTO_TEST_CASE(ReadAvailableBench)
+{
+    ThreadPool::Instance();
+    RunSinkBench("AsyncReadSome", false);
+    RunSinkBench("AsyncReadAvailable", true);
+    ThreadPool::Instance().Stop();
+    ThreadPool::Destory();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+#endif
\ No newline at end of file
@@ -0,0 +1,146 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <boost/test/unit_test.hpp>
+#include "Concurrent/FutexWaitEvent.h"
+#include "Concurrent/WaitEvent.h"
+
+namespace
+{
+    const int SignalCount = 2000000;
+
+    const int RoundTripCount = 20000;
+
+    /**
+     * Measures Signal/Reset without waiters,the common case of an event guarding a mostly non-empty queue.
+     *
+     * @param name Name of the case.
+     * @param evt The event.
+     */
+    template<typename Event> void RunUncontendedBench(const char *name, Event &evt)
+    {
+        auto beg = std::chrono::steady_clock::now();
+        for (int i = 0; i < SignalCount; ++i)
+        {
+            evt.Signal();
+            evt.Reset();
+        }
+        double nanos = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - beg).count();
+        BOOST_TEST_MESSAGE(name << " Signal+Reset without waiters:" << nanos / SignalCount << " ns");
+    }
+
+    /**
+     * Bounces a signal between two threads over a pair of events and reports the round trip latency percentiles.
+     *
+     * @param name Name of the case.
+     * @param request The request event.
+     * @param response The response event.
+     */
+    template<typename Event> void RunPingPongBench(const char *name, Event &request, Event &response)
+    {
+        std::thread echo([&]()
+        {
+            for (int i = 0; i < RoundTripCount; ++i)
+            {
+                request.Wait();
+                response.Signal();
+            }
+        });
+        std::vector<double> latencies;
+        latencies.reserve(RoundTripCount);
+        for (int i = 0; i < RoundTripCount; ++i)
+        {
+            auto beg = std::chrono::steady_clock::now();
+            request.Signal();
+            response.Wait();
+            latencies.push_back(std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - beg).count());
+        }
+        echo.join();
+        std::sort(latencies.begin(), latencies.end());
+        BOOST_TEST_MESSAGE(name << " round trip:p50 " << latencies[latencies.size() / 2] << " us,p99 "
+            << latencies[latencies.size() * 99 / 100] << " us");
+    }
+
+    /**
+     * Releases a group of waiters with one signal and reports the time until the last one runs.
+     *
+     * @param name Name of the case.
+     * @param evt The event.
+     * @param chain True if a released waiter signals the event again to release the next one.
+     */
+    template<typename Event> void RunBroadcastBench(const char *name, Event &evt, bool chain)
+    {
+        const int waiterCount = 8;
+        std::vector<std::thread> threads;
+        std::atomic<int> ready(0);
+        for (int i = 0; i < waiterCount; ++i)
+        {
+            threads.emplace_back([&]()
+            {
+                ready.fetch_add(1);
+                evt.Wait();
+                if (chain)
+                {
+                    evt.Signal();
+                }
+            });
+        }
+        while (ready.load() < waiterCount)
+        {
+            std::this_thread::yield();
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        auto beg = std::chrono::steady_clock::now();
+        evt.Signal();
+        for (auto &thread : threads)
+        {
+            thread.join();
+        }
+        double micros = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - beg).count();
+        BOOST_TEST_MESSAGE(name << " release " << waiterCount << " waiters:" << micros << " us");
+        evt.Reset();
+    }
+}
+
+BOOST_AUTO_TEST_SUITE(WaitEventBenchmark)
+
+BOOST_AUTO_TEST_CASE(UncontendedBench)
+{
+    WaitEvent evt;
+    RunUncontendedBench("WaitEvent", evt);
+    FutexWaitEvent futexEvt;
+    RunUncontendedBench("FutexWaitEvent", futexEvt);
+}
+
+BOOST_AUTO_TEST_CASE(PingPongBench)
+{
+    {
+        WaitEvent request, response;
+        RunPingPongBench("WaitEvent", request, response);
+    }
+    {
+        FutexWaitEvent request(FutexWaitEvent::AutoReset, 0), response(FutexWaitEvent::AutoReset, 0);
+        RunPingPongBench("FutexWaitEvent(no spin)", request, response);
+    }
+    {
+        FutexWaitEvent request, response;
+        RunPingPongBench("FutexWaitEvent(spin)", request, response);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(BroadcastBench)
+{
+    {
+        //WaitEvent wakes one waiter per signal,the released waiter passes the signal on.
+        WaitEvent evt;
+        RunBroadcastBench("WaitEvent(chained)", evt, true);
+    }
+    {
+        FutexWaitEvent evt(FutexWaitEvent::ManualReset);
+        RunBroadcastBench("FutexWaitEvent(manual-reset)", evt, false);
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,181 @@
+#include "Channel/Common/AwaitableChannel.h"
+#include "Concurrent/Timer/AwaitableTimer.h"
+
+#if defined(BOOST_ASIO_HAS_CO_AWAIT) && defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
+
+#include <chrono>
+#include <boost/test/unit_test.hpp>
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/redirect_error.hpp>
+#include <boost/asio/strand.hpp>
+#include "Concurrent/ThreadPool.h"
+#include "Concurrent/WaitEvent.h"
+#include "Channel/Unix/UnixStreamPassiveChannel.h"
+
+BOOST_AUTO_TEST_SUITE(AwaitableChannelTest)
+
+const size_t AwaitableTestSize = 100;
+
+const size_t AwaitableTestRounds = 50;
+
+/**
+ * Echoes everything back until end of stream.
+ *
+ * @param channel The server side channel.
+ */
+boost::asio::awaitable<void> AwaitableEchoServer(AwaitableChannel &channel)
+{
+    us8 buf[AwaitableTestSize];
+    BufDescriptor desc = { buf, sizeof(buf) };
+    boost::system::error_code err;
+    for (;;)
+    {
+        size_t bytes = co_await channel.ReadSome(&desc, 1, boost::asio::redirect_error(boost::asio::use_awaitable, err));
+        if (err)
+        {
+            BOOST_TEST((err == boost::asio::error::eof), "AwaitableEchoServer read error:" << err.message());
+            break;
+        }
+        co_await channel.WriteCopy(buf, bytes);
+    }
+    co_await channel.Close();
+}
+
+/**
+ * Sends AwaitableTestRounds messages and checks the echoes.
+ *
+ * @param channel The client side channel.
+ */
+boost::asio::awaitable<void> AwaitableEchoClient(AwaitableChannel &channel)
+{
+    co_await channel.Open();
+    std::shared_ptr<LinearBuffer> data(new LinearBuffer(AwaitableTestSize));
+    us8 received[AwaitableTestSize];
+    for (size_t round = 0; round < AwaitableTestRounds; ++round)
+    {
+        data->clear();
+        for (size_t i = 0; i < AwaitableTestSize; ++i)
+        {
+            data->push_back(static_cast<us8>(i + round));
+        }
+        BOOST_TEST(co_await channel.Write(data, 0, data->size()) == AwaitableTestSize);
+        size_t readSize = 0;
+        while (readSize < AwaitableTestSize)
+        {
+            BufDescriptor desc = { received + readSize, AwaitableTestSize - readSize };
+            readSize += co_await channel.ReadSome(&desc, 1);
+        }
+        BOOST_TEST(std::equal(received, received + AwaitableTestSize, data->data()));
+    }
+    co_await channel.Close();
+}
+
+/**
+ * Sends AwaitableTestRounds messages from a coroutine running on a strand and checks it is resumed on the strand.
+ *
+ * @param channel The client side channel.
+ * @param strand The strand.
+ */
+boost::asio::awaitable<void> AwaitableStrandClient(AwaitableChannel &channel
+    , boost::asio::strand<boost::asio::io_context::executor_type> &strand)
+{
+    co_await channel.Open();
+    BOOST_TEST(strand.running_in_this_thread());
+    us8 data[AwaitableTestSize];
+    us8 received[AwaitableTestSize];
+    for (size_t round = 0; round < AwaitableTestRounds; ++round)
+    {
+        for (size_t i = 0; i < AwaitableTestSize; ++i)
+        {
+            data[i] = static_cast<us8>(i + round);
+        }
+        BOOST_TEST(co_await channel.WriteCopy(data, AwaitableTestSize) == AwaitableTestSize);
+        BOOST_TEST(strand.running_in_this_thread());
+        size_t readSize = 0;
+        while (readSize < AwaitableTestSize)
+        {
+            BufDescriptor desc = { received + readSize, AwaitableTestSize - readSize };
+            readSize += co_await channel.ReadSome(&desc, 1);
+            BOOST_TEST(strand.running_in_this_thread());
+        }
+        BOOST_TEST(std::equal(received, received + AwaitableTestSize, data));
+    }
+    co_await channel.Close();
+    BOOST_TEST(strand.running_in_this_thread());
+}
+
+/**
+ * Waits on the timer and checks the elapsed time.
+ */
+boost::asio::awaitable<void> AwaitableTimerWait()
+{
+    AwaitableTimer timer;
+    auto beg = std::chrono::steady_clock::now();
+    co_await timer.After(std::chrono::milliseconds(50));
+    BOOST_TEST((std::chrono::steady_clock::now() - beg >= std::chrono::milliseconds(50)));
+}
+
+BOOST_AUTO_TEST_CASE(GeneralTest)
+{
+    ThreadPool::Instance();
+    std::shared_ptr<UnixStreamTraits::StreamType> clientSock(new UnixStreamTraits::StreamType(ThreadPool::Instance().Context()));
+    std::shared_ptr<UnixStreamTraits::StreamType> serverSock(new UnixStreamTraits::StreamType(ThreadPool::Instance().Context()));
+    boost::asio::local::connect_pair(*clientSock, *serverSock);
+    AwaitableChannel client(std::make_shared<UnixStreamPassiveChannel>(clientSock));
+    AwaitableChannel server(std::make_shared<UnixStreamPassiveChannel>(serverSock));
+
+    WaitEvent finished[3];
+    auto completion = [](WaitEvent &event)
+    {
+        return [&event](std::exception_ptr e)
+        {
+            BOOST_TEST(!e, "Coroutine throwed an exception.");
+            event.Signal();
+        };
+    };
+    boost::asio::co_spawn(ThreadPool::Instance().Context(), AwaitableEchoServer(server), completion(finished[0]));
+    boost::asio::co_spawn(ThreadPool::Instance().Context(), AwaitableEchoClient(client), completion(finished[1]));
+    boost::asio::co_spawn(ThreadPool::Instance().Context(), AwaitableTimerWait(), completion(finished[2]));
+    for (WaitEvent &event : finished)
+    {
+        BOOST_TEST_REQUIRE(event.TimedWait(5000));
+    }
+
+    ThreadPool::Instance().Stop();
+    ThreadPool::Destory();
+}
+
+BOOST_AUTO_TEST_CASE(StrandTest)
+{
+    ThreadPool::Instance();
+    std::shared_ptr<UnixStreamTraits::StreamType> clientSock(new UnixStreamTraits::StreamType(ThreadPool::Instance().Context()));
+    std::shared_ptr<UnixStreamTraits::StreamType> serverSock(new UnixStreamTraits::StreamType(ThreadPool::Instance().Context()));
+    boost::asio::local::connect_pair(*clientSock, *serverSock);
+    AwaitableChannel client(std::make_shared<UnixStreamPassiveChannel>(clientSock));
+    AwaitableChannel server(std::make_shared<UnixStreamPassiveChannel>(serverSock));
+    auto strand = boost::asio::make_strand(ThreadPool::Instance().Context());
+
+    WaitEvent finished[2];
+    auto completion = [](WaitEvent &event)
+    {
+        return [&event](std::exception_ptr e)
+        {
+            BOOST_TEST(!e, "Coroutine throwed an exception.");
+            event.Signal();
+        };
+    };
+    //the completions run on the thread pool,the coroutine must still be resumed through its strand.
+    boost::asio::co_spawn(ThreadPool::Instance().Context(), AwaitableEchoServer(server), completion(finished[0]));
+    boost::asio::co_spawn(strand, AwaitableStrandClient(client, strand), completion(finished[1]));
+    for (WaitEvent &event : finished)
+    {
+        BOOST_TEST_REQUIRE(event.TimedWait(5000));
+    }
+
+    ThreadPool::Instance().Stop();
+    ThreadPool::Destory();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+#endif
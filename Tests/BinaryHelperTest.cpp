@@ -112,4 +112,61 @@ BOOST_AUTO_TEST_CASE(GeneralTest)
     }
 }
 
+BOOST_AUTO_TEST_CASE(CircularBufferReaderTest)
+{
+    CircularBuffer circularBuf(16);
+    BufDescriptor bufs[2];
+    size_t bufCount = circularBuf.free_buffers(bufs);
+    BOOST_TEST(bufCount == 1);
+    circularBuf.inc_size(bufs[0].m_size);
+    circularBuf.pop_front(11);
+    bufCount = circularBuf.free_buffers(bufs);
+    BOOST_TEST(bufCount == 1);
+    circularBuf.inc_size(bufs[0].m_size);
+    BOOST_TEST(circularBuf.size() == 16);
+    BOOST_TEST(circularBuf.content_buffers(bufs) == 2);
+    for (size_t i = 0; i < circularBuf.size(); ++i)
+    {
+        circularBuf[i] = static_cast<us8>(0x80 + i * 7);
+    }
+
+    for (us8 size = 1; size <= 4; ++size)
+    {
+        for (size_t offset = 0; offset + size <= circularBuf.size(); ++offset)
+        {
+            us8 bytes[4];
+            for (us8 i = 0; i < size; ++i)
+            {
+                bytes[i] = circularBuf[offset + i];
+            }
+            us32 expectLE = BinaryHelper::ReadBinData(bytes, 0, size, true);
+            us32 expectBE = BinaryHelper::ReadBinData(bytes, 0, size, false);
+            s32 expectSignedLE = BinaryHelper::ReadBinDataSigned(bytes, 0, size, true);
+            s32 expectSignedBE = BinaryHelper::ReadBinDataSigned(bytes, 0, size, false);
+            BOOST_TEST(BinaryHelper::ReadBinData(circularBuf, offset, size, true) == expectLE, "offset:" << offset << ",size:" << +size);
+            BOOST_TEST(BinaryHelper::ReadBinData(circularBuf, offset, size, false) == expectBE, "offset:" << offset << ",size:" << +size);
+            BOOST_TEST(BinaryHelper::ReadBinDataSigned(circularBuf, offset, size, true) == expectSignedLE, "offset:" << offset << ",size:" << +size);
+            BOOST_TEST(BinaryHelper::ReadBinDataSigned(circularBuf, offset, size, false) == expectSignedBE, "offset:" << offset << ",size:" << +size);
+            if (size == 4)
+            {
+                BOOST_TEST(BinaryHelper::ReadBinData(circularBuf, offset, true) == BinaryHelper::ReadBinData(bytes, 0, true));
+                BOOST_TEST(BinaryHelper::ReadBinData(circularBuf, offset, false) == BinaryHelper::ReadBinData(bytes, 0, false));
+            }
+        }
+    }
+
+    CircularBufferReader reader(circularBuf, 2);
+    BOOST_TEST((reader.Offset() == 2 && reader.Remain() == 14));
+    us32 val16 = reader.ReadBinData(2, false);
+    BOOST_TEST(val16 == BinaryHelper::ReadBinData(circularBuf, 2, 2, false));
+    s32 val24 = reader.ReadBinDataSigned(3, true);
+    BOOST_TEST(val24 == BinaryHelper::ReadBinDataSigned(circularBuf, 4, 3, true));
+    reader.Skip(1);
+    f32 valFloat = reader.ReadBinData(true);
+    BOOST_TEST(valFloat == BinaryHelper::ReadBinData(circularBuf, 8, true));
+    BOOST_TEST((reader.Offset() == 12 && reader.Remain() == 4));
+    reader.Seek(0);
+    BOOST_TEST(reader.ReadBinData(1, true) == circularBuf[0]);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
\ No newline at end of file
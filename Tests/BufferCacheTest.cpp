@@ -1,6 +1,7 @@
 #include <boost/test/unit_test.hpp>
 #include "Buffer/CircularBufferCache.h"
 #include "Buffer/LinearBufferCache.h"
+#include "Buffer/LinearBufferAppender.h"
 
 BOOST_AUTO_TEST_SUITE(BufferCacheTest)
 
@@ -132,4 +133,52 @@ BOOST_AUTO_TEST_CASE(LinearBufferCacheNoTrivialWrapperTest)
     BOOST_TEST(objCount == 0);
 }
 
+BOOST_AUTO_TEST_CASE(LinearBufferAppenderTest)
+{
+    LinearBufferCache::Instance().Destory();
+    us8 temp[3000];
+    for (size_t i = 0; i < sizeof(temp); ++i)
+    {
+        temp[i] = static_cast<us8>(i);
+    }
+    {
+        LinearBufferAppender appender(100);
+        appender.Append(temp, 100);
+        BOOST_TEST((!appender.IsPooled() && appender.Size() == 100));
+        appender.Append(temp + 100, 200);
+        BOOST_TEST(appender.Buffer().growable());
+        std::shared_ptr<LinearBuffer> result = appender.Detach();
+        BOOST_TEST((result->size() == 300 && (*result)[0] == 0 && (*result)[299] == static_cast<us8>(299)));
+        BOOST_TEST(appender.Size() == 0);
+    }
+    LinearBufferCache::Instance().AddToObjectPool(512, 2);
+    LinearBufferCache::Instance().AddToObjectPool(2048, 1);
+    {
+        LinearBufferAppender appender(100);
+        BOOST_TEST((appender.IsPooled() && appender.Buffer().capacity() == 512));
+        appender.Append(temp, 500);
+        appender.Append(temp + 500, 500);
+        BOOST_TEST((appender.IsPooled() && appender.Buffer().capacity() == 2048));
+        appender.Append(temp + 1000, 2000);
+        BOOST_TEST((!appender.IsPooled() && appender.Buffer().capacity() >= 3000));
+        LinearBuffer &buf = appender.Buffer();
+        BOOST_TEST(std::equal(buf.begin(), buf.end(), temp, temp + sizeof(temp)));
+        appender.Append(static_cast<us8>(1));
+        BOOST_TEST((appender.Size() == 3001 && buf.back() == 1));
+    }
+    {
+        LinearBufferAppender appender;
+        appender.Append(temp, 10);
+        BOOST_TEST(appender.IsPooled());
+        std::shared_ptr<LinearBuffer> result = appender.Detach();
+        BOOST_TEST((result->capacity() == 512 && result->size() == 10));
+        BOOST_TEST(!appender.IsPooled());
+        result.reset();
+        LinearBufferCache::ptr_t buf1 = LinearBufferCache::Instance().Get(512);
+        LinearBufferCache::ptr_t buf2 = LinearBufferCache::Instance().Get(512);
+        BOOST_TEST((buf1 && buf2 && buf1->size() == 0 && buf2->size() == 0));
+    }
+    LinearBufferCache::Instance().Destory();
+}
+
 BOOST_AUTO_TEST_SUITE_END()
\ No newline at end of file
@@ -0,0 +1,66 @@
+#include <boost/test/unit_test.hpp>
+#include "Buffer/BufferSlice.h"
+
+BOOST_AUTO_TEST_SUITE(BufferSliceTest)
+
+BOOST_AUTO_TEST_CASE(SliceTest)
+{
+    std::shared_ptr<LinearBuffer> body(new LinearBuffer(16));
+    body->assign({ 1, 2, 3, 4, 5, 6, 7, 8 });
+    BufferSlice empty;
+    BOOST_TEST((empty.Empty() && empty.Data() == nullptr && empty.UseCount() == 0));
+    {
+        BufferSlice whole(body);
+        BOOST_TEST((whole.Size() == 8 && whole.Data() == body->data() && body.use_count() == 2));
+        BufferSlice part(body, 2, 4);
+        BOOST_TEST((part.Size() == 4 && part.Data()[0] == 3 && body.use_count() == 3));
+        BufferSlice sub = part.Sub(1, 2);
+        BOOST_TEST((sub.Size() == 2 && sub.Data()[0] == 4 && sub.Data()[1] == 5 && body.use_count() == 4));
+        BufferSlice copied = sub;
+        BOOST_TEST((copied.Data() == sub.Data() && body.use_count() == 5));
+    }
+    BOOST_TEST(body.use_count() == 1);
+
+    LinearBufferCache::Instance().Destory();
+    LinearBufferCache::Instance().AddToObjectPool(64, 1);
+    us8 header[4] = { 9, 9, 9, 9 };
+    us8 large[100] = { 9 };
+    const us8 *pooledData;
+    {
+        BufferSlice pooled = BufferSlice::Copy(header, sizeof(header));
+        BOOST_TEST((pooled.Size() == 4 && std::equal(pooled.Data(), pooled.Data() + 4, header)));
+        pooledData = pooled.Data();
+        BufferSlice heap = BufferSlice::Copy(large, sizeof(large));
+        BOOST_TEST((heap.Size() == 100 && std::equal(heap.Data(), heap.Data() + 100, large)));
+    }
+    BOOST_TEST(LinearBufferCache::Instance().Get(4)->data() == pooledData);
+    LinearBufferCache::Instance().Destory();
+}
+
+BOOST_AUTO_TEST_CASE(ChainTest)
+{
+    std::shared_ptr<LinearBuffer> body(new LinearBuffer(16));
+    body->assign({ 1, 2, 3, 4, 5, 6, 7, 8 });
+    us8 header[2] = { 9, 10 };
+    BufferChain chain;
+    BOOST_TEST((chain.Empty() && chain.Size() == 0));
+    chain.Append(BufferSlice(body));
+    chain.Append(BufferSlice());
+    chain.Prepend(BufferSlice::Copy(header, sizeof(header)));
+    BOOST_TEST((chain.SliceCount() == 2 && chain.Size() == 10));
+    BOOST_TEST((chain[0].Data()[0] == 9 && chain[1].Data() == body->data()));
+    {
+        BufferChain chain2(chain);
+        BOOST_TEST((chain2.SliceCount() == 2 && body.use_count() == 3));
+    }
+    chain.Append(BufferSlice(body, 0, 1));
+    chain.Append(BufferSlice(body, 7, 1));
+    BOOST_TEST((chain.SliceCount() == BufferChain::MaxSliceCount && chain.Size() == 12));
+#ifndef NDEBUG
+    BOOST_CHECK_THROW(chain.Append(BufferSlice(body)), std::out_of_range);
+#endif
+    chain.Clear();
+    BOOST_TEST((chain.Empty() && chain.Size() == 0 && body.use_count() == 1));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
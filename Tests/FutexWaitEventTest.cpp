@@ -0,0 +1,134 @@
+#include <atomic>
+#include <boost/test/unit_test.hpp>
+#include <boost/thread.hpp>
+#include "Concurrent/FutexWaitEvent.h"
+
+BOOST_AUTO_TEST_SUITE(FutexWaitEventTest)
+
+BOOST_AUTO_TEST_CASE(AutoResetTest)
+{
+    FutexWaitEvent evt;
+    BOOST_TEST(evt == true);
+    BOOST_TEST(evt.TimedWait(50) == false);
+    evt.Signal();
+    BOOST_TEST(evt.TimedWait(0) == true);
+    BOOST_TEST(evt.TimedWait(50) == false);
+
+    std::atomic<int> released(0);
+    boost::thread_group threads;
+    for (int i = 0; i < 4; ++i)
+    {
+        threads.create_thread([&]()
+        {
+            evt.Wait();
+            released.fetch_add(1);
+        });
+    }
+    for (int i = 1; i <= 4; ++i)
+    {
+        //an auto-reset signal releases one waiter only.
+        evt.Signal();
+        while (released.load() < i)
+        {
+            boost::this_thread::sleep_for(boost::chrono::milliseconds(1));
+        }
+        boost::this_thread::sleep_for(boost::chrono::milliseconds(20));
+        BOOST_TEST(released.load() == i);
+    }
+    threads.join_all();
+}
+
+BOOST_AUTO_TEST_CASE(ManualResetTest)
+{
+    FutexWaitEvent evt(FutexWaitEvent::ManualReset, 0);
+    std::atomic<int> released(0);
+    boost::thread_group threads;
+    for (int i = 0; i < 4; ++i)
+    {
+        threads.create_thread([&]()
+        {
+            evt.Wait();
+            released.fetch_add(1);
+        });
+    }
+    boost::this_thread::sleep_for(boost::chrono::milliseconds(20));
+    BOOST_TEST(released.load() == 0);
+    evt.Signal();
+    threads.join_all();
+    BOOST_TEST(released.load() == 4);
+    BOOST_TEST(evt.TimedWait(0) == true);
+    evt.Reset();
+    BOOST_TEST(evt.TimedWait(50) == false);
+
+    //SignalAll releases the current waiters without leaving the event signaled.
+    FutexWaitEvent autoEvt;
+    for (int i = 0; i < 4; ++i)
+    {
+        threads.create_thread([&]()
+        {
+            autoEvt.Wait();
+            released.fetch_add(1);
+        });
+    }
+    boost::this_thread::sleep_for(boost::chrono::milliseconds(20));
+    autoEvt.SignalAll();
+    threads.join_all();
+    BOOST_TEST(released.load() == 8);
+    BOOST_TEST(autoEvt.TimedWait(50) == false);
+}
+
+BOOST_AUTO_TEST_CASE(ActionTest)
+{
+    FutexWaitEvent evt;
+    int value = 0;
+    evt.Signal([&]() { return false; });
+    BOOST_TEST(evt.TimedWait(50) == false);
+
+    boost::thread t([&]()
+    {
+        evt.Wait([&]() { value *= 2; });
+    });
+    evt.Signal([&]() { value = 21; });
+    t.join();
+    BOOST_TEST(value == 42);
+
+    bool result = true;
+    BOOST_TEST(evt.TimedWait(50, [&](bool ret) { result = ret; }) == false);
+    BOOST_TEST(result == false);
+    evt.Signal();
+    evt.Reset([&]() { value = 0; });
+    BOOST_TEST(evt.TimedWait(0, [&](bool ret) { result = ret; }) == false);
+    BOOST_TEST(value == 0);
+
+    //the waiters released by SignalAll execute their actions too.
+    std::atomic<int> released(0);
+    std::atomic<int> actions(0);
+    boost::thread_group threads;
+    for (int i = 0; i < 2; ++i)
+    {
+        threads.create_thread([&]()
+        {
+            released.fetch_add(1);
+            evt.Wait([&]() { actions.fetch_add(1); });
+        });
+        threads.create_thread([&]()
+        {
+            released.fetch_add(1);
+            if (evt.TimedWait(5000, [&](bool ret) { if (ret) actions.fetch_add(1); }))
+            {
+                actions.fetch_add(10);
+            }
+        });
+    }
+    while (released.load() < 4)
+    {
+        boost::this_thread::sleep_for(boost::chrono::milliseconds(1));
+    }
+    boost::this_thread::sleep_for(boost::chrono::milliseconds(20));
+    evt.SignalAll();
+    threads.join_all();
+    BOOST_TEST(actions.load() == 24);
+    BOOST_TEST(evt.TimedWait(0) == false);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
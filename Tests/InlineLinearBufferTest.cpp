@@ -0,0 +1,63 @@
+#include <boost/test/unit_test.hpp>
+#include "Buffer/InlineLinearBuffer.h"
+
+BOOST_AUTO_TEST_SUITE(InlineLinearBufferTest)
+
+BOOST_AUTO_TEST_CASE(CopyCtrlTest)
+{
+    InlineLinearBuffer<64> buf64;
+    BOOST_TEST((buf64.capacity() == 64 && buf64.empty() && !buf64.growable()));
+    BOOST_CHECK_THROW(buf64.reserve(65), std::length_error);
+    buf64.assign(60, 10);
+    InlineLinearBuffer<64> buf64_2(buf64);
+    BOOST_TEST(buf64_2 == buf64, boost::test_tools::per_element());
+    buf64_2[0] = 1;
+    BOOST_TEST((buf64[0] == 10 && buf64_2[0] == 1));
+    buf64_2 = buf64;
+    BOOST_TEST(buf64_2 == buf64, boost::test_tools::per_element());
+    InlineLinearBuffer<64> buf64_3;
+    buf64_3.assign({ 1, 2, 3 });
+    std::swap(buf64_3, buf64_2);
+    BOOST_TEST(buf64_2.size() == 3);
+    BOOST_TEST(buf64_3 == buf64, boost::test_tools::per_element());
+}
+
+BOOST_AUTO_TEST_CASE(ReadWriteTest)
+{
+    InlineLinearBuffer<16> buf16;
+#ifndef NDEBUG
+    us8 temp[3] = { 1, 2, 3 };
+    BOOST_CHECK_THROW(buf16.assign(17, 10), std::out_of_range);
+    BOOST_CHECK_THROW(buf16.assign(temp + sizeof(temp) / sizeof(us8), temp), std::out_of_range);
+    BOOST_CHECK_THROW(buf16.insert(buf16.begin() + 1, 1, 1), std::out_of_range);
+    BOOST_CHECK_THROW(buf16.erase(buf16.begin()), std::out_of_range);
+    BOOST_CHECK_THROW(buf16.pop_back(), std::logic_error);
+#endif
+    buf16.assign({ 1, 2, 3 });
+    BOOST_TEST((buf16.size() == 3 && buf16.front() == 1 && buf16.back() == 3 && buf16.at(1) == 2));
+    buf16.insert(buf16.begin() + 1, 2, 9);
+    BOOST_TEST((buf16.size() == 5 && buf16[1] == 9 && buf16[2] == 9 && buf16[3] == 2));
+    buf16.insert(buf16.begin(), { 7, 8 });
+    BOOST_TEST((buf16.size() == 7 && buf16[0] == 7 && buf16[1] == 8 && buf16[2] == 1));
+    buf16.erase(buf16.begin(), buf16.begin() + 2);
+    buf16.erase(buf16.begin() + 1);
+    BOOST_TEST((buf16.size() == 4 && buf16[0] == 1 && buf16[1] == 9 && buf16[3] == 3));
+    us8 data[12] = { 0 };
+    buf16.append(data, sizeof(data));
+    BOOST_TEST((buf16.size() == 16 && *buf16.rbegin() == 0));
+#ifndef NDEBUG
+    BOOST_CHECK_THROW(buf16.push_back(1), std::out_of_range);
+    BOOST_CHECK_THROW(buf16.append(data, 1), std::out_of_range);
+#endif
+    buf16.resize(2);
+    buf16.resize(4, 5);
+    BOOST_TEST((buf16.size() == 4 && buf16[0] == 1 && buf16[1] == 9 && buf16[2] == 5 && buf16[3] == 5));
+    buf16.pop_back();
+    buf16.push_back(6);
+    BOOST_TEST(buf16.back() == 6);
+    buf16.clear();
+    buf16.inc_size(16);
+    BOOST_TEST((buf16.size() == 16 && buf16.max_size() == 16));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
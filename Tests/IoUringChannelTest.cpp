@@ -0,0 +1,128 @@
+#ifdef USE_IO_URING_CHANNEL
+
+#include <vector>
+#include <boost/test/unit_test.hpp>
+#include "Concurrent/ThreadPool.h"
+#include "Concurrent/WaitEvent.h"
+#include "Channel/Unix/UnixStreamPassiveChannel.h"
+
+BOOST_AUTO_TEST_SUITE(IoUringChannelTest)
+
+const size_t IoUringTestSize = 64 * 1024 + 10;
+
+/**
+ * The client side writes IoUringTestSize bytes and closes,the server side reads until end of stream.
+ */
+class IoUringTestHandler :public std::enable_shared_from_this<IoUringTestHandler>, public IAsyncChannelHandler
+{
+public:
+    IAsyncChannel::ptr_t m_channel;
+
+    us8 m_readBuf[1000];
+
+    std::vector<us8> m_received;
+
+    boost::system::error_code m_readError;
+
+    size_t m_writeCount{ 0 };
+
+    WaitEvent m_finished;
+
+    void BeginRead()
+    {
+        BufDescriptor bufs[2] = { { m_readBuf, 300 }, { m_readBuf + 300, sizeof(m_readBuf) - 300 } };
+        m_channel->AsyncReadSome(bufs, 2, shared_from_this());
+    }
+
+    virtual void EndOpen(const boost::system::error_code &err) override
+    {
+    }
+
+    virtual void EndRead(const boost::system::error_code &err, std::size_t bytesTransferred, void *ctx) override
+    {
+        if (err)
+        {
+            m_readError = err;
+            m_finished.Signal();
+            return;
+        }
+        m_received.insert(m_received.end(), m_readBuf, m_readBuf + bytesTransferred);
+        BeginRead();
+    }
+
+    virtual void EndWrite(const boost::system::error_code &err, std::size_t bytesTransferred, void *ctx) override
+    {
+        BOOST_TEST(!err, "IoUringTestHandler EndWrite called,message:" << err.message());
+        if (++m_writeCount == 2)
+        {
+            m_channel->AsyncClose(shared_from_this());
+        }
+    }
+
+    virtual void EndClose(const boost::system::error_code &err) override
+    {
+    }
+};
+
+/**
+ * Sends IoUringTestSize bytes through a connected unix socket pair and checks them.
+ */
+void RunIoUringEcho()
+{
+    std::shared_ptr<UnixStreamTraits::StreamType> clientSock(new UnixStreamTraits::StreamType(ThreadPool::Instance().Context()));
+    std::shared_ptr<UnixStreamTraits::StreamType> serverSock(new UnixStreamTraits::StreamType(ThreadPool::Instance().Context()));
+    boost::asio::local::connect_pair(*clientSock, *serverSock);
+    std::shared_ptr<IoUringTestHandler> client(new IoUringTestHandler()), server(new IoUringTestHandler());
+    client->m_channel.reset(new UnixStreamPassiveChannel(clientSock));
+    server->m_channel.reset(new UnixStreamPassiveChannel(serverSock));
+    server->BeginRead();
+
+    us8 head[10];
+    for (size_t i = 0; i < sizeof(head); ++i)
+    {
+        head[i] = static_cast<us8>(i);
+    }
+    std::shared_ptr<LinearBuffer> body(new LinearBuffer(IoUringTestSize - sizeof(head)));
+    for (size_t i = sizeof(head); i < IoUringTestSize; ++i)
+    {
+        body->push_back(static_cast<us8>(i));
+    }
+    client->m_channel->AsyncWriteCopy(head, sizeof(head), client);
+    client->m_channel->AsyncWrite(body, 0, body->size(), client);
+
+    BOOST_TEST_REQUIRE(server->m_finished.TimedWait(5000));
+    BOOST_TEST(server->m_readError == boost::asio::error::eof);
+    BOOST_TEST_REQUIRE(server->m_received.size() == IoUringTestSize);
+    for (size_t i = 0; i < IoUringTestSize; ++i)
+    {
+        if (server->m_received[i] != static_cast<us8>(i))
+        {
+            BOOST_TEST(server->m_received[i] == static_cast<us8>(i), "Received buf content, index:" << i);
+            break;
+        }
+    }
+    server->m_channel->AsyncClose(server);
+    client->m_channel.reset();
+    server->m_channel.reset();
+}
+
+BOOST_AUTO_TEST_CASE(GeneralTest)
+{
+    //a small buffer ring,so the data is queued in several buffers and the buffers run out.
+    IoUringService::Configure(IoUringSettings{ 64, 4, 512 });
+    ThreadPool::Instance();
+    BOOST_TEST_MESSAGE("io_uring available:" << boost::asio::use_service<IoUringService>(ThreadPool::Instance().Context()).Available());
+    RunIoUringEcho();
+
+    IoUringService::SetEnabled(false);
+    RunIoUringEcho();
+    IoUringService::SetEnabled(true);
+
+    ThreadPool::Instance().Stop();
+    ThreadPool::Destory();
+    IoUringService::Configure(IoUringSettings{ 1024, 1024, 4096 });
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+#endif
\ No newline at end of file
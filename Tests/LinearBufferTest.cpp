@@ -103,4 +103,42 @@ BOOST_AUTO_TEST_CASE(ReadWriteTest)
     BOOST_TEST((buf512.size() == 512 && buf512[0] == buf512[256] && buf512[256] == buf512[511] && buf512[511] == 255));
 }
 
+BOOST_AUTO_TEST_CASE(GrowthTest)
+{
+    LinearBuffer buf;
+    BOOST_TEST(!buf.growable());
+    buf.set_growable(true);
+    BOOST_TEST(buf.growable());
+    buf.push_back(1);
+    BOOST_TEST((buf.size() == 1 && buf.capacity() >= 1 && buf[0] == 1));
+    us8 temp[100];
+    for (size_t i = 0; i < sizeof(temp); ++i)
+    {
+        temp[i] = static_cast<us8>(i);
+    }
+    buf.append(temp, sizeof(temp));
+    BOOST_TEST((buf.size() == 101 && buf.capacity() >= 101));
+    BOOST_TEST((buf[0] == 1 && buf[1] == 0 && buf[100] == 99));
+    size_t capacity = buf.capacity();
+    buf.resize(capacity + 1, 7);
+    BOOST_TEST((buf.size() == capacity + 1 && buf.capacity() >= capacity * 2));
+    BOOST_TEST((buf[100] == 99 && buf[101] == 7 && buf[capacity] == 7));
+    buf.resize(3);
+    buf.insert(buf.begin() + 1, buf.capacity(), 5);
+    BOOST_TEST((buf.size() == capacity * 2 + 3 && buf[0] == 1 && buf[1] == 5 && buf[buf.size() - 2] == 0 && buf.back() == 1));
+    buf.assign(buf.capacity() + 10, 9);
+    BOOST_TEST((buf.front() == 9 && buf.back() == 9));
+
+    LinearBuffer fixed(4);
+    fixed.append(temp, 4);
+    BOOST_TEST((fixed.size() == 4 && fixed[3] == 3));
+#ifndef NDEBUG
+    BOOST_CHECK_THROW(fixed.append(temp, 1), std::out_of_range);
+#endif
+    LinearBuffer copied(buf);
+    BOOST_TEST(copied.growable());
+    copied.swap(fixed);
+    BOOST_TEST((!copied.growable() && fixed.growable()));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
\ No newline at end of file
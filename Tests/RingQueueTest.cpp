@@ -0,0 +1,112 @@
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <boost/test/unit_test.hpp>
+#include "Concurrent/RingQueue.h"
+
+BOOST_AUTO_TEST_SUITE(RingQueueTest)
+
+BOOST_AUTO_TEST_CASE(MpmcGeneralTest)
+{
+    MpmcRingQueue<std::shared_ptr<int>> queue(5);
+    BOOST_TEST(queue.Capacity() == 8U);
+    std::shared_ptr<int> value = std::make_shared<int>(0);
+    for (int i = 0; i < 8; ++i)
+    {
+        BOOST_TEST(queue.TryPush(std::make_shared<int>(i)));
+    }
+    BOOST_TEST(!queue.TryPush(value));
+    BOOST_TEST(queue.SizeApprox() == 8U);
+    BOOST_TEST(!queue.Push(value, 10));
+    for (int i = 0; i < 8; ++i)
+    {
+        BOOST_TEST_REQUIRE(queue.TryPop(value));
+        BOOST_TEST(*value == i);
+    }
+    BOOST_TEST(!queue.TryPop(value));
+    BOOST_TEST(!queue.Pop(value, 10));
+
+    //the remaining elements are destroyed with the queue.
+    std::weak_ptr<int> remaining;
+    {
+        MpmcRingQueue<std::shared_ptr<int>> temp(4);
+        auto element = std::make_shared<int>(1);
+        remaining = element;
+        BOOST_TEST(temp.TryEmplace(std::move(element)));
+    }
+    BOOST_TEST(remaining.expired());
+}
+
+BOOST_AUTO_TEST_CASE(MpmcConcurrentTest)
+{
+    const int ThreadCount = 4;
+    const int CountPerThread = 100000;
+    MpmcRingQueue<int> queue(64);
+    std::atomic<long long> sum(0);
+    std::vector<std::thread> threads;
+    for (int i = 0; i < ThreadCount; ++i)
+    {
+        threads.emplace_back([&queue]()
+        {
+            for (int j = 1; j <= CountPerThread; ++j)
+            {
+                queue.Push(j);
+            }
+        });
+        threads.emplace_back([&queue, &sum]()
+        {
+            long long localSum = 0;
+            int value;
+            for (int j = 0; j < CountPerThread; ++j)
+            {
+                queue.Pop(value);
+                localSum += value;
+            }
+            sum += localSum;
+        });
+    }
+    for (auto &thread : threads)
+    {
+        thread.join();
+    }
+    BOOST_TEST(sum.load() == static_cast<long long>(CountPerThread) * (CountPerThread + 1) / 2 * ThreadCount);
+    BOOST_TEST(queue.SizeApprox() == 0U);
+}
+
+BOOST_AUTO_TEST_CASE(SpscTest)
+{
+    const int Count = 200000;
+    SpscRingQueue<std::unique_ptr<int>> queue(16);
+    BOOST_TEST(queue.Capacity() == 16U);
+    std::thread producer([&queue]()
+    {
+        for (int i = 0; i < Count; ++i)
+        {
+            queue.Push(std::unique_ptr<int>(new int(i)));
+        }
+    });
+    bool ordered = true;
+    std::unique_ptr<int> value;
+    for (int i = 0; i < Count; ++i)
+    {
+        //mix the non-blocking and the blocking pops.
+        if (!(i & 1) || !queue.TryPop(value))
+        {
+            queue.Pop(value);
+        }
+        ordered = ordered && *value == i;
+    }
+    producer.join();
+    BOOST_TEST(ordered);
+    BOOST_TEST(!queue.TryPop(value));
+    BOOST_TEST(!queue.Pop(value, 10));
+    for (int i = 0; i < 16; ++i)
+    {
+        BOOST_TEST(queue.TryEmplace(new int(i)));
+    }
+    BOOST_TEST(!queue.Push(std::unique_ptr<int>(new int(16)), 10));
+    BOOST_TEST(queue.SizeApprox() == 16U);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,147 @@
+#if defined(USE_ODBC_DATABASE_UTILS)
+
+#include <cstdlib>
+#include <thread>
+#include <vector>
+#include <boost/test/unit_test.hpp>
+#include "Database/SQL/Common/SqlConnectionPool.h"
+#include "Database/SQL/Common/SqlBatchWriter.hpp"
+
+BOOST_AUTO_TEST_SUITE(SqlBatchWriterTest)
+
+/**
+ * A test row.
+ */
+struct TestRow
+{
+    int m_id;
+
+    std::string m_name;
+};
+
+BOOST_AUTO_TEST_CASE(GeneralTest)
+{
+    const char *connStr = getenv("UTILS_TEST_ODBC_CONN");
+    auto pool = SqlConnectionPool::Create({ "SqlBatchWriterTest", SqlDatabaseType::ODBC
+        , connStr ? connStr : "Driver=SQLite3;Database=/tmp/UtilsSqlBatchWriterTest.db;", 1, 2, "", false, std::chrono::milliseconds(0)
+        , std::chrono::milliseconds(0), std::chrono::milliseconds(1000), std::chrono::milliseconds(1000) });
+    BOOST_TEST_REQUIRE(static_cast<bool>(pool));
+    {
+        auto db = pool->Borrow();
+        BOOST_TEST_REQUIRE(static_cast<bool>(db));
+        db->Prepare("drop table if exists batch_writer_test", 1) && db->FlushBuffer() && db->Commit();
+        BOOST_TEST_REQUIRE((db->Prepare("create table batch_writer_test(id int,name varchar(32))", 1) && db->FlushBuffer() && db->Commit())
+            , "Create table error:" << db->LastError());
+    }
+
+    const int producerCount = 4;
+    const int rowsPerProducer = 500;
+    std::atomic<size_t> groupedRows{ 0 };
+    {
+        SqlBatchWriter<TestRow> writer("insert into batch_writer_test values(:id<int>,:name<char[32]>)"
+            , { "SqlBatchWriterTest", 64, std::chrono::milliseconds(20) }
+            , [](ISqlDatabase &db, const TestRow &row) { db << row.m_id << row.m_name; }
+            , [&groupedRows](size_t rowCount, bool succeeded, const std::string &error)
+            {
+                BOOST_TEST(succeeded, "Group error:" << error);
+                groupedRows += rowCount;
+            });
+        std::vector<std::thread> producers;
+        for (int i = 0; i < producerCount; ++i)
+        {
+            producers.emplace_back([&writer, i]()
+                {
+                    for (int j = 0; j < rowsPerProducer; ++j)
+                    {
+                        int id = i * rowsPerProducer + j;
+                        writer.Write(TestRow{ id, std::to_string(id) });
+                    }
+                });
+        }
+        for (auto &producer : producers)
+        {
+            producer.join();
+        }
+        writer.Stop();
+        BOOST_TEST(!writer.Write(TestRow{ -1, "stopped" }));
+        BOOST_TEST(writer.PendingRows() == 0U);
+
+        SqlBatchWriterStats stats = writer.GetStats();
+        BOOST_TEST(stats.m_rows == static_cast<us64>(producerCount * rowsPerProducer));
+        BOOST_TEST(stats.m_failedRows == 0U);
+        //rows are committed in groups,not one by one.
+        BOOST_TEST(stats.m_groups < stats.m_rows);
+    }
+    BOOST_TEST(groupedRows == static_cast<size_t>(producerCount * rowsPerProducer));
+
+    {
+        auto db = pool->Borrow();
+        int count = 0;
+        BOOST_TEST_REQUIRE((db->Prepare("select count(*) from batch_writer_test", 1) && db->FlushBuffer()));
+        *db >> count;
+        BOOST_TEST(count == producerCount * rowsPerProducer);
+    }
+
+    {
+        //a failed group is rolled back and reported.
+        SqlBatchWriter<TestRow> writer("insert into table_not_exists values(:id<int>,:name<char[32]>)"
+            , { "SqlBatchWriterTest", 8, std::chrono::milliseconds(5) }
+            , [](ISqlDatabase &db, const TestRow &row) { db << row.m_id << row.m_name; });
+        for (int i = 0; i < 10; ++i)
+        {
+            writer.Write(TestRow{ i, std::to_string(i) });
+        }
+        writer.Stop();
+        SqlBatchWriterStats stats = writer.GetStats();
+        BOOST_TEST(stats.m_rows == 0U);
+        BOOST_TEST(stats.m_failedRows == 10U);
+    }
+
+    SqlConnectionPool::Destory("SqlBatchWriterTest");
+}
+
+BOOST_AUTO_TEST_CASE(StopRaceTest)
+{
+    //no pool,every group fails,so each accepted row must show up in the failed row count.
+    std::atomic<size_t> groupedRows{ 0 };
+    SqlBatchWriter<TestRow> writer("insert into batch_writer_test values(:id<int>,:name<char[32]>)"
+        , { "SqlBatchWriterStopRaceTest", 16, std::chrono::milliseconds(1) }
+        , [](ISqlDatabase &db, const TestRow &row) { db << row.m_id << row.m_name; }
+        , [&groupedRows](size_t rowCount, bool succeeded, const std::string &error)
+        {
+            groupedRows += rowCount;
+        });
+    std::atomic<size_t> acceptedRows{ 0 };
+    std::atomic<int> started{ 0 };
+    std::vector<std::thread> producers;
+    for (int i = 0; i < 4; ++i)
+    {
+        producers.emplace_back([&]()
+            {
+                started.fetch_add(1);
+                for (int id = 0; writer.Write(TestRow{ id, std::to_string(id) }); ++id)
+                {
+                    acceptedRows.fetch_add(1);
+                }
+            });
+    }
+    while (started.load() < 4 || acceptedRows.load() < 1000)
+    {
+        std::this_thread::yield();
+    }
+    //the producers are still writing when Stop is called.
+    writer.Stop();
+    for (auto &producer : producers)
+    {
+        producer.join();
+    }
+    SqlBatchWriterStats stats = writer.GetStats();
+    BOOST_TEST(stats.m_rows == 0U);
+    BOOST_TEST(stats.m_failedRows == acceptedRows.load());
+    BOOST_TEST(groupedRows.load() == acceptedRows.load());
+    BOOST_TEST(writer.PendingRows() == 0U);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+#endif
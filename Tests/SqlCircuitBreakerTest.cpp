@@ -0,0 +1,170 @@
+#if defined(USE_ODBC_DATABASE_UTILS)
+
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <thread>
+#include <boost/test/unit_test.hpp>
+#include "Concurrent/WaitEvent.h"
+#include "Database/SQL/ODBC/ODBCSqlDatabase.h"
+
+namespace
+{
+    /**
+     * Stand-in of a connection dropped by the network,reports a communication link failure like the driver does.
+     */
+    class DroppingDatabase :public ODBCSqlDatabase
+    {
+    public:
+        explicit DroppingDatabase(const char *connStr) :ODBCSqlDatabase(connStr, true)
+        {
+        }
+
+        void DropConnection()
+        {
+            odbc::otl_exception err("Communication link failure", 0);
+            strcpy(reinterpret_cast<char*>(err.sqlstate), "08S01");
+            HandleNetworkError(err);
+        }
+    };
+
+    bool WaitCount(const std::atomic<int> &count, int value, std::chrono::milliseconds timeout)
+    {
+        auto deadline = std::chrono::steady_clock::now() + timeout;
+        while (count.load() < value && std::chrono::steady_clock::now() < deadline)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return count.load() >= value;
+    }
+
+    bool WaitState(SqlCircuitBreaker &breaker, SqlCircuitState state, std::chrono::milliseconds timeout)
+    {
+        auto deadline = std::chrono::steady_clock::now() + timeout;
+        while (breaker.State() != state && std::chrono::steady_clock::now() < deadline)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+        return breaker.State() == state;
+    }
+}
+
+BOOST_AUTO_TEST_SUITE(SqlCircuitBreakerTest)
+
+BOOST_AUTO_TEST_CASE(GeneralTest)
+{
+    //stand-in of the database,the probe fails while it is down and blocks until the test releases it.
+    std::atomic<bool> databaseUp(false);
+    std::atomic<int> probeCount(0);
+    WaitEvent probeGate;
+    SqlCircuitBreaker breaker([&]() { ++probeCount; probeGate.Wait(); return databaseUp.load(); }
+        , SqlCircuitBreakerSettings{ 2, std::chrono::milliseconds(20), std::chrono::milliseconds(80) });
+    BOOST_TEST(breaker.AllowRequest());
+    breaker.OnFailure();
+    BOOST_TEST(breaker.AllowRequest());
+    breaker.OnSuccess();
+    breaker.OnFailure();
+    BOOST_TEST((breaker.State() == SqlCircuitState::Closed));
+
+    breaker.OnFailure();
+    BOOST_TEST((breaker.State() != SqlCircuitState::Closed));
+    BOOST_TEST(!breaker.AllowRequest());
+    //failures reported while the breaker is open do not restart the backoff.
+    breaker.OnFailure();
+    BOOST_TEST(breaker.GetStats().m_failureCount == 2U);
+
+    //the backoff is doubled after each failed probe up to m_maxBackoff.
+    const std::chrono::milliseconds backoffs[] = { std::chrono::milliseconds(20), std::chrono::milliseconds(40)
+        , std::chrono::milliseconds(80), std::chrono::milliseconds(80) };
+    for (int i = 0; i < 4; ++i)
+    {
+        BOOST_TEST_REQUIRE(WaitCount(probeCount, i + 1, std::chrono::milliseconds(5000)));
+        SqlCircuitBreakerStats stats = breaker.GetStats();
+        BOOST_TEST((stats.m_state == SqlCircuitState::HalfOpen));
+        BOOST_TEST(stats.m_probeCount == static_cast<us64>(i + 1));
+        BOOST_TEST((stats.m_backoff == backoffs[i]));
+        BOOST_TEST(!breaker.AllowRequest());
+        if (i < 3)
+        {
+            probeGate.Signal();
+        }
+    }
+    SqlCircuitBreakerStats stats = breaker.GetStats();
+    BOOST_TEST(stats.m_tripCount == 1U);
+    BOOST_TEST(stats.m_rejectedCount == 5U);
+
+    databaseUp = true;
+    probeGate.Signal();
+    BOOST_TEST_REQUIRE(WaitState(breaker, SqlCircuitState::Closed, std::chrono::milliseconds(5000)));
+    BOOST_TEST(breaker.AllowRequest());
+    stats = breaker.GetStats();
+    BOOST_TEST(stats.m_failureCount == 0U);
+    BOOST_TEST(stats.m_probeCount == 4U);
+    BOOST_TEST((stats.m_backoff == std::chrono::milliseconds(20)));
+
+    //the breaker opens again after the threshold.
+    databaseUp = false;
+    breaker.OnFailure();
+    breaker.OnFailure();
+    BOOST_TEST(!breaker.AllowRequest());
+    BOOST_TEST(breaker.GetStats().m_tripCount == 2U);
+    databaseUp = true;
+    BOOST_TEST_REQUIRE(WaitCount(probeCount, 5, std::chrono::milliseconds(5000)));
+    probeGate.Signal();
+    BOOST_TEST(WaitState(breaker, SqlCircuitState::Closed, std::chrono::milliseconds(5000)));
+}
+
+BOOST_AUTO_TEST_CASE(FastFailTest)
+{
+    SqlCircuitBreakerSettings defaultSettings = SqlCircuitBreaker::DefaultSettings();
+    SqlCircuitBreaker::SetDefaultSettings(SqlCircuitBreakerSettings{ 2, std::chrono::milliseconds(60000), std::chrono::milliseconds(60000) });
+    //a connection string which always fails to log on stands in for a database which is down.
+    ODBCSqlDatabase db("Driver=UtilsNoSuchDriver;Database=/tmp/UtilsSqlCircuitBreakerTest.db;");
+    ODBCSqlDatabase other("Driver=UtilsNoSuchDriver;Database=/tmp/UtilsSqlCircuitBreakerTest.db;");
+    SqlCircuitBreaker::SetDefaultSettings(defaultSettings);
+    BOOST_TEST((db.CircuitBreaker() == other.CircuitBreaker()));
+
+    BOOST_TEST(!db.Prepare("select 1", 1));
+    BOOST_TEST(!other.Prepare("select 1", 1));
+    BOOST_TEST((db.CircuitBreaker()->State() == SqlCircuitState::Open));
+    //the open breaker rejects the logons instead of trying them,so no further failure is counted.
+    for (int i = 0; i < 100; ++i)
+    {
+        BOOST_TEST_REQUIRE(!db.Prepare("select 1", 1));
+    }
+    BOOST_TEST(db.LastError().find("熔断") != std::string::npos);
+    SqlCircuitBreakerStats stats = db.CircuitBreaker()->GetStats();
+    BOOST_TEST(stats.m_rejectedCount == 100U);
+    BOOST_TEST(stats.m_failureCount == 2U);
+    BOOST_TEST(stats.m_probeCount == 0U);
+    db.CircuitBreaker()->Stop();
+}
+
+BOOST_AUTO_TEST_CASE(DroppedConnectionTest)
+{
+    SqlCircuitBreakerSettings defaultSettings = SqlCircuitBreaker::DefaultSettings();
+    SqlCircuitBreaker::SetDefaultSettings(SqlCircuitBreakerSettings{ 2, std::chrono::milliseconds(60000), std::chrono::milliseconds(60000) });
+    DroppingDatabase db("Driver=SQLite3;Database=/tmp/UtilsSqlCircuitBreakerDropTest.db;");
+    SqlCircuitBreaker::SetDefaultSettings(defaultSettings);
+    BOOST_TEST_REQUIRE(db.Prepare("select 1", 1), "Prepare error:" << db.LastError());
+
+    //a dropped connection counts as a failure,the next statement logs on again.
+    db.DropConnection();
+    BOOST_TEST(db.CircuitBreaker()->GetStats().m_failureCount == 1U);
+    BOOST_TEST_REQUIRE(db.Prepare("select 1", 1), "Prepare error:" << db.LastError());
+    BOOST_TEST(db.CircuitBreaker()->GetStats().m_failureCount == 0U);
+
+    db.DropConnection();
+    db.DropConnection();
+    BOOST_TEST((db.CircuitBreaker()->State() == SqlCircuitState::Open));
+    BOOST_TEST(!db.Prepare("select 1", 1));
+    BOOST_TEST(db.LastError().find("熔断") != std::string::npos);
+    SqlCircuitBreakerStats stats = db.CircuitBreaker()->GetStats();
+    BOOST_TEST(stats.m_tripCount == 1U);
+    BOOST_TEST(stats.m_rejectedCount == 1U);
+    db.CircuitBreaker()->Stop();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+#endif
@@ -0,0 +1,141 @@
+#if defined(USE_ODBC_DATABASE_UTILS)
+
+#include <cstdlib>
+#include <boost/test/unit_test.hpp>
+#include "Database/SQL/ODBC/ODBCSqlDatabase.h"
+
+BOOST_AUTO_TEST_SUITE(SqlColumnBatchTest)
+
+BOOST_AUTO_TEST_CASE(GeneralTest)
+{
+    //small arena chunks,so the strings are spread over several chunks.
+    SqlColumnBatch batch({ SqlColumnType::Int32, SqlColumnType::Int64, SqlColumnType::Double, SqlColumnType::String }, 100, 64);
+    BOOST_TEST(batch.ColumnCount() == 4U);
+    BOOST_TEST(batch.Capacity() == 100U);
+    BOOST_TEST(batch.RowCount() == 0U);
+    for (size_t i = 0; i < batch.Capacity(); ++i)
+    {
+        batch.Int32s(0)[i] = static_cast<s32>(i);
+        batch.Int64s(1)[i] = static_cast<s64>(i) << 40;
+        batch.Doubles(2)[i] = i / 2.0;
+        std::string str = std::to_string(i) + std::string(i % 20, 'x');
+        batch.SetString(3, i, str.data(), str.size());
+        batch.SetNull(2, i, i % 3 == 0);
+    }
+    batch.SetRowCount(batch.Capacity());
+    BOOST_TEST(batch.Full());
+    bool matched = true;
+    for (size_t i = 0; i < batch.Capacity(); ++i)
+    {
+        std::string str = std::to_string(i) + std::string(i % 20, 'x');
+        matched = matched && batch.Int32s(0)[i] == static_cast<s32>(i) && batch.Int64s(1)[i] == static_cast<s64>(i) << 40
+            && batch.Doubles(2)[i] == i / 2.0 && str == batch.String(3, i) && batch.StringLength(3, i) == str.size()
+            && batch.IsNull(2, i) == (i % 3 == 0) && !batch.IsNull(0, i);
+    }
+    BOOST_TEST(matched);
+
+    //a string longer than the chunk size gets its own chunk.
+    std::string longStr(1000, 'y');
+    batch.SetString(3, 0, longStr.data(), longStr.size());
+    BOOST_TEST(batch.String(3, 0) == longStr);
+    BOOST_TEST(batch.String(3, 1) == std::string("1x"));
+
+    batch.Clear();
+    BOOST_TEST(batch.RowCount() == 0U);
+    batch.SetString(3, 0, "abc", 3);
+    BOOST_TEST(batch.String(3, 0) == std::string("abc"));
+}
+
+BOOST_AUTO_TEST_CASE(FetchTest)
+{
+    const char *connStr = getenv("UTILS_TEST_ODBC_CONN");
+    ODBCSqlDatabase db(connStr ? connStr : "Driver=SQLite3;Database=/tmp/UtilsSqlColumnBatchTest.db;", true);
+    BOOST_TEST_REQUIRE((db.Prepare("drop table if exists column_batch_test", 1) && db.FlushBuffer() && db.Commit()));
+    BOOST_TEST_REQUIRE((db.Prepare("create table column_batch_test(id int,big bigint,value double precision,name varchar(32))", 1)
+        && db.FlushBuffer() && db.Commit()), "Create table error:" << db.LastError());
+    const int rowCount = 250;
+    BOOST_TEST_REQUIRE(db.Prepare("insert into column_batch_test values(:id<int>,:big<bigint>,:value<double>,:name<char[32]>)", 64));
+    for (int i = 0; i < rowCount; ++i)
+    {
+        db << i;
+        db << static_cast<s64>(i) * 1000000000LL;
+        if (i % 10 == 0)
+        {
+            db << otl_null();
+        }
+        else
+        {
+            db << i * 0.5;
+        }
+        db << std::to_string(i);
+    }
+    BOOST_TEST_REQUIRE((db.FlushBuffer() && db.Commit()), "Insert error:" << db.LastError());
+
+    BOOST_TEST_REQUIRE(db.Prepare("select id,big,value,name from column_batch_test order by id", 64));
+    SqlColumnBatch batch({ SqlColumnType::Int32, SqlColumnType::Int64, SqlColumnType::Double, SqlColumnType::String }, 100);
+    int total = 0;
+    bool matched = true;
+    for (;;)
+    {
+        batch.Clear();
+        int fetched = db.FetchColumns(batch);
+        BOOST_TEST_REQUIRE(fetched >= 0, "Fetch error:" << db.LastError());
+        if (!fetched)
+        {
+            break;
+        }
+        BOOST_TEST(static_cast<size_t>(fetched) == batch.RowCount());
+        for (int i = 0; i < fetched; ++i)
+        {
+            int id = total + i;
+            matched = matched && batch.Int32s(0)[i] == id && batch.Int64s(1)[i] == static_cast<s64>(id) * 1000000000LL
+                && batch.IsNull(2, i) == (id % 10 == 0) && (batch.IsNull(2, i) || batch.Doubles(2)[i] == id * 0.5)
+                && std::to_string(id) == batch.String(3, i);
+        }
+        total += fetched;
+    }
+    BOOST_TEST(total == rowCount);
+    BOOST_TEST(matched);
+}
+
+BOOST_AUTO_TEST_CASE(InsertTest)
+{
+    const char *connStr = getenv("UTILS_TEST_ODBC_CONN");
+    ODBCSqlDatabase db(connStr ? connStr : "Driver=SQLite3;Database=/tmp/UtilsSqlColumnBatchTest.db;", true);
+    BOOST_TEST_REQUIRE((db.Prepare("drop table if exists column_insert_test", 1) && db.FlushBuffer() && db.Commit()));
+    BOOST_TEST_REQUIRE((db.Prepare("create table column_insert_test(id int,big bigint,name varchar(32))", 1) && db.FlushBuffer() && db.Commit())
+        , "Create table error:" << db.LastError());
+
+    const size_t rowCount = 100;
+    SqlColumnBatch batch({ SqlColumnType::Int32, SqlColumnType::Int64, SqlColumnType::String }, rowCount);
+    for (size_t i = 0; i < rowCount; ++i)
+    {
+        batch.Int32s(0)[i] = static_cast<s32>(i);
+        batch.Int64s(1)[i] = static_cast<s64>(i) << 33;
+        std::string name = "name" + std::to_string(i);
+        batch.SetString(2, i, name.data(), name.size());
+        batch.SetNull(2, i, i % 7 == 0);
+    }
+    batch.SetRowCount(rowCount);
+    BOOST_TEST_REQUIRE(db.Prepare("insert into column_insert_test values(:id<int>,:big<bigint>,:name<char[32]>)", static_cast<int>(rowCount)));
+    BOOST_TEST_REQUIRE((db.InsertColumns(batch) && db.Commit()), "Insert error:" << db.LastError());
+    //the batch is larger than the statement buffer,OTL flushes the full buffer automatically.
+    BOOST_TEST_REQUIRE(db.Prepare("insert into column_insert_test values(:id<int>,:big<bigint>,:name<char[32]>)", 16));
+    BOOST_TEST_REQUIRE((db.InsertColumns(batch) && db.Commit()), "Insert error:" << db.LastError());
+
+    SqlColumnBatch result({ SqlColumnType::Int32, SqlColumnType::Int64, SqlColumnType::String }, rowCount * 2);
+    BOOST_TEST_REQUIRE(db.Prepare("select id,big,name from column_insert_test order by id", 64));
+    BOOST_TEST_REQUIRE(db.FetchColumns(result) == static_cast<int>(rowCount * 2));
+    bool matched = true;
+    for (size_t i = 0; i < rowCount * 2; ++i)
+    {
+        size_t id = i / 2;
+        matched = matched && result.Int32s(0)[i] == static_cast<s32>(id) && result.Int64s(1)[i] == static_cast<s64>(id) << 33
+            && result.IsNull(2, i) == (id % 7 == 0) && (result.IsNull(2, i) || "name" + std::to_string(id) == result.String(2, i));
+    }
+    BOOST_TEST(matched);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+#endif
@@ -0,0 +1,109 @@
+#if defined(USE_ODBC_DATABASE_UTILS)
+
+#include <cstdlib>
+#include <thread>
+#include <vector>
+#include <boost/test/unit_test.hpp>
+#include "Database/SQL/Common/SqlConnectionPool.h"
+
+BOOST_AUTO_TEST_SUITE(SqlConnectionPoolTest)
+
+/**
+ * Gets the settings of a test pool.
+ *
+ * @param name The pool name.
+ * @param minSize The min size.
+ * @param maxSize The max size.
+ *
+ * @return The settings.
+ */
+SqlConnectionPoolSettings TestPoolSettings(const char *name, size_t minSize, size_t maxSize)
+{
+    const char *connStr = getenv("UTILS_TEST_ODBC_CONN");
+    return { name, SqlDatabaseType::ODBC, connStr ? connStr : "Driver=SQLite3;Database=/tmp/UtilsSqlConnectionPoolTest.db;", minSize, maxSize
+        , "select 1", true, std::chrono::milliseconds(10000), std::chrono::milliseconds(100), std::chrono::milliseconds(1000)
+        , std::chrono::milliseconds(20) };
+}
+
+BOOST_AUTO_TEST_CASE(GeneralTest)
+{
+    auto pool = SqlConnectionPool::Create(TestPoolSettings("GeneralTest", 2, 3));
+    BOOST_TEST_REQUIRE(static_cast<bool>(pool));
+    BOOST_TEST(!SqlConnectionPool::Create(TestPoolSettings("GeneralTest", 1, 1)));
+    BOOST_TEST(SqlConnectionPool::Find("GeneralTest") == pool);
+    BOOST_TEST_REQUIRE(pool->WaitWarmUp(10000));
+    SqlConnectionPoolStats stats = pool->GetStats();
+    BOOST_TEST(stats.m_totalCount == 2U);
+    BOOST_TEST(stats.m_idleCount == 2U);
+
+    {
+        std::vector<SqlConnectionPool::ptr_t> borrowed;
+        for (int i = 0; i < 3; ++i)
+        {
+            borrowed.push_back(pool->Borrow());
+            BOOST_TEST_REQUIRE(static_cast<bool>(borrowed.back()));
+        }
+        //exhausted,the borrower times out.
+        auto beg = std::chrono::steady_clock::now();
+        BOOST_TEST(!pool->Borrow(std::chrono::milliseconds(100)));
+        BOOST_TEST((std::chrono::steady_clock::now() - beg >= std::chrono::milliseconds(100)));
+        BOOST_TEST(pool->GetStats().m_timeoutCount == 1U);
+
+        //the waiting borrower gets the returned connection.
+        ISqlDatabase *returned = borrowed.back().get();
+        ISqlDatabase *waited = nullptr;
+        std::thread waiter([&pool, &waited]()
+            {
+                auto db = pool->Borrow(std::chrono::milliseconds(5000));
+                waited = db.get();
+            });
+        while (!pool->GetStats().m_waiterCount)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        borrowed.pop_back();
+        waiter.join();
+        BOOST_TEST(waited == returned);
+    }
+    stats = pool->GetStats();
+    BOOST_TEST(stats.m_totalCount == 3U);
+    BOOST_TEST(stats.m_idleCount == 3U);
+    BOOST_TEST(stats.m_createdCount == 3U);
+
+    //the idle connection above the min size is closed.
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (pool->GetStats().m_totalCount > 2U && std::chrono::steady_clock::now() < deadline)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    BOOST_TEST(pool->GetStats().m_totalCount == 2U);
+
+    //a connection borrowed before the pool is destroyed is closed when it is returned.
+    auto db = pool->Borrow();
+    BOOST_TEST_REQUIRE(static_cast<bool>(db));
+    SqlConnectionPool::Destory("GeneralTest");
+    BOOST_TEST(!SqlConnectionPool::Find("GeneralTest"));
+    BOOST_TEST(!pool->Borrow());
+    db.reset();
+    stats = pool->GetStats();
+    BOOST_TEST(stats.m_totalCount == 0U);
+    BOOST_TEST(stats.m_idleCount == 0U);
+}
+
+BOOST_AUTO_TEST_CASE(ValidationTest)
+{
+    SqlConnectionPoolSettings settings = TestPoolSettings("ValidationTest", 1, 2);
+    settings.m_validationSql = "select * from table_not_exists";
+    auto pool = SqlConnectionPool::Create(settings);
+    BOOST_TEST_REQUIRE(static_cast<bool>(pool));
+    BOOST_TEST_REQUIRE(pool->WaitWarmUp(10000));
+    BOOST_TEST(!pool->Borrow(std::chrono::milliseconds(100)));
+    SqlConnectionPoolStats stats = pool->GetStats();
+    BOOST_TEST(stats.m_totalCount == 0U);
+    BOOST_TEST(stats.m_validationFailedCount > 0U);
+    SqlConnectionPool::DestoryAll();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+#endif
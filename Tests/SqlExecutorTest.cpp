@@ -0,0 +1,157 @@
+#if defined(USE_ODBC_DATABASE_UTILS)
+
+#include <atomic>
+#include <cstdlib>
+#include <vector>
+#include <boost/test/unit_test.hpp>
+#include "Concurrent/ThreadPool.h"
+#include "Concurrent/WaitEvent.h"
+#include "Database/SQL/Common/SqlConnectionPool.h"
+#include "Database/SQL/Common/SqlExecutor.h"
+
+BOOST_AUTO_TEST_SUITE(SqlExecutorTest)
+
+/**
+ * Gets the ODBC connection string of the tests(UTILS_TEST_ODBC_CONN,the default is a local SQLite database via the SQLite3 ODBC
+ * driver).
+ *
+ * @return The connection string.
+ */
+const char* TestOdbcConnStr()
+{
+    const char *connStr = getenv("UTILS_TEST_ODBC_CONN");
+    return connStr ? connStr : "Driver=SQLite3;Database=/tmp/UtilsSqlExecutorTest.db;";
+}
+
+BOOST_AUTO_TEST_CASE(GeneralTest)
+{
+    ThreadPool::Instance();
+    BOOST_TEST_REQUIRE(static_cast<bool>(SqlConnectionPool::Create({ "SqlExecutorTest", SqlDatabaseType::ODBC, TestOdbcConnStr(), 2, 4, ""
+        , false, std::chrono::milliseconds(0), std::chrono::milliseconds(0), std::chrono::milliseconds(1000), std::chrono::milliseconds(1000) })));
+    {
+        SqlExecutor executor({ "SqlExecutorTest", 2, 0 });
+        auto exec = [&executor](const char *sql)
+            {
+                return executor.Execute(sql, [sql](ISqlDatabase &db)
+                    {
+                        return db.Prepare(sql, 1) && db.FlushBuffer() && db.Commit();
+                    }).get();
+            };
+        exec("drop table if exists executor_test");
+        SqlResult result = exec("create table executor_test(id int,name varchar(32))");
+        BOOST_TEST_REQUIRE(result.m_succeeded, "Create table error:" << result.m_error);
+
+        const int rowCount = 100;
+        WaitEvent allInserted;
+        std::atomic<int> insertedCount{ 0 };
+        for (int i = 0; i < rowCount; ++i)
+        {
+            BOOST_TEST(executor.AsyncExecute("insert executor_test", [i](ISqlDatabase &db)
+                {
+                    if (!db.Prepare("insert into executor_test values(:id<int>,:name<char[32]>)", 1))
+                    {
+                        return false;
+                    }
+                    db << i << std::to_string(i);
+                    return db.FlushBuffer() && db.Commit();
+                }, [&insertedCount, &allInserted](const SqlResult &result)
+                {
+                    BOOST_TEST(result.m_succeeded, "Insert error:" << result.m_error);
+                    if (++insertedCount == rowCount)
+                    {
+                        allInserted.Signal();
+                    }
+                }));
+        }
+        BOOST_TEST_REQUIRE(allInserted.TimedWait(10000));
+
+        int count = 0;
+        result = executor.Execute("select count", [&count](ISqlDatabase &db)
+            {
+                if (!db.Prepare("select count(*) from executor_test", 1) || !db.FlushBuffer())
+                {
+                    return false;
+                }
+                db >> count;
+                return true;
+            }).get();
+        BOOST_TEST(result.m_succeeded, "Select error:" << result.m_error);
+        BOOST_TEST(count == rowCount);
+
+        result = exec("select * from table_not_exists");
+        BOOST_TEST(!result.m_succeeded);
+        BOOST_TEST(!result.m_error.empty());
+
+        auto stats = executor.GetStatementStats();
+        BOOST_TEST(stats["insert executor_test"].m_count == static_cast<us64>(rowCount));
+        BOOST_TEST(stats["insert executor_test"].m_failedCount == 0U);
+        BOOST_TEST(stats["select * from table_not_exists"].m_failedCount == 1U);
+        BOOST_TEST(executor.QueueDepth() == 0U);
+    }
+
+    {
+        //one worker is blocked,so the second statement waits in the queue and the third one is rejected.
+        SqlExecutor executor({ "SqlExecutorTest", 1, 2 });
+        WaitEvent started, release;
+        auto blocked = executor.Execute("block", [&started, &release](ISqlDatabase&)
+            {
+                started.Signal();
+                release.Wait();
+                return true;
+            });
+        BOOST_TEST_REQUIRE(started.TimedWait(5000));
+        auto queued = executor.Execute("queued", [](ISqlDatabase&) { return true; });
+        BOOST_TEST(!executor.AsyncExecute("rejected", [](ISqlDatabase&) { return true; }, [](const SqlResult&) {}));
+        BOOST_TEST(executor.Execute("rejected", [](ISqlDatabase&) { return true; }).get().m_rejected);
+        release.Signal();
+        BOOST_TEST(blocked.get().m_succeeded);
+        BOOST_TEST(queued.get().m_succeeded);
+        executor.Stop();
+        BOOST_TEST(executor.Execute("stopped", [](ISqlDatabase&) { return true; }).get().m_rejected);
+    }
+
+    {
+        //every accepted statement is finished even if Stop runs concurrently with the submitters.
+        SqlExecutor executor({ "SqlExecutorTest", 2, 0 });
+        std::atomic<int> acceptedCount{ 0 }, calledCount{ 0 };
+        std::vector<std::future<SqlResult>> results;
+        boost::thread submitter([&executor, &acceptedCount, &calledCount]()
+            {
+                for (int i = 0; i < 1000; ++i)
+                {
+                    if (executor.AsyncExecute("racing", [](ISqlDatabase&) { return true; }, [&calledCount](const SqlResult&) { ++calledCount; }))
+                    {
+                        ++acceptedCount;
+                    }
+                }
+            });
+        for (int i = 0; i < 1000; ++i)
+        {
+            results.push_back(executor.Execute("racing", [](ISqlDatabase&) { return true; }));
+            if (i == 100)
+            {
+                executor.Stop();
+            }
+        }
+        submitter.join();
+        for (auto &result : results)
+        {
+            SqlResult value = result.get();
+            BOOST_TEST((value.m_succeeded || value.m_rejected));
+        }
+        for (int i = 0; i < 500 && calledCount != acceptedCount; ++i)
+        {
+            boost::this_thread::sleep_for(boost::chrono::milliseconds(10));
+        }
+        BOOST_TEST(calledCount == acceptedCount);
+        BOOST_TEST(executor.QueueDepth() == 0U);
+    }
+
+    SqlConnectionPool::Destory("SqlExecutorTest");
+    ThreadPool::Instance().Stop();
+    ThreadPool::Destory();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+#endif
@@ -0,0 +1,95 @@
+#if defined(USE_ODBC_DATABASE_UTILS)
+
+#include <cstdlib>
+#include <boost/test/unit_test.hpp>
+#include "Database/SQL/ODBC/ODBCSqlDatabase.h"
+
+BOOST_AUTO_TEST_SUITE(SqlStatementCacheTest)
+
+BOOST_AUTO_TEST_CASE(GeneralTest)
+{
+    SqlStatementId insertId = SqlStatementRegistry::Intern("insert into statement_cache_test values(:id<int>)");
+    SqlStatementId selectId = SqlStatementRegistry::Intern("select count(*) from statement_cache_test");
+    SqlStatementId deleteId = SqlStatementRegistry::Intern("delete from statement_cache_test");
+    BOOST_TEST(insertId != selectId);
+    BOOST_TEST(SqlStatementRegistry::Intern("insert into statement_cache_test values(:id<int>)") == insertId);
+    BOOST_TEST(SqlStatementRegistry::Text(selectId) == "select count(*) from statement_cache_test");
+    BOOST_TEST(SqlStatementRegistry::Find(SqlInvalidStatementId) == nullptr);
+
+    const char *connStr = getenv("UTILS_TEST_ODBC_CONN");
+    ODBCSqlDatabase db(connStr ? connStr : "Driver=SQLite3;Database=/tmp/UtilsSqlStatementCacheTest.db;", true, 2);
+    BOOST_TEST_REQUIRE((db.Prepare("drop table if exists statement_cache_test", 1, false) && db.FlushBuffer() && db.Commit()));
+    BOOST_TEST_REQUIRE((db.Prepare("create table statement_cache_test(id int)", 1, false) && db.FlushBuffer() && db.Commit())
+        , "Create table error:" << db.LastError());
+    //an ID which is not interned fails without throwing.
+    BOOST_TEST(!db.PrepareStatement(SqlInvalidStatementId, 1));
+    BOOST_TEST(!db.LastError().empty());
+    SqlStatementCacheStats stats = db.StatementCacheStats();
+    BOOST_TEST(stats.m_missCount == 0U);
+    BOOST_TEST(stats.m_size == 0U);
+
+    const int rowCount = 10;
+    for (int i = 0; i < rowCount; ++i)
+    {
+        BOOST_TEST_REQUIRE(db.PrepareStatement(insertId, 1));
+        db << i;
+        BOOST_TEST_REQUIRE(db.FlushBuffer());
+    }
+    BOOST_TEST(db.Commit());
+    stats = db.StatementCacheStats();
+    BOOST_TEST(stats.m_missCount == 1U);
+    BOOST_TEST(stats.m_hitCount == static_cast<us64>(rowCount - 1));
+
+    //the cached select is executed again on every prepare.
+    int count = 0;
+    BOOST_TEST_REQUIRE(db.PrepareStatement(selectId, 1));
+    db >> count;
+    BOOST_TEST(count == rowCount);
+    BOOST_TEST_REQUIRE(db.PrepareStatement(insertId, 1));
+    db << rowCount;
+    BOOST_TEST_REQUIRE((db.FlushBuffer() && db.Commit()));
+    stats = db.StatementCacheStats();
+    BOOST_TEST(stats.m_missCount == 2U);
+    BOOST_TEST(stats.m_hitCount == static_cast<us64>(rowCount));
+    BOOST_TEST(stats.m_size == 2U);
+
+    //a statement prepared by text is cached by its text without being interned(only the tracing interns its normalized text once),
+    //the least recently used statement(the select) is evicted.
+    size_t internedCount = SqlStatementRegistry::Size();
+    BOOST_TEST_REQUIRE(db.Prepare("select count(*) from statement_cache_test", 1));
+    db >> count;
+    BOOST_TEST(count == rowCount + 1);
+    size_t tracedCount = SqlStatementRegistry::Size();
+    BOOST_TEST(tracedCount <= internedCount + 1);
+    BOOST_TEST_REQUIRE(db.Prepare("select count(*) from statement_cache_test", 1));
+    db >> count;
+    BOOST_TEST(count == rowCount + 1);
+    BOOST_TEST(SqlStatementRegistry::Size() == tracedCount);
+    stats = db.StatementCacheStats();
+    BOOST_TEST(stats.m_missCount == 3U);
+    BOOST_TEST(stats.m_hitCount == static_cast<us64>(rowCount + 1));
+    BOOST_TEST(stats.m_evictedCount == 1U);
+    BOOST_TEST(stats.m_size == 2U);
+
+    //the same text with another buffer size is another statement.
+    BOOST_TEST_REQUIRE(db.Prepare("select count(*) from statement_cache_test", 2));
+    BOOST_TEST(db.StatementCacheStats().m_missCount == 4U);
+
+    //the least recently used statement(the insert) is evicted.
+    BOOST_TEST_REQUIRE((db.PrepareStatement(deleteId, 1) && db.FlushBuffer() && db.Commit()));
+    stats = db.StatementCacheStats();
+    BOOST_TEST(stats.m_evictedCount == 3U);
+    BOOST_TEST(stats.m_size == 2U);
+    BOOST_TEST_REQUIRE(db.Prepare("select count(*) from statement_cache_test", 2));
+    BOOST_TEST(db.StatementCacheStats().m_hitCount == stats.m_hitCount + 1);
+    db >> count;
+    BOOST_TEST(count == 0);
+    BOOST_TEST_REQUIRE(db.PrepareStatement(insertId, 1));
+    stats = db.StatementCacheStats();
+    BOOST_TEST(stats.m_missCount == 6U);
+    BOOST_TEST(stats.m_evictedCount == 4U);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+#endif
@@ -0,0 +1,123 @@
+#if defined(USE_ODBC_DATABASE_UTILS)
+
+#include <cstdlib>
+#include <boost/test/unit_test.hpp>
+#include "Database/SQL/ODBC/ODBCSqlDatabase.h"
+
+BOOST_AUTO_TEST_SUITE(SqlStatementTracerTest)
+
+BOOST_AUTO_TEST_CASE(GeneralTest)
+{
+    SqlStatementTracerSettings settings = SqlStatementTracer::Settings();
+    SqlStatementTracer::SetSettings(SqlStatementTracerSettings{ true, std::chrono::microseconds(1000), 2 });
+    SqlStatementId id = SqlStatementRegistry::Intern("select * from statement_tracer_general_test");
+    us64 logged = 0;
+    us64 slowCount = SqlStatementTracer::SlowQueryCount(&logged);
+    for (us64 micros : { 0, 1, 3, 100, 5000 })
+    {
+        SqlStatementTracer::Record(id, SqlPhase::Flush, micros, 2, 1);
+    }
+    for (int i = 0; i < 4; ++i)
+    {
+        SqlStatementTracer::Record(id, SqlPhase::Commit, 2000);
+    }
+    SqlStatementTracer::Record(SqlInvalidStatementId, SqlPhase::Flush, 10);
+
+    SqlStatementTrace trace;
+    BOOST_TEST_REQUIRE(SqlStatementTracer::Snapshot(id, trace));
+    BOOST_TEST(trace.m_sql == "select * from statement_tracer_general_test");
+    const SqlLatencyHistogram &flush = trace.m_phases[static_cast<size_t>(SqlPhase::Flush)];
+    BOOST_TEST(flush.m_count == 5U);
+    BOOST_TEST(flush.m_totalMicros == 5104U);
+    BOOST_TEST(flush.m_maxMicros == 5000U);
+    BOOST_TEST(flush.m_buckets[0] == 1U);
+    BOOST_TEST(flush.m_buckets[1] == 1U);
+    BOOST_TEST(flush.m_buckets[2] == 1U);
+    BOOST_TEST(flush.m_buckets[7] == 1U);
+    BOOST_TEST(flush.m_buckets[13] == 1U);
+    BOOST_TEST(flush.Percentile(0.5) == 4U);
+    BOOST_TEST(flush.Percentile(1) == 8192U);
+    BOOST_TEST(trace.m_phases[static_cast<size_t>(SqlPhase::Commit)].m_count == 4U);
+    BOOST_TEST(trace.m_phases[static_cast<size_t>(SqlPhase::Prepare)].m_count == 0U);
+
+    //5 slow phases,at most 2 logged in a second(the window may roll over once during the test).
+    us64 newLogged = 0;
+    BOOST_TEST(SqlStatementTracer::SlowQueryCount(&newLogged) == slowCount + 5);
+    BOOST_TEST(newLogged - logged >= 2U);
+    BOOST_TEST(newLogged - logged <= 4U);
+
+    bool found = false;
+    for (auto &item : SqlStatementTracer::SnapshotAll())
+    {
+        found = found || item.m_id == id;
+    }
+    BOOST_TEST(found);
+    SqlStatementTracer::Reset();
+    BOOST_TEST(!SqlStatementTracer::Snapshot(id, trace));
+    SqlStatementTracer::SetSettings(settings);
+}
+
+BOOST_AUTO_TEST_CASE(NormalizeTest)
+{
+    BOOST_TEST(SqlStatementTracer::Normalize("  select  *\r\n from t1 where id = 12 and name='a''b c' and v>1.5e3  ")
+        == "select * from t1 where id = ? and name=? and v>?");
+    BOOST_TEST(SqlStatementTracer::Normalize("insert into t2 values(:id<int>,'x')") == "insert into t2 values(:id<int>,?)");
+}
+
+BOOST_AUTO_TEST_CASE(TraceIdTest)
+{
+    //the literals do not create new IDs.
+    SqlStatementId id = SqlStatementTracer::TraceId("select * from statement_tracer_id_test where id in (1, 2)");
+    BOOST_TEST(SqlStatementTracer::TraceId("select * from statement_tracer_id_test where id in (3, 4)") == id);
+    BOOST_TEST(SqlStatementRegistry::Text(id) == "select * from statement_tracer_id_test where id in (?, ?)");
+
+    //a full registry interns no new statement,the interned ones are still found.
+    size_t size = SqlStatementRegistry::Size();
+    BOOST_TEST(SqlStatementRegistry::TryIntern("select * from statement_tracer_id_test where id = ?", size) == SqlInvalidStatementId);
+    BOOST_TEST(SqlStatementRegistry::TryIntern("select * from statement_tracer_id_test where id in (?, ?)", size) == id);
+    BOOST_TEST(SqlStatementRegistry::Size() == size);
+}
+
+BOOST_AUTO_TEST_CASE(OdbcTest)
+{
+    const char *connStr = getenv("UTILS_TEST_ODBC_CONN");
+    ODBCSqlDatabase db(connStr ? connStr : "Driver=SQLite3;Database=/tmp/UtilsSqlStatementTracerTest.db;", true);
+    BOOST_TEST_REQUIRE((db.Prepare("drop table if exists statement_tracer_test", 1, false) && db.FlushBuffer() && db.Commit()));
+    BOOST_TEST_REQUIRE((db.Prepare("create table statement_tracer_test(id int)", 1, false) && db.FlushBuffer() && db.Commit())
+        , "Create table error:" << db.LastError());
+    SqlStatementId insertId = SqlStatementRegistry::Intern("insert into statement_tracer_test values(:id<int>)");
+    BOOST_TEST_REQUIRE(db.PrepareStatement(insertId, 10));
+    for (int i = 0; i < 10; ++i)
+    {
+        db << i;
+    }
+    BOOST_TEST_REQUIRE((db.FlushBuffer() && db.Commit()));
+
+    SqlStatementId selectId = SqlStatementRegistry::Intern("select id from statement_tracer_test");
+    SqlStatementTrace trace;
+    us64 fetchCount = SqlStatementTracer::Snapshot(selectId, trace) ? trace.m_phases[static_cast<size_t>(SqlPhase::Fetch)].m_count : 0;
+    BOOST_TEST_REQUIRE(db.PrepareStatement(selectId, 4));
+    int id;
+    while (!db.IsEOF())
+    {
+        db >> id;
+    }
+    //the fetch time is recorded once when the result set ends.
+    BOOST_TEST_REQUIRE(SqlStatementTracer::Snapshot(selectId, trace));
+    BOOST_TEST(trace.m_phases[static_cast<size_t>(SqlPhase::Fetch)].m_count == fetchCount + 1);
+    BOOST_TEST(db.IsEOF() != 0);
+    BOOST_TEST_REQUIRE(db.Prepare("select count(*) from statement_tracer_test where id > 5", 1, false));
+    BOOST_TEST_REQUIRE(SqlStatementTracer::Snapshot(selectId, trace));
+    BOOST_TEST(trace.m_phases[static_cast<size_t>(SqlPhase::Fetch)].m_count == fetchCount + 1);
+
+    BOOST_TEST_REQUIRE(SqlStatementTracer::Snapshot(insertId, trace));
+    BOOST_TEST(trace.m_phases[static_cast<size_t>(SqlPhase::Prepare)].m_count >= 1U);
+    BOOST_TEST(trace.m_phases[static_cast<size_t>(SqlPhase::Flush)].m_count >= 1U);
+    BOOST_TEST(trace.m_phases[static_cast<size_t>(SqlPhase::Commit)].m_count >= 1U);
+    BOOST_TEST_REQUIRE(SqlStatementTracer::Snapshot(SqlStatementRegistry::Intern("select count(*) from statement_tracer_test where id > ?"), trace));
+    BOOST_TEST(trace.m_phases[static_cast<size_t>(SqlPhase::Prepare)].m_count >= 1U);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+#endif
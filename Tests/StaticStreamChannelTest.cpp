@@ -0,0 +1,135 @@
+#include <boost/asio.hpp>
+
+#if defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
+
+#include <vector>
+#include <boost/test/unit_test.hpp>
+#include "Concurrent/ThreadPool.h"
+#include "Concurrent/WaitEvent.h"
+#include "Channel/Traits/UnixStreamTraits.h"
+#include "Channel/Common/StaticStreamChannel.hpp"
+
+BOOST_AUTO_TEST_SUITE(StaticStreamChannelTest)
+
+const size_t StaticMessageSize = 20;
+
+const size_t StaticMessageCount = 1000;
+
+/**
+ * The client side writes StaticMessageCount messages,the server side echoes them back and the client side checks them.
+ */
+class StaticEchoChannel :public StaticStreamChannel<UnixStreamTraits, StaticEchoChannel>
+{
+public:
+    StaticEchoChannel(const std::shared_ptr<UnixStreamTraits::StreamType> &stream, bool server)
+        :StaticStreamChannel<UnixStreamTraits, StaticEchoChannel>(stream, 64), m_server(server)
+    {
+    }
+
+    void BeginRead()
+    {
+        AsyncReadSome(m_readBufs, 2);
+    }
+
+    void EndRead(const boost::system::error_code &err, std::size_t bytesTransferred)
+    {
+        if (err)
+        {
+            m_readError = err;
+            m_finished.Signal();
+            return;
+        }
+        if (m_server)
+        {
+            AsyncWriteCopy(m_readBuf, bytesTransferred);
+        }
+        else
+        {
+            m_received.insert(m_received.end(), m_readBuf, m_readBuf + bytesTransferred);
+            if (m_received.size() == StaticMessageSize * StaticMessageCount)
+            {
+                m_finished.Signal();
+                return;
+            }
+        }
+        BeginRead();
+    }
+
+    void EndWrite(const boost::system::error_code &err, std::size_t bytesTransferred)
+    {
+        BOOST_TEST(!err, "StaticEchoChannel EndWrite called,message:" << err.message());
+        ++m_writeBatchCount;
+        m_writtenBytes += bytesTransferred;
+    }
+
+    bool m_server;
+
+    us8 m_readBuf[100];
+
+    BufDescriptor m_readBufs[2] = { { m_readBuf, 7 }, { m_readBuf + 7, sizeof(m_readBuf) - 7 } };
+
+    std::vector<us8> m_received;
+
+    boost::system::error_code m_readError;
+
+    size_t m_writeBatchCount{ 0 };
+
+    size_t m_writtenBytes{ 0 };
+
+    WaitEvent m_finished;
+};
+
+BOOST_AUTO_TEST_CASE(GeneralTest)
+{
+    ThreadPool::Instance();
+    std::shared_ptr<UnixStreamTraits::StreamType> clientSock(new UnixStreamTraits::StreamType(ThreadPool::Instance().Context()));
+    std::shared_ptr<UnixStreamTraits::StreamType> serverSock(new UnixStreamTraits::StreamType(ThreadPool::Instance().Context()));
+    boost::asio::local::connect_pair(*clientSock, *serverSock);
+    StaticEchoChannel client(clientSock, false), server(serverSock, true);
+    server.BeginRead();
+    client.BeginRead();
+    for (size_t i = 0; i < StaticMessageCount; ++i)
+    {
+        us8 message[StaticMessageSize];
+        for (size_t j = 0; j < StaticMessageSize; ++j)
+        {
+            message[j] = static_cast<us8>(i + j);
+        }
+        client.AsyncWriteCopy(message, sizeof(message));
+    }
+
+    BOOST_TEST_REQUIRE(client.m_finished.TimedWait(5000));
+    BOOST_TEST_REQUIRE(client.m_received.size() == StaticMessageSize * StaticMessageCount);
+    for (size_t i = 0; i < StaticMessageCount; ++i)
+    {
+        for (size_t j = 0; j < StaticMessageSize; ++j)
+        {
+            if (client.m_received[i * StaticMessageSize + j] != static_cast<us8>(i + j))
+            {
+                BOOST_TEST(client.m_received[i * StaticMessageSize + j] == static_cast<us8>(i + j), "Message:" << i << ",index:" << j);
+                break;
+            }
+        }
+    }
+    //closing completes the pending read of the client and the server gets end of stream.
+    client.BeginRead();
+    boost::system::error_code shutdownErr, closeErr;
+    client.Close(shutdownErr, closeErr);
+    BOOST_TEST(!closeErr);
+    BOOST_TEST_REQUIRE(client.m_finished.TimedWait(5000));
+    BOOST_TEST((client.m_readError == boost::asio::error::operation_aborted || client.m_readError == boost::asio::error::eof));
+    BOOST_TEST_REQUIRE(server.m_finished.TimedWait(5000));
+    BOOST_TEST(server.m_readError == boost::asio::error::eof);
+    BOOST_TEST(client.m_writtenBytes == StaticMessageSize * StaticMessageCount);
+    BOOST_TEST_MESSAGE("Client write batches:" << client.m_writeBatchCount);
+    BOOST_TEST(client.m_writeBatchCount <= StaticMessageCount);
+    BOOST_TEST(client.QueuedBytes() == 0U);
+    server.Close(shutdownErr, closeErr);
+
+    ThreadPool::Instance().Stop();
+    ThreadPool::Destory();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+#endif
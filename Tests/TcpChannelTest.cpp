@@ -1,4 +1,6 @@
+#include <algorithm>
 #include <boost/test/unit_test.hpp>
+#include <boost/thread.hpp>
 #include <log4cplus/logger.h>
 #include <log4cplus/consoleappender.h>
 #include <log4cplus/layout.h>
@@ -6,6 +8,9 @@
 #include "Channel/Tcp/TcpV4Listener.h"
 #include "Channel/Tcp/TcpV4Channel.h"
 #include "Channel/Tcp/TcpV4PassiveChannel.h"
+#include "Channel/Tcp/TcpV6Listener.h"
+#include "Channel/Tcp/TcpV6Channel.h"
+#include "Channel/Tcp/TcpV6PassiveChannel.h"
 #include "Buffer/CircularBuffer.h"
 #include "Concurrent/TaskBarrier.h"
 #include "Concurrent/WaitEvent.h"
@@ -63,11 +68,30 @@ public:
         BOOST_TEST(!err, "MonkHandler EndOpen called,message:" << err.message());
         if(!err)
         {
+            std::shared_ptr<LinearBuffer> body(new LinearBuffer(512));
+            body->assign(6, 10);
+            us8 header[4] = { 10, 10, 10, 10 };
             for (int i = 0; i < 10; ++i)
             {
-                std::shared_ptr<LinearBuffer> buf(new LinearBuffer(512));
-                buf->assign(10, 10);
-                m_channel->AsyncWrite(buf, 0, buf->size(), shared_from_this());
+                if (i % 3 == 1)
+                {
+                    InlineLinearBuffer<16> buf;
+                    buf.assign(10, 10);
+                    m_channel->AsyncWrite(buf, 0, buf.size(), shared_from_this());
+                }
+                else if (i % 3 == 2)
+                {
+                    BufferChain chain;
+                    chain.Append(BufferSlice::Copy(header, sizeof(header)));
+                    chain.Append(BufferSlice(body));
+                    m_channel->AsyncWrite(chain, shared_from_this());
+                }
+                else
+                {
+                    std::shared_ptr<LinearBuffer> buf(new LinearBuffer(512));
+                    buf->assign(10, 10);
+                    m_channel->AsyncWrite(buf, 0, buf->size(), shared_from_this());
+                }
             }
             BufDescriptor bufs[2];
             size_t bufSize = m_readBuf->free_buffers(bufs);
@@ -301,4 +325,402 @@ BOOST_AUTO_TEST_CASE(GeneralTest)
     ThreadPool::Destory();
 }
 
+class WatermarkHandler :public IAsyncChannelHandler
+{
+public:
+    std::atomic<size_t> m_highCount{ 0 };
+
+    std::atomic<size_t> m_lowCount{ 0 };
+
+    std::atomic<size_t> m_droppedCount{ 0 };
+
+    std::atomic<size_t> m_writeCount{ 0 };
+
+    size_t m_expectedWriteCount{ 0 };
+
+    WaitEvent m_allWritten;
+
+    void Reset(size_t expectedWriteCount)
+    {
+        m_highCount = 0;
+        m_lowCount = 0;
+        m_droppedCount = 0;
+        m_writeCount = 0;
+        m_expectedWriteCount = expectedWriteCount;
+    }
+
+    virtual void EndOpen(const boost::system::error_code &err) override
+    {
+    }
+
+    virtual void EndRead(const boost::system::error_code &err, std::size_t bytesTransferred, void *ctx) override
+    {
+    }
+
+    virtual void EndWrite(const boost::system::error_code &err, std::size_t bytesTransferred, void *ctx) override
+    {
+        if (err == boost::asio::error::no_buffer_space)
+        {
+            ++m_droppedCount;
+        }
+        if (++m_writeCount == m_expectedWriteCount)
+        {
+            m_allWritten.Signal();
+        }
+    }
+
+    virtual void EndClose(const boost::system::error_code &err) override
+    {
+    }
+
+    virtual void HighWatermarkReached(std::size_t queuedBytes, std::size_t queuedCount) override
+    {
+        ++m_highCount;
+    }
+
+    virtual void LowWatermarkReached(std::size_t queuedBytes, std::size_t queuedCount) override
+    {
+        ++m_lowCount;
+    }
+};
+
+BOOST_AUTO_TEST_CASE(WriteQueueTest)
+{
+    boost::asio::io_context &context = ThreadPool::Instance().Context();
+    boost::asio::ip::tcp::acceptor acceptor(context, boost::asio::ip::tcp::endpoint(boost::asio::ip::address_v4::loopback(), 0));
+    boost::asio::ip::tcp::socket client(context);
+    client.connect(acceptor.local_endpoint());
+    client.set_option(boost::asio::socket_base::receive_buffer_size(4096));
+    std::shared_ptr<boost::asio::ip::tcp::socket> server(new boost::asio::ip::tcp::socket(context));
+    acceptor.accept(*server);
+    server->set_option(boost::asio::socket_base::send_buffer_size(4096));
+    IAsyncChannel::ptr_t channel(new TcpV4PassiveChannel(server, server->remote_endpoint()));
+    std::shared_ptr<WatermarkHandler> handler(new WatermarkHandler());
+
+    //the peer does not read,so the write queue grows until the peer starts reading.
+    channel->SetWriteQueueSettings({ 64 * 1024, 16 * 1024, 0, 0, WriteQueuePolicy::Backpressure });
+    std::shared_ptr<LinearBuffer> block(new LinearBuffer(8192));
+    block->assign(8192, 1);
+    handler->Reset(32);
+    for (size_t i = 0; i < 32; ++i)
+    {
+        channel->AsyncWrite(block, 0, block->size(), handler);
+    }
+    WriteQueueStatus status = channel->GetWriteQueueStatus();
+    BOOST_TEST((handler->m_highCount == 1 && handler->m_lowCount == 0));
+    BOOST_TEST((status.m_aboveHighWatermark && status.m_queuedBytes > 64 * 1024 && status.m_queuedCount > 8));
+    std::vector<us8> recvBuf(1024 * 1024 + 10);
+    boost::asio::read(client, boost::asio::buffer(recvBuf.data(), 32 * 8192));
+    BOOST_TEST(handler->m_allWritten.TimedWait(5000));
+    status = channel->GetWriteQueueStatus();
+    BOOST_TEST((handler->m_highCount == 1 && handler->m_lowCount == 1 && handler->m_droppedCount == 0));
+    BOOST_TEST((!status.m_aboveHighWatermark && status.m_queuedBytes == 0 && status.m_queuedCount == 0));
+
+    //the large block stays in progress while the small ones are dropped.
+    channel->SetWriteQueueSettings({ 0, 0, 2, 1, WriteQueuePolicy::DropNewest });
+    std::shared_ptr<LinearBuffer> large(new LinearBuffer(1024 * 1024));
+    large->assign(1024 * 1024, 1);
+    handler->Reset(4);
+    channel->AsyncWrite(large, 0, large->size(), handler);
+    for (us8 i = 2; i < 4; ++i)
+    {
+        InlineLinearBuffer<16> small;
+        small.assign(10, i);
+        channel->AsyncWrite(small, 0, small.size(), handler);
+    }
+    status = channel->GetWriteQueueStatus();
+    BOOST_TEST((status.m_queuedCount == 2 && status.m_droppedCount == 1 && status.m_droppedBytes == 10));
+    channel->SetWriteQueueSettings({ 0, 0, 2, 1, WriteQueuePolicy::DropOldest });
+    InlineLinearBuffer<16> small;
+    small.assign(10, 4);
+    channel->AsyncWrite(small, 0, small.size(), handler);
+    status = channel->GetWriteQueueStatus();
+    BOOST_TEST((status.m_queuedCount == 2 && status.m_droppedCount == 2 && status.m_droppedBytes == 20));
+    boost::asio::read(client, boost::asio::buffer(recvBuf));
+    BOOST_TEST(std::all_of(recvBuf.begin() + 1024 * 1024, recvBuf.end(), [](us8 val) { return val == 4; }));
+    BOOST_TEST(handler->m_allWritten.TimedWait(5000));
+    BOOST_TEST((handler->m_highCount == 1 && handler->m_lowCount == 1 && handler->m_droppedCount == 2));
+
+    channel.reset();
+    client.close();
+    ThreadPool::Instance().Stop();
+    ThreadPool::Destory();
+}
+
+/**
+ * Drains the queue while the high watermark notification is in flight,so the low watermark is reached before it returns.
+ */
+class SlowWatermarkHandler :public WatermarkHandler
+{
+public:
+    IAsyncChannel *m_channel{ nullptr };
+
+    boost::asio::ip::tcp::socket *m_client{ nullptr };
+
+    size_t m_writtenBytes{ 0 };
+
+    std::atomic<bool> m_inHigh{ false };
+
+    std::atomic<bool> m_overlapped{ false };
+
+    std::vector<char> m_order;
+
+    virtual void HighWatermarkReached(std::size_t queuedBytes, std::size_t queuedCount) override
+    {
+        m_inHigh = true;
+        m_order.push_back('H');
+        std::vector<us8> recvBuf(m_writtenBytes);
+        boost::asio::read(*m_client, boost::asio::buffer(recvBuf));
+        for (int i = 0; i < 500 && m_channel->GetWriteQueueStatus().m_aboveHighWatermark; ++i)
+        {
+            boost::this_thread::sleep_for(boost::chrono::milliseconds(10));
+        }
+        //gives EndWrite the chance to deliver the low watermark concurrently.
+        boost::this_thread::sleep_for(boost::chrono::milliseconds(50));
+        WatermarkHandler::HighWatermarkReached(queuedBytes, queuedCount);
+        m_inHigh = false;
+    }
+
+    virtual void LowWatermarkReached(std::size_t queuedBytes, std::size_t queuedCount) override
+    {
+        if (m_inHigh)
+        {
+            m_overlapped = true;
+        }
+        m_order.push_back('L');
+        WatermarkHandler::LowWatermarkReached(queuedBytes, queuedCount);
+    }
+};
+
+BOOST_AUTO_TEST_CASE(WatermarkOrderTest)
+{
+    boost::asio::io_context &context = ThreadPool::Instance().Context();
+    boost::asio::ip::tcp::acceptor acceptor(context, boost::asio::ip::tcp::endpoint(boost::asio::ip::address_v4::loopback(), 0));
+    boost::asio::ip::tcp::socket client(context);
+    client.connect(acceptor.local_endpoint());
+    client.set_option(boost::asio::socket_base::receive_buffer_size(4096));
+    std::shared_ptr<boost::asio::ip::tcp::socket> server(new boost::asio::ip::tcp::socket(context));
+    acceptor.accept(*server);
+    server->set_option(boost::asio::socket_base::send_buffer_size(4096));
+    IAsyncChannel::ptr_t channel(new TcpV4PassiveChannel(server, server->remote_endpoint()));
+    std::shared_ptr<SlowWatermarkHandler> handler(new SlowWatermarkHandler());
+    handler->m_channel = channel.get();
+    handler->m_client = &client;
+
+    channel->SetWriteQueueSettings({ 64 * 1024, 16 * 1024, 0, 0, WriteQueuePolicy::Backpressure });
+    std::shared_ptr<LinearBuffer> block(new LinearBuffer(8192));
+    block->assign(8192, 1);
+    size_t writeCount = 0;
+    while (!handler->m_highCount && writeCount < 64)
+    {
+        handler->m_writtenBytes += block->size();
+        ++writeCount;
+        channel->AsyncWrite(block, 0, block->size(), handler);
+    }
+    //the low watermark was reached during the high watermark notification,it must be delivered after that one returns.
+    for (int i = 0; i < 500 && !handler->m_lowCount; ++i)
+    {
+        boost::this_thread::sleep_for(boost::chrono::milliseconds(10));
+    }
+    BOOST_TEST((handler->m_highCount == 1 && handler->m_lowCount == 1));
+    BOOST_TEST(!handler->m_overlapped);
+    BOOST_TEST((handler->m_order == std::vector<char>{ 'H', 'L' }));
+    BOOST_TEST(!channel->GetWriteQueueStatus().m_aboveHighWatermark);
+
+    channel.reset();
+    client.close();
+    ThreadPool::Instance().Stop();
+    ThreadPool::Destory();
+}
+
+std::atomic<size_t> GlobalAcceptCount{ 0 };
+
+void CountAcceptFunc(std::shared_ptr<boost::asio::ip::tcp::endpoint> &remoteEndPoint, std::shared_ptr<boost::asio::ip::tcp::socket> &sock)
+{
+    if (++GlobalAcceptCount == 64)
+    {
+        GlobalWaitEvent.Signal();
+    }
+}
+
+BOOST_AUTO_TEST_CASE(ListenerShardingTest)
+{
+    //a small pool whose threads are all blocked below,so the connections are pending when the acceptors wake up.
+    SetInitConcurrentHint(1);
+    ThreadPool::Instance();
+    SetListenerAcceptFunc(CountAcceptFunc);
+    GlobalAcceptCount = 0;
+    GlobalWaitEvent.Reset();
+    TcpV4Listener::Instance().SetListenerSettings({ 64, 4, 8 });
+    TcpListenerSettings settings = TcpV4Listener::Instance().GetListenerSettings();
+    BOOST_TEST((settings.m_backlog == 64 && settings.m_acceptorCount == 4 && settings.m_maxAcceptPerWakeup == 8));
+    boost::asio::ip::tcp::endpoint ep(boost::asio::ip::address_v4::loopback(), 8005);
+    BOOST_TEST(TcpV4Listener::Instance().AddListenEndPoint(ep), "Add sharded end point error.");
+    BOOST_TEST(!TcpV4Listener::Instance().AddListenEndPoint(ep), "Add same sharded end point error not happened.");
+
+    //the pool has at most 2*hint+2 threads,a blocking task per thread keeps all of them busy.
+    std::atomic<bool> released{ false };
+    std::atomic<int> blocked{ 0 };
+    for (int i = 0; i < 4; ++i)
+    {
+        QueueThreadPoolWorkItem([&released, &blocked]()
+        {
+            ++blocked;
+            while (!released)
+            {
+                boost::this_thread::sleep_for(boost::chrono::milliseconds(1));
+            }
+        });
+    }
+    while (!blocked)
+    {
+        boost::this_thread::sleep_for(boost::chrono::milliseconds(1));
+    }
+    boost::this_thread::sleep_for(boost::chrono::milliseconds(200));
+    boost::asio::io_context context;
+    std::vector<std::unique_ptr<boost::asio::ip::tcp::socket>> clients;
+    for (size_t i = 0; i < 64; ++i)
+    {
+        clients.emplace_back(new boost::asio::ip::tcp::socket(context));
+        clients.back()->connect(ep);
+    }
+    released = true;
+    BOOST_TEST(GlobalWaitEvent.TimedWait(5000));
+    BOOST_TEST(GlobalAcceptCount == 64);
+
+    std::vector<TcpAcceptorStats> stats = TcpV4Listener::Instance().GetAcceptorStats();
+    BOOST_TEST(stats.size() == 4);
+    size_t usedAcceptors = 0, accepted = 0, maxBatch = 0;
+    for (auto &acceptorStats : stats)
+    {
+        BOOST_TEST(acceptorStats.m_localEndPoint == ep);
+        BOOST_TEST(acceptorStats.m_maxBatch <= 8);
+        usedAcceptors += acceptorStats.m_acceptedCount ? 1 : 0;
+        accepted += acceptorStats.m_acceptedCount;
+        maxBatch = std::max(maxBatch, acceptorStats.m_maxBatch);
+    }
+    //the kernel spreads the connections among the shards,and a wakeup drains more than one pending connection.
+    BOOST_TEST(usedAcceptors > 1);
+    BOOST_TEST(accepted == 64);
+    BOOST_TEST(maxBatch > 1);
+
+    TcpV4Listener::Instance().RemoveListenerEndPoint(ep);
+    BOOST_TEST(TcpV4Listener::Instance().GetAcceptorStats().empty());
+    boost::asio::ip::tcp::socket refused(context);
+    boost::system::error_code err;
+    refused.connect(ep, err);
+    BOOST_TEST(err == boost::asio::error::connection_refused);
+
+    clients.clear();
+    TcpV4Listener::Destory();
+    ThreadPool::Instance().Stop();
+    ThreadPool::Destory();
+    SetInitConcurrentHint(boost::thread::hardware_concurrency());
+}
+
+std::atomic<bool> GlobalAcceptedNoDelay{ false };
+
+void NoDelayAcceptFunc(std::shared_ptr<boost::asio::ip::tcp::endpoint> &remoteEndPoint, std::shared_ptr<boost::asio::ip::tcp::socket> &sock)
+{
+    boost::asio::ip::tcp::no_delay noDelay;
+    sock->get_option(noDelay);
+    GlobalAcceptedNoDelay = noDelay.value();
+    GlobalWaitEvent.Signal();
+}
+
+BOOST_AUTO_TEST_CASE(SocketOptionsTest)
+{
+    boost::asio::io_context context;
+    boost::asio::ip::tcp::socket sock(context);
+    sock.open(boost::asio::ip::tcp::v4());
+    SocketOptions options = SocketOptions::LowLatency();
+    options.m_keepAlive = 1;
+    options.m_receiveBufferSize = 64 * 1024;
+    boost::system::error_code err;
+    options.ApplyTo(sock, err);
+    BOOST_TEST(!err, "Apply socket options error:" << err.message());
+    boost::asio::ip::tcp::no_delay noDelay;
+    boost::asio::socket_base::keep_alive keepAlive;
+    boost::asio::socket_base::receive_buffer_size recvBufSize;
+    sock.get_option(noDelay);
+    sock.get_option(keepAlive);
+    sock.get_option(recvBufSize);
+    BOOST_TEST((noDelay.value() && keepAlive.value() && recvBufSize.value() >= 64 * 1024));
+    SocketOptions::Default().ApplyTo(sock, err);
+    sock.get_option(noDelay);
+    BOOST_TEST((!err && noDelay.value()));
+
+    ThreadPool::Instance();
+    SetListenerAcceptFunc(NoDelayAcceptFunc);
+    GlobalWaitEvent.Reset();
+    TcpListenerSettings settings = TcpV4Listener::Instance().GetListenerSettings();
+    settings.m_socketOptions = SocketOptions::LowLatency();
+    TcpV4Listener::Instance().SetListenerSettings(settings);
+    boost::asio::ip::tcp::endpoint ep(boost::asio::ip::address_v4::loopback(), 8006);
+    BOOST_TEST(TcpV4Listener::Instance().AddListenEndPoint(ep), "Add end point error.");
+    boost::asio::ip::tcp::socket client(context);
+    client.connect(ep);
+    BOOST_TEST(GlobalWaitEvent.TimedWait(5000));
+    BOOST_TEST(GlobalAcceptedNoDelay);
+
+    client.close();
+    TcpV4Listener::Destory();
+    ThreadPool::Instance().Stop();
+    ThreadPool::Destory();
+}
+
+std::atomic<size_t> GlobalV4MappedCount{ 0 };
+
+void V6AcceptFunc(std::shared_ptr<boost::asio::ip::tcp::endpoint> &remoteEndPoint, std::shared_ptr<boost::asio::ip::tcp::socket> &sock)
+{
+    if (remoteEndPoint->address().is_v6() && remoteEndPoint->address().to_v6().is_v4_mapped())
+    {
+        ++GlobalV4MappedCount;
+    }
+    IAsyncChannel::ptr_t channel(new TcpV6PassiveChannel(sock, *remoteEndPoint));
+    std::shared_ptr<MonkSrvHandler> handler(new MonkSrvHandler());
+    handler->m_channel = channel;
+    channel->AsyncOpen(handler);
+}
+
+BOOST_AUTO_TEST_CASE(V6Test)
+{
+    ThreadPool::Instance();
+    SetListenerAcceptFunc(V6AcceptFunc);
+    GlobalV4MappedCount = 0;
+    BOOST_TEST(TcpV6Listener::Instance().AddListenEndPoints({ { boost::asio::ip::address_v6::loopback(), 8010 } }), "Add end point error.");
+    BOOST_TEST(TcpV6Listener::Instance().AddListenEndPoint(
+        boost::asio::ip::tcp::endpoint(boost::asio::ip::address_v6::any(), 8011)), "Add dual-stack end point error.");
+
+    GlobalBarrier.ResetTaskCount(4);
+    GlobalBarrier.Reset();
+    {
+        std::shared_ptr<MonkHandler> client(new MonkHandler());
+        client->m_channel.reset(new TcpV6Channel("::1", 8010));
+        client->m_channel->AsyncOpen(client);
+    }
+    {
+        std::shared_ptr<MonkHandler> client(new MonkHandler());
+        client->m_channel.reset(new TcpV4Channel("127.0.0.1", 8011));
+        client->m_channel->AsyncOpen(client);
+    }
+    GlobalBarrier.WaitAllFinished();
+    BOOST_TEST(GlobalV4MappedCount == 1);
+
+    TcpListenerSettings settings = TcpV6Listener::Instance().GetListenerSettings();
+    settings.m_v6Only = true;
+    TcpV6Listener::Instance().SetListenerSettings(settings);
+    boost::asio::ip::tcp::endpoint ep(boost::asio::ip::address_v6::any(), 8012);
+    BOOST_TEST(TcpV6Listener::Instance().AddListenEndPoint(ep), "Add v6 only end point error.");
+    boost::asio::io_context context;
+    boost::asio::ip::tcp::socket refused(context);
+    boost::system::error_code err;
+    refused.connect(boost::asio::ip::tcp::endpoint(boost::asio::ip::address_v4::loopback(), 8012), err);
+    BOOST_TEST(err == boost::asio::error::connection_refused);
+
+    ThreadPool::Instance().Stop();
+    TcpV6Listener::Destory();
+    ThreadPool::Destory();
+}
+
 BOOST_AUTO_TEST_SUITE_END()
\ No newline at end of file
@@ -0,0 +1,210 @@
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <boost/test/unit_test.hpp>
+#include "Concurrent/ThreadPool.h"
+#include "Concurrent/WaitEvent.h"
+#include "Channel/Udp/UdpChannel.h"
+
+BOOST_AUTO_TEST_SUITE(UdpChannelTest)
+
+const size_t UdpTestDatagramCount = 200;
+
+/**
+ * Receives UdpTestDatagramCount datagrams,each carries its index in the first byte and the index as its size.
+ */
+class UdpTestHandler :public std::enable_shared_from_this<UdpTestHandler>, public IDatagramChannelHandler
+{
+public:
+    UdpChannel::ptr_t m_channel;
+
+    boost::asio::ip::udp::endpoint m_expectedRemote;
+
+    WaitEvent m_opened;
+
+    WaitEvent m_finished;
+
+    size_t m_expectedCount{ UdpTestDatagramCount };
+
+    std::atomic<size_t> m_received{ 0 };
+
+    std::atomic<size_t> m_sent{ 0 };
+
+    std::atomic<size_t> m_errorCount{ 0 };
+
+    size_t m_maxBatch{ 0 };
+
+    virtual void EndOpen(const boost::system::error_code &err) override
+    {
+        BOOST_TEST(!err, "UdpTestHandler EndOpen called,message:" << err.message());
+        m_opened.Signal();
+    }
+
+    virtual void EndReceive(const boost::system::error_code &err, Datagram datagrams[], std::size_t count, void *ctx) override
+    {
+        if (err)
+        {
+            return;
+        }
+        m_maxBatch = std::max(m_maxBatch, count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            size_t index = m_received + i;
+            //the source address of a multicast datagram is the sender's interface address,only its port is known.
+            bool remoteMatched = m_expectedRemote.address().is_unspecified() ? datagrams[i].m_remoteEndPoint.port() == m_expectedRemote.port()
+                : datagrams[i].m_remoteEndPoint == m_expectedRemote;
+            if (datagrams[i].m_buf->size() != index % 256 + 1 || (*datagrams[i].m_buf)[0] != index % 256 || !remoteMatched)
+            {
+                ++m_errorCount;
+            }
+        }
+        m_received += count;
+        if (m_received == m_expectedCount)
+        {
+            m_finished.Signal();
+        }
+        else
+        {
+            m_channel->AsyncReceive(shared_from_this());
+        }
+    }
+
+    virtual void EndSend(const boost::system::error_code &err, std::size_t bytesTransferred, void *ctx) override
+    {
+        if (err)
+        {
+            ++m_errorCount;
+            m_finished.Signal();
+        }
+        else if (++m_sent == m_expectedCount)
+        {
+            m_finished.Signal();
+        }
+    }
+
+    virtual void EndClose(const boost::system::error_code &err) override
+    {
+        BOOST_TEST(!err, "UdpTestHandler EndClose called,message:" << err.message());
+        m_finished.Signal();
+    }
+};
+
+BOOST_AUTO_TEST_CASE(GeneralTest)
+{
+    ThreadPool::Instance();
+    UdpChannelSettings settings = { boost::asio::ip::udp::endpoint(boost::asio::ip::address_v4::loopback(), 0), 512, 32, 16, false };
+    std::shared_ptr<UdpTestHandler> receiver(new UdpTestHandler()), sender(new UdpTestHandler());
+    receiver->m_channel.reset(new UdpChannel(settings));
+    sender->m_channel.reset(new UdpChannel(settings));
+    receiver->m_channel->AsyncOpen(receiver);
+    sender->m_channel->AsyncOpen(sender);
+    receiver->m_opened.Wait();
+    sender->m_opened.Wait();
+    boost::system::error_code err;
+    boost::asio::ip::udp::endpoint receiverEndPoint = receiver->m_channel->LocalEndPoint(err);
+    receiver->m_expectedRemote = sender->m_channel->LocalEndPoint(err);
+    BOOST_TEST(!err);
+
+    for (size_t i = 0; i < UdpTestDatagramCount; ++i)
+    {
+        if (i % 2 == 0)
+        {
+            us8 data[256];
+            std::fill(data, data + sizeof(data), static_cast<us8>(i % 256));
+            sender->m_channel->AsyncSendCopy(data, i % 256 + 1, receiverEndPoint, sender);
+        }
+        else
+        {
+            std::shared_ptr<LinearBuffer> buf(new LinearBuffer(256));
+            buf->assign(i % 256 + 1, static_cast<us8>(i % 256));
+            sender->m_channel->AsyncSendTo(buf, 0, buf->size(), receiverEndPoint, sender);
+        }
+        if (i % 32 == 31)
+        {
+            //keeps the loopback receive queue from overflowing.
+            while (sender->m_sent < i + 1)
+            {
+                std::this_thread::yield();
+            }
+            if (i == 31)
+            {
+                //the first burst is pending before the receiver starts,so its first wakeup receives a batch.
+                receiver->m_channel->AsyncReceive(receiver);
+            }
+        }
+    }
+    BOOST_TEST(sender->m_finished.TimedWait(5000));
+    BOOST_TEST(receiver->m_finished.TimedWait(5000));
+    BOOST_TEST(receiver->m_received == UdpTestDatagramCount);
+    BOOST_TEST(receiver->m_errorCount == 0);
+    BOOST_TEST(sender->m_errorCount == 0);
+    BOOST_TEST(receiver->m_maxBatch <= settings.m_receiveBatchSize);
+    BOOST_TEST(receiver->m_maxBatch > 1, "Datagrams are not received in batches.");
+
+    receiver->m_channel->AsyncClose(receiver);
+    BOOST_TEST(receiver->m_finished.TimedWait(5000));
+    us8 data = 0;
+    receiver->m_channel->AsyncSendCopy(&data, 1, receiverEndPoint, receiver);
+    BOOST_TEST(receiver->m_finished.TimedWait(5000));
+    BOOST_TEST(receiver->m_errorCount == 1, "Send on closed channel not failed.");
+    sender->m_channel->AsyncClose(sender);
+    BOOST_TEST(sender->m_finished.TimedWait(5000));
+
+    receiver->m_channel.reset();
+    sender->m_channel.reset();
+    ThreadPool::Instance().Stop();
+    ThreadPool::Destory();
+}
+
+BOOST_AUTO_TEST_CASE(MulticastTest)
+{
+    ThreadPool::Instance();
+    const boost::asio::ip::address group = boost::asio::ip::make_address("239.255.42.99");
+    UdpChannelSettings settings;
+    settings.m_reuseAddress = true;
+    std::shared_ptr<UdpTestHandler> receiver(new UdpTestHandler()), sender(new UdpTestHandler());
+    receiver->m_expectedCount = sender->m_expectedCount = 8;
+    receiver->m_channel.reset(new UdpChannel(settings));
+    sender->m_channel.reset(new UdpChannel(UdpChannelSettings()));
+    receiver->m_channel->AsyncOpen(receiver);
+    sender->m_channel->AsyncOpen(sender);
+    receiver->m_opened.Wait();
+    sender->m_opened.Wait();
+    boost::system::error_code err;
+    receiver->m_channel->JoinMulticastGroup(group, err);
+    if (err == boost::asio::error::no_such_device)
+    {
+        //multicast needs a route to the group,which some build hosts do not have.
+        BOOST_TEST_MESSAGE("Multicast is not available,test skipped:" << err.message());
+    }
+    else
+    {
+        BOOST_TEST(!err, "Join multicast group failed:" << err.message());
+        boost::asio::ip::udp::endpoint groupEndPoint(group, receiver->m_channel->LocalEndPoint(err).port());
+        receiver->m_expectedRemote = boost::asio::ip::udp::endpoint(boost::asio::ip::address_v4::any(), sender->m_channel->LocalEndPoint(err).port());
+        receiver->m_channel->AsyncReceive(receiver);
+        for (size_t i = 0; i < 8; ++i)
+        {
+            us8 data[256];
+            std::fill(data, data + sizeof(data), static_cast<us8>(i));
+            sender->m_channel->AsyncSendCopy(data, i + 1, groupEndPoint, sender);
+        }
+        BOOST_TEST(sender->m_finished.TimedWait(5000));
+        BOOST_TEST(receiver->m_finished.TimedWait(5000));
+        BOOST_TEST(receiver->m_received == 8);
+        BOOST_TEST(receiver->m_errorCount == 0);
+        receiver->m_channel->LeaveMulticastGroup(group, err);
+        BOOST_TEST(!err);
+    }
+
+    receiver->m_channel->AsyncClose(receiver);
+    BOOST_TEST(receiver->m_finished.TimedWait(5000));
+    sender->m_channel->AsyncClose(sender);
+    BOOST_TEST(sender->m_finished.TimedWait(5000));
+    receiver->m_channel.reset();
+    sender->m_channel.reset();
+    ThreadPool::Instance().Stop();
+    ThreadPool::Destory();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
\ No newline at end of file
@@ -0,0 +1,312 @@
+#if defined(linux) || defined(__linux)
+
+#include <cstdio>
+#include <memory>
+#include <vector>
+#include <unistd.h>
+#include <boost/test/unit_test.hpp>
+#include "Concurrent/ThreadPool.h"
+#include "Concurrent/TaskBarrier.h"
+#include "Concurrent/WaitEvent.h"
+#include "Buffer/CircularBuffer.h"
+#include "Channel/Unix/UnixStreamChannel.h"
+#include "Channel/Unix/UnixStreamPassiveChannel.h"
+#include "Channel/Unix/UnixStreamListener.h"
+#include "Channel/Unix/UnixFdPassing.h"
+
+BOOST_AUTO_TEST_SUITE(UnixStreamChannelTest)
+
+const char UnixStreamTestPath[] = "/tmp/UtilsUnixStreamChannelTest.sock";
+
+const size_t UnixStreamTestSize = 100;
+
+TaskBarrier<> GlobalUnixStreamBarrier(2);
+
+/**
+ * Reads UnixStreamTestSize bytes,the server side sends them back and the client side checks them.
+ */
+class UnixEchoHandler :public std::enable_shared_from_this<UnixEchoHandler>, public IAsyncChannelHandler
+{
+public:
+    IAsyncChannel::ptr_t m_channel;
+
+    bool m_server{ false };
+
+    us8 m_readBuf[UnixStreamTestSize];
+
+    size_t m_readSize{ 0 };
+
+    void BeginRead()
+    {
+        BufDescriptor buf = { m_readBuf + m_readSize, UnixStreamTestSize - m_readSize };
+        m_channel->AsyncReadSome(&buf, 1, shared_from_this());
+    }
+
+    virtual void EndOpen(const boost::system::error_code &err) override
+    {
+        BOOST_TEST(!err, "UnixEchoHandler EndOpen called,message:" << err.message());
+        if (!m_server)
+        {
+            us8 data[UnixStreamTestSize];
+            for (size_t i = 0; i < UnixStreamTestSize; ++i)
+            {
+                data[i] = static_cast<us8>(i);
+            }
+            m_channel->AsyncWriteCopy(data, sizeof(data), shared_from_this());
+        }
+        BeginRead();
+    }
+
+    virtual void EndRead(const boost::system::error_code &err, std::size_t bytesTransferred, void *ctx) override
+    {
+        BOOST_TEST(!err, "UnixEchoHandler EndRead called,message:" << err.message());
+        if (err)
+        {
+            m_channel->AsyncClose(shared_from_this());
+            return;
+        }
+        m_readSize += bytesTransferred;
+        if (m_readSize < UnixStreamTestSize)
+        {
+            BeginRead();
+        }
+        else if (m_server)
+        {
+            m_channel->AsyncWriteCopy(m_readBuf, UnixStreamTestSize, shared_from_this());
+        }
+        else
+        {
+            for (size_t i = 0; i < UnixStreamTestSize; ++i)
+            {
+                BOOST_TEST(m_readBuf[i] == i, "UnixEchoHandler received buf content, index:" << i);
+            }
+            m_channel->AsyncClose(shared_from_this());
+        }
+    }
+
+    virtual void EndWrite(const boost::system::error_code &err, std::size_t bytesTransferred, void *ctx) override
+    {
+        BOOST_TEST(!err, "UnixEchoHandler EndWrite called,message:" << err.message());
+        if (m_server)
+        {
+            m_channel->AsyncClose(shared_from_this());
+        }
+    }
+
+    virtual void EndClose(const boost::system::error_code &err) override
+    {
+        GlobalUnixStreamBarrier.IncFinishedCount(1);
+    }
+};
+
+void UnixTestAcceptFunc(std::shared_ptr<UnixStreamTraits::StreamType> &sock)
+{
+    std::shared_ptr<UnixEchoHandler> handler(new UnixEchoHandler());
+    handler->m_server = true;
+    handler->m_channel.reset(new UnixStreamPassiveChannel(sock));
+    handler->m_channel->AsyncOpen(handler);
+}
+
+BOOST_AUTO_TEST_CASE(GeneralTest)
+{
+    ThreadPool::Instance();
+    SetUnixListenerAcceptFunc(UnixTestAcceptFunc);
+    BOOST_TEST(UnixStreamListener::Instance().AddListenEndPoint(UnixStreamTestPath), "Add end point error.");
+    BOOST_TEST(!UnixStreamListener::Instance().AddListenEndPoint(UnixStreamTestPath), "Add same end point error not happened.");
+
+    GlobalUnixStreamBarrier.ResetTaskCount(2);
+    GlobalUnixStreamBarrier.Reset();
+    {
+        std::shared_ptr<UnixEchoHandler> client(new UnixEchoHandler());
+        client->m_channel.reset(new UnixStreamChannel(UnixStreamTestPath));
+        client->m_channel->AsyncOpen(client);
+    }
+    GlobalUnixStreamBarrier.WaitAllFinished();
+
+    UnixStreamListener::Instance().RemoveListenerEndPoint(UnixStreamTestPath);
+    BOOST_TEST(access(UnixStreamTestPath, F_OK) != 0, "Socket file is not removed.");
+    ThreadPool::Instance().Stop();
+    UnixStreamListener::Destory();
+    ThreadPool::Destory();
+}
+
+BOOST_AUTO_TEST_CASE(SocketFileTest)
+{
+    ThreadPool::Instance();
+    SetUnixListenerAcceptFunc(UnixTestAcceptFunc);
+    unlink(UnixStreamTestPath);
+
+    //a regular file is never removed.
+    FILE *file = fopen(UnixStreamTestPath, "w");
+    BOOST_TEST_REQUIRE(file != nullptr);
+    fclose(file);
+    BOOST_TEST(!UnixStreamListener::Instance().AddListenEndPoint(UnixStreamTestPath), "Regular file is replaced.");
+    BOOST_TEST(access(UnixStreamTestPath, F_OK) == 0, "Regular file is removed.");
+    unlink(UnixStreamTestPath);
+
+    //the socket file of a live listener is never removed.
+    boost::asio::io_context context;
+    {
+        boost::asio::local::stream_protocol::acceptor live(context, UnixStreamTraits::EndPointType(UnixStreamTestPath));
+        BOOST_TEST(!UnixStreamListener::Instance().AddListenEndPoint(UnixStreamTestPath), "Live listener is replaced.");
+        BOOST_TEST(access(UnixStreamTestPath, F_OK) == 0, "Socket file of live listener is removed.");
+    }
+    unlink(UnixStreamTestPath);
+
+    //the probe does not block on a live listener whose backlog is full.
+    {
+        boost::asio::local::stream_protocol::acceptor live(context, UnixStreamTraits::EndPointType(UnixStreamTestPath));
+        live.listen(0);
+        std::vector<std::unique_ptr<UnixStreamTraits::StreamType>> pending;
+        boost::system::error_code err;
+        while (!err && pending.size() < 64)
+        {
+            pending.emplace_back(new UnixStreamTraits::StreamType(context));
+            pending.back()->open(UnixStreamTraits::Protocol());
+            pending.back()->non_blocking(true);
+            pending.back()->connect(UnixStreamTraits::EndPointType(UnixStreamTestPath), err);
+        }
+        //asio reports the EAGAIN of a unix socket connect as no_buffer_space.
+        BOOST_TEST_REQUIRE(err == boost::asio::error::no_buffer_space, "Backlog is not full:" << err.message());
+        BOOST_TEST(!UnixStreamListener::Instance().AddListenEndPoint(UnixStreamTestPath), "Live listener is replaced.");
+        BOOST_TEST(access(UnixStreamTestPath, F_OK) == 0, "Socket file of live listener is removed.");
+    }
+
+    //the socket file left by the closed acceptor is stale.
+    BOOST_TEST(access(UnixStreamTestPath, F_OK) == 0);
+    BOOST_TEST(UnixStreamListener::Instance().AddListenEndPoint(UnixStreamTestPath), "Stale socket file is not replaced.");
+
+    //the path taken over by another listener is not removed with the end point.
+    unlink(UnixStreamTestPath);
+    {
+        boost::asio::local::stream_protocol::acceptor other(context, UnixStreamTraits::EndPointType(UnixStreamTestPath));
+        UnixStreamListener::Instance().RemoveListenerEndPoint(UnixStreamTestPath);
+        BOOST_TEST(access(UnixStreamTestPath, F_OK) == 0, "Socket file of another listener is removed.");
+    }
+    unlink(UnixStreamTestPath);
+
+    ThreadPool::Instance().Stop();
+    UnixStreamListener::Destory();
+    ThreadPool::Destory();
+}
+
+BOOST_AUTO_TEST_CASE(FdPassingTest)
+{
+    boost::asio::io_context context;
+    UnixStreamTraits::StreamType sender(context), receiver(context);
+    boost::asio::local::connect_pair(sender, receiver);
+    int pipeFds[2];
+    BOOST_TEST_REQUIRE(pipe(pipeFds) == 0);
+
+    boost::system::error_code err;
+    BOOST_TEST(UnixFdPassing::SendFileDescriptor(sender, pipeFds[1], err));
+    int fd = UnixFdPassing::ReceiveFileDescriptor(receiver, err);
+    BOOST_TEST_REQUIRE(fd >= 0, "Receive file descriptor error:" << err.message());
+    BOOST_TEST(fd != pipeFds[1]);
+    char data = 'x';
+    BOOST_TEST(write(fd, &data, 1) == 1);
+    data = 0;
+    BOOST_TEST(read(pipeFds[0], &data, 1) == 1);
+    BOOST_TEST(data == 'x');
+
+    boost::asio::write(sender, boost::asio::buffer(&data, 1));
+    BOOST_TEST(UnixFdPassing::ReceiveFileDescriptor(receiver, err) == -1);
+    BOOST_TEST(err == boost::asio::error::no_descriptors);
+
+    close(fd);
+    close(pipeFds[0]);
+    close(pipeFds[1]);
+}
+
+/**
+ * Records the result of each read.
+ */
+class UnixReadAvailableHandler :public IAsyncChannelHandler
+{
+public:
+    boost::system::error_code m_err;
+
+    size_t m_bytes{ 0 };
+
+    WaitEvent m_finished;
+
+    virtual void EndOpen(const boost::system::error_code &err) override
+    {
+    }
+
+    virtual void EndRead(const boost::system::error_code &err, std::size_t bytesTransferred, void *ctx) override
+    {
+        m_err = err;
+        m_bytes = bytesTransferred;
+        m_finished.Signal();
+    }
+
+    virtual void EndWrite(const boost::system::error_code &err, std::size_t bytesTransferred, void *ctx) override
+    {
+    }
+
+    virtual void EndClose(const boost::system::error_code &err) override
+    {
+        m_finished.Signal();
+    }
+};
+
+BOOST_AUTO_TEST_CASE(ReadAvailableTest)
+{
+    ThreadPool::Instance();
+    std::shared_ptr<UnixStreamTraits::StreamType> sender(new UnixStreamTraits::StreamType(ThreadPool::Instance().Context()));
+    std::shared_ptr<UnixStreamTraits::StreamType> receiver(new UnixStreamTraits::StreamType(ThreadPool::Instance().Context()));
+    boost::asio::local::connect_pair(*sender, *receiver);
+    IAsyncChannel::ptr_t channel(new UnixStreamPassiveChannel(receiver));
+    std::shared_ptr<UnixReadAvailableHandler> handler(new UnixReadAvailableHandler());
+
+    //one byte is left near the end of the circular buffer,so the free space wraps around and is split into two buffers.
+    const size_t capacity = 4096, chunkSize = 1000, chunkCount = 3;
+    CircularBuffer buf(capacity);
+    buf.inc_size(capacity - 100);
+    buf.pop_front(capacity - 101);
+    us8 chunk[chunkSize];
+    for (size_t i = 0; i < chunkCount; ++i)
+    {
+        for (size_t j = 0; j < chunkSize; ++j)
+        {
+            chunk[j] = static_cast<us8>(i * chunkSize + j);
+        }
+        boost::asio::write(*sender, boost::asio::buffer(chunk));
+    }
+    sender->shutdown(boost::asio::socket_base::shutdown_send);
+
+    BufDescriptor bufs[2];
+    size_t bufSize = buf.free_buffers(bufs);
+    BOOST_TEST(bufSize == 2U);
+    channel->AsyncReadAvailable(bufs, bufSize, handler);
+    BOOST_TEST_REQUIRE(handler->m_finished.TimedWait(5000));
+    BOOST_TEST(!handler->m_err, "Read error:" << handler->m_err.message());
+    BOOST_TEST(handler->m_bytes == chunkSize * chunkCount);
+    BOOST_TEST(!receiver->non_blocking(), "The drain must not change the socket mode.");
+    buf.inc_size(handler->m_bytes);
+    buf.pop_front(1);
+    for (size_t i = 0; i < buf.size(); ++i)
+    {
+        if (buf[i] != static_cast<us8>(i))
+        {
+            BOOST_TEST(buf[i] == static_cast<us8>(i), "Index:" << i);
+            break;
+        }
+    }
+
+    //the end of stream found by the drain is reported by the next read.
+    bufSize = buf.free_buffers(bufs);
+    channel->AsyncReadAvailable(bufs, bufSize, handler);
+    BOOST_TEST_REQUIRE(handler->m_finished.TimedWait(5000));
+    BOOST_TEST(handler->m_err == boost::asio::error::eof);
+
+    channel->AsyncClose(handler);
+    BOOST_TEST(handler->m_finished.TimedWait(5000));
+    ThreadPool::Instance().Stop();
+    ThreadPool::Destory();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+#endif
\ No newline at end of file
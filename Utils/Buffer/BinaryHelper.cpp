@@ -706,21 +706,23 @@ s32 BinaryHelper::ReadBinDataBE_Signed(const us8* buf, size_t offset, us8 size)
 
 us32 BinaryHelper::ReadBinData(CircularBuffer& buf, size_t offset, us8 size, bool isLittleEndian)
 {
-    us32 ret = 0;
-    switch (size)
+    if (size == 1)
     {
-    case 1:
-        ret = buf[offset];
-        break;
-    case 2:
-        ret = isLittleEndian ? buf[offset] | (buf[offset + 1] << 8) : (buf[offset] << 8) | buf[offset + 1];
-        break;
-    case 3:
-        ret = isLittleEndian ? buf[offset] | (buf[offset + 1] << 8) | (buf[offset + 2] << 16) : (buf[offset] << 16) | (buf[offset + 1] << 8) | buf[offset + 2];
-        break;
-    case 4:
-        ret = isLittleEndian ? buf[offset] | (buf[offset + 1] << 8) | (buf[offset + 2] << 16) | (buf[offset + 3] << 24) : (buf[offset] << 24) | (buf[offset + 1] << 16) | (buf[offset + 2] << 8) | buf[offset + 3];
-        break;
+        return buf[offset];
     }
-    return ret;
+    return CircularBufferReader(buf).PeekBinData(offset, size, isLittleEndian);
+}
+
+s32 BinaryHelper::ReadBinDataSigned(CircularBuffer& buf, size_t offset, us8 size, bool isLittleEndian)
+{
+    if (size == 1)
+    {
+        return static_cast<s8>(buf[offset]);
+    }
+    return CircularBufferReader(buf).PeekBinDataSigned(offset, size, isLittleEndian);
+}
+
+f32 BinaryHelper::ReadBinData(CircularBuffer& buf, size_t offset, bool isLittleEndian)
+{
+    return CircularBufferReader(buf).PeekBinData(offset, isLittleEndian);
 }
\ No newline at end of file
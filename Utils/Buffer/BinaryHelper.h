@@ -3,6 +3,7 @@
 
 #include "BufferDescriptor.h"
 #include "CircularBuffer.h"
+#include "CircularBufferReader.h"
 
 /**
  * Buildin type binary operation utilities.
@@ -295,6 +296,29 @@ public:
      */
     static us32 ReadBinData(CircularBuffer &buf, size_t offset, us8 size, bool isLittleEndian);
 
+    /**
+     * Reads a signed integer at the specific position of a buf(at most 4 bytes).
+     *
+     * @param [in,out] buf The buffer.
+     * @param offset Read offset in the buffer.
+     * @param size Read size.
+     * @param isLittleEndian True if read as little endian, false if as big endian.
+     *
+     * @return The readed data.
+     */
+    static s32 ReadBinDataSigned(CircularBuffer &buf, size_t offset, us8 size, bool isLittleEndian);
+
+    /**
+     * Reads a float(four-bytes) at the specific position of a buf.
+     *
+     * @param [in,out] buf The buffer.
+     * @param offset Read offset in the buffer.
+     * @param isLittleEndian True if read as little endian, false if as big endian.
+     *
+     * @return The readed data.
+     */
+    static f32 ReadBinData(CircularBuffer &buf, size_t offset, bool isLittleEndian);
+
 private:
 
     /**
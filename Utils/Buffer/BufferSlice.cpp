@@ -0,0 +1,14 @@
+#include "BufferSlice.h"
+
+constexpr size_t BufferChain::MaxSliceCount;
+
+BufferSlice BufferSlice::Copy(const void *data, size_t size)
+{
+    std::shared_ptr<LinearBuffer> buf = LinearBufferCache::Instance().Get(size);
+    if (!buf)
+    {
+        buf = std::make_shared<LinearBuffer>(size);
+    }
+    buf->append(data, size);
+    return BufferSlice(buf);
+}
@@ -0,0 +1,268 @@
+#ifndef BUFFERSLICE_H
+#define BUFFERSLICE_H
+
+#include <array>
+#include <cassert>
+#include <stdexcept>
+#include "LinearBufferCache.h"
+
+/**
+ * Immutable reference counted view of a range of a @ref LinearBuffer.
+ *
+ * Copying a slice only increases the reference count of the underlying buffer,so one encoded message can be shared by many
+ * write requests without copying.A buffer from @ref LinearBufferCache is returned to the cache after the last slice released.
+ *
+ * @note The content of the underlying buffer must not be modified while it is referenced by any slice.
+ */
+class UTILS_EXPORTS_API BufferSlice
+{
+public:
+
+    /**
+     * Default constructor(an empty slice).
+     */
+    BufferSlice() :m_holder(), m_offset(0), m_size(0)
+    {
+    }
+
+    /**
+     * Constructs a slice which references whole content of a buffer.
+     *
+     * @param buf The buffer.
+     */
+    BufferSlice(const std::shared_ptr<LinearBuffer> &buf) :m_holder(buf), m_offset(0), m_size(buf ? buf->size() : 0)
+    {
+    }
+
+    /**
+     * Constructs a slice which references a range of a buffer's content.
+     *
+     * @param buf The buffer.
+     * @param offset Offset of the range.
+     * @param size Size of the range.
+     */
+    BufferSlice(const std::shared_ptr<LinearBuffer> &buf, size_t offset, size_t size) :m_holder(buf), m_offset(offset), m_size(size)
+    {
+        assert(buf && offset + size <= buf->size());
+    }
+
+    /**
+     * Makes a slice by copying the data into a buffer from @ref LinearBufferCache(a heap buffer is used when the cache can not serve
+     * the request).
+     *
+     * @param data The data.
+     * @param size Size of the data.
+     *
+     * @return The slice.
+     */
+    static BufferSlice Copy(const void *data, size_t size);
+
+    /**
+     * Gets a sub range of this slice(shares the same buffer).
+     *
+     * @param offset Offset of the sub range(relative to this slice).
+     * @param size Size of the sub range.
+     *
+     * @return The sub slice.
+     */
+    BufferSlice Sub(size_t offset, size_t size) const
+    {
+        assert(offset + size <= m_size);
+        return BufferSlice(m_holder, m_offset + offset, size);
+    }
+
+    /**
+     * Gets the begin pointer of the slice.
+     *
+     * @return Data pointer.
+     */
+    const us8* Data() const
+    {
+        return m_holder ? m_holder->data() + m_offset : nullptr;
+    }
+
+    /**
+     * Gets size of the slice.
+     *
+     * @return Byte count.
+     */
+    size_t Size() const
+    {
+        return m_size;
+    }
+
+    /**
+     * Query if this slice is empty.
+     *
+     * @return True if empty.
+     */
+    bool Empty() const
+    {
+        return m_size == 0;
+    }
+
+    /**
+     * Gets the reference count of the underlying buffer.
+     *
+     * @return The reference count(0 for an empty slice).
+     */
+    long UseCount() const
+    {
+        return m_holder.use_count();
+    }
+
+private:
+
+    /**
+     * Constructor used by @ref Sub.
+     */
+    BufferSlice(const std::shared_ptr<const LinearBuffer> &holder, size_t offset, size_t size) :m_holder(holder), m_offset(offset)
+        , m_size(size)
+    {
+    }
+
+    std::shared_ptr<const LinearBuffer> m_holder;   /**< The underlying buffer. */
+
+    size_t m_offset;    /**< Offset of the slice in the buffer. */
+
+    size_t m_size;  /**< Size of the slice. */
+};
+
+/**
+ * A short ordered list of @ref BufferSlice which is written as one message(scatter list).
+ *
+ * The usual usage is prepending a small per-connection header to a shared body:
+ * @code
+ * BufferChain chain;
+ * chain.Append(BufferSlice::Copy(header, headerSize));
+ * chain.Append(body);
+ * channel->AsyncWrite(chain, handler);
+ * @endcode
+ */
+class UTILS_EXPORTS_API BufferChain
+{
+public:
+
+    static constexpr size_t MaxSliceCount = 4;  /**< Max number of slices in a chain(header,body and trailer are enough for most protocols). */
+
+    /**
+     * Default constructor.
+     */
+    BufferChain() :m_slices(), m_count(0), m_size(0)
+    {
+    }
+
+    /**
+     * Appends a slice to the end of the chain(an empty slice is ignored).
+     *
+     * @param slice The slice.
+     */
+    void Append(const BufferSlice &slice)
+    {
+        if (!slice.Empty())
+        {
+            CheckCount();
+            m_slices[m_count++] = slice;
+            m_size += slice.Size();
+        }
+    }
+
+    /**
+     * Inserts a slice to the front of the chain(an empty slice is ignored).
+     *
+     * @param slice The slice.
+     */
+    void Prepend(const BufferSlice &slice)
+    {
+        if (!slice.Empty())
+        {
+            CheckCount();
+            for (size_t i = m_count; i > 0; --i)
+            {
+                m_slices[i] = std::move(m_slices[i - 1]);
+            }
+            m_slices[0] = slice;
+            ++m_count;
+            m_size += slice.Size();
+        }
+    }
+
+    /**
+     * Gets a slice.
+     *
+     * @param index Index of the slice.
+     *
+     * @return The slice.
+     */
+    const BufferSlice& operator[](size_t index) const
+    {
+        assert(index < m_count);
+        return m_slices[index];
+    }
+
+    /**
+     * Gets the number of slices.
+     *
+     * @return Slice count.
+     */
+    size_t SliceCount() const
+    {
+        return m_count;
+    }
+
+    /**
+     * Gets total byte count of all slices.
+     *
+     * @return Total size.
+     */
+    size_t Size() const
+    {
+        return m_size;
+    }
+
+    /**
+     * Query if the chain is empty.
+     *
+     * @return True if empty.
+     */
+    bool Empty() const
+    {
+        return m_count == 0;
+    }
+
+    /**
+     * Releases all slices.
+     */
+    void Clear()
+    {
+        for (size_t i = 0; i < m_count; ++i)
+        {
+            m_slices[i] = BufferSlice();
+        }
+        m_count = 0;
+        m_size = 0;
+    }
+
+private:
+
+    /**
+     * Checks whether another slice can be added(throws std::out_of_range in debug mode).
+     */
+    void CheckCount() const
+    {
+#ifndef NDEBUG
+        if (m_count == MaxSliceCount)
+        {
+            throw std::out_of_range("too many slices.");
+        }
+#endif
+    }
+
+    std::array<BufferSlice, MaxSliceCount> m_slices;    /**< The slices. */
+
+    size_t m_count; /**< Number of slices. */
+
+    size_t m_size;  /**< Total byte count of all slices. */
+};
+
+#endif /* BUFFERSLICE_H */
@@ -0,0 +1,19 @@
+#include "CircularBufferReader.h"
+#include "../Common/RunTimeLibraryHelper.h"
+
+CircularBufferReader::CircularBufferReader(CircularBuffer &buf, size_t offset) :m_segs{ { nullptr, 0 }, { nullptr, 0 } }, m_size(buf.size())
+    , m_offset(offset)
+{
+    assert(offset <= m_size);
+    if (m_size)
+    {
+        buf.content_buffers(m_segs);
+    }
+}
+
+void CircularBufferReader::Gather(size_t offset, us8 size, us8 temp[4]) const
+{
+    size_t firstSize = m_segs[0].m_size - offset;
+    RunTimeLibraryHelper::MemCpy(temp, 4, m_segs[0].m_beg + offset, firstSize);
+    RunTimeLibraryHelper::MemCpy(temp + firstSize, 4 - firstSize, m_segs[1].m_beg, size - firstSize);
+}
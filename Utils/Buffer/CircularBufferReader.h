@@ -0,0 +1,227 @@
+#ifndef CIRCULARBUFFERREADER_H
+#define CIRCULARBUFFERREADER_H
+
+#include <string.h>
+#include <cassert>
+#include <boost/endian/conversion.hpp>
+#include "CircularBuffer.h"
+
+/**
+ * Binary data reader cursor over a @ref CircularBuffer.
+ *
+ * The content of the buffer is resolved into at most two contiguous segments on construction,a field which lies in one segment is
+ * decoded with a single unaligned load,only a field which straddles the wrap point is gathered from both segments.
+ *
+ * @note The reader holds raw pointers to the buffer content,any operation which changes the buffer content(pop_front,inc_size,clear,
+ * reserve...) invalidates the reader.
+ */
+class UTILS_EXPORTS_API CircularBufferReader
+{
+public:
+
+    /**
+     * Constructor
+     *
+     * @param [in,out] buf The buffer.
+     * @param offset (Optional) Initial read offset in the buffer.
+     */
+    CircularBufferReader(CircularBuffer &buf, size_t offset = 0);
+
+    /**
+     * Gets current read offset in the buffer.
+     *
+     * @return Current read offset.
+     */
+    size_t Offset() const
+    {
+        return m_offset;
+    }
+
+    /**
+     * Gets the number of bytes which are not read.
+     *
+     * @return Remain byte count.
+     */
+    size_t Remain() const
+    {
+        return m_size - m_offset;
+    }
+
+    /**
+     * Moves read offset to the specific position.
+     *
+     * @param offset New read offset.
+     */
+    void Seek(size_t offset)
+    {
+        assert(offset <= m_size);
+        m_offset = offset;
+    }
+
+    /**
+     * Skips the specific number of bytes.
+     *
+     * @param size Skipped byte count.
+     */
+    void Skip(size_t size)
+    {
+        Seek(m_offset + size);
+    }
+
+    /**
+     * Reads a unsigned integer at current offset(at most 4 bytes) and advances the offset.
+     *
+     * @param size Read size.
+     * @param isLittleEndian True if read as little endian, false if as big endian.
+     *
+     * @return The readed data.
+     */
+    us32 ReadBinData(us8 size, bool isLittleEndian)
+    {
+        us32 ret = PeekBinData(m_offset, size, isLittleEndian);
+        m_offset += size;
+        return ret;
+    }
+
+    /**
+     * Reads a signed integer at current offset(at most 4 bytes) and advances the offset.
+     *
+     * @param size Read size.
+     * @param isLittleEndian True if read as little endian, false if as big endian.
+     *
+     * @return The readed data.
+     */
+    s32 ReadBinDataSigned(us8 size, bool isLittleEndian)
+    {
+        s32 ret = PeekBinDataSigned(m_offset, size, isLittleEndian);
+        m_offset += size;
+        return ret;
+    }
+
+    /**
+     * Reads a float(four-bytes) at current offset and advances the offset.
+     *
+     * @param isLittleEndian True if read as little endian, false if as big endian.
+     *
+     * @return The readed data.
+     */
+    f32 ReadBinData(bool isLittleEndian)
+    {
+        f32 ret = PeekBinData(m_offset, isLittleEndian);
+        m_offset += 4;
+        return ret;
+    }
+
+    /**
+     * Reads a unsigned integer at the specific offset(at most 4 bytes),current offset is not changed.
+     *
+     * @param offset Read offset in the buffer.
+     * @param size Read size.
+     * @param isLittleEndian True if read as little endian, false if as big endian.
+     *
+     * @return The readed data.
+     */
+    us32 PeekBinData(size_t offset, us8 size, bool isLittleEndian) const
+    {
+        us8 temp[4];
+        const us8 *ptr = Resolve(offset, size, temp);
+        switch (size)
+        {
+        case 1:
+            return *ptr;
+        case 2:
+            return isLittleEndian ? boost::endian::load_little_u16(ptr) : boost::endian::load_big_u16(ptr);
+        case 3:
+            return isLittleEndian ? boost::endian::load_little_u24(ptr) : boost::endian::load_big_u24(ptr);
+        case 4:
+            return isLittleEndian ? boost::endian::load_little_u32(ptr) : boost::endian::load_big_u32(ptr);
+        }
+        return 0;
+    }
+
+    /**
+     * Reads a signed integer at the specific offset(at most 4 bytes),current offset is not changed.
+     *
+     * @param offset Read offset in the buffer.
+     * @param size Read size.
+     * @param isLittleEndian True if read as little endian, false if as big endian.
+     *
+     * @return The readed data.
+     */
+    s32 PeekBinDataSigned(size_t offset, us8 size, bool isLittleEndian) const
+    {
+        us8 temp[4];
+        const us8 *ptr = Resolve(offset, size, temp);
+        switch (size)
+        {
+        case 1:
+            return *reinterpret_cast<const s8*>(ptr);
+        case 2:
+            return isLittleEndian ? boost::endian::load_little_s16(ptr) : boost::endian::load_big_s16(ptr);
+        case 3:
+            return isLittleEndian ? boost::endian::load_little_s24(ptr) : boost::endian::load_big_s24(ptr);
+        case 4:
+            return isLittleEndian ? boost::endian::load_little_s32(ptr) : boost::endian::load_big_s32(ptr);
+        }
+        return 0;
+    }
+
+    /**
+     * Reads a float(four-bytes) at the specific offset,current offset is not changed.
+     *
+     * @param offset Read offset in the buffer.
+     * @param isLittleEndian True if read as little endian, false if as big endian.
+     *
+     * @return The readed data.
+     */
+    f32 PeekBinData(size_t offset, bool isLittleEndian) const
+    {
+        us32 val = PeekBinData(offset, 4, isLittleEndian);
+        f32 ret;
+        memcpy(&ret, &val, sizeof(ret));
+        return ret;
+    }
+
+private:
+
+    /**
+     * Resolves the address of a field.
+     *
+     * @param offset Field offset in the buffer.
+     * @param size Field size(at most 4 bytes).
+     * @param [out] temp Gather buffer used when the field straddles the wrap point.
+     *
+     * @return Pointer to the contiguous field bytes(points into the buffer or to temp).
+     */
+    const us8* Resolve(size_t offset, us8 size, us8 temp[4]) const
+    {
+        assert(size <= 4 && offset + size <= m_size);
+        if (offset + size <= m_segs[0].m_size)
+        {
+            return m_segs[0].m_beg + offset;
+        }
+        else if (offset >= m_segs[0].m_size)
+        {
+            return m_segs[1].m_beg + (offset - m_segs[0].m_size);
+        }
+        Gather(offset, size, temp);
+        return temp;
+    }
+
+    /**
+     * Gathers a field which straddles the wrap point.
+     *
+     * @param offset Field offset in the buffer.
+     * @param size Field size(at most 4 bytes).
+     * @param [out] temp Gather buffer.
+     */
+    void Gather(size_t offset, us8 size, us8 temp[4]) const;
+
+    BufDescriptor m_segs[2];    /**< Content segments of the buffer(the second one is empty when content is contiguous). */
+
+    size_t m_size;  /**< Content size of the buffer. */
+
+    size_t m_offset;    /**< Current read offset. */
+};
+
+#endif /* CIRCULARBUFFERREADER_H */
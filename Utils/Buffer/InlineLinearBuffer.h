@@ -0,0 +1,627 @@
+#ifndef INLINELINEARBUFFER_H
+#define INLINELINEARBUFFER_H
+
+#include "../Common/CommonHdr.h"
+#include "../Common/RunTimeLibraryHelper.h"
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <cassert>
+
+/**
+ * Fixed size linear buffer with inline storage(API compatible with @ref LinearBuffer).
+ *
+ * The storage is a member array so creating the buffer costs no heap allocation,it is intended for small control messages and can
+ * be written by IAsyncChannel::AsyncWrite without heap allocation(the content is copied into the write request).
+ *
+ * @tparam N Capacity of the buffer.
+ */
+template<size_t N> class InlineLinearBuffer
+{
+public:
+
+    static_assert(N > 0, "InlineLinearBuffer capacity must be greater than 0.");
+
+    /**
+     * Defines an alias representing type of the value.
+     */
+    using value_type = us8;
+
+    /**
+     * Defines an alias representing type of the size.
+     */
+    using size_type = size_t;
+
+    /**
+     * Defines an alias representing type of the difference.
+     */
+    using difference_type = ptrdiff_t;
+
+    /**
+     * Defines an alias representing the value reference.
+     */
+    using reference = value_type&;
+
+    /**
+     * Defines an alias representing the constant value reference.
+     */
+    using const_reference = const value_type&;
+
+    /**
+     * Defines an alias representing the value pointer.
+     */
+    using pointer = value_type*;
+
+    /**
+     * Defines an alias representing the constant value pointer.
+     */
+    using const_pointer = const value_type*;
+
+    /**
+     * Defines an alias representing the iterator.
+     */
+    using iterator = pointer;
+
+    /**
+     * Defines an alias representing the constant iterator.
+     */
+    using const_iterator = const_pointer;
+
+    /**
+     * Defines an alias representing the reverse iterator.
+     */
+    using reverse_iterator = std::reverse_iterator<pointer>;
+
+    /**
+     * Defines an alias representing the constant reverse iterator.
+     */
+    using const_reverse_iterator = std::reverse_iterator<const_pointer>;
+
+    /**
+     * Constructor
+     *
+     * @param capacity (Optional) Required capacity(must not be greater than N,kept for compatibility with @ref LinearBuffer).
+     */
+    InlineLinearBuffer(size_type capacity = N) :m_size(0)
+    {
+        reserve(capacity);
+    }
+
+    /**
+     * Copy constructor
+     *
+     * @param rhs The right hand side.
+     */
+    InlineLinearBuffer(const InlineLinearBuffer &rhs) :m_size(rhs.m_size)
+    {
+        RunTimeLibraryHelper::MemCpy(m_data, N, rhs.m_data, rhs.m_size);
+    }
+
+    /**
+     * Assignment operator
+     *
+     * @param rhs The right hand side.
+     *
+     * @return Equal to *this.
+     */
+    InlineLinearBuffer& operator=(const InlineLinearBuffer &rhs)
+    {
+        if (this != &rhs)
+        {
+            RunTimeLibraryHelper::MemCpy(m_data, N, rhs.m_data, rhs.m_size);
+            m_size = rhs.m_size;
+        }
+        return *this;
+    }
+
+    /**
+     * @see LinearBuffer::assign(size_type count, const_reference value)
+     */
+    void assign(size_type count, const_reference value)
+    {
+        check_capacity(count, "assign out of range.");
+        memset(m_data, value, count);
+        m_size = count;
+    }
+
+    /**
+     * @see LinearBuffer::assign(const_iterator first, const_iterator last)
+     */
+    void assign(const_iterator first, const_iterator last)
+    {
+#ifndef NDEBUG
+        if (last < first)
+        {
+            throw std::out_of_range("assign out of range.");
+        }
+#endif
+        size_type size = last - first;
+        check_capacity(size, "assign out of range.");
+        RunTimeLibraryHelper::MemCpy(m_data, N, first, size);
+        m_size = size;
+    }
+
+    /**
+     * @see LinearBuffer::assign(std::initializer_list<value_type> ilist)
+     */
+    void assign(std::initializer_list<value_type> ilist)
+    {
+        assign(ilist.begin(), ilist.end());
+    }
+
+    /**
+     * @see LinearBuffer::at(size_type pos)
+     */
+    reference at(size_type pos)
+    {
+        if (pos >= m_size)
+        {
+            throw std::out_of_range("out of range.");
+        }
+        return m_data[pos];
+    }
+
+    /**
+     * @see LinearBuffer::at(size_type pos)
+     */
+    const_reference at(size_type pos) const
+    {
+        if (pos >= m_size)
+        {
+            throw std::out_of_range("out of range.");
+        }
+        return m_data[pos];
+    }
+
+    /**
+     * @see LinearBuffer::operator[](size_type pos)
+     */
+    reference operator[](size_type pos)
+    {
+#ifndef NDEBUG
+        return at(pos);
+#else
+        return m_data[pos];
+#endif
+    }
+
+    /**
+     * @see LinearBuffer::operator[](size_type pos)
+     */
+    const_reference operator[](size_type pos) const
+    {
+#ifndef NDEBUG
+        return at(pos);
+#else
+        return m_data[pos];
+#endif
+    }
+
+    /**
+     * @see LinearBuffer::front()
+     */
+    reference front()
+    {
+        assert(!empty());
+        return m_data[0];
+    }
+
+    /**
+     * @see LinearBuffer::front()
+     */
+    const_reference front() const
+    {
+        assert(!empty());
+        return m_data[0];
+    }
+
+    /**
+     * @see LinearBuffer::back()
+     */
+    reference back()
+    {
+        assert(!empty());
+        return m_data[m_size - 1];
+    }
+
+    /**
+     * @see LinearBuffer::back()
+     */
+    const_reference back() const
+    {
+        assert(!empty());
+        return m_data[m_size - 1];
+    }
+
+    /**
+     * @see LinearBuffer::data()
+     */
+    pointer data() noexcept
+    {
+        return m_data;
+    }
+
+    /**
+     * @see LinearBuffer::data()
+     */
+    const_pointer data() const noexcept
+    {
+        return m_data;
+    }
+
+    /**
+     * @see LinearBuffer::begin()
+     */
+    iterator begin() noexcept
+    {
+        return m_data;
+    }
+
+    /**
+     * @see LinearBuffer::begin()
+     */
+    const_iterator begin() const noexcept
+    {
+        return m_data;
+    }
+
+    /**
+     * @see LinearBuffer::cbegin()
+     */
+    const_iterator cbegin() const noexcept
+    {
+        return begin();
+    }
+
+    /**
+     * @see LinearBuffer::end()
+     */
+    iterator end() noexcept
+    {
+        return m_data + m_size;
+    }
+
+    /**
+     * @see LinearBuffer::end()
+     */
+    const_iterator end() const noexcept
+    {
+        return m_data + m_size;
+    }
+
+    /**
+     * @see LinearBuffer::cend()
+     */
+    const_iterator cend() const noexcept
+    {
+        return end();
+    }
+
+    /**
+     * @see LinearBuffer::rbegin()
+     */
+    reverse_iterator rbegin() noexcept
+    {
+        return reverse_iterator(end());
+    }
+
+    /**
+     * @see LinearBuffer::rbegin()
+     */
+    const_reverse_iterator rbegin() const noexcept
+    {
+        return const_reverse_iterator(end());
+    }
+
+    /**
+     * @see LinearBuffer::crbegin()
+     */
+    const_reverse_iterator crbegin() const noexcept
+    {
+        return rbegin();
+    }
+
+    /**
+     * @see LinearBuffer::rend()
+     */
+    reverse_iterator rend() noexcept
+    {
+        return reverse_iterator(begin());
+    }
+
+    /**
+     * @see LinearBuffer::rend()
+     */
+    const_reverse_iterator rend() const noexcept
+    {
+        return const_reverse_iterator(begin());
+    }
+
+    /**
+     * @see LinearBuffer::crend()
+     */
+    const_reverse_iterator crend() const noexcept
+    {
+        return rend();
+    }
+
+    /**
+     * @see LinearBuffer::empty()
+     */
+    bool empty() const noexcept
+    {
+        return m_size == 0;
+    }
+
+    /**
+     * @see LinearBuffer::size()
+     */
+    size_type size() const noexcept
+    {
+        return m_size;
+    }
+
+    /**
+     * @see LinearBuffer::max_size()
+     */
+    size_type max_size() const noexcept
+    {
+        return N;
+    }
+
+    /**
+     * Reserves the given new capacity(the capacity is fixed to N,a greater value is an error).
+     *
+     * @exception std::length_error Thrown when newCapacity is greater than N.
+     *
+     * @param newCapacity The new capacity.
+     */
+    void reserve(size_type newCapacity)
+    {
+        if (newCapacity > N)
+        {
+            throw std::length_error("reserve exceeds inline capacity.");
+        }
+    }
+
+    /**
+     * @see LinearBuffer::capacity()
+     */
+    constexpr size_type capacity() const noexcept
+    {
+        return N;
+    }
+
+    /**
+     * Query if the capacity of this buffer grows automatically(always false).
+     *
+     * @return False.
+     */
+    constexpr bool growable() const noexcept
+    {
+        return false;
+    }
+
+    /**
+     * @see LinearBuffer::clear()
+     */
+    void clear() noexcept
+    {
+        m_size = 0;
+    }
+
+    /**
+     * @see LinearBuffer::insert(const_iterator pos, const_reference value)
+     */
+    iterator insert(const_iterator pos, const_reference value)
+    {
+        return insert(pos, 1, value);
+    }
+
+    /**
+     * @see LinearBuffer::insert(const_iterator pos, size_type count, const_reference value)
+     */
+    iterator insert(const_iterator pos, size_type count, const_reference value)
+    {
+        iterator iter = make_room(pos, count);
+        memset(iter, value, count);
+        return iter;
+    }
+
+    /**
+     * @see LinearBuffer::insert(const_iterator pos, const_iterator first, const_iterator last)
+     */
+    iterator insert(const_iterator pos, const_iterator first, const_iterator last)
+    {
+#ifndef NDEBUG
+        if (last < first)
+        {
+            throw std::out_of_range("insert out of range.");
+        }
+        if ((first >= begin() && first < end()) || (last >= begin() && last < end()))
+        {
+            throw std::range_error("insert range overlaped.");
+        }
+#endif
+        size_type count = last - first;
+        iterator iter = make_room(pos, count);
+        RunTimeLibraryHelper::MemCpy(iter, count, first, count);
+        return iter;
+    }
+
+    /**
+     * @see LinearBuffer::insert(const_iterator pos, std::initializer_list<value_type> ilist)
+     */
+    iterator insert(const_iterator pos, std::initializer_list<value_type> ilist)
+    {
+        return insert(pos, ilist.begin(), ilist.end());
+    }
+
+    /**
+     * @see LinearBuffer::erase(const_iterator pos)
+     */
+    iterator erase(const_iterator pos)
+    {
+        return erase(pos, pos + 1);
+    }
+
+    /**
+     * @see LinearBuffer::erase(const_iterator first, const_iterator last)
+     */
+    iterator erase(const_iterator first, const_iterator last)
+    {
+#ifndef NDEBUG
+        if (empty() || first >= end() || first < begin() || last > end() || last < begin() || last < first)
+        {
+            throw std::out_of_range("erase out of range.");
+        }
+#endif
+        iterator iterBeg = const_cast<iterator>(first);
+        iterator iterEnd = const_cast<iterator>(last);
+        RunTimeLibraryHelper::MemMove(iterBeg, (m_data + N) - iterBeg, iterEnd, end() - iterEnd);
+        m_size -= iterEnd - iterBeg;
+        return iterEnd;
+    }
+
+    /**
+     * @see LinearBuffer::append(const void *data, size_type size)
+     */
+    void append(const void *data, size_type size)
+    {
+        check_capacity(m_size + size, "append out of range.");
+        RunTimeLibraryHelper::MemCpy(m_data + m_size, N - m_size, data, size);
+        m_size += size;
+    }
+
+    /**
+     * @see LinearBuffer::push_back(const_reference value)
+     */
+    void push_back(const_reference value)
+    {
+        check_capacity(m_size + 1, "push_back out of range.");
+        m_data[m_size++] = value;
+    }
+
+    /**
+     * @see LinearBuffer::pop_back()
+     */
+    void pop_back()
+    {
+#ifndef NDEBUG
+        if (empty())
+        {
+            throw std::logic_error("pop_back() when empty() is true.");
+        }
+#endif
+        --m_size;
+    }
+
+    /**
+     * @see LinearBuffer::resize(size_type count)
+     */
+    void resize(size_type count)
+    {
+        resize(count, 0);
+    }
+
+    /**
+     * @see LinearBuffer::resize(size_type count, const value_type& value)
+     */
+    void resize(size_type count, const value_type& value)
+    {
+        check_capacity(count, "resize out of range.");
+        if (count > m_size)
+        {
+            memset(m_data + m_size, value, count - m_size);
+        }
+        m_size = count;
+    }
+
+    /**
+     * Swaps contents with the given buffer(contents are copied).
+     *
+     * @param [in,out] other The buffer.
+     */
+    void swap(InlineLinearBuffer &other) noexcept
+    {
+        InlineLinearBuffer temp(other);
+        other = *this;
+        *this = temp;
+    }
+
+    /**
+     * @see LinearBuffer::inc_size(size_t incSize)
+     */
+    void inc_size(size_t incSize)
+    {
+        assert(m_size + incSize <= N);
+        m_size += incSize;
+    }
+
+private:
+
+    /**
+     * Checks the required capacity.
+     *
+     * @exception std::out_of_range Thrown when required capacity is greater than N(debug only).
+     *
+     * @param requireCapacity The required capacity.
+     * @param errMsg Exception message.
+     */
+    void check_capacity(size_type requireCapacity, const char *errMsg) const
+    {
+#ifndef NDEBUG
+        if (requireCapacity > N)
+        {
+            throw std::out_of_range(errMsg);
+        }
+#else
+        (void)requireCapacity;
+        (void)errMsg;
+#endif
+    }
+
+    /**
+     * Moves the data after pos to make room for inserted values.
+     *
+     * @param pos Position to be insertted.
+     * @param count Number of insertted values.
+     *
+     * @return An iterator point to the room.
+     */
+    iterator make_room(const_iterator pos, size_type count)
+    {
+#ifndef NDEBUG
+        if (pos > end() || pos < begin())
+        {
+            throw std::out_of_range("insert out of range.");
+        }
+#endif
+        check_capacity(m_size + count, "insert out of range.");
+        iterator iter = const_cast<iterator>(pos);
+        RunTimeLibraryHelper::MemMove(iter + count, (m_data + N) - (iter + count), iter, end() - iter);
+        m_size += count;
+        return iter;
+    }
+
+    size_type m_size;   /**< Current size. */
+
+    us8 m_data[N];  /**< Inline storage. */
+};
+
+namespace std
+{
+    /**
+     * Swaps contents with the given buffers.
+     *
+     * @tparam N Capacity of the buffers.
+     * @param [in,out] lhs The left hand side.
+     * @param [in,out] rhs The right hand side.
+     */
+    template<size_t N> inline void swap(InlineLinearBuffer<N>& lhs, InlineLinearBuffer<N>& rhs) noexcept
+    {
+        lhs.swap(rhs);
+    }
+}
+
+#endif /* INLINELINEARBUFFER_H */
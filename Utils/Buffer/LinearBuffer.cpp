@@ -1,12 +1,41 @@
 #include "LinearBuffer.h"
-#include "../Common/RunTimeLibraryHelper.h"
+#include <cstdlib>
+#include <new>
 
-LinearBuffer::LinearBuffer(size_type capacity) :m_beg(capacity == 0 ? nullptr : new us8[capacity]), m_last(m_beg), m_capacityLast(m_beg + capacity)
+namespace
+{
+    /**
+     * Allocates a raw memory block(malloc based,so the block can be extended by realloc).
+     *
+     * @exception std::bad_alloc Thrown when allocation failed.
+     *
+     * @param size Block size.
+     *
+     * @return Allocated memory block(nullptr when size is 0).
+     */
+    us8* AllocBlock(size_t size)
+    {
+        if (size == 0)
+        {
+            return nullptr;
+        }
+        us8 *ret = static_cast<us8*>(std::malloc(size));
+        if (!ret)
+        {
+            throw std::bad_alloc();
+        }
+        return ret;
+    }
+}
+
+LinearBuffer::LinearBuffer(size_type capacity) :m_beg(AllocBlock(capacity)), m_last(m_beg), m_capacityLast(m_beg + capacity)
+    , m_growable(false)
 {
 }
 
 LinearBuffer::LinearBuffer(const LinearBuffer &rhs):LinearBuffer(rhs.capacity())
 {
+    m_growable = rhs.m_growable;
     size_type rhsSize = rhs.size();
     if(rhsSize)
     {
@@ -22,7 +51,7 @@ LinearBuffer::LinearBuffer(LinearBuffer &&rhs) noexcept :LinearBuffer(0)
 
 LinearBuffer::~LinearBuffer()
 {
-    delete[] m_beg;
+    std::free(m_beg);
 }
 
 LinearBuffer& LinearBuffer::operator=(const LinearBuffer &rhs)
@@ -40,12 +69,7 @@ LinearBuffer& LinearBuffer::operator=(LinearBuffer &&rhs) noexcept
 
 void LinearBuffer::assign(size_type count, const_reference value)
 {
-#ifndef NDEBUG
-    if(count > capacity())
-    {
-        throw std::out_of_range("assign out of range.");
-    }
-#endif
+    ensure_capacity(count, "assign out of range.");
     memset(m_beg, value, count);
     m_last = m_beg + count;
 }
@@ -53,12 +77,13 @@ void LinearBuffer::assign(size_type count, const_reference value)
 void LinearBuffer::assign(const_iterator first, const_iterator last)
 {
 #ifndef NDEBUG
-    if (last < first || static_cast<size_type>(last - first) > capacity())
+    if (last < first)
     {
         throw std::out_of_range("assign out of range.");
     }
 #endif
     size_type size = last - first;
+    ensure_capacity(size, "assign out of range.");
     RunTimeLibraryHelper::MemCpy(m_beg, size, first, size);
     m_last = m_beg + size;
 }
@@ -66,12 +91,7 @@ void LinearBuffer::assign(const_iterator first, const_iterator last)
 void LinearBuffer::assign(std::initializer_list<value_type> ilist)
 {
     size_type realSize = ilist.size();
-#ifndef NDEBUG
-    if (realSize > capacity())
-    {
-        throw std::out_of_range("assign out of range.");
-    }
-#endif
+    ensure_capacity(realSize, "assign out of range.");
     RunTimeLibraryHelper::MemCpy(m_beg, realSize, ilist.begin(), realSize);
     m_last = m_beg + realSize;
 }
@@ -80,22 +100,36 @@ void LinearBuffer::reserve(size_type newCapacity)
 {
     if(newCapacity > capacity())
     {
-        LinearBuffer rhs(newCapacity);
-        rhs.insert(rhs.begin(), begin(), end());
-        swap(rhs);
+        size_type currentSize = size();
+        us8 *newBeg = static_cast<us8*>(std::realloc(m_beg, newCapacity));
+        if (!newBeg)
+        {
+            throw std::bad_alloc();
+        }
+        m_beg = newBeg;
+        m_last = m_beg + currentSize;
+        m_capacityLast = m_beg + newCapacity;
     }
 }
 
+void LinearBuffer::grow(size_type requireCapacity)
+{
+    size_type newCapacity = capacity() * 2;
+    reserve(newCapacity > requireCapacity ? newCapacity : requireCapacity);
+}
+
 LinearBuffer::iterator LinearBuffer::insert(const_iterator pos, size_type count, const_reference value)
 {
 #ifndef NDEBUG
-    if (size() + count > capacity() || pos > m_last || pos < m_beg)
+    if ((!m_growable && size() + count > capacity()) || pos > m_last || pos < m_beg)
     {
         throw std::out_of_range("insert out of range.");
     }
 #endif
-    iterator iter = const_cast<iterator>(pos);
-    RunTimeLibraryHelper::MemMove(iter + count, m_capacityLast - (pos + count), pos, m_last - pos);
+    size_type index = pos - m_beg;
+    ensure_free(count, "insert out of range.");
+    iterator iter = m_beg + index;
+    RunTimeLibraryHelper::MemMove(iter + count, m_capacityLast - (iter + count), iter, m_last - iter);
     memset(iter, value, count);
     m_last += count;
     return iter;
@@ -105,7 +139,7 @@ LinearBuffer::iterator LinearBuffer::insert(const_iterator pos, const_iterator f
 {
     size_type inserttedSize = last - first;
 #ifndef NDEBUG
-    if (last<first || size() + inserttedSize > capacity() || pos > m_last || pos < m_beg)
+    if (last<first || (!m_growable && size() + inserttedSize > capacity()) || pos > m_last || pos < m_beg)
     {
         throw std::out_of_range("insert out of range.");
     }
@@ -114,8 +148,10 @@ LinearBuffer::iterator LinearBuffer::insert(const_iterator pos, const_iterator f
         throw std::range_error("insert range overlaped.");
     }
 #endif
-    iterator iter = const_cast<iterator>(pos);
-    RunTimeLibraryHelper::MemMove(iter + inserttedSize, m_capacityLast - (pos + inserttedSize), pos, m_last - pos);
+    size_type index = pos - m_beg;
+    ensure_free(inserttedSize, "insert out of range.");
+    iterator iter = m_beg + index;
+    RunTimeLibraryHelper::MemMove(iter + inserttedSize, m_capacityLast - (iter + inserttedSize), iter, m_last - iter);
     RunTimeLibraryHelper::MemCpy(iter, inserttedSize, first, inserttedSize);
     m_last += inserttedSize;
     return iter;
@@ -124,7 +160,7 @@ LinearBuffer::iterator LinearBuffer::insert(const_iterator pos, const_iterator f
 LinearBuffer::iterator LinearBuffer::insert(const_iterator pos, std::initializer_list<value_type> ilist)
 {
 #ifndef NDEBUG
-    if (size() + ilist.size() > capacity() || pos > m_last || pos < m_beg)
+    if ((!m_growable && size() + ilist.size() > capacity()) || pos > m_last || pos < m_beg)
     {
         throw std::out_of_range("insert out of range.");
     }
@@ -133,9 +169,11 @@ LinearBuffer::iterator LinearBuffer::insert(const_iterator pos, std::initializer
         throw std::range_error("insert range overlaped.");
     }
 #endif
-    iterator iter = const_cast<iterator>(pos);
+    size_type index = pos - m_beg;
     size_type realSize = ilist.size();
-    RunTimeLibraryHelper::MemMove(iter + realSize, m_capacityLast - (pos + realSize), pos, m_last - pos);
+    ensure_free(realSize, "insert out of range.");
+    iterator iter = m_beg + index;
+    RunTimeLibraryHelper::MemMove(iter + realSize, m_capacityLast - (iter + realSize), iter, m_last - iter);
     RunTimeLibraryHelper::MemCpy(iter, realSize, ilist.begin(), realSize);
     m_last += realSize;
     return iter;
@@ -172,28 +210,18 @@ LinearBuffer::iterator LinearBuffer::erase(const_iterator first, const_iterator
 
 void LinearBuffer::push_back(const_reference value)
 {
-#ifndef NDEBUG
-    if (size() == capacity())
-    {
-        throw std::out_of_range("push_back out of range.");
-    }
-#endif
+    ensure_free(1, "push_back out of range.");
     *m_last++ = value;
 }
 
 void LinearBuffer::resize(size_type count, const value_type& value)
 {
-#ifndef NDEBUG
-    if (count > capacity())
-    {
-        throw std::out_of_range("resize out of range.");
-    }
-#endif
+    ensure_capacity(count, "resize out of range.");
     size_type currentSize = size();
     if (count > currentSize)
     {
-        memset(m_last, value, count);
-        m_last += count;
+        memset(m_last, value, count - currentSize);
+        m_last = m_beg + count;
     }
     else
     {
@@ -206,4 +234,5 @@ void LinearBuffer::swap(LinearBuffer &other) noexcept
     std::swap(m_beg, other.m_beg);
     std::swap(m_last, other.m_last);
     std::swap(m_capacityLast, other.m_capacityLast);
+    std::swap(m_growable, other.m_growable);
 }
\ No newline at end of file
@@ -2,13 +2,20 @@
 #define LINEARBUFFER_H
 
 #include "../Common/CommonHdr.h"
+#include "../Common/RunTimeLibraryHelper.h"
 #include <initializer_list>
 #include <iterator>
 #include <stdexcept>
 #include <cassert>
 
 /**
- * Fixed size linear buffer.
+ * Linear buffer.
+ *
+ * The buffer is fixed size by default(operations which exceed the capacity are errors),growth can be enabled by
+ * @ref set_growable,in which case the capacity grows geometrically when required.
+ *
+ * @note A buffer obtained from a buffer cache must not be grown,the cache looks up the owner block by capacity when the buffer is
+ * returned,use @ref LinearBufferAppender to build a variable-length message from cached buffers instead.
  */
 class UTILS_EXPORTS_API LinearBuffer
 {
@@ -435,6 +442,29 @@ public:
         return m_capacityLast - m_beg;
     }
 
+    /**
+     * Query if the capacity of this buffer grows automatically.
+     *
+     * @return True if growable, false if fixed size.
+     */
+    bool growable() const noexcept
+    {
+        return m_growable;
+    }
+
+    /**
+     * Enables or disables automatic growth of this buffer.
+     *
+     * When enabled,insert/push_back/append/assign/resize grow the capacity(at least doubled) instead of treating an overflow as
+     * an error.
+     *
+     * @param growable True to enable growth, false to keep the capacity fixed.
+     */
+    void set_growable(bool growable) noexcept
+    {
+        m_growable = growable;
+    }
+
     /**
      * Clears contents of this buffer.
      */
@@ -514,6 +544,19 @@ public:
      */
     void push_back(const_reference value);
 
+    /**
+     * Appends a range of raw data at the end of the buffer.
+     *
+     * @param data The data(must not point into this buffer).
+     * @param size Size of the data.
+     */
+    void append(const void *data, size_type size)
+    {
+        ensure_free(size, "append out of range.");
+        RunTimeLibraryHelper::MemCpy(m_last, m_capacityLast - m_last, data, size);
+        m_last += size;
+    }
+
     /**
      * Pops a value at the end of the buffer.
      *
@@ -569,11 +612,60 @@ public:
     }
 
 private:
+
+    /**
+     * Makes sure the capacity is not less than the given size,grows the buffer when growable.
+     *
+     * @exception std::out_of_range Thrown when capacity is not enough and the buffer is not growable(debug only).
+     *
+     * @param requireCapacity The required capacity.
+     * @param errMsg Exception message.
+     */
+    void ensure_capacity(size_type requireCapacity, const char *errMsg)
+    {
+        if (requireCapacity > capacity())
+        {
+            if (m_growable)
+            {
+                grow(requireCapacity);
+            }
+#ifndef NDEBUG
+            else
+            {
+                throw std::out_of_range(errMsg);
+            }
+#endif
+        }
+    }
+
+    /**
+     * Makes sure there is room for the given number of additional bytes.
+     *
+     * @param count Number of additional bytes.
+     * @param errMsg Exception message.
+     */
+    void ensure_free(size_type count, const char *errMsg)
+    {
+        if (static_cast<size_type>(m_capacityLast - m_last) < count)
+        {
+            ensure_capacity(size() + count, errMsg);
+        }
+    }
+
+    /**
+     * Grows the capacity geometrically.
+     *
+     * @param requireCapacity The required capacity.
+     */
+    void grow(size_type requireCapacity);
+
     iterator m_beg; /**< The beg pointer of the memory block. */
 
     iterator m_last;	/**< One past last pointer base on current size. */
 
     iterator m_capacityLast;	/**< One past last pointer of whole memory block. */
+
+    bool m_growable;    /**< Wether the capacity grows automatically. */
 };
 
 namespace std
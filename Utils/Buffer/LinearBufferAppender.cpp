@@ -0,0 +1,57 @@
+#include "LinearBufferAppender.h"
+
+LinearBufferAppender::LinearBufferAppender(size_t capacityHint) :m_pooled(), m_heap(), m_buf(&m_heap)
+{
+    m_heap.set_growable(true);
+    if (capacityHint)
+    {
+        Grow(capacityHint);
+    }
+}
+
+std::shared_ptr<LinearBuffer> LinearBufferAppender::Detach()
+{
+    std::shared_ptr<LinearBuffer> ret;
+    if (m_pooled)
+    {
+        ret = std::move(m_pooled);
+    }
+    else
+    {
+        ret = std::make_shared<LinearBuffer>(std::move(m_heap));
+        m_heap.set_growable(true);
+    }
+    m_buf = &m_heap;
+    return ret;
+}
+
+void LinearBufferAppender::Grow(size_t requireCapacity)
+{
+    size_t newCapacity = m_buf->capacity() * 2;
+    if (newCapacity < requireCapacity)
+    {
+        newCapacity = requireCapacity;
+    }
+    LinearBufferCache::ptr_t larger = LinearBufferCache::Instance().Get(newCapacity);
+    if (larger)
+    {
+        larger->append(m_buf->data(), m_buf->size());
+        if (m_buf == &m_heap)
+        {
+            LinearBuffer().swap(m_heap);
+            m_heap.set_growable(true);
+        }
+        m_pooled = std::move(larger);
+        m_buf = m_pooled.get();
+    }
+    else
+    {
+        m_heap.reserve(newCapacity);
+        if (m_buf != &m_heap)
+        {
+            m_heap.append(m_buf->data(), m_buf->size());
+            m_pooled.reset();
+            m_buf = &m_heap;
+        }
+    }
+}
@@ -0,0 +1,107 @@
+#ifndef LINEARBUFFERAPPENDER_H
+#define LINEARBUFFERAPPENDER_H
+
+#include "LinearBufferCache.h"
+
+/**
+ * Builds a variable-length message into a linear buffer which grows geometrically.
+ *
+ * The appender starts with(and grows into) buffers from @ref LinearBufferCache when a large enough one is available,the content
+ * is copied into the larger buffer and the old one is returned to the cache.When the cache can not serve the request,the content
+ * is moved into a growable heap buffer and later growth is done by realloc.
+ */
+class UTILS_EXPORTS_API LinearBufferAppender
+{
+public:
+
+    /**
+     * Constructor
+     *
+     * @param capacityHint (Optional) Initial capacity hint.
+     */
+    LinearBufferAppender(size_t capacityHint = 0);
+
+    LinearBufferAppender(const LinearBufferAppender&) = delete;
+
+    LinearBufferAppender& operator=(const LinearBufferAppender&) = delete;
+
+    /**
+     * Appends a range of raw data.
+     *
+     * @param data The data.
+     * @param size Size of the data.
+     */
+    void Append(const void *data, size_t size)
+    {
+        if (m_buf->capacity() - m_buf->size() < size)
+        {
+            Grow(m_buf->size() + size);
+        }
+        m_buf->append(data, size);
+    }
+
+    /**
+     * Appends a byte.
+     *
+     * @param value The value.
+     */
+    void Append(us8 value)
+    {
+        Append(&value, 1);
+    }
+
+    /**
+     * Gets the buffer which holds current content.
+     *
+     * @return The buffer(valid until next append or @ref Detach).
+     */
+    LinearBuffer& Buffer()
+    {
+        return *m_buf;
+    }
+
+    /**
+     * Gets size of current content.
+     *
+     * @return Content size.
+     */
+    size_t Size() const
+    {
+        return m_buf->size();
+    }
+
+    /**
+     * Query if current content is held by a cached buffer.
+     *
+     * @return True if cached, false if held by the heap buffer.
+     */
+    bool IsPooled() const
+    {
+        return m_pooled.get() != nullptr;
+    }
+
+    /**
+     * Detaches current buffer from the appender(the appender becomes empty),the result can be used in
+     * IAsyncChannel::AsyncWrite directly and a cached buffer is returned to the cache when released.
+     *
+     * @return The buffer.
+     */
+    std::shared_ptr<LinearBuffer> Detach();
+
+private:
+
+    /**
+     * Grows the buffer geometrically.
+     *
+     * @param requireCapacity The required capacity.
+     */
+    void Grow(size_t requireCapacity);
+
+    LinearBufferCache::ptr_t m_pooled;  /**< Cached buffer(null when the content is held by m_heap). */
+
+    LinearBuffer m_heap;    /**< Heap buffer used when the cache can not serve the request. */
+
+    LinearBuffer *m_buf;    /**< Buffer which holds current content. */
+};
+
+#endif /* LINEARBUFFERAPPENDER_H */
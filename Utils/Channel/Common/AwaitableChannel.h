@@ -0,0 +1,357 @@
+#ifndef AWAITABLECHANNEL_H
+#define AWAITABLECHANNEL_H
+
+#include <type_traits>
+#include <typeinfo>
+#include <utility>
+#include <boost/asio/async_result.hpp>
+#include <boost/asio/dispatch.hpp>
+#include <boost/asio/associated_executor.hpp>
+#include <boost/asio/any_io_executor.hpp>
+#include <boost/asio/io_context.hpp>
+
+#if defined(BOOST_ASIO_HAS_CO_AWAIT)
+
+#include <boost/asio/use_awaitable.hpp>
+#include "IAsyncChannel.h"
+#include "HandlerAllocator.h"
+
+/**
+ * Coroutine(C++20) facade of @ref IAsyncChannel,the operations are asio asynchronous operations,so they can be awaited with
+ * boost::asio::use_awaitable(the default completion token):
+ *
+ * @code
+ * size_t bytes = co_await channel.ReadSome(bufs, 2);
+ * co_await channel.Write(buf, 0, buf->size());
+ * @endcode
+ *
+ * Errors are thrown as boost::system::system_error,pass boost::asio::redirect_error(boost::asio::use_awaitable, err) as the token to
+ * get the error code instead.Coroutine frames are recycled by asio per thread,and the operation states are allocated from memory
+ * blocks owned by the facade,so the facade adds no heap allocation to an operation:an awaited loop allocates exactly what the same
+ * loop written with handlers does(the allocations of the wrapped channel itself).A coroutine is always resumed through its executor,
+ * so a coroutine spawned on a strand stays on the strand(the strand may allocate to queue the resumption).
+ *
+ * @note At most one read,one write and one open/close operation of a facade can be pending at the same time(concurrent writers
+ * are still correct,but fall back to heap allocations).The facade and the wrapped channel can be used together.
+ */
+class AwaitableChannel
+{
+public:
+
+    /**
+     * Constructor
+     *
+     * @param channel The wrapped channel.
+     */
+    explicit AwaitableChannel(IAsyncChannel::ptr_t channel) :m_channel(std::move(channel)), m_bridge(std::make_shared<Bridge>())
+    {
+    }
+
+    /**
+     * Gets the wrapped channel.
+     *
+     * @return The channel.
+     */
+    const IAsyncChannel::ptr_t& Channel() const
+    {
+        return m_channel;
+    }
+
+    /**
+     * Opens the channel(see @ref IAsyncChannel::AsyncOpen).
+     *
+     * @tparam CompletionToken Type of the completion token.
+     * @param token The completion token,signature is void(boost::system::error_code).
+     *
+     * @return Depends on the token(boost::asio::awaitable<void> by default).
+     */
+    template<typename CompletionToken = boost::asio::use_awaitable_t<>> auto Open(CompletionToken &&token = {})
+    {
+        return boost::asio::async_initiate<CompletionToken, void(boost::system::error_code)>(
+            [this](auto &&handler)
+            {
+                m_bridge->m_controlOp = m_bridge->template MakeOp<false>(m_bridge->m_controlMemory, std::move(handler));
+                m_channel->AsyncOpen(m_bridge);
+            }, token);
+    }
+
+    /**
+     * Reads some data(see @ref IAsyncChannel::AsyncReadSome).
+     *
+     * @tparam CompletionToken Type of the completion token.
+     * @param bufs The read buf array(must be valid until the operation completes).
+     * @param bufSize Size of the read buf array.
+     * @param token The completion token,signature is void(boost::system::error_code, size_t).
+     *
+     * @return Depends on the token(boost::asio::awaitable<size_t> by default).
+     */
+    template<typename CompletionToken = boost::asio::use_awaitable_t<>> auto ReadSome(BufDescriptor bufs[], size_t bufSize
+        , CompletionToken &&token = {})
+    {
+        return boost::asio::async_initiate<CompletionToken, void(boost::system::error_code, size_t)>(
+            [this, bufs, bufSize](auto &&handler)
+            {
+                m_channel->AsyncReadSome(bufs, bufSize, m_bridge, m_bridge->template MakeOp<true>(m_bridge->m_readMemory
+                    , std::move(handler)));
+            }, token);
+    }
+
+    /**
+     * Writes a buffer(see @ref IAsyncChannel::AsyncWrite).
+     *
+     * @tparam CompletionToken Type of the completion token.
+     * @param buf The write buffer.
+     * @param sendOffset Offset of buffer to be writen.
+     * @param sendLen Byte count to be writen.
+     * @param token The completion token,signature is void(boost::system::error_code, size_t).
+     *
+     * @return Depends on the token(boost::asio::awaitable<size_t> by default).
+     */
+    template<typename CompletionToken = boost::asio::use_awaitable_t<>> auto Write(const std::shared_ptr<LinearBuffer> &buf
+        , size_t sendOffset, size_t sendLen, CompletionToken &&token = {})
+    {
+        return boost::asio::async_initiate<CompletionToken, void(boost::system::error_code, size_t)>(
+            [this](auto &&handler, const std::shared_ptr<LinearBuffer> &buf, size_t sendOffset, size_t sendLen)
+            {
+                m_channel->AsyncWrite(buf, sendOffset, sendLen, m_bridge, m_bridge->template MakeOp<true>(m_bridge->m_writeMemory
+                    , std::move(handler)));
+            }, token, buf, sendOffset, sendLen);
+    }
+
+    /**
+     * Writes a slice chain(see @ref IAsyncChannel::AsyncWrite).
+     *
+     * @tparam CompletionToken Type of the completion token.
+     * @param chain The slices to be writen(must be valid until the operation is started,the slices are referenced by the channel).
+     * @param token The completion token,signature is void(boost::system::error_code, size_t).
+     *
+     * @return Depends on the token(boost::asio::awaitable<size_t> by default).
+     */
+    template<typename CompletionToken = boost::asio::use_awaitable_t<>> auto Write(const BufferChain &chain, CompletionToken &&token = {})
+    {
+        return boost::asio::async_initiate<CompletionToken, void(boost::system::error_code, size_t)>(
+            [this](auto &&handler, const BufferChain *chain)
+            {
+                m_channel->AsyncWrite(*chain, m_bridge, m_bridge->template MakeOp<true>(m_bridge->m_writeMemory, std::move(handler)));
+            }, token, &chain);
+    }
+
+    /**
+     * Writes a copy of the data(see @ref IAsyncChannel::AsyncWriteCopy).
+     *
+     * @tparam CompletionToken Type of the completion token.
+     * @param data The data to be writen(must be valid until the operation is started).
+     * @param sendLen Byte count to be writen.
+     * @param token The completion token,signature is void(boost::system::error_code, size_t).
+     *
+     * @return Depends on the token(boost::asio::awaitable<size_t> by default).
+     */
+    template<typename CompletionToken = boost::asio::use_awaitable_t<>> auto WriteCopy(const void *data, size_t sendLen
+        , CompletionToken &&token = {})
+    {
+        return boost::asio::async_initiate<CompletionToken, void(boost::system::error_code, size_t)>(
+            [this, data, sendLen](auto &&handler)
+            {
+                m_channel->AsyncWriteCopy(data, sendLen, m_bridge, m_bridge->template MakeOp<true>(m_bridge->m_writeMemory
+                    , std::move(handler)));
+            }, token);
+    }
+
+    /**
+     * Closes the channel(see @ref IAsyncChannel::AsyncClose).
+     *
+     * @tparam CompletionToken Type of the completion token.
+     * @param token The completion token,signature is void(boost::system::error_code).
+     *
+     * @return Depends on the token(boost::asio::awaitable<void> by default).
+     */
+    template<typename CompletionToken = boost::asio::use_awaitable_t<>> auto Close(CompletionToken &&token = {})
+    {
+        return boost::asio::async_initiate<CompletionToken, void(boost::system::error_code)>(
+            [this](auto &&handler)
+            {
+                m_bridge->m_controlOp = m_bridge->template MakeOp<false>(m_bridge->m_controlMemory, std::move(handler));
+                m_channel->AsyncClose(m_bridge);
+            }, token);
+    }
+
+private:
+    static constexpr size_t OpMemorySize = 128; /**< Size of the memory block of each operation kind. */
+
+    /**
+     * Type erased pending operation.
+     */
+    class Op
+    {
+    public:
+        /**
+         * Completes the operation and destroys it.
+         *
+         * @param err Result of operation.
+         * @param bytesTransferred Number of bytes transferred.
+         */
+        virtual void Complete(const boost::system::error_code &err, size_t bytesTransferred) = 0;
+
+    protected:
+        /**
+         * Destructor
+         */
+        ~Op() = default;
+    };
+
+    /**
+     * Pending operation holding the completion handler.
+     *
+     * @tparam Handler Type of the completion handler.
+     * @tparam HasSize True if the handler takes the transferred bytes.
+     */
+    template<typename Handler, bool HasSize> class HandlerOp :public Op
+    {
+    public:
+        /**
+         * Constructor
+         *
+         * @param [in,out] memory The memory block which the operation is allocated from.
+         * @param handler The completion handler.
+         */
+        HandlerOp(HandlerMemory<OpMemorySize> &memory, Handler &&handler) :m_memory(&memory), m_handler(std::move(handler))
+        {
+        }
+
+        virtual void Complete(const boost::system::error_code &err, size_t bytesTransferred) override
+        {
+            HandlerMemory<OpMemorySize> *memory = m_memory;
+            Handler handler(std::move(m_handler));
+            this->~HandlerOp();
+            memory->Deallocate(this);
+            auto executor = boost::asio::get_associated_executor(handler);
+            //the function queued by the executor reuses the memory block of the operation,asio releases it before the upcall.
+            Dispatch(executor, MakeAllocHandler(*memory, [handler = std::move(handler), err, bytesTransferred]() mutable
+                {
+                    Invoke(handler, err, bytesTransferred);
+                }));
+        }
+
+    private:
+        /**
+         * Dispatches a function to the executor of the handler,dispatch runs it inline when the executor allows it(such as the
+         * io_context of the thread pool),a strand or other executor wrapper keeps its guarantees.
+         *
+         * @tparam Executor Type of the executor.
+         * @tparam Function Type of the function.
+         * @param executor The executor.
+         * @param function The function.
+         */
+        template<typename Executor, typename Function> static void Dispatch(const Executor &executor, Function &&function)
+        {
+            if constexpr (std::is_same<Executor, boost::asio::any_io_executor>::value)
+            {
+                //the type erased executor allocates a copy of the function even if it runs inline,the io_context executor of a
+                //coroutine spawned on the thread pool does not(target does not check the type,so target_type is compared).
+                if (executor.target_type() == typeid(boost::asio::io_context::executor_type))
+                {
+                    boost::asio::dispatch(*executor.template target<boost::asio::io_context::executor_type>()
+                        , std::forward<Function>(function));
+                    return;
+                }
+            }
+            boost::asio::dispatch(executor, std::forward<Function>(function));
+        }
+
+        /**
+         * Invokes the completion handler.
+         *
+         * @param [in,out] handler The completion handler.
+         * @param err Result of operation.
+         * @param bytesTransferred Number of bytes transferred.
+         */
+        static void Invoke(Handler &handler, const boost::system::error_code &err, size_t bytesTransferred)
+        {
+            if constexpr (HasSize)
+            {
+                handler(err, bytesTransferred);
+            }
+            else
+            {
+                handler(err);
+            }
+        }
+
+        HandlerMemory<OpMemorySize> *m_memory;  /**< The memory block which the operation is allocated from. */
+
+        Handler m_handler;  /**< The completion handler. */
+    };
+
+    /**
+     * The channel handler which forwards completions to the pending operations.
+     */
+    class Bridge :public IAsyncChannelHandler
+    {
+    public:
+        HandlerMemory<OpMemorySize> m_readMemory;   /**< Memory of read operations. */
+
+        HandlerMemory<OpMemorySize> m_writeMemory;  /**< Memory of write operations. */
+
+        HandlerMemory<OpMemorySize> m_controlMemory;    /**< Memory of open/close operations. */
+
+        Op *m_controlOp{ nullptr }; /**< Pending open/close operation. */
+
+        /**
+         * Creates a pending operation.
+         *
+         * @tparam HasSize True if the handler takes the transferred bytes.
+         * @tparam Handler Type of the completion handler.
+         * @param [in,out] memory The memory block to allocate from.
+         * @param handler The completion handler.
+         *
+         * @return The operation.
+         */
+        template<bool HasSize, typename Handler> Op* MakeOp(HandlerMemory<OpMemorySize> &memory, Handler &&handler)
+        {
+            using OpType = HandlerOp<typename std::decay<Handler>::type, HasSize>;
+            void *ptr = memory.Allocate(sizeof(OpType));
+            return new (ptr) OpType(memory, std::move(handler));
+        }
+
+        virtual void EndOpen(const boost::system::error_code &err) override
+        {
+            CompleteControl(err);
+        }
+
+        virtual void EndRead(const boost::system::error_code &err, std::size_t bytesTransferred, void *ctx) override
+        {
+            static_cast<Op*>(ctx)->Complete(err, bytesTransferred);
+        }
+
+        virtual void EndWrite(const boost::system::error_code &err, std::size_t bytesTransferred, void *ctx) override
+        {
+            static_cast<Op*>(ctx)->Complete(err, bytesTransferred);
+        }
+
+        virtual void EndClose(const boost::system::error_code &err) override
+        {
+            CompleteControl(err);
+        }
+
+    private:
+        /**
+         * Completes the pending open/close operation.
+         *
+         * @param err Result of operation.
+         */
+        void CompleteControl(const boost::system::error_code &err)
+        {
+            Op *op = m_controlOp;
+            m_controlOp = nullptr;
+            op->Complete(err, 0);
+        }
+    };
+
+    IAsyncChannel::ptr_t m_channel; /**< The wrapped channel. */
+
+    std::shared_ptr<Bridge> m_bridge;   /**< Handler passed to the wrapped channel. */
+};
+
+#endif
+
+#endif /* AWAITABLECHANNEL_H */
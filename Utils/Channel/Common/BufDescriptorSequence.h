@@ -0,0 +1,191 @@
+#ifndef BUFDESCRIPTORSEQUENCE_H
+#define BUFDESCRIPTORSEQUENCE_H
+
+#include <iterator>
+#include <boost/asio/buffer.hpp>
+#include "../../Buffer/BufferDescriptor.h"
+
+/**
+ * Adapts an array of @ref BufDescriptor to the asio MutableBufferSequence concept without copying the descriptors.
+ *
+ * @note The array must be alive until the asio operation completes.
+ */
+class BufDescriptorSequence
+{
+public:
+
+    /**
+     * Iterator which yields a boost::asio::mutable_buffer for each descriptor.
+     */
+    class const_iterator
+    {
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+
+        using value_type = boost::asio::mutable_buffer;
+
+        using difference_type = std::ptrdiff_t;
+
+        using pointer = const boost::asio::mutable_buffer*;
+
+        using reference = boost::asio::mutable_buffer;
+
+        /**
+         * Constructor
+         *
+         * @param desc Pointer of the descriptor.
+         */
+        explicit const_iterator(const BufDescriptor *desc) :m_desc(desc)
+        {
+        }
+
+        boost::asio::mutable_buffer operator*() const
+        {
+            return boost::asio::mutable_buffer(m_desc->m_beg, m_desc->m_size);
+        }
+
+        const_iterator& operator++()
+        {
+            ++m_desc;
+            return *this;
+        }
+
+        const_iterator operator++(int)
+        {
+            const_iterator ret(*this);
+            ++m_desc;
+            return ret;
+        }
+
+        const_iterator& operator--()
+        {
+            --m_desc;
+            return *this;
+        }
+
+        const_iterator operator--(int)
+        {
+            const_iterator ret(*this);
+            --m_desc;
+            return ret;
+        }
+
+        bool operator==(const const_iterator &rhs) const
+        {
+            return m_desc == rhs.m_desc;
+        }
+
+        bool operator!=(const const_iterator &rhs) const
+        {
+            return m_desc != rhs.m_desc;
+        }
+
+    private:
+        const BufDescriptor *m_desc;    /**< The descriptor. */
+    };
+
+    using value_type = boost::asio::mutable_buffer;
+
+    /**
+     * Constructor
+     *
+     * @param bufs The descriptor array.
+     * @param bufSize Size of the descriptor array.
+     */
+    BufDescriptorSequence(const BufDescriptor bufs[], size_t bufSize) :m_bufs(bufs), m_bufSize(bufSize)
+    {
+    }
+
+    const_iterator begin() const
+    {
+        return const_iterator(m_bufs);
+    }
+
+    const_iterator end() const
+    {
+        return const_iterator(m_bufs + m_bufSize);
+    }
+
+private:
+    const BufDescriptor *m_bufs;    /**< The descriptor array. */
+
+    size_t m_bufSize;   /**< Size of the descriptor array. */
+};
+
+/**
+ * Copy of a small @ref BufDescriptor array as an asio MutableBufferSequence(stored inline,so it does not allocate and the source
+ * array can be released once the asio operation is started).
+ *
+ * @tparam N Max number of descriptors.
+ */
+template<size_t N> class BufDescriptorArray
+{
+public:
+    using value_type = boost::asio::mutable_buffer;
+
+    using const_iterator = const boost::asio::mutable_buffer*;
+
+    static constexpr size_t Capacity = N;   /**< Max number of descriptors. */
+
+    /**
+     * Constructor
+     *
+     * @param bufs The descriptor array.
+     * @param bufSize Size of the descriptor array(must not be greater than N).
+     */
+    BufDescriptorArray(const BufDescriptor bufs[], size_t bufSize) :m_beg(0), m_count(bufSize)
+    {
+        for (size_t i = 0; i < bufSize; ++i)
+        {
+            m_bufs[i] = boost::asio::mutable_buffer(bufs[i].m_beg, bufs[i].m_size);
+        }
+    }
+
+    const_iterator begin() const
+    {
+        return m_bufs + m_beg;
+    }
+
+    const_iterator end() const
+    {
+        return m_bufs + m_count;
+    }
+
+    /**
+     * Gets the total size of the remaining buffers.
+     *
+     * @return Size in bytes.
+     */
+    size_t Size() const
+    {
+        return boost::asio::buffer_size(*this);
+    }
+
+    /**
+     * Removes bytes from the front of the buffers(the bytes were filled).
+     *
+     * @param size Number of bytes.
+     */
+    void Consume(size_t size)
+    {
+        while (size && m_beg < m_count)
+        {
+            if (size < m_bufs[m_beg].size())
+            {
+                m_bufs[m_beg] += size;
+                return;
+            }
+            size -= m_bufs[m_beg].size();
+            ++m_beg;
+        }
+    }
+
+private:
+    boost::asio::mutable_buffer m_bufs[N];  /**< The buffers. */
+
+    size_t m_beg;   /**< Index of the first remaining buffer. */
+
+    size_t m_count; /**< Number of buffers. */
+};
+
+#endif /* BUFDESCRIPTORSEQUENCE_H */
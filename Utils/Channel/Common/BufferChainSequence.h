@@ -0,0 +1,116 @@
+#ifndef BUFFERCHAINSEQUENCE_H
+#define BUFFERCHAINSEQUENCE_H
+
+#include <iterator>
+#include <boost/asio/buffer.hpp>
+#include "../../Buffer/BufferSlice.h"
+
+/**
+ * Adapts a @ref BufferChain to the asio ConstBufferSequence concept without copying the slices.
+ *
+ * @note The chain must be alive until the asio operation completes.
+ */
+class BufferChainSequence
+{
+public:
+
+    /**
+     * Iterator which yields a boost::asio::const_buffer for each slice.
+     */
+    class const_iterator
+    {
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+
+        using value_type = boost::asio::const_buffer;
+
+        using difference_type = std::ptrdiff_t;
+
+        using pointer = const boost::asio::const_buffer*;
+
+        using reference = boost::asio::const_buffer;
+
+        /**
+         * Constructor
+         *
+         * @param chain The chain.
+         * @param index Index of the slice.
+         */
+        const_iterator(const BufferChain *chain, size_t index) :m_chain(chain), m_index(index)
+        {
+        }
+
+        boost::asio::const_buffer operator*() const
+        {
+            const BufferSlice &slice = (*m_chain)[m_index];
+            return boost::asio::const_buffer(slice.Data(), slice.Size());
+        }
+
+        const_iterator& operator++()
+        {
+            ++m_index;
+            return *this;
+        }
+
+        const_iterator operator++(int)
+        {
+            const_iterator ret(*this);
+            ++m_index;
+            return ret;
+        }
+
+        const_iterator& operator--()
+        {
+            --m_index;
+            return *this;
+        }
+
+        const_iterator operator--(int)
+        {
+            const_iterator ret(*this);
+            --m_index;
+            return ret;
+        }
+
+        bool operator==(const const_iterator &rhs) const
+        {
+            return m_index == rhs.m_index;
+        }
+
+        bool operator!=(const const_iterator &rhs) const
+        {
+            return m_index != rhs.m_index;
+        }
+
+    private:
+        const BufferChain *m_chain; /**< The chain. */
+
+        size_t m_index; /**< Index of the slice. */
+    };
+
+    using value_type = boost::asio::const_buffer;
+
+    /**
+     * Constructor
+     *
+     * @param chain The chain.
+     */
+    explicit BufferChainSequence(const BufferChain &chain) :m_chain(&chain)
+    {
+    }
+
+    const_iterator begin() const
+    {
+        return const_iterator(m_chain, 0);
+    }
+
+    const_iterator end() const
+    {
+        return const_iterator(m_chain, m_chain->SliceCount());
+    }
+
+private:
+    const BufferChain *m_chain; /**< The chain. */
+};
+
+#endif /* BUFFERCHAINSEQUENCE_H */
@@ -0,0 +1,233 @@
+#ifndef HANDLERALLOCATOR_H
+#define HANDLERALLOCATOR_H
+
+#include <atomic>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+/**
+ * Memory block reused by asio operations which never overlap(such as the chained writes of a channel).
+ *
+ * A request which is too large or arrives while the block is in use(also from another thread,the block is claimed atomically) falls
+ * back to the global operator new.
+ *
+ * @tparam Size Size of the memory block.
+ */
+template<size_t Size> class HandlerMemory
+{
+public:
+
+    /**
+     * Default constructor
+     */
+    HandlerMemory() :m_inUse(false)
+    {
+    }
+
+    HandlerMemory(const HandlerMemory&) = delete;
+
+    HandlerMemory& operator=(const HandlerMemory&) = delete;
+
+    /**
+     * Allocates memory.
+     *
+     * @param size Required size.
+     *
+     * @return Allocated memory.
+     */
+    void* Allocate(size_t size)
+    {
+        if (size <= Size && !m_inUse.exchange(true, std::memory_order_acquire))
+        {
+            return &m_storage;
+        }
+        return ::operator new(size);
+    }
+
+    /**
+     * Deallocates memory.
+     *
+     * @param ptr Memory returned by @ref Allocate.
+     */
+    void Deallocate(void *ptr)
+    {
+        if (ptr == &m_storage)
+        {
+            m_inUse.store(false, std::memory_order_release);
+        }
+        else
+        {
+            ::operator delete(ptr);
+        }
+    }
+
+private:
+    typename std::aligned_storage<Size>::type m_storage;    /**< The memory block. */
+
+    std::atomic<bool> m_inUse;  /**< True if the memory block is in use. */
+};
+
+/**
+ * Allocator adapter of @ref HandlerMemory(used as the associated allocator of asio handlers).
+ *
+ * @tparam T Value type.
+ * @tparam Size Size of the memory block.
+ */
+template<typename T, size_t Size> class HandlerAllocator
+{
+public:
+    template<typename, size_t> friend class HandlerAllocator;
+
+    /**
+     * Defines an alias representing type of the value.
+     */
+    using value_type = T;
+
+    /**
+     * Rebinds the allocator to another value type.
+     *
+     * @tparam U Another value type.
+     */
+    template<typename U> struct rebind
+    {
+        using other = HandlerAllocator<U, Size>;
+    };
+
+    /**
+     * Constructor
+     *
+     * @param [in,out] memory The memory block.
+     */
+    explicit HandlerAllocator(HandlerMemory<Size> &memory) noexcept :m_memory(&memory)
+    {
+    }
+
+    /**
+     * Converting constructor
+     *
+     * @param other Allocator of another value type.
+     */
+    template<typename U> HandlerAllocator(const HandlerAllocator<U, Size> &other) noexcept :m_memory(other.m_memory)
+    {
+    }
+
+    /**
+     * Allocates memory for n objects.
+     *
+     * @param n Number of objects.
+     *
+     * @return Allocated memory.
+     */
+    T* allocate(size_t n)
+    {
+        return static_cast<T*>(m_memory->Allocate(sizeof(T) * n));
+    }
+
+    /**
+     * Deallocates memory.
+     *
+     * @param ptr Memory returned by @ref allocate.
+     */
+    void deallocate(T *ptr, size_t /*n*/)
+    {
+        m_memory->Deallocate(ptr);
+    }
+
+    /**
+     * Equality operator
+     *
+     * @param other Another allocator.
+     *
+     * @return True if both use the same memory block.
+     */
+    template<typename U> bool operator==(const HandlerAllocator<U, Size> &other) const noexcept
+    {
+        return m_memory == other.m_memory;
+    }
+
+    /**
+     * Inequality operator
+     *
+     * @param other Another allocator.
+     *
+     * @return True if the memory blocks are different.
+     */
+    template<typename U> bool operator!=(const HandlerAllocator<U, Size> &other) const noexcept
+    {
+        return m_memory != other.m_memory;
+    }
+
+private:
+    HandlerMemory<Size> *m_memory;  /**< The memory block. */
+};
+
+/**
+ * Wraps an asio handler so the operation memory is allocated from a @ref HandlerMemory.
+ *
+ * @tparam Handler Type of the wrapped handler.
+ * @tparam Size Size of the memory block.
+ */
+template<typename Handler, size_t Size> class AllocHandler
+{
+public:
+
+    /**
+     * Defines an alias representing type of the associated allocator.
+     */
+    using allocator_type = HandlerAllocator<Handler, Size>;
+
+    /**
+     * Constructor
+     *
+     * @param [in,out] memory The memory block.
+     * @param handler The wrapped handler.
+     */
+    AllocHandler(HandlerMemory<Size> &memory, Handler handler) :m_memory(&memory), m_handler(std::move(handler))
+    {
+    }
+
+    /**
+     * Gets the associated allocator.
+     *
+     * @return The allocator.
+     */
+    allocator_type get_allocator() const noexcept
+    {
+        return allocator_type(*m_memory);
+    }
+
+    /**
+     * Invokes the wrapped handler.
+     *
+     * @tparam Args Type of the arguments.
+     * @param args The arguments.
+     */
+    template<typename... Args> void operator()(Args&&... args)
+    {
+        m_handler(std::forward<Args>(args)...);
+    }
+
+private:
+    HandlerMemory<Size> *m_memory;  /**< The memory block. */
+
+    Handler m_handler;  /**< The wrapped handler. */
+};
+
+/**
+ * Makes an @ref AllocHandler.
+ *
+ * @tparam Handler Type of the wrapped handler.
+ * @tparam Size Size of the memory block.
+ * @param [in,out] memory The memory block.
+ * @param handler The wrapped handler.
+ *
+ * @return The handler.
+ */
+template<typename Handler, size_t Size> AllocHandler<typename std::decay<Handler>::type, Size> MakeAllocHandler(HandlerMemory<Size> &memory
+    , Handler &&handler)
+{
+    return AllocHandler<typename std::decay<Handler>::type, Size>(memory, std::forward<Handler>(handler));
+}
+
+#endif /* HANDLERALLOCATOR_H */
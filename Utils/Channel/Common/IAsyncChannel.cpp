@@ -1,7 +1,14 @@
 #include "IAsyncChannel.h"
 
+constexpr size_t IAsyncChannel::InlineWriteCapacity;
+
 IAsyncChannel::IAsyncChannel() = default;
 
 IAsyncChannel::~IAsyncChannel()
 {
-}
\ No newline at end of file
+}
+
+void IAsyncChannel::AsyncReadAvailable(BufDescriptor bufs[], size_t bufSize, const IAsyncChannelHandler::ptr_t &handler, void *ctx)
+{
+    AsyncReadSome(bufs, bufSize, handler, ctx);
+}
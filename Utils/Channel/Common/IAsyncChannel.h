@@ -2,9 +2,13 @@
 #define IASYNCCHANNEL_H
 
 #include <memory>
+#include <cassert>
 #include "IAsyncChannelHandler.h"
+#include "WriteQueueSettings.h"
 #include "../../Buffer/BufferDescriptor.h"
 #include "../../Buffer/LinearBuffer.h"
+#include "../../Buffer/InlineLinearBuffer.h"
+#include "../../Buffer/BufferSlice.h"
 
 /**
  * The interface of asynchronous communication channels.
@@ -17,6 +21,8 @@ public:
      */
     using ptr_t = std::shared_ptr<IAsyncChannel>;
 
+    static constexpr size_t InlineWriteCapacity = 64;   /**< Max size of data copied into the write request without heap allocation. */
+
     /**
      * Default constructor.
      */
@@ -46,6 +52,20 @@ public:
      */
     virtual void AsyncReadSome(BufDescriptor bufs[], size_t bufSize, const IAsyncChannelHandler::ptr_t &handler, void *ctx = nullptr) = 0;
 
+    /**
+     * Start an asynchronous read operation which keeps reading until the buffers are full or no more data is available(the handler
+     * is called once with the total bytes),all operation error will reportted in the callback handler.
+     *
+     * @param bufs The read buf array(such as the free space of a CircularBuffer,see CircularBuffer::free_buffers).
+     * @param bufSize Size of the read buf array.
+     * @param handler The handler to be called when the read operation completes.
+     * @param ctx (Optional) user defined context data.
+     *
+     * @note The operation waits until some data arrives like @ref AsyncReadSome.An error found after some data was read is reported by
+     * the next read.The default implementation is same as @ref AsyncReadSome.
+     */
+    virtual void AsyncReadAvailable(BufDescriptor bufs[], size_t bufSize, const IAsyncChannelHandler::ptr_t &handler, void *ctx = nullptr);
+
     /**
      * Start an asynchronous write operation on the communication channel,all operation error will reportted in the callback handler.
      *
@@ -56,11 +76,71 @@ public:
      * @param [in,out] ctx (Optional) user defined context data.
      * 
      * @note The write operation will write all of the requested number of bytes(or an error occurred) before call the handler. This function support
-     * multiple calls before previous operation finished(following request will be queued).
+     * multiple calls before previous operation finished(following request will be queued,see @ref SetWriteQueueSettings).A request dropped by
+     * the write queue policy is completed with boost::asio::error::no_buffer_space.
      */
     virtual void AsyncWrite(const std::shared_ptr<LinearBuffer> &buf, size_t sendOffset, size_t sendLen
         , const IAsyncChannelHandler::ptr_t &handler, void *ctx = nullptr) = 0;
 
+    /**
+     * Start an asynchronous write operation of a slice chain(scatter write),all operation error will reportted in the callback handler.
+     *
+     * @param chain The slices to be writen(in order,the slices are referenced until the operation completes).
+     * @param handler The handler to be called when the write operation completes.
+     * @param [in,out] ctx (Optional) user defined context data.
+     *
+     * @note No data is copied,so one shared body can be sent to many channels with a different header for each one.The other
+     * behaviors are same as @ref AsyncWrite.
+     */
+    virtual void AsyncWrite(const BufferChain &chain, const IAsyncChannelHandler::ptr_t &handler, void *ctx = nullptr) = 0;
+
+    /**
+     * Start an asynchronous write operation which copies the data into the write request,all operation error will reportted in the
+     * callback handler.
+     *
+     * @param data The data to be writen(can be released after this function returned).
+     * @param sendLen Byte count to be writen.
+     * @param handler The handler to be called when the write operation completes.
+     * @param [in,out] ctx (Optional) user defined context data.
+     *
+     * @note Small data(not greater than @ref InlineWriteCapacity bytes) is copied into the write request without heap allocation.
+     * The other behaviors are same as @ref AsyncWrite.
+     */
+    virtual void AsyncWriteCopy(const void *data, size_t sendLen, const IAsyncChannelHandler::ptr_t &handler, void *ctx = nullptr) = 0;
+
+    /**
+     * Start an asynchronous write operation of an inline buffer(the content is copied,see @ref AsyncWriteCopy).
+     *
+     * @tparam N Capacity of the buffer.
+     * @param buf The write buffer.
+     * @param sendOffset Offset of buffer to be writen.
+     * @param sendLen Byte count to be writen.
+     * @param handler The handler to be called when the write operation completes.
+     * @param [in,out] ctx (Optional) user defined context data.
+     */
+    template<size_t N> void AsyncWrite(const InlineLinearBuffer<N> &buf, size_t sendOffset, size_t sendLen
+        , const IAsyncChannelHandler::ptr_t &handler, void *ctx = nullptr)
+    {
+        assert(sendOffset + sendLen <= buf.size());
+        AsyncWriteCopy(buf.data() + sendOffset, sendLen, handler, ctx);
+    }
+
+    /**
+     * Sets the write queue settings(the default settings are unlimited).
+     *
+     * @param settings The settings.
+     *
+     * @note The new settings take effect on following write requests.
+     */
+    virtual void SetWriteQueueSettings(const WriteQueueSettings &settings) = 0;
+
+    /**
+     * Gets runtime status of the write queue.
+     *
+     * @return The status.
+     */
+    virtual WriteQueueStatus GetWriteQueueStatus() = 0;
+
     /**
      * Start an asynchronous close operation on the communication channel,all operation error will reportted in the callback handler.
      *
@@ -4,4 +4,12 @@ IAsyncChannelHandler::IAsyncChannelHandler() = default;
 
 IAsyncChannelHandler::~IAsyncChannelHandler()
 {
+}
+
+void IAsyncChannelHandler::HighWatermarkReached(std::size_t queuedBytes, std::size_t queuedCount)
+{
+}
+
+void IAsyncChannelHandler::LowWatermarkReached(std::size_t queuedBytes, std::size_t queuedCount)
+{
 }
\ No newline at end of file
@@ -59,6 +59,29 @@ public:
      * @param err Result of operation.
      */
     virtual void EndClose(const boost::system::error_code &err) = 0;
+
+    /**
+     * The handler to be called when the write queue of the channel reaches its high watermark(the default implementation does nothing).
+     *
+     * @param queuedBytes Queued bytes of the channel.
+     * @param queuedCount Queued write requests of the channel.
+     *
+     * @note Called by the handler whose write request reaches the watermark,usually inside IAsyncChannel::AsyncWrite(so do not hold a
+     * lock which is required by the callback while writing).Producers should pause until @ref LowWatermarkReached is called.The
+     * notifications of a channel are never concurrent and always alternate,a state change during a notification is delivered by the
+     * thread of that notification after it returns.
+     */
+    virtual void HighWatermarkReached(std::size_t queuedBytes, std::size_t queuedCount);
+
+    /**
+     * The handler to be called when the write queue of the channel drops to its low watermark(the default implementation does nothing).
+     *
+     * @param queuedBytes Queued bytes of the channel.
+     * @param queuedCount Queued write requests of the channel.
+     *
+     * @note Called on the handler which got @ref HighWatermarkReached,after a write request completes.
+     */
+    virtual void LowWatermarkReached(std::size_t queuedBytes, std::size_t queuedCount);
 };
 
 #endif /* IASYNCCHANNELHANDLER_H */
\ No newline at end of file
@@ -0,0 +1,139 @@
+#ifndef STATICSTREAMCHANNEL_H
+#define STATICSTREAMCHANNEL_H
+
+#include <memory>
+#include <boost/system/error_code.hpp>
+#include "HandlerAllocator.h"
+#include "../../Buffer/BufferDescriptor.h"
+#include "../../Buffer/LinearBuffer.h"
+#include "../../Concurrent/SpinLock.h"
+
+/**
+ * Stream channel whose completion handler is bound at compile time(CRTP),the derived class implements:
+ *
+ * @code
+ * void EndRead(const boost::system::error_code &err, std::size_t bytesTransferred);
+ * void EndWrite(const boost::system::error_code &err, std::size_t bytesTransferred);
+ * @endcode
+ *
+ * Compared with @ref IAsyncChannel there is no virtual call and no shared_ptr copy per operation,and the asio operations are
+ * allocated from memory blocks owned by the channel.Small writes are copied into a write buffer,the data written while a write is
+ * in progress is coalesced and sent by the next write,so @ref EndWrite is called once per sent batch.
+ *
+ * @tparam StreamTraits Traits of the socket stream(TcpV4Traits,TcpV6Traits or UnixStreamTraits).
+ * @tparam Derived Type of the derived class.
+ *
+ * @note The channel does not keep itself alive,the derived object must not be destroyed while an operation is pending(close the
+ * channel and wait for the completions,which are reported with boost::asio::error::operation_aborted).Include
+ * StaticStreamChannel.hpp to instantiate it.
+ */
+template<typename StreamTraits, typename Derived> class StaticStreamChannel
+{
+public:
+
+    /**
+     * Defines an alias representing type of the stream.
+     */
+    using StreamType = typename StreamTraits::StreamType;
+
+    /**
+     * Constructor
+     *
+     * @param stream The connected stream.
+     * @param writeBufferCapacity (Optional) Initial capacity of the write buffers(they grow when required).
+     */
+    explicit StaticStreamChannel(const std::shared_ptr<StreamType> &stream, size_t writeBufferCapacity = 4096);
+
+    StaticStreamChannel(const StaticStreamChannel&) = delete;
+
+    StaticStreamChannel& operator=(const StaticStreamChannel&) = delete;
+
+    /**
+     * Starts an asynchronous read operation,the derived EndRead is called when it completes.
+     *
+     * @param buf The read buffer.
+     * @param size Size of the read buffer.
+     */
+    void AsyncReadSome(void *buf, size_t size);
+
+    /**
+     * Starts an asynchronous scatter read operation,the derived EndRead is called when it completes.
+     *
+     * @param bufs The read buf array(must be alive until the operation completes).
+     * @param bufSize Size of the read buf array.
+     */
+    void AsyncReadSome(const BufDescriptor bufs[], size_t bufSize);
+
+    /**
+     * Copies data into the write buffer and starts writing if the channel is idle,the derived EndWrite is called when the batch
+     * containing the data is sent.
+     *
+     * @param data The data to be writen(can be released after this function returned).
+     * @param sendLen Byte count to be writen.
+     */
+    void AsyncWriteCopy(const void *data, size_t sendLen);
+
+    /**
+     * Gets the number of bytes waiting to be sent(including the batch in progress).
+     *
+     * @return Queued bytes.
+     */
+    size_t QueuedBytes();
+
+    /**
+     * Shuts down and closes the stream,the pending operations complete with boost::asio::error::operation_aborted.
+     *
+     * @param [out] shutdownErr The shutdown error.
+     * @param [out] closeErr The close error.
+     */
+    void Close(boost::system::error_code &shutdownErr, boost::system::error_code &closeErr);
+
+    /**
+     * Gets the stream.
+     *
+     * @return The stream.
+     */
+    const std::shared_ptr<StreamType>& Stream() const
+    {
+        return m_stream;
+    }
+
+protected:
+
+    /**
+     * Destructor(closes the stream if it is still open).
+     */
+    ~StaticStreamChannel();
+
+private:
+    static constexpr size_t HandlerMemorySize = 256;    /**< Size of the operation memory block of reads and writes. */
+
+    std::shared_ptr<StreamType> m_stream;   /**< The stream. */
+
+    SpinLock<> m_lock;  /**< Internal spin lock used for thread safe. */
+
+    LinearBuffer m_writingBuf;  /**< The batch being sent. */
+
+    LinearBuffer m_pendingBuf;  /**< Data written while a batch is being sent. */
+
+    bool m_writing; /**< True if a batch is being sent. */
+
+    HandlerMemory<HandlerMemorySize> m_readHandlerMemory;   /**< Operation memory of the read in progress. */
+
+    HandlerMemory<HandlerMemorySize> m_writeHandlerMemory;  /**< Operation memory of the write in progress. */
+
+    /**
+     * Sends m_writingBuf(called with m_lock held).
+     */
+    void StartWrite();
+
+    /**
+     * The write operation callback handler for internal use.
+     *
+     * @param err Result of operation.
+     * @param bytesTransferred Number of bytes written.
+     */
+    void FinishWrite(const boost::system::error_code &err, std::size_t bytesTransferred);
+};
+
+#endif /* STATICSTREAMCHANNEL_H */
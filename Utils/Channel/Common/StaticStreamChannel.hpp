@@ -0,0 +1,108 @@
+#ifndef STATICSTREAMCHANNELIMPL_H
+#define STATICSTREAMCHANNELIMPL_H
+
+#include "StaticStreamChannel.h"
+#include <boost/asio.hpp>
+#include "BufDescriptorSequence.h"
+
+template<typename StreamTraits, typename Derived> StaticStreamChannel<StreamTraits, Derived>::StaticStreamChannel(
+    const std::shared_ptr<StreamType> &stream, size_t writeBufferCapacity) :m_stream(stream), m_lock(), m_writingBuf(writeBufferCapacity)
+    , m_pendingBuf(writeBufferCapacity), m_writing(false), m_readHandlerMemory(), m_writeHandlerMemory()
+{
+    m_writingBuf.set_growable(true);
+    m_pendingBuf.set_growable(true);
+}
+
+template<typename StreamTraits, typename Derived> StaticStreamChannel<StreamTraits, Derived>::~StaticStreamChannel()
+{
+    boost::system::error_code shutdownErr, closeErr;
+    Close(shutdownErr, closeErr);
+}
+
+template<typename StreamTraits, typename Derived> void StaticStreamChannel<StreamTraits, Derived>::AsyncReadSome(void *buf, size_t size)
+{
+    SpinLock<>::ScopeLock lock(m_lock);
+    m_stream->async_read_some(boost::asio::buffer(buf, size), MakeAllocHandler(m_readHandlerMemory
+        , [this](const boost::system::error_code &err, std::size_t bytesTransferred)
+        {
+            static_cast<Derived*>(this)->EndRead(err, bytesTransferred);
+        }));
+}
+
+template<typename StreamTraits, typename Derived> void StaticStreamChannel<StreamTraits, Derived>::AsyncReadSome(const BufDescriptor bufs[]
+    , size_t bufSize)
+{
+    SpinLock<>::ScopeLock lock(m_lock);
+    m_stream->async_read_some(BufDescriptorSequence(bufs, bufSize), MakeAllocHandler(m_readHandlerMemory
+        , [this](const boost::system::error_code &err, std::size_t bytesTransferred)
+        {
+            static_cast<Derived*>(this)->EndRead(err, bytesTransferred);
+        }));
+}
+
+template<typename StreamTraits, typename Derived> void StaticStreamChannel<StreamTraits, Derived>::AsyncWriteCopy(const void *data
+    , size_t sendLen)
+{
+    SpinLock<>::ScopeLock lock(m_lock);
+    if (m_writing)
+    {
+        m_pendingBuf.append(data, sendLen);
+    }
+    else
+    {
+        m_writingBuf.append(data, sendLen);
+        m_writing = true;
+        StartWrite();
+    }
+}
+
+template<typename StreamTraits, typename Derived> size_t StaticStreamChannel<StreamTraits, Derived>::QueuedBytes()
+{
+    SpinLock<>::ScopeLock lock(m_lock);
+    return m_writingBuf.size() + m_pendingBuf.size();
+}
+
+template<typename StreamTraits, typename Derived> void StaticStreamChannel<StreamTraits, Derived>::Close(boost::system::error_code &shutdownErr
+    , boost::system::error_code &closeErr)
+{
+    SpinLock<>::ScopeLock lock(m_lock);
+    if (m_stream->is_open())
+    {
+        m_stream->shutdown(boost::asio::socket_base::shutdown_both, shutdownErr);
+        m_stream->close(closeErr);
+    }
+}
+
+template<typename StreamTraits, typename Derived> void StaticStreamChannel<StreamTraits, Derived>::StartWrite()
+{
+    boost::asio::async_write(*m_stream, boost::asio::buffer(m_writingBuf.data(), m_writingBuf.size()), MakeAllocHandler(m_writeHandlerMemory
+        , [this](const boost::system::error_code &err, std::size_t bytesTransferred)
+        {
+            FinishWrite(err, bytesTransferred);
+        }));
+}
+
+template<typename StreamTraits, typename Derived> void StaticStreamChannel<StreamTraits, Derived>::FinishWrite(
+    const boost::system::error_code &err, std::size_t bytesTransferred)
+{
+    {
+        SpinLock<>::ScopeLock lock(m_lock);
+        m_writingBuf.clear();
+        if (err)
+        {
+            m_pendingBuf.clear();
+        }
+        if (m_pendingBuf.empty())
+        {
+            m_writing = false;
+        }
+        else
+        {
+            m_writingBuf.swap(m_pendingBuf);
+            StartWrite();
+        }
+    }
+    static_cast<Derived*>(this)->EndWrite(err, bytesTransferred);
+}
+
+#endif /* STATICSTREAMCHANNELIMPL_H */
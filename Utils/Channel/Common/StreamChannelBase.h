@@ -3,7 +3,12 @@
 
 #include "../../Log/Log4cplusCustomInc.h"
 #include "IAsyncChannel.h"
+#include "HandlerAllocator.h"
+#include "BufDescriptorSequence.h"
 #include "../../Concurrent/SpinLock.h"
+#ifdef USE_IO_URING_CHANNEL
+#include "../Uring/IoUringStream.h"
+#endif
 
 /**
 * The base class of stream based channel.
@@ -28,12 +33,42 @@ public:
     */
     virtual void AsyncReadSome(BufDescriptor bufs[], size_t bufSize, const IAsyncChannelHandler::ptr_t &handler, void *ctx) override;
 
+    /**
+     * {@inheritDoc}
+     *
+     * @note Socket streams read in non-blocking mode after the first read completes until the socket would block,other streams behave
+     * like @ref AsyncReadSome.
+     */
+    virtual void AsyncReadAvailable(BufDescriptor bufs[], size_t bufSize, const IAsyncChannelHandler::ptr_t &handler, void *ctx) override;
+
     /**
      * {@inheritDoc}
      */
     virtual void AsyncWrite(const std::shared_ptr<LinearBuffer> &buf, size_t sendOffset, size_t sendLen
         , const IAsyncChannelHandler::ptr_t &handler, void *ctx) override;
 
+    /**
+     * {@inheritDoc}
+     */
+    virtual void AsyncWrite(const BufferChain &chain, const IAsyncChannelHandler::ptr_t &handler, void *ctx) override;
+
+    using IAsyncChannel::AsyncWrite;
+
+    /**
+     * {@inheritDoc}
+     */
+    virtual void AsyncWriteCopy(const void *data, size_t sendLen, const IAsyncChannelHandler::ptr_t &handler, void *ctx) override;
+
+    /**
+     * {@inheritDoc}
+     */
+    virtual void SetWriteQueueSettings(const WriteQueueSettings &settings) override;
+
+    /**
+     * {@inheritDoc}
+     */
+    virtual WriteQueueStatus GetWriteQueueStatus() override;
+
 protected:
     std::shared_ptr<typename StreamTraits::StreamType> m_stream;	/**< Pointer of underlying stream implementation. */
 
@@ -41,7 +76,20 @@ protected:
 
     static log4cplus::Logger log;   /**< The logger */
 
+    /**
+     * Cancels the io_uring operations of the stream and detaches it(must be called before the stream is closed,the next I/O
+     * attaches the reopened stream,called with m_lock held).Does nothing if the io_uring backend is not used.
+     */
+    void DetachIoUring();
+
 private:
+    static constexpr size_t InlineReadBufCount = 4; /**< Max number of read buffers passed to asio without heap allocation. */
+
+    /**
+     * Defines an alias representing the read buffer sequence stored in the asio operation.
+     */
+    using ReadBufArray = BufDescriptorArray<InlineReadBufCount>;
+
     /**
      * A write request.
      */
@@ -49,7 +97,9 @@ private:
     {
         IAsyncChannelHandler::ptr_t m_handler;  /**< Request's callback handler. */
 
-        std::shared_ptr<LinearBuffer> m_buf;	/**< Request's write buffer. */
+        std::shared_ptr<LinearBuffer> m_buf;	/**< Request's write buffer(null when the data is copied into m_inlineData or held by m_chain). */
+
+        BufferChain m_chain;    /**< Request's write slices(empty unless written by the chain overload of @ref AsyncWrite). */
 
         size_t m_sendOffset;	/**< Offset of buffer to be writen. */
 
@@ -58,8 +108,133 @@ private:
         void *m_ctx;	/**< Request's user defined context data. */
 
         std::unique_ptr<WrReq> m_next;  /**< Next write request(used as a linked list). */
+
+        us8 m_inlineData[InlineWriteCapacity];  /**< Copied data of @ref AsyncWriteCopy. */
+
+        /**
+         * Gets the begin pointer of the data to be writen.
+         *
+         * @return Data pointer.
+         */
+        const us8* Data() const
+        {
+            return m_buf ? m_buf->data() + m_sendOffset : m_inlineData + m_sendOffset;
+        }
     } *m_lastWrReq; /**< Last write request in this channel's write linked list. */
 
+    WrReq *m_curWrReq;  /**< The write request in progress(first one in the write linked list). */
+
+    static constexpr size_t MaxFreeWrReqCount = 8;  /**< Max number of recycled write requests kept by a channel. */
+
+    std::unique_ptr<WrReq> m_freeWrReqs;    /**< Recycled write requests(used as a linked list). */
+
+    size_t m_freeWrReqCount;    /**< Number of recycled write requests. */
+
+    HandlerMemory<256> m_writeHandlerMemory;    /**< Operation memory of the write in progress(writes are chained,never overlapped). */
+
+    WriteQueueSettings m_wrQueueSettings;   /**< Write queue settings. */
+
+    WriteQueueStatus m_wrQueueStatus;   /**< Write queue status. */
+
+    IAsyncChannelHandler::ptr_t m_watermarkHandler; /**< Handler whose write request reached the high watermark last. */
+
+    IAsyncChannelHandler::ptr_t m_notifiedHandler;  /**< Handler which got the last high watermark notification. */
+
+    bool m_watermarkNotified;   /**< Watermark state last delivered to the handlers(true if above the high watermark). */
+
+    bool m_watermarkDelivering; /**< True if a thread is delivering the watermark notifications. */
+#ifdef USE_IO_URING_CHANNEL
+    std::shared_ptr<IoUringStream> m_uringStream;   /**< The io_uring I/O of the stream(null if the reactor is used). */
+
+    bool m_uringProbed; /**< True if the stream was checked for the io_uring backend. */
+
+    std::unique_ptr<WrReq> m_uringWrReq;    /**< The write request in progress on the io_uring backend. */
+
+    /**
+     * Attaches the stream to the io_uring backend on first use(called with m_lock held).
+     *
+     * @return The io_uring I/O of the stream,null if the backend is disabled or not available for this stream.
+     */
+    std::shared_ptr<IoUringStream> AttachIoUring();
+#endif
+
+    /**
+     * Reads the data which is available without blocking into the remaining buffers(called after the first read of
+     * @ref AsyncReadAvailable completes,a single non-blocking receive made without m_lock held,the socket mode is not changed).
+     *
+     * @param [in,out] bufs The read buffers.
+     * @param filled Number of bytes filled by the first read.
+     *
+     * @return Number of bytes read by this function.
+     */
+    size_t ReadAvailable(ReadBufArray &bufs, size_t filled);
+
+    /**
+     * Applies the write queue policy and queues a write request.
+     *
+     * @tparam Func Type of the request fill function.
+     * @param sendLen Byte count to be writen.
+     * @param handler The handler to be called when the write operation completes.
+     * @param ctx User defined context data.
+     * @param fillFunc Function which fills the data fields(m_buf,m_chain,m_inlineData,m_sendOffset) of the request(called with m_lock held).
+     */
+    template<typename Func> void Write(size_t sendLen, const IAsyncChannelHandler::ptr_t &handler, void *ctx, Func fillFunc);
+
+    /**
+     * Query if queueing the specific number of bytes exceeds the high watermark(called with m_lock held).
+     *
+     * @param sendLen Byte count to be queued.
+     *
+     * @return True if exceeds.
+     */
+    bool ExceedHighWatermark(size_t sendLen) const;
+
+    /**
+     * Drops the oldest queued write request which is not in progress(called with m_lock held).
+     *
+     * @return False if there is no request to drop.
+     */
+    bool DropOldestWrReq();
+
+    /**
+     * Completes a dropped write request with boost::asio::error::no_buffer_space asynchronously.
+     *
+     * @param handler The handler of the request.
+     * @param sendLen Byte count of the request.
+     * @param ctx User defined context data of the request.
+     */
+    void PostDropped(IAsyncChannelHandler::ptr_t handler, size_t sendLen, void *ctx);
+
+    /**
+     * Gets a recycled write request or allocates a new one(called with m_lock held).
+     *
+     * @return The write request.
+     */
+    std::unique_ptr<WrReq> AllocWrReq();
+
+    /**
+     * Recycles a finished write request(called with m_lock held).
+     *
+     * @param [in,out] wrReq The write request.
+     */
+    void FreeWrReq(std::unique_ptr<WrReq> &wrReq);
+
+    /**
+     * Appends a write request to the write linked list and starts writing if the channel is idle(called with m_lock held).
+     *
+     * @param [in,out] wrReq The write request.
+     *
+     * @return True if the high watermark is reached by this request.
+     */
+    bool QueueWrReq(std::unique_ptr<WrReq> &wrReq);
+
+    /**
+     * Starts the write operation of a request(called with m_lock held).
+     *
+     * @param [in,out] wrReq The write request.
+     */
+    void StartWrite(std::unique_ptr<WrReq> &wrReq);
+
     /**
      * The write operation callback handler for internal use.
      *
@@ -68,6 +243,13 @@ private:
      * @param bytesTransferred Number of bytes written from the wrReq.
      */
     void EndWrite(std::unique_ptr<WrReq> &wrReq, const boost::system::error_code &err, std::size_t bytesTransferred);
+
+    /**
+     * Delivers the watermark notifications until the delivered state matches the queue state(called after the state changes,without
+     * m_lock held).Only one thread delivers at a time,a state change during the delivery is picked up by the delivering thread,so the
+     * notifications are never concurrent and always alternate between high and low.
+     */
+    void DeliverWatermark();
 };
 
 #endif /* STREAMCHANNELBASE_H */
\ No newline at end of file
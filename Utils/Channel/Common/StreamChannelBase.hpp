@@ -3,19 +3,55 @@
 
 #include "StreamChannelBase.h"
 #include <boost/asio.hpp>
+#include "../../Common/RunTimeLibraryHelper.h"
+#include "BufferChainSequence.h"
+#ifndef _WIN32
+#include <sys/socket.h>
+#include <sys/uio.h>
+#endif
+#ifdef USE_IO_URING_CHANNEL
+#include "../../Concurrent/ThreadPool.h"
+#endif
 
 template<typename StreamTraits, const char *LoggerName> log4cplus::Logger StreamChannelBase<StreamTraits, LoggerName>::log 
     = log4cplus::Logger::getInstance(LoggerName);
 
 template<typename StreamTraits, const char *LoggerName> StreamChannelBase<StreamTraits, LoggerName>::StreamChannelBase(
     const std::shared_ptr<typename StreamTraits::StreamType> &stream) :std::enable_shared_from_this<StreamChannelBase<StreamTraits, LoggerName>>(), m_stream(stream)
-    , m_lock(), m_lastWrReq(nullptr)
+    , m_lock(), m_lastWrReq(nullptr), m_curWrReq(nullptr), m_freeWrReqs(), m_freeWrReqCount(0), m_writeHandlerMemory()
+    , m_wrQueueSettings{ 0, 0, 0, 0, WriteQueuePolicy::Backpressure }, m_wrQueueStatus{ 0, 0, 0, 0, false }, m_watermarkHandler()
+    , m_notifiedHandler(), m_watermarkNotified(false), m_watermarkDelivering(false)
+#ifdef USE_IO_URING_CHANNEL
+    , m_uringStream(), m_uringProbed(false), m_uringWrReq()
+#endif
 {
 }
 
 template<typename StreamTraits, const char *LoggerName> void StreamChannelBase<StreamTraits, LoggerName>::AsyncReadSome(
     BufDescriptor bufs[], size_t bufSize, const IAsyncChannelHandler::ptr_t &handler, void *ctx)
 {
+#ifdef USE_IO_URING_CHANNEL
+    std::shared_ptr<IoUringStream> uringStream;
+    {
+        SpinLock<>::ScopeLock lock(m_lock);
+        uringStream = AttachIoUring();
+    }
+    if (uringStream)
+    {
+        uringStream->AsyncReadSome(bufs, bufSize, handler, ctx);
+        return;
+    }
+#endif
+    auto completion = [handler = handler, ctx = ctx](const boost::system::error_code &err, std::size_t bytesTransferred)
+        {
+            handler->EndRead(err, bytesTransferred, ctx);
+        };
+    if (bufSize <= InlineReadBufCount)
+    {
+        SpinLock<>::ScopeLock lock(m_lock);
+        m_stream->async_read_some(ReadBufArray(bufs, bufSize), std::move(completion));
+        return;
+    }
     std::vector<boost::asio::mutable_buffer> bufSeq;
     bufSeq.reserve(bufSize);
     for (size_t i = 0; i < bufSize; ++i)
@@ -23,56 +59,450 @@ template<typename StreamTraits, const char *LoggerName> void StreamChannelBase<S
         bufSeq.push_back(boost::asio::buffer(bufs[i].m_beg, bufs[i].m_size));
     }
     SpinLock<>::ScopeLock lock(m_lock);
-    m_stream->async_read_some(std::move(bufSeq), [handler = handler, ctx = ctx](const boost::system::error_code &err, std::size_t bytesTransferred)
+    m_stream->async_read_some(std::move(bufSeq), std::move(completion));
+}
+
+template<typename StreamTraits, const char *LoggerName> void StreamChannelBase<StreamTraits, LoggerName>::AsyncReadAvailable(
+    BufDescriptor bufs[], size_t bufSize, const IAsyncChannelHandler::ptr_t &handler, void *ctx)
+{
+#ifdef USE_IO_URING_CHANNEL
+    std::shared_ptr<IoUringStream> uringStream;
+    {
+        SpinLock<>::ScopeLock lock(m_lock);
+        uringStream = AttachIoUring();
+    }
+    if (uringStream)
+    {
+        //the queued segments are all copied,which is already the same behavior.
+        uringStream->AsyncReadSome(bufs, bufSize, handler, ctx);
+        return;
+    }
+#endif
+    if (bufSize > InlineReadBufCount)
+    {
+        AsyncReadSome(bufs, bufSize, handler, ctx);
+        return;
+    }
+    ReadBufArray bufSeq(bufs, bufSize);
+    SpinLock<>::ScopeLock lock(m_lock);
+    m_stream->async_read_some(bufSeq, [self = StreamChannelBase<StreamTraits, LoggerName>::shared_from_this(), bufSeq = bufSeq
+        , handler = handler, ctx = ctx](const boost::system::error_code &err, std::size_t bytesTransferred) mutable
         {
+            if (!err)
+            {
+                bytesTransferred += self->ReadAvailable(bufSeq, bytesTransferred);
+            }
             handler->EndRead(err, bytesTransferred, ctx);
         });
 }
 
 template<typename StreamTraits, const char *LoggerName> void StreamChannelBase<StreamTraits, LoggerName>::AsyncWrite(const std::shared_ptr<LinearBuffer> &buf
     , size_t sendOffset, size_t sendLen, const IAsyncChannelHandler::ptr_t &handler, void *ctx)
+{
+    Write(sendLen, handler, ctx, [&buf, sendOffset](WrReq &req)
+        {
+            req.m_buf = buf;
+            req.m_sendOffset = sendOffset;
+        });
+}
+
+template<typename StreamTraits, const char *LoggerName> void StreamChannelBase<StreamTraits, LoggerName>::AsyncWrite(const BufferChain &chain
+    , const IAsyncChannelHandler::ptr_t &handler, void *ctx)
+{
+    Write(chain.Size(), handler, ctx, [&chain](WrReq &req)
+        {
+            req.m_chain = chain;
+            req.m_sendOffset = 0;
+        });
+}
+
+template<typename StreamTraits, const char *LoggerName> void StreamChannelBase<StreamTraits, LoggerName>::AsyncWriteCopy(const void *data
+    , size_t sendLen, const IAsyncChannelHandler::ptr_t &handler, void *ctx)
+{
+    std::shared_ptr<LinearBuffer> buf;
+    if (sendLen > InlineWriteCapacity)
+    {
+        buf = std::make_shared<LinearBuffer>(sendLen);
+        buf->append(data, sendLen);
+    }
+    Write(sendLen, handler, ctx, [&buf, data, sendLen](WrReq &req)
+        {
+            if (!buf)
+            {
+                RunTimeLibraryHelper::MemCpy(req.m_inlineData, InlineWriteCapacity, data, sendLen);
+            }
+            req.m_buf = std::move(buf);
+            req.m_sendOffset = 0;
+        });
+}
+
+template<typename StreamTraits, const char *LoggerName> void StreamChannelBase<StreamTraits, LoggerName>::SetWriteQueueSettings(
+    const WriteQueueSettings &settings)
+{
+    SpinLock<>::ScopeLock lock(m_lock);
+    m_wrQueueSettings = settings;
+}
+
+template<typename StreamTraits, const char *LoggerName> WriteQueueStatus StreamChannelBase<StreamTraits, LoggerName>::GetWriteQueueStatus()
 {
     SpinLock<>::ScopeLock lock(m_lock);
+    return m_wrQueueStatus;
+}
+
+/**
+ * Gets the socket handle of a stream which does not support non-blocking reads.
+ *
+ * @tparam Stream Type of the stream.
+ *
+ * @return Always -1.
+ */
+template<typename Stream> int StreamSocketHandle(Stream&)
+{
+    return -1;
+}
+
+#ifndef _WIN32
+/**
+ * Gets the native handle of a socket.
+ *
+ * @tparam Protocol Type of the protocol.
+ * @tparam Executor Type of the executor.
+ * @param [in,out] socket The socket.
+ *
+ * @return The native handle,-1 if the socket is closed.
+ */
+template<typename Protocol, typename Executor> int StreamSocketHandle(boost::asio::basic_stream_socket<Protocol, Executor> &socket)
+{
+    return socket.is_open() ? socket.native_handle() : -1;
+}
+#endif
+
+template<typename StreamTraits, const char *LoggerName> size_t StreamChannelBase<StreamTraits, LoggerName>::ReadAvailable(ReadBufArray &bufs
+    , size_t filled)
+{
+    bufs.Consume(filled);
+    if (!bufs.Size())
+    {
+        return 0;
+    }
+    int fd;
+    {
+        SpinLock<>::ScopeLock lock(m_lock);
+        fd = StreamSocketHandle(*m_stream);
+    }
+#ifndef _WIN32
+    if (fd >= 0)
+    {
+        //one call fills the whole buffer array,a short read means the socket is drained.
+        iovec iov[ReadBufArray::Capacity];
+        size_t count = 0;
+        for (const boost::asio::mutable_buffer &buf : bufs)
+        {
+            iov[count].iov_base = buf.data();
+            iov[count].iov_len = buf.size();
+            ++count;
+        }
+        msghdr msg = {};
+        msg.msg_iov = iov;
+        msg.msg_iovlen = count;
+        ssize_t bytes = ::recvmsg(fd, &msg, MSG_DONTWAIT);
+        return bytes > 0 ? static_cast<size_t>(bytes) : 0;
+    }
+#endif
+    return 0;
+}
+
+template<typename StreamTraits, const char *LoggerName> template<typename Func> void StreamChannelBase<StreamTraits, LoggerName>::Write(
+    size_t sendLen, const IAsyncChannelHandler::ptr_t &handler, void *ctx, Func fillFunc)
+{
+#ifdef USE_IO_URING_CHANNEL
+    //a send started under m_lock enters the ring after m_lock is released.
+    IoUringService::SubmitScope submitScope;
+#endif
+    {
+        SpinLock<>::ScopeLock lock(m_lock);
+        if (ExceedHighWatermark(sendLen))
+        {
+            if (m_wrQueueSettings.m_policy == WriteQueuePolicy::DropNewest)
+            {
+                ++m_wrQueueStatus.m_droppedCount;
+                m_wrQueueStatus.m_droppedBytes += sendLen;
+                PostDropped(handler, sendLen, ctx);
+                return;
+            }
+            else if (m_wrQueueSettings.m_policy == WriteQueuePolicy::DropOldest)
+            {
+                while (ExceedHighWatermark(sendLen) && DropOldestWrReq())
+                {
+                }
+            }
+        }
+        std::unique_ptr<WrReq> req = AllocWrReq();
+        fillFunc(*req);
+        req->m_handler = handler;
+        req->m_sendLen = sendLen;
+        req->m_ctx = ctx;
+        if (!QueueWrReq(req))
+        {
+            return;
+        }
+        m_watermarkHandler = handler;
+    }
+    DeliverWatermark();
+}
+
+template<typename StreamTraits, const char *LoggerName> bool StreamChannelBase<StreamTraits, LoggerName>::ExceedHighWatermark(size_t sendLen) const
+{
+    return m_wrQueueStatus.m_queuedCount
+        && ((m_wrQueueSettings.m_highWatermarkBytes && m_wrQueueStatus.m_queuedBytes + sendLen > m_wrQueueSettings.m_highWatermarkBytes)
+            || (m_wrQueueSettings.m_highWatermarkCount && m_wrQueueStatus.m_queuedCount + 1 > m_wrQueueSettings.m_highWatermarkCount));
+}
+
+template<typename StreamTraits, const char *LoggerName> bool StreamChannelBase<StreamTraits, LoggerName>::DropOldestWrReq()
+{
+    if (!m_curWrReq || !m_curWrReq->m_next)
+    {
+        return false;
+    }
+    std::unique_ptr<WrReq> dropped = std::move(m_curWrReq->m_next);
+    m_curWrReq->m_next = std::move(dropped->m_next);
+    if (m_lastWrReq == dropped.get())
+    {
+        m_lastWrReq = m_curWrReq;
+    }
+    m_wrQueueStatus.m_queuedBytes -= dropped->m_sendLen;
+    --m_wrQueueStatus.m_queuedCount;
+    ++m_wrQueueStatus.m_droppedCount;
+    m_wrQueueStatus.m_droppedBytes += dropped->m_sendLen;
+    PostDropped(std::move(dropped->m_handler), dropped->m_sendLen, dropped->m_ctx);
+    dropped->m_buf.reset();
+    dropped->m_chain.Clear();
+    FreeWrReq(dropped);
+    return true;
+}
+
+template<typename StreamTraits, const char *LoggerName> void StreamChannelBase<StreamTraits, LoggerName>::PostDropped(IAsyncChannelHandler::ptr_t handler
+    , size_t sendLen, void *ctx)
+{
+    LOG4CPLUS_DEBUG_FMT(log, "写队列已满，丢弃写请求，字节数：%zu，排队字节数：%zu，排队请求数：%zu。", sendLen, m_wrQueueStatus.m_queuedBytes
+        , m_wrQueueStatus.m_queuedCount);
+    boost::asio::post(m_stream->get_executor(), [handler = std::move(handler), ctx = ctx]()
+        {
+            handler->EndWrite(boost::asio::error::no_buffer_space, 0, ctx);
+        });
+}
+
+template<typename StreamTraits, const char *LoggerName> std::unique_ptr<typename StreamChannelBase<StreamTraits, LoggerName>::WrReq>
+    StreamChannelBase<StreamTraits, LoggerName>::AllocWrReq()
+{
+    if (m_freeWrReqs)
+    {
+        std::unique_ptr<WrReq> ret = std::move(m_freeWrReqs);
+        m_freeWrReqs = std::move(ret->m_next);
+        --m_freeWrReqCount;
+        return ret;
+    }
+    return std::unique_ptr<WrReq>(new WrReq());
+}
+
+template<typename StreamTraits, const char *LoggerName> void StreamChannelBase<StreamTraits, LoggerName>::FreeWrReq(std::unique_ptr<WrReq> &wrReq)
+{
+    if (m_freeWrReqCount < MaxFreeWrReqCount)
+    {
+        wrReq->m_next = std::move(m_freeWrReqs);
+        m_freeWrReqs = std::move(wrReq);
+        ++m_freeWrReqCount;
+    }
+    else
+    {
+        wrReq.reset();
+    }
+}
+
+template<typename StreamTraits, const char *LoggerName> bool StreamChannelBase<StreamTraits, LoggerName>::QueueWrReq(std::unique_ptr<WrReq> &wrReq)
+{
+    m_wrQueueStatus.m_queuedBytes += wrReq->m_sendLen;
+    ++m_wrQueueStatus.m_queuedCount;
     if (m_lastWrReq)
     {
-        m_lastWrReq->m_next = std::unique_ptr<WrReq>(new WrReq{ handler, buf, sendOffset, sendLen, ctx, nullptr });
+        m_lastWrReq->m_next = std::move(wrReq);
         m_lastWrReq = m_lastWrReq->m_next.get();
     }
     else
     {
-        std::unique_ptr<WrReq> req(new WrReq{ handler, buf, sendOffset, sendLen, ctx, nullptr });
-        m_lastWrReq = req.get();
-        boost::asio::async_write(*m_stream, boost::asio::buffer(buf->data() + sendOffset, sendLen)
-            , [self = StreamChannelBase<StreamTraits, LoggerName>::shared_from_this(), req = std::move(req)]
-            (const boost::system::error_code &err, std::size_t bytesTransferred) mutable
-            {
-                self->EndWrite(req, err, bytesTransferred);
-            });
+        m_lastWrReq = wrReq.get();
+        StartWrite(wrReq);
+    }
+    if (m_wrQueueStatus.m_aboveHighWatermark)
+    {
+        return false;
+    }
+    m_wrQueueStatus.m_aboveHighWatermark = (m_wrQueueSettings.m_highWatermarkBytes
+        && m_wrQueueStatus.m_queuedBytes >= m_wrQueueSettings.m_highWatermarkBytes) || (m_wrQueueSettings.m_highWatermarkCount
+        && m_wrQueueStatus.m_queuedCount >= m_wrQueueSettings.m_highWatermarkCount);
+    return m_wrQueueStatus.m_aboveHighWatermark;
+}
+
+template<typename StreamTraits, const char *LoggerName> void StreamChannelBase<StreamTraits, LoggerName>::StartWrite(std::unique_ptr<WrReq> &wrReq)
+{
+    m_curWrReq = wrReq.get();
+#ifdef USE_IO_URING_CHANNEL
+    if (AttachIoUring())
+    {
+        m_uringWrReq = std::move(wrReq);
+        if (m_uringWrReq->m_chain.Empty())
+        {
+            m_uringStream->AsyncWrite(m_uringWrReq->Data(), m_uringWrReq->m_sendLen, StreamChannelBase<StreamTraits, LoggerName>::shared_from_this());
+        }
+        else
+        {
+            m_uringStream->AsyncWrite(m_uringWrReq->m_chain, StreamChannelBase<StreamTraits, LoggerName>::shared_from_this());
+        }
+        return;
+    }
+#endif
+    const BufferChain &chain = wrReq->m_chain;
+    const us8 *buffer = wrReq->Data();
+    size_t bufferSize = wrReq->m_sendLen;
+    auto handler = MakeAllocHandler(m_writeHandlerMemory, [self = StreamChannelBase<StreamTraits, LoggerName>::shared_from_this()
+        , req = std::move(wrReq)](const boost::system::error_code &err, std::size_t bytesTransferred) mutable
+        {
+            self->EndWrite(req, err, bytesTransferred);
+        });
+    if (chain.Empty())
+    {
+        boost::asio::async_write(*m_stream, boost::asio::buffer(buffer, bufferSize), std::move(handler));
+    }
+    else
+    {
+        boost::asio::async_write(*m_stream, BufferChainSequence(chain), std::move(handler));
     }
 }
 
 template<typename StreamTraits, const char *LoggerName> void StreamChannelBase<StreamTraits, LoggerName>::EndWrite(std::unique_ptr<WrReq> &wrReq
     , const boost::system::error_code &err, std::size_t bytesTransferred)
 {
+    IAsyncChannelHandler::ptr_t handler(std::move(wrReq->m_handler));
+    void *ctx = wrReq->m_ctx;
+    wrReq->m_buf.reset();
+    wrReq->m_chain.Clear();
+    bool lowWatermarkReached = false;
     {
         SpinLock<>::ScopeLock lock(m_lock);
+        m_wrQueueStatus.m_queuedBytes -= wrReq->m_sendLen;
+        --m_wrQueueStatus.m_queuedCount;
+        if (m_wrQueueStatus.m_aboveHighWatermark
+            && (!m_wrQueueSettings.m_highWatermarkBytes || m_wrQueueStatus.m_queuedBytes <= m_wrQueueSettings.m_lowWatermarkBytes)
+            && (!m_wrQueueSettings.m_highWatermarkCount || m_wrQueueStatus.m_queuedCount <= m_wrQueueSettings.m_lowWatermarkCount))
+        {
+            m_wrQueueStatus.m_aboveHighWatermark = false;
+            m_watermarkHandler.reset();
+            lowWatermarkReached = true;
+        }
         if (wrReq->m_next)
         {
-            us8* buffer = wrReq->m_next->m_buf->data() + wrReq->m_next->m_sendOffset;
-            size_t bufferSize = wrReq->m_next->m_sendLen;
-            boost::asio::async_write(*m_stream, boost::asio::buffer(buffer, bufferSize)
-                , [self = StreamChannelBase<StreamTraits, LoggerName>::shared_from_this(), req = std::move(wrReq->m_next)]
-                (const boost::system::error_code &err, std::size_t bytesTransferred) mutable
-                {
-                    self->EndWrite(req, err, bytesTransferred);
-                });
+            StartWrite(wrReq->m_next);
         }
         else
         {
             m_lastWrReq = nullptr;
+            m_curWrReq = nullptr;
+        }
+        FreeWrReq(wrReq);
+    }
+    handler->EndWrite(err, bytesTransferred, ctx);
+    if (lowWatermarkReached)
+    {
+        DeliverWatermark();
+    }
+}
+
+template<typename StreamTraits, const char *LoggerName> void StreamChannelBase<StreamTraits, LoggerName>::DeliverWatermark()
+{
+    {
+        SpinLock<>::ScopeLock lock(m_lock);
+        if (m_watermarkDelivering)
+        {
+            return;
+        }
+        m_watermarkDelivering = true;
+    }
+    for (;;)
+    {
+        IAsyncChannelHandler::ptr_t handler;
+        bool above;
+        size_t queuedBytes, queuedCount;
+        {
+            SpinLock<>::ScopeLock lock(m_lock);
+            above = m_wrQueueStatus.m_aboveHighWatermark;
+            if (above == m_watermarkNotified)
+            {
+                m_watermarkDelivering = false;
+                return;
+            }
+            m_watermarkNotified = above;
+            queuedBytes = m_wrQueueStatus.m_queuedBytes;
+            queuedCount = m_wrQueueStatus.m_queuedCount;
+            if (above)
+            {
+                m_notifiedHandler = m_watermarkHandler;
+                handler = m_notifiedHandler;
+            }
+            else
+            {
+                handler = std::move(m_notifiedHandler);
+            }
+        }
+        if (above)
+        {
+            handler->HighWatermarkReached(queuedBytes, queuedCount);
+        }
+        else
+        {
+            handler->LowWatermarkReached(queuedBytes, queuedCount);
+        }
+    }
+}
+
+template<typename StreamTraits, const char *LoggerName> void StreamChannelBase<StreamTraits, LoggerName>::DetachIoUring()
+{
+#ifdef USE_IO_URING_CHANNEL
+    m_uringProbed = false;
+    if (m_uringStream)
+    {
+        m_uringStream->Close();
+        m_uringStream.reset();
+    }
+#endif
+}
+
+#ifdef USE_IO_URING_CHANNEL
+template<typename StreamTraits, const char *LoggerName> std::shared_ptr<IoUringStream> StreamChannelBase<StreamTraits, LoggerName>::AttachIoUring()
+{
+    if (!m_uringProbed)
+    {
+        int fd = m_stream->native_handle();
+        if (fd < 0)
+        {
+            return m_uringStream;
+        }
+        m_uringProbed = true;
+        if (IoUringService::Enabled() && IoUringStream::IsStreamSocket(fd))
+        {
+            IoUringService &service = boost::asio::use_service<IoUringService>(ThreadPool::Instance().Context());
+            if (service.Available())
+            {
+                m_uringStream = std::make_shared<IoUringStream>(ThreadPool::Instance().Context(), service, fd
+                    , [this](const boost::system::error_code &err, std::size_t bytesTransferred)
+                    {
+                        std::unique_ptr<WrReq> wrReq(std::move(m_uringWrReq));
+                        EndWrite(wrReq, err, bytesTransferred);
+                    });
+            }
         }
     }
-    wrReq->m_handler->EndWrite(err, bytesTransferred, wrReq->m_ctx);
+    return m_uringStream;
 }
+#endif
 
 #endif /* STREAMCHANNELBASEIMPL_H */
\ No newline at end of file
@@ -0,0 +1,51 @@
+#ifndef WRITEQUEUESETTINGS_H
+#define WRITEQUEUESETTINGS_H
+
+#include <cstddef>
+
+/**
+ * Values that represent the behavior of a channel's write queue when the high watermark is reached.
+ */
+enum class WriteQueuePolicy :int
+{
+    Backpressure = 0,   /**< Queues all requests,producers should pause on IAsyncChannelHandler::HighWatermarkReached. */
+    DropOldest, /**< Drops the oldest queued(not in progress) requests to make room for the new one. */
+    DropNewest  /**< Rejects the new request. */
+};
+
+/**
+ * Settings of a channel's write queue(a watermark of 0 means unlimited).
+ *
+ * The high watermark is reached when queued bytes or queued requests reach their high value,the low watermark is reached when both
+ * of them are not greater than their low value.Queued requests include the one in progress.
+ */
+struct WriteQueueSettings
+{
+    std::size_t m_highWatermarkBytes;   /**< High watermark of queued bytes. */
+
+    std::size_t m_lowWatermarkBytes;    /**< Low watermark of queued bytes. */
+
+    std::size_t m_highWatermarkCount;   /**< High watermark of queued requests. */
+
+    std::size_t m_lowWatermarkCount;    /**< Low watermark of queued requests. */
+
+    WriteQueuePolicy m_policy;  /**< Behavior when the high watermark is reached. */
+};
+
+/**
+ * Runtime status of a channel's write queue.
+ */
+struct WriteQueueStatus
+{
+    std::size_t m_queuedBytes;  /**< Queued bytes(including the request in progress). */
+
+    std::size_t m_queuedCount;  /**< Queued requests(including the request in progress). */
+
+    std::size_t m_droppedBytes; /**< Total bytes dropped by @ref WriteQueuePolicy::DropOldest or @ref WriteQueuePolicy::DropNewest. */
+
+    std::size_t m_droppedCount; /**< Total requests dropped by @ref WriteQueuePolicy::DropOldest or @ref WriteQueuePolicy::DropNewest. */
+
+    bool m_aboveHighWatermark;  /**< True if the high watermark is reached and the low watermark is not reached yet. */
+};
+
+#endif /* WRITEQUEUESETTINGS_H */
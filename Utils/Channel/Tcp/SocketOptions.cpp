@@ -0,0 +1,64 @@
+#include "SocketOptions.h"
+#if defined(IS_UNIX)
+#include <netinet/tcp.h>
+#endif
+
+namespace
+{
+    /**
+     * Sets an integer socket option if it is not the system default(-1).
+     *
+     * @tparam Level Option level.
+     * @tparam Name Option name.
+     * @tparam Socket Type of the socket.
+     * @param [in,out] sock The socket.
+     * @param value Option value.
+     * @param [in,out] err Set to the error if no error occurred before.
+     */
+    template<int Level, int Name, typename Socket> void SetIntegerOption(Socket &sock, int value, boost::system::error_code &err)
+    {
+        if (value != -1)
+        {
+            boost::system::error_code setErr;
+            sock.set_option(boost::asio::detail::socket_option::integer<Level, Name>(value), setErr);
+            if (setErr && !err)
+            {
+                err = setErr;
+            }
+        }
+    }
+}
+
+void SocketOptions::ApplyTo(boost::asio::ip::tcp::socket &sock, boost::system::error_code &err) const
+{
+    err.clear();
+    SetIntegerOption<IPPROTO_TCP, TCP_NODELAY>(sock, m_noDelay, err);
+    SetIntegerOption<SOL_SOCKET, SO_KEEPALIVE>(sock, m_keepAlive, err);
+    SetIntegerOption<SOL_SOCKET, SO_SNDBUF>(sock, m_sendBufferSize, err);
+    SetIntegerOption<SOL_SOCKET, SO_RCVBUF>(sock, m_receiveBufferSize, err);
+#if defined(TCP_QUICKACK)
+    SetIntegerOption<IPPROTO_TCP, TCP_QUICKACK>(sock, m_quickAck, err);
+#endif
+#if defined(TCP_KEEPIDLE)
+    SetIntegerOption<IPPROTO_TCP, TCP_KEEPIDLE>(sock, m_keepAliveIdle, err);
+#endif
+#if defined(TCP_KEEPINTVL)
+    SetIntegerOption<IPPROTO_TCP, TCP_KEEPINTVL>(sock, m_keepAliveInterval, err);
+#endif
+#if defined(TCP_KEEPCNT)
+    SetIntegerOption<IPPROTO_TCP, TCP_KEEPCNT>(sock, m_keepAliveCount, err);
+#endif
+#if defined(SO_BUSY_POLL)
+    SetIntegerOption<SOL_SOCKET, SO_BUSY_POLL>(sock, m_busyPoll, err);
+#endif
+#if defined(TCP_NOTSENT_LOWAT)
+    SetIntegerOption<IPPROTO_TCP, TCP_NOTSENT_LOWAT>(sock, m_notSentLowat, err);
+#endif
+}
+
+void SocketOptions::ApplyTo(boost::asio::ip::tcp::acceptor &acceptor, boost::system::error_code &err) const
+{
+    err.clear();
+    SetIntegerOption<SOL_SOCKET, SO_SNDBUF>(acceptor, m_sendBufferSize, err);
+    SetIntegerOption<SOL_SOCKET, SO_RCVBUF>(acceptor, m_receiveBufferSize, err);
+}
@@ -0,0 +1,76 @@
+#ifndef SOCKETOPTIONS_H
+#define SOCKETOPTIONS_H
+
+#include <boost/asio.hpp>
+#include "../../Common/CommonHdr.h"
+
+/**
+ * A TCP socket tuning profile applied when a channel is opened or a connection is accepted.
+ *
+ * Every option is left as the system default when its value is -1.Options which are not supported by current platform(TCP_QUICKACK,
+ * SO_BUSY_POLL,TCP_NOTSENT_LOWAT and the keepalive timings are Linux specific) are ignored.
+ */
+struct UTILS_EXPORTS_API SocketOptions
+{
+    int m_noDelay = -1;  /**< TCP_NODELAY(0 or 1),1 disables the Nagle algorithm. */
+
+    int m_quickAck = -1; /**< TCP_QUICKACK(0 or 1),1 disables delayed ACK(the kernel may enable delayed ACK again later). */
+
+    int m_keepAlive = -1;    /**< SO_KEEPALIVE(0 or 1). */
+
+    int m_keepAliveIdle = -1;    /**< TCP_KEEPIDLE in seconds. */
+
+    int m_keepAliveInterval = -1;    /**< TCP_KEEPINTVL in seconds. */
+
+    int m_keepAliveCount = -1;   /**< TCP_KEEPCNT. */
+
+    int m_sendBufferSize = -1;   /**< SO_SNDBUF in bytes. */
+
+    int m_receiveBufferSize = -1;    /**< SO_RCVBUF in bytes(applied to the acceptor too,so the window scale of accepted connections fits). */
+
+    int m_busyPoll = -1; /**< SO_BUSY_POLL in microseconds. */
+
+    int m_notSentLowat = -1; /**< TCP_NOTSENT_LOWAT in bytes. */
+
+    /**
+     * Gets a profile which keeps all system defaults.
+     *
+     * @return The profile.
+     */
+    static SocketOptions Default()
+    {
+        return SocketOptions();
+    }
+
+    /**
+     * Gets a profile for request/response traffic(TCP_NODELAY,TCP_QUICKACK and a 16KB TCP_NOTSENT_LOWAT).
+     *
+     * @return The profile.
+     */
+    static SocketOptions LowLatency()
+    {
+        SocketOptions ret;
+        ret.m_noDelay = 1;
+        ret.m_quickAck = 1;
+        ret.m_notSentLowat = 16 * 1024;
+        return ret;
+    }
+
+    /**
+     * Applies the options to a socket.
+     *
+     * @param [in,out] sock The socket(must be opened).
+     * @param [out] err The first error,all options are tried even if one of them failed.
+     */
+    void ApplyTo(boost::asio::ip::tcp::socket &sock, boost::system::error_code &err) const;
+
+    /**
+     * Applies the options which are inherited by accepted sockets(buffer sizes) to an acceptor before listening.
+     *
+     * @param [in,out] acceptor The acceptor(must be opened).
+     * @param [out] err The first error.
+     */
+    void ApplyTo(boost::asio::ip::tcp::acceptor &acceptor, boost::system::error_code &err) const;
+};
+
+#endif /* SOCKETOPTIONS_H */
@@ -3,6 +3,7 @@
 
 #include <boost/asio.hpp>
 #include "../Common/StreamChannelBase.h"
+#include "SocketOptions.h"
 
 /**
  * Base class of TCP channel.
@@ -57,6 +58,16 @@ public:
      */
     virtual void AsyncClose(const IAsyncChannelHandler::ptr_t &handler) override;
 
+    /**
+     * Sets the socket options(the default is ProtocolTraits::DefaultSocketOptions()).
+     *
+     * @param options The socket options.
+     * @param [out] error The first error of applying options when the channel is opened.
+     *
+     * @note The options are applied immediately if the channel is opened,and applied again on each open.
+     */
+    void SetSocketOptions(const SocketOptions &options, boost::system::error_code &error);
+
 private:
 
     /**
@@ -78,6 +89,8 @@ private:
 
     boost::asio::ip::tcp::endpoint m_remoteEndPoint;	/**< The remote end point used to connect. */
 
+    SocketOptions m_socketOptions;  /**< Socket options applied on open. */
+
     volatile bool m_closed; /**< True if closed */
 };
 
@@ -15,7 +15,7 @@ template <typename ProtocolTraits, const char *LoggerName>
 TcpChannelBase<ProtocolTraits, LoggerName>::TcpChannelBase(const typename ProtocolTraits::AddressType &remoteAddr, us16 remotePort, bool openOnConstruct, us16 localPort
     , const typename ProtocolTraits::AddressType &localAddr): StreamChannelBase<ProtocolTraits, LoggerName>(
     std::make_shared<typename ProtocolTraits::StreamType>(ThreadPool::Instance().Context())), m_localEndPoint(localAddr, localPort), m_remoteEndPoint(remoteAddr, remotePort)
-    , m_closed(true)
+    , m_socketOptions(ProtocolTraits::DefaultSocketOptions()), m_closed(true)
 {
     if (openOnConstruct)
     {
@@ -67,6 +67,18 @@ void TcpChannelBase<ProtocolTraits, LoggerName>::AsyncClose(
     QueueThreadPoolWorkItem([handler = handler, err = shutdownErr ? shutdownErr : closeErr]() { handler->EndClose(err); });
 }
 
+template <typename ProtocolTraits, const char *LoggerName>
+void TcpChannelBase<ProtocolTraits, LoggerName>::SetSocketOptions(const SocketOptions &options, boost::system::error_code &error)
+{
+    SpinLock<>::ScopeLock lock(BaseType::m_lock);
+    m_socketOptions = options;
+    error.clear();
+    if (BaseType::m_stream->is_open())
+    {
+        m_socketOptions.ApplyTo(*BaseType::m_stream, error);
+    }
+}
+
 template <typename ProtocolTraits, const char *LoggerName>
 void TcpChannelBase<ProtocolTraits, LoggerName>::Open(boost::system::error_code &error)
 {
@@ -77,6 +89,12 @@ void TcpChannelBase<ProtocolTraits, LoggerName>::Open(boost::system::error_code
     }
     else
     {
+        boost::system::error_code optionErr;
+        m_socketOptions.ApplyTo(*BaseType::m_stream, optionErr);
+        if (optionErr)
+        {
+            LOG4CPLUS_WARN_FMT(BaseType::log, "设置Tcp通道套接字选项错误：%s", optionErr.message().c_str());
+        }
         if (m_localEndPoint.port() != 0)
         {
             StreamChannelBase<ProtocolTraits, LoggerName>::m_stream->bind(m_localEndPoint, error);
@@ -104,6 +122,7 @@ void TcpChannelBase<ProtocolTraits, LoggerName>::Close(boost::system::error_code
 {
     if (!m_closed)
     {
+        BaseType::DetachIoUring();
         BaseType::m_stream->shutdown(boost::asio::socket_base::shutdown_both, shutdownErr);
         if (shutdownErr)
         {
@@ -0,0 +1,13 @@
+#include "TcpListenerAccept.h"
+
+TcpListenerAcceptFunc *acceptFunc = nullptr;
+
+void SetListenerAcceptFunc(TcpListenerAcceptFunc *func)
+{
+    acceptFunc = func;
+}
+
+void TcpListenerAcceptEntry(std::shared_ptr<boost::asio::ip::tcp::endpoint> &remoteEndPoint, std::shared_ptr<boost::asio::ip::tcp::socket> &sock)
+{
+    acceptFunc(remoteEndPoint, sock);
+}
\ No newline at end of file
@@ -0,0 +1,19 @@
+#ifndef TCPLISTENERACCEPT_H
+#define TCPLISTENERACCEPT_H
+
+#include <memory>
+#include <boost/asio.hpp>
+#include "../../Common/CommonHdr.h"
+
+using TcpListenerAcceptFunc = void (std::shared_ptr<boost::asio::ip::tcp::endpoint> &, std::shared_ptr<boost::asio::ip::tcp::socket> &);
+
+void TcpListenerAcceptEntry(std::shared_ptr<boost::asio::ip::tcp::endpoint> &remoteEndPoint, std::shared_ptr<boost::asio::ip::tcp::socket> &sock);
+
+/**
+ * Sets the function called with connections accepted by the TCP listeners(shared by TcpV4Listener and TcpV6Listener).
+ *
+ * @param [in] func The accept function.
+ */
+UTILS_EXPORTS_API void SetListenerAcceptFunc(TcpListenerAcceptFunc *func);
+
+#endif /* TCPLISTENERACCEPT_H */
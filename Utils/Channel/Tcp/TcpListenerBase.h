@@ -1,7 +1,8 @@
 #ifndef TCPLISTENERBASE_H
 #define TCPLISTENERBASE_H
 
-#include <set>
+#include <map>
+#include <vector>
 #include <utility>
 #include <initializer_list>
 #include <memory>
@@ -9,6 +10,7 @@
 #include "../../Log/Log4cplusCustomInc.h"
 #include "../../Common/CommonHdr.h"
 #include "../../Concurrent/SpinLock.h"
+#include "TcpListenerSettings.h"
 
 /**
  * A TCP listener base class.
@@ -107,6 +109,29 @@ public:
      */
     void RemoveListenerEndPoint(const boost::asio::ip::tcp::endpoint &localEndPoint);
 
+    /**
+     * Sets the listener settings(the default is one acceptor per end point which accepts one connection per wakeup).
+     *
+     * @param settings The settings.
+     *
+     * @note The settings are applied to the end points added afterwards.
+     */
+    void SetListenerSettings(const TcpListenerSettings &settings);
+
+    /**
+     * Gets the listener settings.
+     *
+     * @return The settings.
+     */
+    TcpListenerSettings GetListenerSettings();
+
+    /**
+     * Gets the accept statistics of all acceptors(one entry per SO_REUSEPORT shard).
+     *
+     * @return The statistics.
+     */
+    std::vector<TcpAcceptorStats> GetAcceptorStats();
+
 protected:
 
     /**
@@ -119,6 +144,21 @@ private:
 
     static ptr_t instance;  /**< Global instance. */
 
+    /**
+     * Per acceptor state.
+     */
+    struct AcceptorEntry
+    {
+        AcceptorEntry() :m_lock(), m_stats{ boost::asio::ip::tcp::endpoint(), 0, 0, 0 }
+        {
+        }
+
+        SpinLock<> m_lock;  /**< Lock of the acceptor object,held while accepting and closing(m_lock is only held to find the entry,so the
+                             shards of an end point accept in parallel). */
+
+        TcpAcceptorStats m_stats;   /**< Accept statistics(m_localEndPoint is filled by GetAcceptorStats). */
+    };
+
     /**
      * Begin a close operation.
      *
@@ -130,10 +170,40 @@ private:
      * Adds listener end point implementation(thread unsafe).
      *
      * @param localEndPoint The local end point to be added.
+     * @param [in,out] listeners The added acceptors are appended to it when success.
      *
-     * @return Iterator point to added end point when success,otherwise return a end iterator.
+     * @return True if it succeeds, false if it fails(no acceptor is added).
      */
-    std::set<std::shared_ptr<boost::asio::ip::tcp::acceptor>>::iterator AddListenerEndPointUnsafe(const boost::asio::ip::tcp::endpoint &localEndPoint);
+    bool AddListenerEndPointUnsafe(const boost::asio::ip::tcp::endpoint &localEndPoint
+        , std::vector<std::shared_ptr<boost::asio::ip::tcp::acceptor>> &listeners);
+
+    /**
+     * Opens an acceptor.
+     *
+     * @param localEndPoint The local end point.
+     * @param reusePort True to set SO_REUSEPORT.
+     *
+     * @return The acceptor.
+     *
+     * @throws boost::system::system_error Thrown when open,bind or listen failed.
+     */
+    std::shared_ptr<boost::asio::ip::tcp::acceptor> OpenAcceptor(const boost::asio::ip::tcp::endpoint &localEndPoint, bool reusePort);
+
+    /**
+     * Closes an acceptor with its entry lock held(thread unsafe).
+     *
+     * @param acceptor The acceptor and its entry.
+     * @param [out] err The error.
+     */
+    void CloseAcceptorEntry(const std::pair<const std::shared_ptr<boost::asio::ip::tcp::acceptor>, std::shared_ptr<AcceptorEntry>> &acceptor
+        , boost::system::error_code &err);
+
+    /**
+     * Closes an acceptor and removes it from the acceptor set(thread unsafe).
+     *
+     * @param listener The acceptor.
+     */
+    void CloseAcceptorUnsafe(const std::shared_ptr<boost::asio::ip::tcp::acceptor> &listener);
 
     /**
      * Begin an accept operation.
@@ -153,6 +223,15 @@ private:
     void EndAccept(std::shared_ptr<boost::asio::ip::tcp::socket> sock, std::shared_ptr<boost::asio::ip::tcp::endpoint> remoteEndPoint, std::shared_ptr<boost::asio::ip::tcp::acceptor> listener
         , const boost::system::error_code& error);
 
+    /**
+     * Applies socket options to an accepted socket(a failure is logged and the connection is still accepted).
+     *
+     * @param options The socket options.
+     * @param [in,out] sock The accepted socket.
+     * @param remoteEndPoint The remote end point.
+     */
+    void ApplySocketOptions(const SocketOptions &options, boost::asio::ip::tcp::socket &sock, const boost::asio::ip::tcp::endpoint &remoteEndPoint);
+
     /**
      * Removes the listener end point implementation(thread unsafe)
      *
@@ -160,7 +239,9 @@ private:
      */
     void RemoveListenerEndPointUnsafe(const boost::asio::ip::tcp::endpoint &localEndPoint);
 
-    std::set<std::shared_ptr<boost::asio::ip::tcp::acceptor>> m_acceptors;  /**< Listeners. */
+    std::map<std::shared_ptr<boost::asio::ip::tcp::acceptor>, std::shared_ptr<AcceptorEntry>> m_acceptors;  /**< Listeners. */
+
+    TcpListenerSettings m_settings; /**< Listener settings. */
 
     volatile bool m_stoped; /**< True if stoped. */
 
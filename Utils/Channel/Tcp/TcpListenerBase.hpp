@@ -32,7 +32,8 @@ template<typename ProtocolTraits, typename AcceptFunc, AcceptFunc *AcceptFunctio
 }
 
 template<typename ProtocolTraits, typename AcceptFunc, AcceptFunc *AcceptFunction, const char *LoggerName> 
-    TcpListenerBase<ProtocolTraits, AcceptFunc, AcceptFunction, LoggerName>::TcpListenerBase() :m_acceptors(), m_stoped(false), m_lock()
+    TcpListenerBase<ProtocolTraits, AcceptFunc, AcceptFunction, LoggerName>::TcpListenerBase() :m_acceptors()
+    , m_settings{ boost::asio::socket_base::max_listen_connections, 1, 1, ProtocolTraits::DefaultSocketOptions(), false }, m_stoped(false), m_lock()
 {
 }
 
@@ -53,10 +54,12 @@ template<typename ProtocolTraits, typename AcceptFunc, AcceptFunc *AcceptFunctio
         m_stoped = true;
         for (auto i = m_acceptors.begin(); i != m_acceptors.end(); ++i)
         {
-            (*i)->close(err);
+            boost::system::error_code epErr;
+            boost::asio::ip::tcp::endpoint ep = i->first->local_endpoint(epErr);
+            CloseAcceptorEntry(*i, err);
             if(err)
             {
-                LOG4CPLUS_ERROR(log, "启动关闭监听错误，终结点：" << (*i)->local_endpoint() << "，错误信息：" << err.message());
+                LOG4CPLUS_ERROR(log, "启动关闭监听错误，终结点：" << ep << "，错误信息：" << err.message());
                 if(ret)
                 {
                     ret = false;
@@ -72,7 +75,7 @@ template<typename ProtocolTraits, typename AcceptFunc, AcceptFunc *AcceptFunctio
     std::initializer_list<std::pair<typename ProtocolTraits::AddressType, us16>> localEndPoints)
 {
     bool ret = true;
-    std::vector<std::set<std::shared_ptr<boost::asio::ip::tcp::acceptor>>::iterator> listeners;
+    std::vector<std::shared_ptr<boost::asio::ip::tcp::acceptor>> listeners;
     SpinLock<>::ScopeLock lock(m_lock);
     if (m_stoped)
     {
@@ -81,26 +84,13 @@ template<typename ProtocolTraits, typename AcceptFunc, AcceptFunc *AcceptFunctio
     for (auto i = localEndPoints.begin(); i != localEndPoints.end(); ++i)
     {
         boost::asio::ip::tcp::endpoint temp(i->first, i->second);
-        std::set<std::shared_ptr<boost::asio::ip::tcp::acceptor>>::iterator iter = AddListenerEndPointUnsafe(temp);
-        if (iter != m_acceptors.end())
-        {
-            listeners.push_back(iter);
-        }
-        else
+        if (!AddListenerEndPointUnsafe(temp, listeners))
         {
             ret = false;
-            std::for_each(listeners.begin(), listeners.end(),
-                [&](std::set<std::shared_ptr<boost::asio::ip::tcp::acceptor>>::iterator &listenerIter)->void
+            for (auto &listener : listeners)
             {
-                boost::system::error_code err;
-                (*listenerIter)->close(err);
-                if(err)
-                {
-                    LOG4CPLUS_ERROR(log, "添加监听失败后移除监听错误，终结点：" << (*listenerIter)->local_endpoint() << "，错误信息：" << err.message());
-                }
-                m_acceptors.erase(listenerIter);
+                CloseAcceptorUnsafe(listener);
             }
-            );
             break;
         }
     }
@@ -112,10 +102,11 @@ template<typename ProtocolTraits, typename AcceptFunc, AcceptFunc *AcceptFunctio
     const boost::asio::ip::tcp::endpoint &localEndPoint)
 {
     bool ret = true;
+    std::vector<std::shared_ptr<boost::asio::ip::tcp::acceptor>> listeners;
     SpinLock<>::ScopeLock lock(m_lock);
     if (!m_stoped)
     {
-        ret = AddListenerEndPointUnsafe(localEndPoint) != m_acceptors.end();
+        ret = AddListenerEndPointUnsafe(localEndPoint, listeners);
     }
     return ret;
 }
@@ -130,39 +121,153 @@ template<typename ProtocolTraits, typename AcceptFunc, AcceptFunc *AcceptFunctio
     }
 }
 
-template<typename ProtocolTraits, typename AcceptFunc, AcceptFunc *AcceptFunction, const char *LoggerName> std::set<std::shared_ptr<boost::asio::ip::tcp::acceptor>>::iterator
-    TcpListenerBase<ProtocolTraits, AcceptFunc, AcceptFunction, LoggerName>::AddListenerEndPointUnsafe(
-    const boost::asio::ip::tcp::endpoint &localEndPoint)
+template<typename ProtocolTraits, typename AcceptFunc, AcceptFunc *AcceptFunction, const char *LoggerName> 
+    void TcpListenerBase<ProtocolTraits, AcceptFunc, AcceptFunction, LoggerName>::SetListenerSettings(const TcpListenerSettings &settings)
 {
-    std::set<std::shared_ptr<boost::asio::ip::tcp::acceptor>>::iterator ret = m_acceptors.end();
-    std::pair<std::set<std::shared_ptr<boost::asio::ip::tcp::acceptor>>::iterator, bool> result = std::make_pair(m_acceptors.end(), false);
+    SpinLock<>::ScopeLock lock(m_lock);
+    m_settings = settings;
+}
+
+template<typename ProtocolTraits, typename AcceptFunc, AcceptFunc *AcceptFunction, const char *LoggerName> 
+    TcpListenerSettings TcpListenerBase<ProtocolTraits, AcceptFunc, AcceptFunction, LoggerName>::GetListenerSettings()
+{
+    SpinLock<>::ScopeLock lock(m_lock);
+    return m_settings;
+}
+
+template<typename ProtocolTraits, typename AcceptFunc, AcceptFunc *AcceptFunction, const char *LoggerName> 
+    std::vector<TcpAcceptorStats> TcpListenerBase<ProtocolTraits, AcceptFunc, AcceptFunction, LoggerName>::GetAcceptorStats()
+{
+    std::vector<TcpAcceptorStats> ret;
+    SpinLock<>::ScopeLock lock(m_lock);
+    ret.reserve(m_acceptors.size());
+    for (auto &acceptor : m_acceptors)
+    {
+        SpinLock<>::ScopeLock entryLock(acceptor.second->m_lock);
+        ret.push_back(acceptor.second->m_stats);
+        boost::system::error_code err;
+        ret.back().m_localEndPoint = acceptor.first->local_endpoint(err);
+    }
+    return ret;
+}
+
+template<typename ProtocolTraits, typename AcceptFunc, AcceptFunc *AcceptFunction, const char *LoggerName> 
+    bool TcpListenerBase<ProtocolTraits, AcceptFunc, AcceptFunction, LoggerName>::AddListenerEndPointUnsafe(
+    const boost::asio::ip::tcp::endpoint &localEndPoint, std::vector<std::shared_ptr<boost::asio::ip::tcp::acceptor>> &listeners)
+{
+    unsigned int acceptorCount = m_settings.m_acceptorCount ? m_settings.m_acceptorCount : 1;
+#if !defined(SO_REUSEPORT)
+    if (acceptorCount > 1)
+    {
+        LOG4CPLUS_WARN(log, "当前平台不支持SO_REUSEPORT，每个监听终结点只使用一个监听，终结点：" << localEndPoint);
+        acceptorCount = 1;
+    }
+#endif
+    if (localEndPoint.port())
+    {
+        for (auto &listener : m_acceptors)
+        {
+            boost::system::error_code err;
+            if (listener.first->local_endpoint(err) == localEndPoint)
+            {
+                //SO_REUSEPORT acceptors could bind the same end point again,so the duplication is checked here.
+                LOG4CPLUS_ERROR(log, "添加监听失败，终结点已存在：" << localEndPoint);
+                return false;
+            }
+        }
+    }
+    std::vector<std::shared_ptr<boost::asio::ip::tcp::acceptor>> added;
     try
     {
-        result = m_acceptors.insert(std::make_shared<boost::asio::ip::tcp::acceptor>(ThreadPool::Instance().Context()));
-        assert(result.second);
-        const std::shared_ptr<boost::asio::ip::tcp::acceptor> &listener = *result.first;
-        listener->open(ProtocolTraits::Protocol());
-        listener->bind(localEndPoint);
-        listener->listen();
-        BeginAccept(listener);
-        ret = result.first;
+        added.reserve(acceptorCount);
+        boost::asio::ip::tcp::endpoint ep(localEndPoint);
+        for (unsigned int i = 0; i < acceptorCount; ++i)
+        {
+            added.push_back(OpenAcceptor(ep, acceptorCount > 1));
+            m_acceptors.emplace(added.back(), std::make_shared<AcceptorEntry>());
+            //port 0 is resolved by the first acceptor,the others must bind the same port.
+            ep = added.back()->local_endpoint();
+        }
+        for (auto &listener : added)
+        {
+            BeginAccept(listener);
+        }
+        listeners.insert(listeners.end(), added.begin(), added.end());
+        return true;
     }
     catch (const boost::system::system_error &err)
     {
         LOG4CPLUS_ERROR(log, "添加监听失败，终结点：" << localEndPoint << "，错误信息：" << err.code().message());
-        m_acceptors.erase(result.first);
-        ret = m_acceptors.end();
     }
     catch (...)
     {
-        if (result.second)
-        {
-            LOG4CPLUS_ERROR(log, "添加监听失败（未知错误），终结点：" << localEndPoint );
-            m_acceptors.erase(result.first);
-            ret = m_acceptors.end();
-        }
+        LOG4CPLUS_ERROR(log, "添加监听失败（未知错误），终结点：" << localEndPoint );
     }
-    return ret;
+    for (auto &listener : added)
+    {
+        CloseAcceptorUnsafe(listener);
+    }
+    return false;
+}
+
+template<typename ProtocolTraits, typename AcceptFunc, AcceptFunc *AcceptFunction, const char *LoggerName> 
+    std::shared_ptr<boost::asio::ip::tcp::acceptor> TcpListenerBase<ProtocolTraits, AcceptFunc, AcceptFunction, LoggerName>::OpenAcceptor(
+    const boost::asio::ip::tcp::endpoint &localEndPoint, bool reusePort)
+{
+    std::shared_ptr<boost::asio::ip::tcp::acceptor> listener = std::make_shared<boost::asio::ip::tcp::acceptor>(ThreadPool::Instance().Context());
+    listener->open(ProtocolTraits::Protocol());
+    listener->set_option(boost::asio::socket_base::reuse_address(true));
+    if (localEndPoint.address().is_v6())
+    {
+        listener->set_option(boost::asio::ip::v6_only(m_settings.m_v6Only));
+    }
+#if defined(SO_REUSEPORT)
+    if (reusePort)
+    {
+        listener->set_option(boost::asio::detail::socket_option::boolean<SOL_SOCKET, SO_REUSEPORT>(true));
+    }
+#endif
+    boost::system::error_code err;
+    m_settings.m_socketOptions.ApplyTo(*listener, err);
+    if (err)
+    {
+        LOG4CPLUS_WARN(log, "设置监听套接字选项失败，终结点：" << localEndPoint << "，错误信息：" << err.message());
+    }
+    listener->bind(localEndPoint);
+    listener->listen(m_settings.m_backlog);
+    if (m_settings.m_maxAcceptPerWakeup > 1)
+    {
+        listener->non_blocking(true);
+    }
+    return listener;
+}
+
+template<typename ProtocolTraits, typename AcceptFunc, AcceptFunc *AcceptFunction, const char *LoggerName> 
+    void TcpListenerBase<ProtocolTraits, AcceptFunc, AcceptFunction, LoggerName>::CloseAcceptorUnsafe(
+    const std::shared_ptr<boost::asio::ip::tcp::acceptor> &listener)
+{
+    auto iter = m_acceptors.find(listener);
+    if (iter == m_acceptors.end())
+    {
+        return;
+    }
+    boost::system::error_code err;
+    boost::asio::ip::tcp::endpoint ep = listener->local_endpoint(err);
+    CloseAcceptorEntry(*iter, err);
+    if(err)
+    {
+        LOG4CPLUS_ERROR(log, "关闭监听错误，终结点：" << ep << "，错误信息：" << err.message());
+    }
+    m_acceptors.erase(iter);
+}
+
+template<typename ProtocolTraits, typename AcceptFunc, AcceptFunc *AcceptFunction, const char *LoggerName> 
+    void TcpListenerBase<ProtocolTraits, AcceptFunc, AcceptFunction, LoggerName>::CloseAcceptorEntry(
+    const std::pair<const std::shared_ptr<boost::asio::ip::tcp::acceptor>, std::shared_ptr<AcceptorEntry>> &acceptor
+    , boost::system::error_code &err)
+{
+    SpinLock<>::ScopeLock lock(acceptor.second->m_lock);
+    acceptor.first->close(err);
 }
 
 template<typename ProtocolTraits, typename AcceptFunc, AcceptFunc *AcceptFunction, const char *LoggerName> 
@@ -184,6 +289,11 @@ template<typename ProtocolTraits, typename AcceptFunc, AcceptFunc *AcceptFunctio
 {
     bool listenerDropped = true;
     boost::asio::ip::tcp::acceptor::endpoint_type ep;
+    std::vector<std::pair<std::shared_ptr<boost::asio::ip::tcp::endpoint>, std::shared_ptr<boost::asio::ip::tcp::socket>>> pending;
+    boost::system::error_code pendingErr;
+    SocketOptions socketOptions;
+    std::shared_ptr<AcceptorEntry> entry;
+    size_t maxAcceptPerWakeup = 1;
     {
         SpinLock<>::ScopeLock lock(m_lock);
         if (!m_stoped)
@@ -191,18 +301,65 @@ template<typename ProtocolTraits, typename AcceptFunc, AcceptFunc *AcceptFunctio
             auto iter = m_acceptors.find(listener);
             if (iter != m_acceptors.end())
             {
-                BeginAccept(listener);
-                listenerDropped = false;
-                if(error)
+                entry = iter->second;
+                maxAcceptPerWakeup = m_settings.m_maxAcceptPerWakeup;
+                socketOptions = m_settings.m_socketOptions;
+            }
+        }
+    }
+    if (entry)
+    {
+        //only the acceptor's own lock is held while draining,so the other shards are not blocked.
+        SpinLock<>::ScopeLock lock(entry->m_lock);
+        if (listener->is_open())
+        {
+            //accepts the connections which are already pending before waiting again(only for non-blocking acceptors).
+            if (!error && listener->non_blocking())
+            {
+                for (size_t i = 1; i < maxAcceptPerWakeup; ++i)
+                {
+                    std::shared_ptr<boost::asio::ip::tcp::socket> pendingSock(new boost::asio::ip::tcp::socket(ThreadPool::Instance().Context()));
+                    std::shared_ptr<boost::asio::ip::tcp::endpoint> pendingPoint(new boost::asio::ip::tcp::endpoint());
+                    listener->accept(*pendingSock, *pendingPoint, pendingErr);
+                    if (pendingErr)
+                    {
+                        break;
+                    }
+                    pending.emplace_back(std::move(pendingPoint), std::move(pendingSock));
+                }
+            }
+            BeginAccept(listener);
+            listenerDropped = false;
+            if (!error)
+            {
+                TcpAcceptorStats &stats = entry->m_stats;
+                ++stats.m_wakeupCount;
+                stats.m_acceptedCount += pending.size() + 1;
+                if (pending.size() + 1 > stats.m_maxBatch)
                 {
-                    ep = listener->local_endpoint();
+                    stats.m_maxBatch = pending.size() + 1;
                 }
             }
+            if(error || (pendingErr && pendingErr != boost::asio::error::would_block && pendingErr != boost::asio::error::try_again))
+            {
+                boost::system::error_code epErr;
+                ep = listener->local_endpoint(epErr);
+            }
         }
     }
     if (!error)
     {
+        ApplySocketOptions(socketOptions, *sock, *remoteEndPoint);
         AcceptFunction(remoteEndPoint, sock);
+        for (auto &conn : pending)
+        {
+            ApplySocketOptions(socketOptions, *conn.second, *conn.first);
+            AcceptFunction(conn.first, conn.second);
+        }
+        if (!listenerDropped && pendingErr && pendingErr != boost::asio::error::would_block && pendingErr != boost::asio::error::try_again)
+        {
+            LOG4CPLUS_ERROR(log, "接收连接失败，监听终结点：" << ep << "，错误信息：" << pendingErr.message());
+        }
     }
     else if(!listenerDropped)
     {
@@ -211,25 +368,36 @@ template<typename ProtocolTraits, typename AcceptFunc, AcceptFunc *AcceptFunctio
 }
 
 template<typename ProtocolTraits, typename AcceptFunc, AcceptFunc *AcceptFunction, const char *LoggerName> 
-    void TcpListenerBase<ProtocolTraits, AcceptFunc, AcceptFunction, LoggerName>::RemoveListenerEndPointUnsafe(const boost::asio::ip::tcp::endpoint &localEndPoint)
+    void TcpListenerBase<ProtocolTraits, AcceptFunc, AcceptFunction, LoggerName>::ApplySocketOptions(const SocketOptions &options
+    , boost::asio::ip::tcp::socket &sock, const boost::asio::ip::tcp::endpoint &remoteEndPoint)
 {
-    auto iter = std::find_if
-        (
-            m_acceptors.begin(), m_acceptors.end()
-            , [&localEndPoint](const std::shared_ptr<boost::asio::ip::tcp::acceptor> &listener)->bool
+    boost::system::error_code err;
+    options.ApplyTo(sock, err);
+    if (err)
     {
-        return localEndPoint == listener->local_endpoint();
+        LOG4CPLUS_WARN(log, "设置接收连接套接字选项失败，远程终结点：" << remoteEndPoint << "，错误信息：" << err.message());
     }
-    );
-    if (iter != m_acceptors.end())
+}
+
+template<typename ProtocolTraits, typename AcceptFunc, AcceptFunc *AcceptFunction, const char *LoggerName> 
+    void TcpListenerBase<ProtocolTraits, AcceptFunc, AcceptFunction, LoggerName>::RemoveListenerEndPointUnsafe(const boost::asio::ip::tcp::endpoint &localEndPoint)
+{
+    for (auto iter = m_acceptors.begin(); iter != m_acceptors.end();)
     {
         boost::system::error_code err;
-        (*iter)->close(err);
-        if(err)
+        if (localEndPoint == iter->first->local_endpoint(err))
+        {
+            CloseAcceptorEntry(*iter, err);
+            if(err)
+            {
+                LOG4CPLUS_ERROR(log, "移除监听失败，终结点：" << localEndPoint << "，错误信息：" << err.message());
+            }
+            iter = m_acceptors.erase(iter);
+        }
+        else
         {
-            LOG4CPLUS_ERROR(log, "移除监听失败，终结点：" << (*iter)->local_endpoint() << "，错误信息：" << err.message());
+            ++iter;
         }
-        m_acceptors.erase(iter);
     }
 }
 
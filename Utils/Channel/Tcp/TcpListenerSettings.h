@@ -0,0 +1,42 @@
+#ifndef TCPLISTENERSETTINGS_H
+#define TCPLISTENERSETTINGS_H
+
+#include <cstddef>
+#include <boost/asio.hpp>
+#include "../../Common/CommonHdr.h"
+#include "SocketOptions.h"
+
+/**
+ * Settings of a TCP listener(applied to the end points added after the settings changed).
+ */
+struct TcpListenerSettings
+{
+    int m_backlog;  /**< Accept backlog of each acceptor. */
+
+    unsigned int m_acceptorCount;   /**< Number of acceptors opened with SO_REUSEPORT per end point(the kernel load-balances incoming
+                                     connections among them,1 means a single acceptor without SO_REUSEPORT). */
+
+    std::size_t m_maxAcceptPerWakeup;   /**< Max number of connections accepted by an acceptor per wakeup(pending connections are accepted
+                                         without another round trip through the thread pool). */
+
+    SocketOptions m_socketOptions;  /**< Socket options applied to accepted connections(applied to the connections accepted afterwards). */
+
+    bool m_v6Only;  /**< IPV6_V6ONLY of IPv6 end points,false makes an IPv6 end point dual-stack(IPv4 clients are accepted with
+                     v4-mapped addresses),ignored by IPv4 end points. */
+};
+
+/**
+ * Accept statistics of an acceptor.
+ */
+struct TcpAcceptorStats
+{
+    boost::asio::ip::tcp::endpoint m_localEndPoint; /**< Local end point of the acceptor. */
+
+    us64 m_wakeupCount; /**< Number of successful accept wakeups. */
+
+    us64 m_acceptedCount;   /**< Number of accepted connections. */
+
+    std::size_t m_maxBatch; /**< Max number of connections accepted by one wakeup. */
+};
+
+#endif /* TCPLISTENERSETTINGS_H */
@@ -3,6 +3,7 @@
 
 #include <boost/asio.hpp>
 #include "../Common/StreamChannelBase.h"
+#include "SocketOptions.h"
 
 /**
  * A TCP passive channel base class.
@@ -42,6 +43,14 @@ public:
      */
     virtual void AsyncClose(const IAsyncChannelHandler::ptr_t &handler) override;
 
+    /**
+     * Applies socket options to the connection(accepted connections already got the listener's options).
+     *
+     * @param options The socket options.
+     * @param [out] error The first error.
+     */
+    void SetSocketOptions(const SocketOptions &options, boost::system::error_code &error);
+
 private:
 
     /**
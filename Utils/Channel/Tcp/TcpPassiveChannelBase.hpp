@@ -36,11 +36,19 @@ template<typename ProtocolTraits, const char *LoggerName> void TcpPassiveChannel
     QueueThreadPoolWorkItem([handler = handler, err = shutdownErr ? shutdownErr : closeErr]() { handler->EndClose(err); });
 }
 
+template<typename ProtocolTraits, const char *LoggerName> void TcpPassiveChannelBase<ProtocolTraits, LoggerName>::SetSocketOptions(
+    const SocketOptions &options, boost::system::error_code &error)
+{
+    SpinLock<>::ScopeLock lock(BaseType::m_lock);
+    options.ApplyTo(*BaseType::m_stream, error);
+}
+
 template<typename ProtocolTraits, const char *LoggerName> void TcpPassiveChannelBase<ProtocolTraits, LoggerName>::Close(boost::system::error_code &shutdownErr
     , boost::system::error_code &closeErr)
 {
     if (!m_closed)
     {
+        BaseType::DetachIoUring();
         BaseType::m_stream->shutdown(boost::asio::socket_base::shutdown_both, shutdownErr);
         if (shutdownErr)
         {
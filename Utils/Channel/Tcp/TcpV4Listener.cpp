@@ -3,16 +3,4 @@
 
 const char TcpV4ListenerLoggerName[] = "TcpV4Listener";
 
-TcpListenerAcceptFunc *acceptFunc = nullptr;
-
-void SetListenerAcceptFunc(TcpListenerAcceptFunc *func)
-{
-    acceptFunc = func;
-}
-
-void TcpListenerAcceptEntry(std::shared_ptr<boost::asio::ip::tcp::endpoint> &remoteEndPoint, std::shared_ptr<boost::asio::ip::tcp::socket> &sock)
-{
-    acceptFunc(remoteEndPoint, sock);
-}
-
 template class UTILS_DEF_API TcpListenerBase<TcpV4Traits, TcpListenerAcceptFunc, TcpListenerAcceptEntry, TcpV4ListenerLoggerName>;
\ No newline at end of file
@@ -2,16 +2,11 @@
 #define TCPV4LISTENER_H
 
 #include "TcpListenerBase.h"
+#include "TcpListenerAccept.h"
 #include "../Traits/TcpV4Traits.h"
 
 extern const char TcpV4ListenerLoggerName[];
 
-using TcpListenerAcceptFunc = void (std::shared_ptr<boost::asio::ip::tcp::endpoint> &, std::shared_ptr<boost::asio::ip::tcp::socket> &);
-
-void TcpListenerAcceptEntry(std::shared_ptr<boost::asio::ip::tcp::endpoint> &remoteEndPoint, std::shared_ptr<boost::asio::ip::tcp::socket> &sock);
-
-UTILS_EXPORTS_API void SetListenerAcceptFunc(TcpListenerAcceptFunc *func);
-
 /**
  * TCP v4 listener.
  */
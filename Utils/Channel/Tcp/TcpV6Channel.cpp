@@ -0,0 +1,6 @@
+#include "TcpV6Channel.h"
+#include "TcpChannelBase.hpp"
+
+const char TcpV6ChannelLoggerName[] = "TcpV6Channel";
+
+template class UTILS_DEF_API TcpChannelBase<TcpV6Traits, TcpV6ChannelLoggerName>;
\ No newline at end of file
@@ -0,0 +1,16 @@
+#ifndef TCPV6CHANNEL_H
+#define TCPV6CHANNEL_H
+
+#include "TcpChannelBase.h"
+#include "../Traits/TcpV6Traits.h"
+
+extern const char TcpV6ChannelLoggerName[];
+
+/**
+ * TCP v6 channel.
+ */
+using TcpV6Channel = TcpChannelBase<TcpV6Traits, TcpV6ChannelLoggerName>;
+
+extern template class UTILS_DECL_API TcpChannelBase<TcpV6Traits, TcpV6ChannelLoggerName>;
+
+#endif /* TCPV6CHANNEL_H */
\ No newline at end of file
@@ -0,0 +1,6 @@
+#include "TcpV6Listener.h"
+#include "TcpListenerBase.hpp"
+
+const char TcpV6ListenerLoggerName[] = "TcpV6Listener";
+
+template class UTILS_DEF_API TcpListenerBase<TcpV6Traits, TcpListenerAcceptFunc, TcpListenerAcceptEntry, TcpV6ListenerLoggerName>;
\ No newline at end of file
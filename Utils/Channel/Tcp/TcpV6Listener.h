@@ -0,0 +1,17 @@
+#ifndef TCPV6LISTENER_H
+#define TCPV6LISTENER_H
+
+#include "TcpListenerBase.h"
+#include "TcpListenerAccept.h"
+#include "../Traits/TcpV6Traits.h"
+
+extern const char TcpV6ListenerLoggerName[];
+
+/**
+ * TCP v6 listener(end points are dual-stack unless TcpListenerSettings::m_v6Only is set).
+ */
+using TcpV6Listener = TcpListenerBase<TcpV6Traits, TcpListenerAcceptFunc, TcpListenerAcceptEntry, TcpV6ListenerLoggerName>;
+
+extern template class UTILS_DECL_API TcpListenerBase<TcpV6Traits, TcpListenerAcceptFunc, TcpListenerAcceptEntry, TcpV6ListenerLoggerName>;
+
+#endif /* TCPV6LISTENER_H */
\ No newline at end of file
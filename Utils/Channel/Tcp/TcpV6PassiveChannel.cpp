@@ -0,0 +1,6 @@
+#include "TcpV6PassiveChannel.h"
+#include "TcpPassiveChannelBase.hpp"
+
+const char TcpV6PassiveChannelLoggerName[] = "TcpV6PassiveChannel";
+
+template class UTILS_DEF_API TcpPassiveChannelBase<TcpV6Traits, TcpV6PassiveChannelLoggerName>;
\ No newline at end of file
@@ -0,0 +1,16 @@
+#ifndef TCPV6PASSIVECHANNEL_H
+#define TCPV6PASSIVECHANNEL_H
+
+#include "TcpPassiveChannelBase.h"
+#include "../Traits/TcpV6Traits.h"
+
+extern const char TcpV6PassiveChannelLoggerName[];
+
+/**
+ * TCP v6 passive channel.
+ */
+using TcpV6PassiveChannel = TcpPassiveChannelBase<TcpV6Traits, TcpV6PassiveChannelLoggerName>;
+
+extern template class UTILS_DECL_API TcpPassiveChannelBase<TcpV6Traits, TcpV6PassiveChannelLoggerName>;
+
+#endif /* TCPV6PASSIVECHANNEL_H */
\ No newline at end of file
@@ -2,6 +2,7 @@
 #define TCPV4TRAITS_H
 
 #include <boost/asio.hpp>
+#include "../Tcp/SocketOptions.h"
 
 /**
  * A TCP v4 traits class.
@@ -61,6 +62,16 @@ public:
     {
         return "0.0.0.0";
     }
+
+    /**
+     * Gets the default socket options of channels and accepted connections.
+     *
+     * @return The system defaults.
+     */
+    static SocketOptions DefaultSocketOptions()
+    {
+        return SocketOptions::Default();
+    }
 };
 
 #endif /* TCPV4TRAITS_H */
\ No newline at end of file
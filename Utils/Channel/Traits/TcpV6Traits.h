@@ -0,0 +1,77 @@
+#ifndef TCPV6TRAITS_H
+#define TCPV6TRAITS_H
+
+#include <boost/asio.hpp>
+#include "../Tcp/SocketOptions.h"
+
+/**
+ * A TCP v6 traits class.
+ */
+class TcpV6Traits
+{
+public:
+
+    /**
+     * Defines an alias representing type of the address.
+     */
+    using AddressType = boost::asio::ip::address_v6;
+
+    /**
+     * Defines an alias representing type of the basic stream.
+     */
+    using StreamType = boost::asio::ip::tcp::socket;
+
+    /**
+     * Gets the protocol representation.
+     *
+     * @return A boost::asio::ip::tcp.
+     */
+    static boost::asio::ip::tcp Protocol()
+    {
+        return boost::asio::ip::tcp::v6();
+    }
+
+    /**
+     * Convert a TCP v6 address from a string.
+     *
+     * @param addr The address string.
+     *
+     * @return Address convertted from address string.
+     */
+    static AddressType AddressFromString(const std::string &addr)
+    {
+        return AddressType::from_string(addr);
+    }
+
+    /**
+     * Get the any address.
+     *
+     * @return Any address.
+     */
+    static AddressType AnyAddress()
+    {
+        return AddressType::any();
+    }
+
+    /**
+     * Get the any address string representation.
+     *
+     * @return A std::string represent any address.
+     */
+    static std::string AnyAddressString()
+    {
+        return "::";
+    }
+
+    /**
+     * Gets the default socket options of channels and accepted connections.
+     *
+     * @return The system defaults.
+     */
+    static SocketOptions DefaultSocketOptions()
+    {
+        return SocketOptions::Default();
+    }
+};
+
+#endif /* TCPV6TRAITS_H */
\ No newline at end of file
@@ -0,0 +1,38 @@
+#ifndef UNIXSTREAMTRAITS_H
+#define UNIXSTREAMTRAITS_H
+
+#include <boost/asio.hpp>
+
+#if defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
+
+/**
+ * A unix domain stream socket traits class.
+ */
+class UnixStreamTraits
+{
+public:
+
+    /**
+     * Defines an alias representing type of the basic stream.
+     */
+    using StreamType = boost::asio::local::stream_protocol::socket;
+
+    /**
+     * Defines an alias representing type of the end point.
+     */
+    using EndPointType = boost::asio::local::stream_protocol::endpoint;
+
+    /**
+     * Gets the protocol representation.
+     *
+     * @return A boost::asio::local::stream_protocol.
+     */
+    static boost::asio::local::stream_protocol Protocol()
+    {
+        return boost::asio::local::stream_protocol();
+    }
+};
+
+#endif
+
+#endif /* UNIXSTREAMTRAITS_H */
\ No newline at end of file
@@ -0,0 +1,17 @@
+#ifndef DATAGRAM_H
+#define DATAGRAM_H
+
+#include <boost/asio.hpp>
+#include "../../Buffer/LinearBufferCache.h"
+
+/**
+ * A received datagram.
+ */
+struct Datagram
+{
+    std::shared_ptr<LinearBuffer> m_buf;    /**< The payload(size is the datagram length),the buffer is reused by the next receive unless moved out. */
+
+    boost::asio::ip::udp::endpoint m_remoteEndPoint;    /**< The end point the datagram is sent from. */
+};
+
+#endif /* DATAGRAM_H */
\ No newline at end of file
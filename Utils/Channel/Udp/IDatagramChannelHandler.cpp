@@ -0,0 +1,7 @@
+#include "IDatagramChannelHandler.h"
+
+IDatagramChannelHandler::IDatagramChannelHandler() = default;
+
+IDatagramChannelHandler::~IDatagramChannelHandler()
+{
+}
\ No newline at end of file
@@ -0,0 +1,65 @@
+#ifndef IDATAGRAMCHANNELHANDLER_H
+#define IDATAGRAMCHANNELHANDLER_H
+
+#include <memory>
+#include <boost/system/error_code.hpp>
+#include "../../Common/CommonHdr.h"
+#include "Datagram.h"
+
+/**
+ * The interface of datagram channel callback handler.
+ */
+class UTILS_EXPORTS_API IDatagramChannelHandler
+{
+public:
+
+    /**
+     * Defines an alias representing the std::shared_ptr<IDatagramChannelHandler>.
+     */
+    using ptr_t = std::shared_ptr<IDatagramChannelHandler>;
+
+    /**
+     * Default constructor
+     */
+    IDatagramChannelHandler();
+
+    /**
+     * Destructor
+     */
+    virtual ~IDatagramChannelHandler();
+
+    /**
+     * The handler to be called when the open operation completes.
+     *
+     * @param err Result of operation.
+     */
+    virtual void EndOpen(const boost::system::error_code &err) = 0;
+
+    /**
+     * The handler to be called when a batch of datagrams is received.
+     *
+     * @param err Result of operation.
+     * @param datagrams The received datagrams(valid until the handler returns,move Datagram::m_buf out to keep the payload).
+     * @param count Number of received datagrams(0 if an error occurred).
+     * @param ctx User defined context data,passed to @ref UdpChannel::AsyncReceive.
+     */
+    virtual void EndReceive(const boost::system::error_code &err, Datagram datagrams[], std::size_t count, void *ctx) = 0;
+
+    /**
+     * The handler to be called when a datagram is sent.
+     *
+     * @param err Result of operation.
+     * @param bytesTransferred Number of bytes sent.
+     * @param ctx User defined context data,passed to @ref UdpChannel::AsyncSendTo.
+     */
+    virtual void EndSend(const boost::system::error_code &err, std::size_t bytesTransferred, void *ctx) = 0;
+
+    /**
+     * The handler to be called when the close operation completes.
+     *
+     * @param err Result of operation.
+     */
+    virtual void EndClose(const boost::system::error_code &err) = 0;
+};
+
+#endif /* IDATAGRAMCHANNELHANDLER_H */
\ No newline at end of file
@@ -0,0 +1,376 @@
+#include <algorithm>
+#include "UdpChannel.h"
+#include "../../Concurrent/ThreadPool.h"
+
+#if defined(__linux__)
+#include <cerrno>
+#include <cstring>
+#include <sys/socket.h>
+#endif
+
+/**
+ * Storage of a receive batch(the buffers of undelivered or not moved out datagrams are reused).
+ */
+struct UdpChannel::ReceiveBatch
+{
+    std::vector<Datagram> m_datagrams;  /**< The datagrams. */
+#if defined(__linux__)
+    std::vector<mmsghdr> m_headers; /**< Message headers of recvmmsg. */
+
+    std::vector<iovec> m_iovs;  /**< Payload buffers of recvmmsg. */
+#endif
+};
+
+/**
+ * Storage of a send batch.
+ */
+struct UdpChannel::SendBatch
+{
+    std::vector<SendReq> m_reqs;    /**< The requests being sent. */
+#if defined(__linux__)
+    std::vector<mmsghdr> m_headers; /**< Message headers of sendmmsg. */
+
+    std::vector<iovec> m_iovs;  /**< Payload buffers of sendmmsg. */
+#endif
+};
+
+log4cplus::Logger UdpChannel::log = log4cplus::Logger::getInstance("UdpChannel");
+
+UdpChannel::UdpChannel(const UdpChannelSettings &settings) :m_socket(ThreadPool::Instance().Context()), m_settings(settings), m_lock()
+    , m_sendQueue(), m_sending(false), m_receiveBatch(), m_sendBatch(new SendBatch())
+{
+    if (m_settings.m_receiveBatchSize == 0)
+    {
+        m_settings.m_receiveBatchSize = 1;
+    }
+    if (m_settings.m_sendBatchSize == 0)
+    {
+        m_settings.m_sendBatchSize = 1;
+    }
+}
+
+UdpChannel::~UdpChannel()
+{
+    boost::system::error_code err;
+    m_socket.close(err);
+}
+
+void UdpChannel::AsyncOpen(const IDatagramChannelHandler::ptr_t &handler)
+{
+    SpinLock<>::ScopeLock lock(m_lock);
+    boost::system::error_code err;
+    if (!m_socket.open(m_settings.m_localEndPoint.protocol(), err))
+    {
+        if ((m_settings.m_reuseAddress && m_socket.set_option(boost::asio::socket_base::reuse_address(true), err))
+            || m_socket.bind(m_settings.m_localEndPoint, err) || m_socket.non_blocking(true, err))
+        {
+            boost::system::error_code closeErr;
+            m_socket.close(closeErr);
+            LOG4CPLUS_ERROR(log, "绑定Udp通道错误，终结点：" << m_settings.m_localEndPoint << "，错误信息：" << err.message());
+        }
+    }
+    else
+    {
+        LOG4CPLUS_ERROR_FMT(log, "打开Udp通道错误：%s", err.message().c_str());
+    }
+    QueueThreadPoolWorkItem([handler = handler, err = err]() { handler->EndOpen(err); });
+}
+
+void UdpChannel::AsyncReceive(const IDatagramChannelHandler::ptr_t &handler, void *ctx)
+{
+    SpinLock<>::ScopeLock lock(m_lock);
+    m_socket.async_wait(boost::asio::socket_base::wait_read, [self = shared_from_this(), handler = handler, ctx]
+        (const boost::system::error_code &err)
+        {
+            self->EndWaitReceive(handler, ctx, err);
+        });
+}
+
+void UdpChannel::AsyncSendTo(const std::shared_ptr<LinearBuffer> &buf, size_t sendOffset, size_t sendLen
+    , const boost::asio::ip::udp::endpoint &remoteEndPoint, const IDatagramChannelHandler::ptr_t &handler, void *ctx)
+{
+    QueueSendReq(SendReq{ handler, buf, buf->data() + sendOffset, sendLen, remoteEndPoint, ctx });
+}
+
+void UdpChannel::AsyncSendCopy(const void *data, size_t sendLen, const boost::asio::ip::udp::endpoint &remoteEndPoint
+    , const IDatagramChannelHandler::ptr_t &handler, void *ctx)
+{
+    std::shared_ptr<LinearBuffer> copy = LinearBufferCache::Instance().Get(sendLen);
+    if (!copy)
+    {
+        copy = std::make_shared<LinearBuffer>(sendLen);
+    }
+    copy->append(data, sendLen);
+    const us8 *payload = copy->data();
+    QueueSendReq(SendReq{ handler, std::move(copy), payload, sendLen, remoteEndPoint, ctx });
+}
+
+void UdpChannel::JoinMulticastGroup(const boost::asio::ip::address &group, boost::system::error_code &error)
+{
+    SpinLock<>::ScopeLock lock(m_lock);
+    m_socket.set_option(boost::asio::ip::multicast::join_group(group), error);
+}
+
+void UdpChannel::LeaveMulticastGroup(const boost::asio::ip::address &group, boost::system::error_code &error)
+{
+    SpinLock<>::ScopeLock lock(m_lock);
+    m_socket.set_option(boost::asio::ip::multicast::leave_group(group), error);
+}
+
+boost::asio::ip::udp::endpoint UdpChannel::LocalEndPoint(boost::system::error_code &error)
+{
+    SpinLock<>::ScopeLock lock(m_lock);
+    return m_socket.local_endpoint(error);
+}
+
+void UdpChannel::AsyncClose(const IDatagramChannelHandler::ptr_t &handler)
+{
+    SpinLock<>::ScopeLock lock(m_lock);
+    boost::system::error_code err;
+    if (m_socket.is_open())
+    {
+        m_socket.close(err);
+        if (err)
+        {
+            LOG4CPLUS_ERROR_FMT(log, "关闭Udp通道错误：%s", err.message().c_str());
+        }
+    }
+    QueueThreadPoolWorkItem([handler = handler, err = err]() { handler->EndClose(err); });
+}
+
+void UdpChannel::QueueSendReq(SendReq &&req)
+{
+    SpinLock<>::ScopeLock lock(m_lock);
+    m_sendQueue.push_back(std::move(req));
+    if (!m_sending)
+    {
+        m_sending = true;
+        m_socket.async_wait(boost::asio::socket_base::wait_write, [self = shared_from_this()](const boost::system::error_code &err)
+            {
+                self->EndWaitSend(err);
+            });
+    }
+}
+
+void UdpChannel::EndWaitReceive(const IDatagramChannelHandler::ptr_t &handler, void *ctx, const boost::system::error_code &err)
+{
+    if (err)
+    {
+        handler->EndReceive(err, nullptr, 0, ctx);
+        return;
+    }
+    std::unique_ptr<ReceiveBatch> batch;
+    {
+        SpinLock<>::ScopeLock lock(m_lock);
+        batch = std::move(m_receiveBatch);
+    }
+    if (!batch)
+    {
+        //the cached batch is still being delivered by another thread.
+        batch.reset(new ReceiveBatch());
+        batch->m_datagrams.resize(m_settings.m_receiveBatchSize);
+#if defined(__linux__)
+        batch->m_headers.resize(m_settings.m_receiveBatchSize);
+        batch->m_iovs.resize(m_settings.m_receiveBatchSize);
+#endif
+    }
+    boost::system::error_code recvErr;
+    size_t count = ReceiveSome(*batch, recvErr);
+    if (recvErr == boost::asio::error::would_block || recvErr == boost::asio::error::try_again)
+    {
+        //woken up spuriously(e.g. another receiver of the same socket took the datagrams).
+        SpinLock<>::ScopeLock lock(m_lock);
+        if (!m_receiveBatch)
+        {
+            m_receiveBatch = std::move(batch);
+        }
+        m_socket.async_wait(boost::asio::socket_base::wait_read, [self = shared_from_this(), handler = handler, ctx]
+            (const boost::system::error_code &err)
+            {
+                self->EndWaitReceive(handler, ctx, err);
+            });
+        return;
+    }
+    if (recvErr)
+    {
+        LOG4CPLUS_ERROR_FMT(log, "Udp通道接收错误：%s", recvErr.message().c_str());
+    }
+    handler->EndReceive(recvErr, batch->m_datagrams.data(), count, ctx);
+    SpinLock<>::ScopeLock lock(m_lock);
+    if (!m_receiveBatch)
+    {
+        m_receiveBatch = std::move(batch);
+    }
+}
+
+size_t UdpChannel::ReceiveSome(ReceiveBatch &batch, boost::system::error_code &error)
+{
+    size_t ret = 0;
+    size_t count = batch.m_datagrams.size();
+    for (size_t i = 0; i < count; ++i)
+    {
+        //refills the slots whose buffers were moved out by the handler.
+        Datagram &datagram = batch.m_datagrams[i];
+        if (!datagram.m_buf)
+        {
+            datagram.m_buf = LinearBufferCache::Instance().Get(m_settings.m_maxDatagramSize);
+            if (!datagram.m_buf)
+            {
+                datagram.m_buf = std::make_shared<LinearBuffer>(m_settings.m_maxDatagramSize);
+            }
+        }
+        datagram.m_buf->clear();
+    }
+#if defined(__linux__)
+    for (size_t i = 0; i < count; ++i)
+    {
+        Datagram &datagram = batch.m_datagrams[i];
+        batch.m_iovs[i].iov_base = datagram.m_buf->data();
+        batch.m_iovs[i].iov_len = m_settings.m_maxDatagramSize;
+        std::memset(&batch.m_headers[i], 0, sizeof(mmsghdr));
+        batch.m_headers[i].msg_hdr.msg_name = datagram.m_remoteEndPoint.data();
+        batch.m_headers[i].msg_hdr.msg_namelen = static_cast<socklen_t>(datagram.m_remoteEndPoint.capacity());
+        batch.m_headers[i].msg_hdr.msg_iov = &batch.m_iovs[i];
+        batch.m_headers[i].msg_hdr.msg_iovlen = 1;
+    }
+    int received = ::recvmmsg(m_socket.native_handle(), batch.m_headers.data(), static_cast<unsigned int>(count), MSG_DONTWAIT, nullptr);
+    if (received < 0)
+    {
+        error.assign(errno, boost::system::system_category());
+        return ret;
+    }
+    ret = static_cast<size_t>(received);
+    for (size_t i = 0; i < ret; ++i)
+    {
+        Datagram &datagram = batch.m_datagrams[i];
+        datagram.m_buf->inc_size(batch.m_headers[i].msg_len);
+        datagram.m_remoteEndPoint.resize(batch.m_headers[i].msg_hdr.msg_namelen);
+    }
+#else
+    for (; ret < count; ++ret)
+    {
+        Datagram &datagram = batch.m_datagrams[ret];
+        size_t size = m_socket.receive_from(boost::asio::buffer(datagram.m_buf->data(), m_settings.m_maxDatagramSize)
+            , datagram.m_remoteEndPoint, 0, error);
+        if (error)
+        {
+            if (ret != 0 && (error == boost::asio::error::would_block || error == boost::asio::error::try_again))
+            {
+                error.clear();
+            }
+            break;
+        }
+        datagram.m_buf->inc_size(size);
+    }
+#endif
+    return ret;
+}
+
+void UdpChannel::EndWaitSend(const boost::system::error_code &err)
+{
+    std::vector<SendReq> &reqs = m_sendBatch->m_reqs;
+    {
+        SpinLock<>::ScopeLock lock(m_lock);
+        size_t count = err ? m_sendQueue.size() : std::min(m_sendQueue.size(), m_settings.m_sendBatchSize);
+        for (size_t i = 0; i < count; ++i)
+        {
+            reqs.push_back(std::move(m_sendQueue.front()));
+            m_sendQueue.pop_front();
+        }
+        if (err)
+        {
+            m_sending = false;
+        }
+    }
+    if (err)
+    {
+        for (auto &req : reqs)
+        {
+            req.m_handler->EndSend(err, 0, req.m_ctx);
+        }
+        reqs.clear();
+        return;
+    }
+
+    boost::system::error_code sendErr, success;
+    size_t sent = SendSome(sendErr);
+    for (size_t i = 0; i < sent; ++i)
+    {
+        reqs[i].m_handler->EndSend(success, reqs[i].m_size, reqs[i].m_ctx);
+    }
+    if (sendErr && sendErr != boost::asio::error::would_block && sendErr != boost::asio::error::try_again && sent < reqs.size())
+    {
+        //a datagram can fail on its own(e.g. message_size or an unreachable destination),the others are sent later.
+        LOG4CPLUS_DEBUG(log, "Udp通道发送错误，终结点：" << reqs[sent].m_remoteEndPoint << "，错误信息：" << sendErr.message());
+        reqs[sent].m_handler->EndSend(sendErr, 0, reqs[sent].m_ctx);
+        ++sent;
+    }
+    SpinLock<>::ScopeLock lock(m_lock);
+    for (size_t i = reqs.size(); i > sent; --i)
+    {
+        m_sendQueue.push_front(std::move(reqs[i - 1]));
+    }
+    reqs.clear();
+    if (m_sendQueue.empty())
+    {
+        m_sending = false;
+    }
+    else
+    {
+        m_socket.async_wait(boost::asio::socket_base::wait_write, [self = shared_from_this()](const boost::system::error_code &err)
+            {
+                self->EndWaitSend(err);
+            });
+    }
+}
+
+size_t UdpChannel::SendSome(boost::system::error_code &error)
+{
+    std::vector<SendReq> &reqs = m_sendBatch->m_reqs;
+    size_t ret = 0;
+#if defined(__linux__)
+    m_sendBatch->m_headers.resize(reqs.size());
+    m_sendBatch->m_iovs.resize(reqs.size());
+    for (size_t i = 0; i < reqs.size(); ++i)
+    {
+        m_sendBatch->m_iovs[i].iov_base = const_cast<us8*>(reqs[i].m_data);
+        m_sendBatch->m_iovs[i].iov_len = reqs[i].m_size;
+        std::memset(&m_sendBatch->m_headers[i], 0, sizeof(mmsghdr));
+        m_sendBatch->m_headers[i].msg_hdr.msg_name = reqs[i].m_remoteEndPoint.data();
+        m_sendBatch->m_headers[i].msg_hdr.msg_namelen = static_cast<socklen_t>(reqs[i].m_remoteEndPoint.size());
+        m_sendBatch->m_headers[i].msg_hdr.msg_iov = &m_sendBatch->m_iovs[i];
+        m_sendBatch->m_headers[i].msg_hdr.msg_iovlen = 1;
+    }
+    int sent = ::sendmmsg(m_socket.native_handle(), m_sendBatch->m_headers.data(), static_cast<unsigned int>(reqs.size()), MSG_DONTWAIT);
+    if (sent < 0)
+    {
+        error.assign(errno, boost::system::system_category());
+    }
+    else
+    {
+        ret = static_cast<size_t>(sent);
+        if (ret < reqs.size())
+        {
+            //sendmmsg stops at the first failed datagram,sending it alone gets its error.
+            if (::sendmsg(m_socket.native_handle(), &m_sendBatch->m_headers[ret].msg_hdr, MSG_DONTWAIT) < 0)
+            {
+                error.assign(errno, boost::system::system_category());
+            }
+            else
+            {
+                ++ret;
+            }
+        }
+    }
+#else
+    for (; ret < reqs.size(); ++ret)
+    {
+        m_socket.send_to(boost::asio::buffer(reqs[ret].m_data, reqs[ret].m_size), reqs[ret].m_remoteEndPoint, 0, error);
+        if (error)
+        {
+            break;
+        }
+    }
+#endif
+    return ret;
+}
\ No newline at end of file
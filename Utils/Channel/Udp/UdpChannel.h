@@ -0,0 +1,210 @@
+#ifndef UDPCHANNEL_H
+#define UDPCHANNEL_H
+
+#include <deque>
+#include <memory>
+#include <vector>
+#include <boost/asio.hpp>
+#include "../../Common/CommonHdr.h"
+#include "../../Log/Log4cplusCustomInc.h"
+#include "../../Concurrent/SpinLock.h"
+#include "IDatagramChannelHandler.h"
+#include "UdpChannelSettings.h"
+
+/**
+ * UDP datagram channel.
+ *
+ * Datagrams are received in batches(recvmmsg on Linux,one system call fills up to UdpChannelSettings::m_receiveBatchSize buffers
+ * taken from LinearBufferCache,or from heap if no cached buffer fits) and queued sends are flushed in batches(sendmmsg on Linux).
+ * Other platforms receive and send the batch datagram by datagram.
+ *
+ * @note Must be owned by a std::shared_ptr.
+ */
+class UTILS_EXPORTS_API UdpChannel :public std::enable_shared_from_this<UdpChannel>
+{
+public:
+
+    /**
+     * Defines an alias representing the pointer to self.
+     */
+    using ptr_t = std::shared_ptr<UdpChannel>;
+
+    /**
+     * Constructor
+     *
+     * @param settings The channel settings.
+     */
+    UdpChannel(const UdpChannelSettings &settings);
+
+    /**
+     * Copy constructor(deleted)
+     */
+    UdpChannel(const UdpChannel&) = delete;
+
+    /**
+     * Destructor
+     */
+    ~UdpChannel();
+
+    /**
+     * Assignment operator(deleted)
+     *
+     * @return Equal to *this.
+     */
+    UdpChannel& operator=(const UdpChannel&) = delete;
+
+    /**
+     * Opens the socket and binds the local end point.
+     *
+     * @param handler The callback handler.
+     */
+    void AsyncOpen(const IDatagramChannelHandler::ptr_t &handler);
+
+    /**
+     * Receives a batch of datagrams(only one receive operation may be outstanding).
+     *
+     * @param handler The callback handler.
+     * @param ctx (Optional) User defined context data passed to IDatagramChannelHandler::EndReceive.
+     */
+    void AsyncReceive(const IDatagramChannelHandler::ptr_t &handler, void *ctx = nullptr);
+
+    /**
+     * Queues a datagram to be sent.
+     *
+     * @param buf The buffer(held until the datagram is sent).
+     * @param sendOffset The offset of the payload.
+     * @param sendLen The size of the payload.
+     * @param remoteEndPoint The destination.
+     * @param handler The callback handler.
+     * @param ctx (Optional) User defined context data passed to IDatagramChannelHandler::EndSend.
+     */
+    void AsyncSendTo(const std::shared_ptr<LinearBuffer> &buf, size_t sendOffset, size_t sendLen, const boost::asio::ip::udp::endpoint &remoteEndPoint
+        , const IDatagramChannelHandler::ptr_t &handler, void *ctx = nullptr);
+
+    /**
+     * Copies a datagram into a buffer from LinearBufferCache(from heap if no cached buffer fits) and queues it to be sent.
+     *
+     * @param data The payload.
+     * @param sendLen The size of the payload.
+     * @param remoteEndPoint The destination.
+     * @param handler The callback handler.
+     * @param ctx (Optional) User defined context data passed to IDatagramChannelHandler::EndSend.
+     */
+    void AsyncSendCopy(const void *data, size_t sendLen, const boost::asio::ip::udp::endpoint &remoteEndPoint
+        , const IDatagramChannelHandler::ptr_t &handler, void *ctx = nullptr);
+
+    /**
+     * Joins a multicast group(the channel must be opened).
+     *
+     * @param group The group address.
+     * @param [out] error The operation result.
+     */
+    void JoinMulticastGroup(const boost::asio::ip::address &group, boost::system::error_code &error);
+
+    /**
+     * Leaves a multicast group.
+     *
+     * @param group The group address.
+     * @param [out] error The operation result.
+     */
+    void LeaveMulticastGroup(const boost::asio::ip::address &group, boost::system::error_code &error);
+
+    /**
+     * Gets the bound local end point.
+     *
+     * @param [out] error The operation result.
+     *
+     * @return The local end point.
+     */
+    boost::asio::ip::udp::endpoint LocalEndPoint(boost::system::error_code &error);
+
+    /**
+     * Closes the socket,the outstanding receive and the queued sends complete with boost::asio::error::operation_aborted.
+     *
+     * @param handler The callback handler.
+     */
+    void AsyncClose(const IDatagramChannelHandler::ptr_t &handler);
+
+private:
+    /**
+     * A send request.
+     */
+    struct SendReq
+    {
+        IDatagramChannelHandler::ptr_t m_handler;   /**< Request's callback handler. */
+
+        std::shared_ptr<LinearBuffer> m_buf;    /**< Request's buffer(the copied payload of @ref AsyncSendCopy). */
+
+        const us8 *m_data;  /**< The payload. */
+
+        size_t m_size;  /**< Size of the payload. */
+
+        boost::asio::ip::udp::endpoint m_remoteEndPoint;    /**< The destination. */
+
+        void *m_ctx;    /**< Request's user defined context data. */
+    };
+
+    struct ReceiveBatch;
+
+    struct SendBatch;
+
+    /**
+     * Queues a send request and starts flushing if no flush is in progress.
+     *
+     * @param [in,out] req The request.
+     */
+    void QueueSendReq(SendReq &&req);
+
+    /**
+     * Internal callback when the socket becomes readable.
+     *
+     * @param handler The callback handler.
+     * @param ctx User defined context data.
+     * @param err The wait result.
+     */
+    void EndWaitReceive(const IDatagramChannelHandler::ptr_t &handler, void *ctx, const boost::system::error_code &err);
+
+    /**
+     * Receives up to a batch of datagrams without blocking.
+     *
+     * @param [in,out] batch The batch storage.
+     * @param [out] error The operation result(boost::asio::error::would_block if nothing was received).
+     *
+     * @return Number of received datagrams.
+     */
+    size_t ReceiveSome(ReceiveBatch &batch, boost::system::error_code &error);
+
+    /**
+     * Internal callback when the socket becomes writable,sends a batch of queued datagrams.
+     *
+     * @param err The wait result.
+     */
+    void EndWaitSend(const boost::system::error_code &err);
+
+    /**
+     * Sends up to a batch of datagrams without blocking.
+     *
+     * @param [out] error The error of the first datagram not sent.
+     *
+     * @return Number of sent datagrams of m_sendBatch.
+     */
+    size_t SendSome(boost::system::error_code &error);
+
+    static log4cplus::Logger log;   /**< The logger. */
+
+    boost::asio::ip::udp::socket m_socket;  /**< The socket. */
+
+    UdpChannelSettings m_settings;  /**< The settings. */
+
+    SpinLock<> m_lock;  /**< Internal lock used for thread safe. */
+
+    std::deque<SendReq> m_sendQueue;    /**< Queued send requests. */
+
+    bool m_sending; /**< True if a flush is in progress. */
+
+    std::unique_ptr<ReceiveBatch> m_receiveBatch;   /**< Cached receive batch storage(null while a batch is delivered). */
+
+    std::unique_ptr<SendBatch> m_sendBatch; /**< Send batch storage(only used by the flush in progress). */
+};
+
+#endif /* UDPCHANNEL_H */
\ No newline at end of file
@@ -0,0 +1,24 @@
+#ifndef UDPCHANNELSETTINGS_H
+#define UDPCHANNELSETTINGS_H
+
+#include <cstddef>
+#include <boost/asio.hpp>
+
+/**
+ * A UDP channel settings(a default constructed one binds an IPv4 wildcard end point with an ephemeral port).
+ */
+struct UdpChannelSettings
+{
+    boost::asio::ip::udp::endpoint m_localEndPoint{ boost::asio::ip::udp::v4(), 0 };  /**< The local end point to bind(port 0 selects a port,
+                                                                                         the address selects the protocol). */
+
+    std::size_t m_maxDatagramSize = 2048;   /**< Max size of a received datagram(longer datagrams are truncated). */
+
+    std::size_t m_receiveBatchSize = 32;    /**< Max number of datagrams received per wakeup. */
+
+    std::size_t m_sendBatchSize = 16;   /**< Max number of queued datagrams sent per system call. */
+
+    bool m_reuseAddress = false;    /**< True to set SO_REUSEADDR before binding(required by several receivers of a multicast group). */
+};
+
+#endif /* UDPCHANNELSETTINGS_H */
\ No newline at end of file
@@ -0,0 +1,98 @@
+#include "UnixFdPassing.h"
+
+#if defined(IS_UNIX) && defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
+
+#include <cerrno>
+#include <cstring>
+#include <sys/socket.h>
+
+#if defined(MSG_CMSG_CLOEXEC)
+#define RECV_FD_FLAGS MSG_CMSG_CLOEXEC
+#else
+#define RECV_FD_FLAGS 0
+#endif
+
+bool UnixFdPassing::SendFileDescriptor(UnixStreamTraits::StreamType &sock, int fd, boost::system::error_code &error)
+{
+    char payload = 0;
+    iovec iov = { &payload, sizeof(payload) };
+    alignas(cmsghdr) char control[CMSG_SPACE(sizeof(int))];
+    std::memset(control, 0, sizeof(control));
+    msghdr msg;
+    std::memset(&msg, 0, sizeof(msg));
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    msg.msg_control = control;
+    msg.msg_controllen = sizeof(control);
+    cmsghdr *cmsg = CMSG_FIRSTHDR(&msg);
+    cmsg->cmsg_level = SOL_SOCKET;
+    cmsg->cmsg_type = SCM_RIGHTS;
+    cmsg->cmsg_len = CMSG_LEN(sizeof(int));
+    std::memcpy(CMSG_DATA(cmsg), &fd, sizeof(int));
+    error.clear();
+    while (::sendmsg(sock.native_handle(), &msg, MSG_NOSIGNAL) < 0)
+    {
+        if (errno == EAGAIN || errno == EWOULDBLOCK)
+        {
+            //the socket is in non-blocking mode after any asynchronous operation.
+            if (sock.wait(boost::asio::socket_base::wait_write, error))
+            {
+                return false;
+            }
+        }
+        else if (errno != EINTR)
+        {
+            error.assign(errno, boost::system::system_category());
+            return false;
+        }
+    }
+    return true;
+}
+
+int UnixFdPassing::ReceiveFileDescriptor(UnixStreamTraits::StreamType &sock, boost::system::error_code &error)
+{
+    char payload = 0;
+    iovec iov = { &payload, sizeof(payload) };
+    alignas(cmsghdr) char control[CMSG_SPACE(sizeof(int))];
+    msghdr msg;
+    std::memset(&msg, 0, sizeof(msg));
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    msg.msg_control = control;
+    msg.msg_controllen = sizeof(control);
+    error.clear();
+    ssize_t ret;
+    while ((ret = ::recvmsg(sock.native_handle(), &msg, RECV_FD_FLAGS)) < 0)
+    {
+        if (errno == EAGAIN || errno == EWOULDBLOCK)
+        {
+            if (sock.wait(boost::asio::socket_base::wait_read, error))
+            {
+                return -1;
+            }
+        }
+        else if (errno != EINTR)
+        {
+            error.assign(errno, boost::system::system_category());
+            return -1;
+        }
+    }
+    if (ret == 0)
+    {
+        error = boost::asio::error::eof;
+        return -1;
+    }
+    for (cmsghdr *cmsg = CMSG_FIRSTHDR(&msg); cmsg != nullptr; cmsg = CMSG_NXTHDR(&msg, cmsg))
+    {
+        if (cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_RIGHTS && cmsg->cmsg_len == CMSG_LEN(sizeof(int)))
+        {
+            int fd;
+            std::memcpy(&fd, CMSG_DATA(cmsg), sizeof(int));
+            return fd;
+        }
+    }
+    error = boost::asio::error::no_descriptors;
+    return -1;
+}
+
+#endif
\ No newline at end of file
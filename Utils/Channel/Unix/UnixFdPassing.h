@@ -0,0 +1,45 @@
+#ifndef UNIXFDPASSING_H
+#define UNIXFDPASSING_H
+
+#include "../../Common/CommonHdr.h"
+#include "../Traits/UnixStreamTraits.h"
+
+#if defined(IS_UNIX) && defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
+
+/**
+ * Passes file descriptors over unix domain stream sockets(SCM_RIGHTS).
+ *
+ * Each descriptor is sent with a one byte payload,so the receiver must read it with @ref ReceiveFileDescriptor at the same position of
+ * the byte stream.The functions block until the operation completes,call them on a socket without outstanding asynchronous operations
+ * (e.g. right after accept,before it is wrapped by a channel).
+ */
+class UTILS_EXPORTS_API UnixFdPassing
+{
+public:
+
+    /**
+     * Sends a file descriptor.
+     *
+     * @param [in,out] sock The connected socket.
+     * @param fd The file descriptor to be sent(still owned by the caller).
+     * @param [out] error The operation result.
+     *
+     * @return True if it succeeds, false if it fails.
+     */
+    static bool SendFileDescriptor(UnixStreamTraits::StreamType &sock, int fd, boost::system::error_code &error);
+
+    /**
+     * Receives a file descriptor.
+     *
+     * @param [in,out] sock The connected socket.
+     * @param [out] error The operation result(boost::asio::error::eof if the peer closed,boost::asio::error::no_descriptors if the
+     *  message carries no descriptor).
+     *
+     * @return The received file descriptor owned by the caller,-1 if it fails.
+     */
+    static int ReceiveFileDescriptor(UnixStreamTraits::StreamType &sock, boost::system::error_code &error);
+};
+
+#endif
+
+#endif /* UNIXFDPASSING_H */
\ No newline at end of file
@@ -0,0 +1,90 @@
+#include "UnixStreamChannel.h"
+
+#if defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
+
+#include "../../Concurrent/ThreadPool.h"
+#include "../Common/StreamChannelBase.hpp"
+
+const char UnixStreamChannelLoggerName[] = "UnixStreamChannel";
+
+template class UTILS_DEF_API StreamChannelBase<UnixStreamTraits, UnixStreamChannelLoggerName>;
+
+UnixStreamChannel::UnixStreamChannel(const std::string &remotePath, bool openOnConstruct)
+    : StreamChannelBase<UnixStreamTraits, UnixStreamChannelLoggerName>(std::make_shared<UnixStreamTraits::StreamType>(ThreadPool::Instance().Context()))
+    , m_remoteEndPoint(remotePath), m_closed(true)
+{
+    if (openOnConstruct)
+    {
+        boost::system::error_code error;
+        Open(error);
+    }
+}
+
+UnixStreamChannel::~UnixStreamChannel()
+{
+    if (!m_closed)
+    {
+        boost::system::error_code shutdownErr, closeErr;
+        Close(shutdownErr, closeErr);
+    }
+}
+
+void UnixStreamChannel::AsyncOpen(const IAsyncChannelHandler::ptr_t &handler)
+{
+    SpinLock<>::ScopeLock lock(BaseType::m_lock);
+    boost::system::error_code err;
+    if (!BaseType::m_stream->is_open())
+    {
+        Open(err);
+    }
+    if (err)
+    {
+        QueueThreadPoolWorkItem([handler = handler, err = err]() { handler->EndOpen(err); });
+    }
+    else
+    {
+        BaseType::m_stream->async_connect(m_remoteEndPoint, [handler = handler](const boost::system::error_code &err) { handler->EndOpen(err); });
+    }
+}
+
+void UnixStreamChannel::AsyncClose(const IAsyncChannelHandler::ptr_t &handler)
+{
+    SpinLock<>::ScopeLock lock(BaseType::m_lock);
+    boost::system::error_code shutdownErr, closeErr;
+    Close(shutdownErr, closeErr);
+    QueueThreadPoolWorkItem([handler = handler, err = shutdownErr ? shutdownErr : closeErr]() { handler->EndClose(err); });
+}
+
+void UnixStreamChannel::Open(boost::system::error_code &error)
+{
+    BaseType::m_stream->open(UnixStreamTraits::Protocol(), error);
+    if (error)
+    {
+        LOG4CPLUS_ERROR_FMT(BaseType::log, "打开UnixStream通道错误：%s", error.message().c_str());
+    }
+    else
+    {
+        m_closed = false;
+    }
+}
+
+void UnixStreamChannel::Close(boost::system::error_code &shutdownErr, boost::system::error_code &closeErr)
+{
+    if (!m_closed)
+    {
+        BaseType::DetachIoUring();
+        BaseType::m_stream->shutdown(boost::asio::socket_base::shutdown_both, shutdownErr);
+        if (shutdownErr)
+        {
+            LOG4CPLUS_ERROR_FMT(BaseType::log, "停止UnixStream通道错误：%s", shutdownErr.message().c_str());
+        }
+        BaseType::m_stream->close(closeErr);
+        if (closeErr)
+        {
+            LOG4CPLUS_ERROR_FMT(BaseType::log, "关闭UnixStream通道错误：%s", closeErr.message().c_str());
+        }
+        m_closed = true;
+    }
+}
+
+#endif
\ No newline at end of file
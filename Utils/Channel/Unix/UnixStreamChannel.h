@@ -0,0 +1,74 @@
+#ifndef UNIXSTREAMCHANNEL_H
+#define UNIXSTREAMCHANNEL_H
+
+#include "../../Common/CommonHdr.h"
+#include "../Traits/UnixStreamTraits.h"
+
+#if defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
+
+#include "../Common/StreamChannelBase.h"
+
+extern const char UnixStreamChannelLoggerName[];
+
+extern template class UTILS_DECL_API StreamChannelBase<UnixStreamTraits, UnixStreamChannelLoggerName>;
+
+/**
+ * Unix domain stream socket channel(connects to a UnixStreamListener or any other unix domain stream server on the same host).
+ */
+class UTILS_EXPORTS_API UnixStreamChannel :public StreamChannelBase<UnixStreamTraits, UnixStreamChannelLoggerName>
+{
+public:
+
+    /**
+     * Defines an alias representing type of the base class.
+     */
+    using BaseType = StreamChannelBase<UnixStreamTraits, UnixStreamChannelLoggerName>;
+
+    /**
+     * Constructor
+     *
+     * @param remotePath The socket path used to connect.
+     * @param openOnConstruct (Optional) True to open on construct.
+     */
+    UnixStreamChannel(const std::string &remotePath, bool openOnConstruct = true);
+
+    /**
+     * Destructor
+     */
+    virtual ~UnixStreamChannel() override;
+
+    /**
+     * {@inheritDoc}
+     */
+    virtual void AsyncOpen(const IAsyncChannelHandler::ptr_t &handler) override;
+
+    /**
+     * {@inheritDoc}
+     */
+    virtual void AsyncClose(const IAsyncChannelHandler::ptr_t &handler) override;
+
+private:
+
+    /**
+     * Opens the this channel.
+     *
+     * @param [out] error Operation result.
+     */
+    void Open(boost::system::error_code &error);
+
+    /**
+     * Closes this channel.
+     *
+     * @param [out] shutdownErr The shutdown result.
+     * @param [out] closeErr The close error.
+     */
+    void Close(boost::system::error_code &shutdownErr, boost::system::error_code &closeErr);
+
+    UnixStreamTraits::EndPointType m_remoteEndPoint;    /**< The remote end point used to connect. */
+
+    volatile bool m_closed; /**< True if closed. */
+};
+
+#endif
+
+#endif /* UNIXSTREAMCHANNEL_H */
\ No newline at end of file
@@ -0,0 +1,252 @@
+#include "UnixStreamListener.h"
+
+#if defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
+
+#include <cerrno>
+#include <cstring>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include "../../Concurrent/ThreadPool.h"
+
+namespace
+{
+    UnixListenerAcceptFunc *unixAcceptFunc = nullptr;
+}
+
+void SetUnixListenerAcceptFunc(UnixListenerAcceptFunc *func)
+{
+    unixAcceptFunc = func;
+}
+
+log4cplus::Logger UnixStreamListener::log = log4cplus::Logger::getInstance("UnixStreamListener");
+
+UnixStreamListener::ptr_t UnixStreamListener::instance;
+
+UnixStreamListener& UnixStreamListener::Instance()
+{
+    if (!instance)
+    {
+        instance.reset(new UnixStreamListener());
+    }
+    return *instance;
+}
+
+void UnixStreamListener::Destory()
+{
+    if (instance)
+    {
+        instance->BeginClose();
+        instance.reset();
+    }
+}
+
+UnixStreamListener::UnixStreamListener() :m_acceptors(), m_stoped(false), m_lock(), m_addMutex()
+{
+}
+
+UnixStreamListener::~UnixStreamListener()
+{
+    m_acceptors.clear();
+}
+
+bool UnixStreamListener::AddListenEndPoint(const std::string &path)
+{
+    //the socket file is probed and bound without m_lock held,m_addMutex keeps two adds of the same path apart.
+    std::lock_guard<std::mutex> addLock(m_addMutex);
+    {
+        SpinLock<>::ScopeLock lock(m_lock);
+        if (m_stoped)
+        {
+            return true;
+        }
+        if (m_acceptors.find(path) != m_acceptors.end())
+        {
+            LOG4CPLUS_ERROR(log, "添加监听失败，终结点已存在：" << path);
+            return false;
+        }
+    }
+    //removes the socket file left by a previous process,bind fails with EADDRINUSE otherwise.
+    if (!RemoveStaleSocketFile(path))
+    {
+        return false;
+    }
+    std::shared_ptr<boost::asio::local::stream_protocol::acceptor> listener
+        = std::make_shared<boost::asio::local::stream_protocol::acceptor>(ThreadPool::Instance().Context());
+    struct stat st;
+    try
+    {
+        listener->open(UnixStreamTraits::Protocol());
+        listener->bind(UnixStreamTraits::EndPointType(path));
+        listener->listen();
+    }
+    catch (boost::system::system_error &ex)
+    {
+        LOG4CPLUS_ERROR(log, "添加监听失败，终结点：" << path << "，错误信息：" << ex.what());
+        boost::system::error_code err;
+        listener->close(err);
+        return false;
+    }
+    if (::lstat(path.c_str(), &st))
+    {
+        //abstract socket addresses have no file.
+        st.st_dev = 0;
+        st.st_ino = 0;
+    }
+    BoundAcceptor acceptor{ listener, st.st_dev, st.st_ino };
+    SpinLock<>::ScopeLock lock(m_lock);
+    if (m_stoped)
+    {
+        CloseAcceptor(path, acceptor);
+        return true;
+    }
+    m_acceptors.emplace(path, acceptor);
+    BeginAccept(listener);
+    return true;
+}
+
+void UnixStreamListener::RemoveListenerEndPoint(const std::string &path)
+{
+    SpinLock<>::ScopeLock lock(m_lock);
+    if (!m_stoped)
+    {
+        auto iter = m_acceptors.find(path);
+        if (iter != m_acceptors.end())
+        {
+            CloseAcceptor(iter->first, iter->second);
+            m_acceptors.erase(iter);
+        }
+    }
+}
+
+bool UnixStreamListener::BeginClose()
+{
+    bool ret = true;
+    SpinLock<>::ScopeLock lock(m_lock);
+    if (!m_stoped)
+    {
+        m_stoped = true;
+        for (auto &acceptor : m_acceptors)
+        {
+            if (!CloseAcceptor(acceptor.first, acceptor.second))
+            {
+                ret = false;
+            }
+        }
+    }
+    return ret;
+}
+
+bool UnixStreamListener::RemoveStaleSocketFile(const std::string &path)
+{
+    struct stat st;
+    if (path.empty() || path[0] == '\0' || ::lstat(path.c_str(), &st))
+    {
+        return true;
+    }
+    if (!S_ISSOCK(st.st_mode))
+    {
+        LOG4CPLUS_ERROR(log, "添加监听失败，路径已存在且不是套接字文件：" << path);
+        return false;
+    }
+    sockaddr_un addr;
+    if (path.size() >= sizeof(addr.sun_path))
+    {
+        return true;
+    }
+    std::memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    std::memcpy(addr.sun_path, path.c_str(), path.size());
+    //a live listener with a full backlog blocks a blocking connect.
+    int fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC | SOCK_NONBLOCK, 0);
+    if (fd < 0)
+    {
+        LOG4CPLUS_ERROR(log, "添加监听失败，无法探测套接字文件：" << path << "，错误信息：" << std::strerror(errno));
+        return false;
+    }
+    int ret = ::connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+    int connectErr = errno;
+    ::close(fd);
+    if (!ret || connectErr == EAGAIN)
+    {
+        LOG4CPLUS_ERROR(log, "添加监听失败，其它进程正在监听该套接字文件：" << path);
+        return false;
+    }
+    if (connectErr == ENOENT)
+    {
+        return true;
+    }
+    //only a socket nobody listens on refuses the connection.
+    if (connectErr != ECONNREFUSED)
+    {
+        LOG4CPLUS_ERROR(log, "添加监听失败，无法确认套接字文件已失效：" << path << "，错误信息：" << std::strerror(connectErr));
+        return false;
+    }
+    if (::unlink(path.c_str()) && errno != ENOENT)
+    {
+        LOG4CPLUS_ERROR(log, "添加监听失败，删除失效套接字文件失败：" << path << "，错误信息：" << std::strerror(errno));
+        return false;
+    }
+    return true;
+}
+
+bool UnixStreamListener::CloseAcceptor(const std::string &path, const BoundAcceptor &acceptor)
+{
+    boost::system::error_code err;
+    acceptor.m_acceptor->close(err);
+    //the path may have been taken over by another listener since bound.
+    struct stat st;
+    if (acceptor.m_ino && !::lstat(path.c_str(), &st) && S_ISSOCK(st.st_mode) && st.st_dev == acceptor.m_dev && st.st_ino == acceptor.m_ino)
+    {
+        ::unlink(path.c_str());
+    }
+    if (err)
+    {
+        LOG4CPLUS_ERROR(log, "关闭监听错误，终结点：" << path << "，错误信息：" << err.message());
+        return false;
+    }
+    return true;
+}
+
+void UnixStreamListener::BeginAccept(std::shared_ptr<boost::asio::local::stream_protocol::acceptor> listener)
+{
+    std::shared_ptr<UnixStreamTraits::StreamType> sock(new UnixStreamTraits::StreamType(ThreadPool::Instance().Context()));
+    listener->async_accept(*sock, [self = shared_from_this(), sock = sock, listener = listener](const boost::system::error_code& error)
+        {
+            self->EndAccept(sock, listener, error);
+        });
+}
+
+void UnixStreamListener::EndAccept(std::shared_ptr<UnixStreamTraits::StreamType> sock
+    , std::shared_ptr<boost::asio::local::stream_protocol::acceptor> listener, const boost::system::error_code& error)
+{
+    bool listenerDropped = true;
+    std::string path;
+    {
+        SpinLock<>::ScopeLock lock(m_lock);
+        if (!m_stoped)
+        {
+            for (auto &acceptor : m_acceptors)
+            {
+                if (acceptor.second.m_acceptor == listener)
+                {
+                    BeginAccept(listener);
+                    listenerDropped = false;
+                    path = acceptor.first;
+                    break;
+                }
+            }
+        }
+    }
+    if (!error)
+    {
+        unixAcceptFunc(sock);
+    }
+    else if (!listenerDropped)
+    {
+        LOG4CPLUS_ERROR(log, "接收连接失败，监听终结点：" << path << "，错误信息：" << error.message());
+    }
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,176 @@
+#ifndef UNIXSTREAMLISTENER_H
+#define UNIXSTREAMLISTENER_H
+
+#include "../../Common/CommonHdr.h"
+#include "../Traits/UnixStreamTraits.h"
+
+#if defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <sys/types.h>
+#include "../../Log/Log4cplusCustomInc.h"
+#include "../../Concurrent/SpinLock.h"
+
+using UnixListenerAcceptFunc = void (std::shared_ptr<UnixStreamTraits::StreamType> &);
+
+/**
+ * Sets the function called with connections accepted by UnixStreamListener.
+ *
+ * @param [in] func The accept function.
+ */
+UTILS_EXPORTS_API void SetUnixListenerAcceptFunc(UnixListenerAcceptFunc *func);
+
+/**
+ * A unix domain stream socket listener.
+ *
+ * Each end point is a socket file path.A stale socket file left by a previous process(a socket file nobody listens on) is removed
+ * before binding,a regular file or a socket file of a live listener is never removed and the end point fails instead.The file is removed
+ * again when the end point is removed,only if it is still the one this listener bound.
+ */
+class UTILS_EXPORTS_API UnixStreamListener : public std::enable_shared_from_this<UnixStreamListener>
+{
+public:
+
+    /**
+     * Defines an alias representing the pointer to self.
+     */
+    using ptr_t = std::shared_ptr<UnixStreamListener>;
+
+    /**
+     * Gets the global instance.
+     *
+     * @return Global instance refernece.
+     */
+    static UnixStreamListener& Instance();
+
+    /**
+     * Destories the global instance.
+     */
+    static void Destory();
+
+    /**
+     * Copy constructor(deleted)
+     */
+    UnixStreamListener(const UnixStreamListener&) = delete;
+
+    /**
+     * Move constructor(deleted)
+     */
+    UnixStreamListener(UnixStreamListener&&) = delete;
+
+    /**
+     * Destructor
+     */
+    ~UnixStreamListener();
+
+    /**
+     * Assignment operator(deleted)
+     *
+     * @return Equal to *this.
+     */
+    UnixStreamListener& operator=(const UnixStreamListener&) = delete;
+
+    /**
+     * Move assignment operator(deleted)
+     */
+    UnixStreamListener&& operator=(UnixStreamListener&&) = delete;
+
+    /**
+     * Adds a listen end point.
+     *
+     * @param path The socket file path.
+     *
+     * @return True if it succeeds, false if it fails.
+     */
+    bool AddListenEndPoint(const std::string &path);
+
+    /**
+     * Removes the listen end point and its socket file.
+     *
+     * @param path The socket file path.
+     */
+    void RemoveListenerEndPoint(const std::string &path);
+
+protected:
+
+    /**
+     * Default constructor
+     */
+    UnixStreamListener();
+
+private:
+    static log4cplus::Logger log;   /**< The logger. */
+
+    static ptr_t instance;  /**< Global instance. */
+
+    /**
+     * Begin a close operation.
+     *
+     * @return True if it succeeds, false if it fails.
+     */
+    bool BeginClose();
+
+    /**
+     * A bound acceptor.
+     */
+    struct BoundAcceptor
+    {
+        std::shared_ptr<boost::asio::local::stream_protocol::acceptor> m_acceptor;  /**< The acceptor. */
+
+        dev_t m_dev;    /**< Device of the bound socket file. */
+
+        ino_t m_ino;    /**< Inode of the bound socket file. */
+    };
+
+    /**
+     * Removes a stale socket file before binding.
+     *
+     * @param path The socket file path.
+     *
+     * @return True if the path does not exist or the stale socket file is removed(only a socket file which refuses the connection
+     *  is stale),false if the path is not a socket file or another listener is accepting on it.
+     */
+    static bool RemoveStaleSocketFile(const std::string &path);
+
+    /**
+     * Closes an acceptor and removes its socket file if the file was not replaced since bound.
+     *
+     * @param path The socket file path.
+     * @param acceptor The acceptor.
+     *
+     * @return True if it succeeds, false if it fails.
+     */
+    bool CloseAcceptor(const std::string &path, const BoundAcceptor &acceptor);
+
+    /**
+     * Begin an accept operation.
+     *
+     * @param listener The acceptor.
+     */
+    void BeginAccept(std::shared_ptr<boost::asio::local::stream_protocol::acceptor> listener);
+
+    /**
+     * Internal end accept callback.
+     *
+     * @param sock The acceptted socket.
+     * @param listener The acceptor.
+     * @param error Accpet operation result.
+     */
+    void EndAccept(std::shared_ptr<UnixStreamTraits::StreamType> sock, std::shared_ptr<boost::asio::local::stream_protocol::acceptor> listener
+        , const boost::system::error_code& error);
+
+    std::map<std::string, BoundAcceptor> m_acceptors; /**< Listeners keyed by socket file path. */
+
+    volatile bool m_stoped; /**< True if stoped. */
+
+    SpinLock<> m_lock;  /**< Internal lock used for thread safe. */
+
+    std::mutex m_addMutex;  /**< Serializes the end points being added(the socket file probe may block,so it is not under m_lock). */
+};
+
+#endif
+
+#endif /* UNIXSTREAMLISTENER_H */
\ No newline at end of file
@@ -0,0 +1,59 @@
+#include "UnixStreamPassiveChannel.h"
+
+#if defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
+
+#include "../../Concurrent/ThreadPool.h"
+#include "../Common/StreamChannelBase.hpp"
+
+const char UnixStreamPassiveChannelLoggerName[] = "UnixStreamPassiveChannel";
+
+template class UTILS_DEF_API StreamChannelBase<UnixStreamTraits, UnixStreamPassiveChannelLoggerName>;
+
+UnixStreamPassiveChannel::UnixStreamPassiveChannel(std::shared_ptr<UnixStreamTraits::StreamType> &stream)
+    : StreamChannelBase<UnixStreamTraits, UnixStreamPassiveChannelLoggerName>(stream), m_closed(false)
+{
+}
+
+UnixStreamPassiveChannel::~UnixStreamPassiveChannel()
+{
+    if (!m_closed)
+    {
+        boost::system::error_code shutdownErr, closeErr;
+        Close(shutdownErr, closeErr);
+    }
+}
+
+void UnixStreamPassiveChannel::AsyncOpen(const IAsyncChannelHandler::ptr_t &handler)
+{
+    boost::system::error_code err;
+    QueueThreadPoolWorkItem([handler = handler, err = err]() mutable { handler->EndOpen(err); });
+}
+
+void UnixStreamPassiveChannel::AsyncClose(const IAsyncChannelHandler::ptr_t &handler)
+{
+    SpinLock<>::ScopeLock lock(BaseType::m_lock);
+    boost::system::error_code shutdownErr, closeErr;
+    Close(shutdownErr, closeErr);
+    QueueThreadPoolWorkItem([handler = handler, err = shutdownErr ? shutdownErr : closeErr]() { handler->EndClose(err); });
+}
+
+void UnixStreamPassiveChannel::Close(boost::system::error_code &shutdownErr, boost::system::error_code &closeErr)
+{
+    if (!m_closed)
+    {
+        BaseType::DetachIoUring();
+        BaseType::m_stream->shutdown(boost::asio::socket_base::shutdown_both, shutdownErr);
+        if (shutdownErr)
+        {
+            LOG4CPLUS_ERROR_FMT(BaseType::log, "停止UnixStream通道错误：%s", shutdownErr.message().c_str());
+        }
+        BaseType::m_stream->close(closeErr);
+        if (closeErr)
+        {
+            LOG4CPLUS_ERROR_FMT(BaseType::log, "关闭UnixStream通道错误：%s", closeErr.message().c_str());
+        }
+        m_closed = true;
+    }
+}
+
+#endif
\ No newline at end of file
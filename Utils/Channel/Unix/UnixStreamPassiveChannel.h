@@ -0,0 +1,64 @@
+#ifndef UNIXSTREAMPASSIVECHANNEL_H
+#define UNIXSTREAMPASSIVECHANNEL_H
+
+#include "../../Common/CommonHdr.h"
+#include "../Traits/UnixStreamTraits.h"
+
+#if defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
+
+#include "../Common/StreamChannelBase.h"
+
+extern const char UnixStreamPassiveChannelLoggerName[];
+
+extern template class UTILS_DECL_API StreamChannelBase<UnixStreamTraits, UnixStreamPassiveChannelLoggerName>;
+
+/**
+ * Unix domain stream socket passive channel(wraps a connection accepted by UnixStreamListener).
+ */
+class UTILS_EXPORTS_API UnixStreamPassiveChannel :public StreamChannelBase<UnixStreamTraits, UnixStreamPassiveChannelLoggerName>
+{
+public:
+
+    /**
+     * Defines an alias representing type of the base class.
+     */
+    using BaseType = StreamChannelBase<UnixStreamTraits, UnixStreamPassiveChannelLoggerName>;
+
+    /**
+     * Constructor
+     *
+     * @param [in,out] stream The accepted socket.
+     */
+    UnixStreamPassiveChannel(std::shared_ptr<UnixStreamTraits::StreamType> &stream);
+
+    /**
+     * Destructor
+     */
+    virtual ~UnixStreamPassiveChannel() override;
+
+    /**
+     * {@inheritDoc}
+     */
+    virtual void AsyncOpen(const IAsyncChannelHandler::ptr_t &handler) override;
+
+    /**
+     * {@inheritDoc}
+     */
+    virtual void AsyncClose(const IAsyncChannelHandler::ptr_t &handler) override;
+
+private:
+
+    /**
+     * Closes this channel.
+     *
+     * @param [out] shutdownErr The shutdown error.
+     * @param [out] closeErr The close error.
+     */
+    void Close(boost::system::error_code &shutdownErr, boost::system::error_code &closeErr);
+
+    volatile bool m_closed; /**< True if closed. */
+};
+
+#endif
+
+#endif /* UNIXSTREAMPASSIVECHANNEL_H */
\ No newline at end of file
@@ -0,0 +1,496 @@
+#ifdef USE_IO_URING_CHANNEL
+
+#include "IoUringService.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <vector>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include "../../Buffer/LinearBufferCache.h"
+
+namespace
+{
+    /**
+     * Nesting depth of the submit scopes of the current thread.
+     */
+    thread_local unsigned int submitScopeDepth = 0;
+
+    /**
+     * The service whose submissions are deferred to the end of the outermost submit scope of the current thread.
+     */
+    thread_local IoUringService *deferredService = nullptr;
+}
+
+IoUringService::Operation::Operation() :m_keepAlive(), m_completionLock(), m_completions(), m_batch(), m_delivering(false)
+    , m_prev(nullptr), m_next(nullptr), m_inFlight(false)
+{
+}
+
+IoUringService::Operation::~Operation()
+{
+}
+
+IoUringService::SubmitScope::SubmitScope()
+{
+    ++submitScopeDepth;
+}
+
+IoUringService::SubmitScope::~SubmitScope()
+{
+    if (--submitScopeDepth == 0 && deferredService)
+    {
+        IoUringService *service = deferredService;
+        deferredService = nullptr;
+        service->Enter();
+    }
+}
+
+boost::asio::execution_context::id IoUringService::id;
+
+log4cplus::Logger IoUringService::log = log4cplus::Logger::getInstance("IoUringService");
+
+IoUringSettings IoUringService::settings = { 1024, 1024, 4096 };
+
+std::atomic<bool> IoUringService::enabled(true);
+
+IoUringService::IoUringService(boost::asio::execution_context &context) :boost::asio::execution_context::service(context)
+    , m_settings(settings), m_ringFd(-1), m_eventFd(-1), m_eventDescriptor(static_cast<boost::asio::io_context&>(context))
+    , m_sqMap(MAP_FAILED), m_sqMapSize(0), m_cqMap(MAP_FAILED), m_cqMapSize(0), m_sqes(static_cast<io_uring_sqe*>(MAP_FAILED))
+    , m_sqesSize(0), m_sqHead(nullptr), m_sqTail(nullptr), m_sqMask(0), m_sqEntries(0), m_sqArray(nullptr), m_sqLocalTail(0)
+    , m_cqHead(nullptr), m_cqTail(nullptr), m_cqMask(0), m_cqes(nullptr), m_bufRing(static_cast<io_uring_buf_ring*>(MAP_FAILED))
+    , m_bufTail(0), m_buffers(), m_bufferPtr(nullptr), m_sqLock(), m_bufLock(), m_inFlightHead(nullptr), m_shutdown(false)
+{
+    if (Setup())
+    {
+        LOG4CPLUS_INFO_FMT(log, "io_uring已启用，提交队列长度：%u，接收缓冲区：%u*%zu字节。", m_sqEntries, m_settings.m_bufferCount
+            , m_settings.m_bufferSize);
+        StartWait();
+    }
+    else
+    {
+        Teardown();
+    }
+}
+
+IoUringService::~IoUringService()
+{
+    Teardown();
+}
+
+void IoUringService::Configure(const IoUringSettings &settings)
+{
+    IoUringService::settings = settings;
+}
+
+void IoUringService::SetEnabled(bool enabled)
+{
+    IoUringService::enabled.store(enabled, std::memory_order_release);
+}
+
+bool IoUringService::Enabled()
+{
+    return enabled.load(std::memory_order_acquire);
+}
+
+void IoUringService::SubmitRecvMultishot(int fd, Operation *op, std::shared_ptr<void> keepAlive)
+{
+    {
+        SpinLock<>::ScopeLock lock(m_sqLock);
+        io_uring_sqe *sqe = GetSqe(op, std::move(keepAlive));
+        sqe->opcode = IORING_OP_RECV;
+        sqe->fd = fd;
+        sqe->flags = IOSQE_BUFFER_SELECT;
+        sqe->ioprio = IORING_RECV_MULTISHOT;
+        sqe->buf_group = 0;
+        Publish();
+    }
+    Submit();
+}
+
+void IoUringService::SubmitRecvMsg(int fd, msghdr *msg, Operation *op, std::shared_ptr<void> keepAlive)
+{
+    {
+        SpinLock<>::ScopeLock lock(m_sqLock);
+        io_uring_sqe *sqe = GetSqe(op, std::move(keepAlive));
+        sqe->opcode = IORING_OP_RECVMSG;
+        sqe->fd = fd;
+        sqe->addr = reinterpret_cast<__u64>(msg);
+        sqe->len = 1;
+        Publish();
+    }
+    Submit();
+}
+
+void IoUringService::SubmitSendMsg(int fd, const msghdr *msg, Operation *op, std::shared_ptr<void> keepAlive)
+{
+    {
+        SpinLock<>::ScopeLock lock(m_sqLock);
+        io_uring_sqe *sqe = GetSqe(op, std::move(keepAlive));
+        sqe->opcode = IORING_OP_SENDMSG;
+        sqe->fd = fd;
+        sqe->addr = reinterpret_cast<__u64>(msg);
+        sqe->len = 1;
+        sqe->msg_flags = MSG_NOSIGNAL;
+        Publish();
+    }
+    Submit();
+}
+
+void IoUringService::SubmitCancel(Operation *op)
+{
+    {
+        SpinLock<>::ScopeLock lock(m_sqLock);
+        io_uring_sqe *sqe = GetSqe(nullptr, std::shared_ptr<void>());
+        sqe->opcode = IORING_OP_ASYNC_CANCEL;
+        sqe->fd = -1;
+        sqe->addr = reinterpret_cast<__u64>(op);
+        sqe->cancel_flags = IORING_ASYNC_CANCEL_ALL;
+        Publish();
+    }
+    Submit();
+}
+
+void IoUringService::ReturnBuffer(unsigned short bid)
+{
+    SpinLock<>::ScopeLock lock(m_bufLock);
+    //not io_uring_buf_ring::bufs,the empty struct before the flexible array occupies a byte in c++ and moves the array.
+    io_uring_buf &buf = reinterpret_cast<io_uring_buf*>(m_bufRing)[m_bufTail & (m_settings.m_bufferCount - 1)];
+    buf.addr = reinterpret_cast<__u64>(Buffer(bid));
+    buf.len = static_cast<__u32>(m_settings.m_bufferSize);
+    buf.bid = bid;
+    __atomic_store_n(&m_bufRing->tail, ++m_bufTail, __ATOMIC_RELEASE);
+}
+
+void IoUringService::shutdown()
+{
+    m_shutdown = true;
+    boost::system::error_code err;
+    m_eventDescriptor.close(err);
+    m_eventFd = -1;
+    std::vector<std::shared_ptr<void>> keepAlives;
+    {
+        SpinLock<>::ScopeLock lock(m_sqLock);
+        for (Operation *op = m_inFlightHead; op; op = op->m_next)
+        {
+            op->m_inFlight = false;
+            keepAlives.push_back(std::move(op->m_keepAlive));
+        }
+        m_inFlightHead = nullptr;
+    }
+}
+
+bool IoUringService::Setup()
+{
+    io_uring_params params;
+    memset(&params, 0, sizeof(params));
+    params.flags = IORING_SETUP_CLAMP;
+    m_ringFd = static_cast<int>(syscall(__NR_io_uring_setup, m_settings.m_entries, &params));
+    if (m_ringFd < 0)
+    {
+        LOG4CPLUS_WARN_FMT(log, "创建io_uring失败，使用reactor：%s", strerror(errno));
+        return false;
+    }
+    m_sqMapSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    m_cqMapSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    if (params.features & IORING_FEAT_SINGLE_MMAP)
+    {
+        m_sqMapSize = m_cqMapSize = std::max(m_sqMapSize, m_cqMapSize);
+    }
+    m_sqMap = mmap(nullptr, m_sqMapSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_ringFd, IORING_OFF_SQ_RING);
+    if (m_sqMap == MAP_FAILED)
+    {
+        LOG4CPLUS_WARN_FMT(log, "映射io_uring提交队列失败，使用reactor：%s", strerror(errno));
+        return false;
+    }
+    if (params.features & IORING_FEAT_SINGLE_MMAP)
+    {
+        m_cqMap = m_sqMap;
+    }
+    else
+    {
+        m_cqMap = mmap(nullptr, m_cqMapSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_ringFd, IORING_OFF_CQ_RING);
+        if (m_cqMap == MAP_FAILED)
+        {
+            LOG4CPLUS_WARN_FMT(log, "映射io_uring完成队列失败，使用reactor：%s", strerror(errno));
+            return false;
+        }
+    }
+    m_sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+    m_sqes = static_cast<io_uring_sqe*>(mmap(nullptr, m_sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_ringFd
+        , IORING_OFF_SQES));
+    if (m_sqes == MAP_FAILED)
+    {
+        LOG4CPLUS_WARN_FMT(log, "映射io_uring提交项失败，使用reactor：%s", strerror(errno));
+        return false;
+    }
+    us8 *sq = static_cast<us8*>(m_sqMap), *cq = static_cast<us8*>(m_cqMap);
+    m_sqHead = reinterpret_cast<unsigned*>(sq + params.sq_off.head);
+    m_sqTail = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+    m_sqMask = *reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+    m_sqEntries = params.sq_entries;
+    m_sqArray = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+    m_sqLocalTail = *m_sqTail;
+    m_cqHead = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+    m_cqTail = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+    m_cqMask = *reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+    m_cqes = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+
+    m_eventFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (m_eventFd < 0 || syscall(__NR_io_uring_register, m_ringFd, IORING_REGISTER_EVENTFD, &m_eventFd, 1) < 0)
+    {
+        LOG4CPLUS_WARN_FMT(log, "注册io_uring事件通知失败，使用reactor：%s", strerror(errno));
+        return false;
+    }
+    boost::system::error_code err;
+    m_eventDescriptor.assign(m_eventFd, err);
+    if (err)
+    {
+        LOG4CPLUS_WARN_FMT(log, "监听io_uring事件通知失败，使用reactor：%s", err.message().c_str());
+        return false;
+    }
+
+    unsigned int count = m_settings.m_bufferCount;
+    if (count == 0 || count > 32768 || (count & (count - 1)) != 0 || m_settings.m_bufferSize == 0)
+    {
+        LOG4CPLUS_WARN_FMT(log, "io_uring接收缓冲区配置无效（%u*%zu字节），使用reactor。", count, m_settings.m_bufferSize);
+        return false;
+    }
+    m_bufRing = static_cast<io_uring_buf_ring*>(mmap(nullptr, count * sizeof(io_uring_buf), PROT_READ | PROT_WRITE
+        , MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+    if (m_bufRing == MAP_FAILED)
+    {
+        LOG4CPLUS_WARN_FMT(log, "分配io_uring接收缓冲区环失败，使用reactor：%s", strerror(errno));
+        return false;
+    }
+    size_t bufferBytes = count * m_settings.m_bufferSize;
+    m_buffers = LinearBufferCache::Instance().Get(bufferBytes);
+    if (!m_buffers)
+    {
+        m_buffers = std::make_shared<LinearBuffer>(bufferBytes);
+    }
+    m_bufferPtr = m_buffers->data();
+    io_uring_buf_reg reg;
+    memset(&reg, 0, sizeof(reg));
+    reg.ring_addr = reinterpret_cast<__u64>(m_bufRing);
+    reg.ring_entries = count;
+    reg.bgid = 0;
+    if (syscall(__NR_io_uring_register, m_ringFd, IORING_REGISTER_PBUF_RING, &reg, 1) < 0)
+    {
+        LOG4CPLUS_WARN_FMT(log, "注册io_uring接收缓冲区失败（需要5.19以上内核），使用reactor：%s", strerror(errno));
+        return false;
+    }
+    for (unsigned int i = 0; i < count; ++i)
+    {
+        ReturnBuffer(static_cast<unsigned short>(i));
+    }
+    return true;
+}
+
+void IoUringService::Teardown()
+{
+    if (m_eventDescriptor.is_open())
+    {
+        boost::system::error_code err;
+        m_eventDescriptor.close(err);
+    }
+    else if (m_eventFd >= 0)
+    {
+        close(m_eventFd);
+    }
+    m_eventFd = -1;
+    if (m_ringFd >= 0)
+    {
+        close(m_ringFd);
+        m_ringFd = -1;
+    }
+    if (m_sqes != MAP_FAILED)
+    {
+        munmap(m_sqes, m_sqesSize);
+        m_sqes = static_cast<io_uring_sqe*>(MAP_FAILED);
+    }
+    if (m_cqMap != MAP_FAILED && m_cqMap != m_sqMap)
+    {
+        munmap(m_cqMap, m_cqMapSize);
+    }
+    m_cqMap = MAP_FAILED;
+    if (m_sqMap != MAP_FAILED)
+    {
+        munmap(m_sqMap, m_sqMapSize);
+        m_sqMap = MAP_FAILED;
+    }
+    if (m_bufRing != MAP_FAILED)
+    {
+        munmap(m_bufRing, m_settings.m_bufferCount * sizeof(io_uring_buf));
+        m_bufRing = static_cast<io_uring_buf_ring*>(MAP_FAILED);
+    }
+    m_buffers.reset();
+    m_bufferPtr = nullptr;
+}
+
+io_uring_sqe* IoUringService::GetSqe(Operation *op, std::shared_ptr<void> &&keepAlive)
+{
+    while (m_sqLocalTail - __atomic_load_n(m_sqHead, __ATOMIC_ACQUIRE) >= m_sqEntries)
+    {
+        Enter();
+    }
+    unsigned index = m_sqLocalTail & m_sqMask;
+    io_uring_sqe *sqe = m_sqes + index;
+    memset(sqe, 0, sizeof(io_uring_sqe));
+    sqe->user_data = reinterpret_cast<__u64>(op);
+    if (op)
+    {
+        op->m_keepAlive = std::move(keepAlive);
+        if (!op->m_inFlight)
+        {
+            op->m_inFlight = true;
+            op->m_prev = nullptr;
+            op->m_next = m_inFlightHead;
+            if (m_inFlightHead)
+            {
+                m_inFlightHead->m_prev = op;
+            }
+            m_inFlightHead = op;
+        }
+    }
+    return sqe;
+}
+
+void IoUringService::Publish()
+{
+    unsigned index = m_sqLocalTail & m_sqMask;
+    m_sqArray[index] = index;
+    //the release store makes the filled entry visible to the kernel(or a concurrent Enter) before the new tail.
+    __atomic_store_n(m_sqTail, ++m_sqLocalTail, __ATOMIC_RELEASE);
+}
+
+void IoUringService::Submit()
+{
+    if (submitScopeDepth && (!deferredService || deferredService == this))
+    {
+        deferredService = this;
+    }
+    else
+    {
+        Enter();
+    }
+}
+
+void IoUringService::Enter()
+{
+    while (syscall(__NR_io_uring_enter, m_ringFd, m_sqEntries, 0, 0, nullptr, 0) < 0)
+    {
+        if (errno != EINTR)
+        {
+            LOG4CPLUS_ERROR_FMT(log, "提交io_uring请求失败：%s", strerror(errno));
+            break;
+        }
+    }
+}
+
+void IoUringService::StartWait()
+{
+    m_eventDescriptor.async_wait(boost::asio::posix::descriptor_base::wait_read, [this](const boost::system::error_code &err)
+        {
+            if (!err)
+            {
+                Reap();
+            }
+        });
+}
+
+void IoUringService::Reap()
+{
+    uint64_t count;
+    if (read(m_eventFd, &count, sizeof(count)) < 0 && errno != EAGAIN)
+    {
+        LOG4CPLUS_ERROR_FMT(log, "读取io_uring事件通知失败：%s", strerror(errno));
+    }
+    unsigned head = *m_cqHead;
+    for (unsigned tail = __atomic_load_n(m_cqTail, __ATOMIC_ACQUIRE); head != tail; tail = __atomic_load_n(m_cqTail, __ATOMIC_ACQUIRE))
+    {
+        while (head != tail)
+        {
+            const io_uring_cqe &cqe = m_cqes[head & m_cqMask];
+            Operation *op = reinterpret_cast<Operation*>(cqe.user_data);
+            int res = cqe.res;
+            unsigned int flags = cqe.flags;
+            __atomic_store_n(m_cqHead, ++head, __ATOMIC_RELEASE);
+            if (!op)
+            {
+                continue;
+            }
+            std::shared_ptr<void> keepAlive;
+            {
+                SpinLock<>::ScopeLock lock(m_sqLock);
+                if (!op->m_inFlight)
+                {
+                    continue;
+                }
+                if (flags & IORING_CQE_F_MORE)
+                {
+                    keepAlive = op->m_keepAlive;
+                }
+                else
+                {
+                    keepAlive = std::move(op->m_keepAlive);
+                    op->m_inFlight = false;
+                    (op->m_prev ? op->m_prev->m_next : m_inFlightHead) = op->m_next;
+                    if (op->m_next)
+                    {
+                        op->m_next->m_prev = op->m_prev;
+                    }
+                }
+            }
+            Dispatch(op, res, flags, std::move(keepAlive));
+        }
+    }
+    if (!m_shutdown)
+    {
+        StartWait();
+    }
+}
+
+void IoUringService::Dispatch(Operation *op, int res, unsigned int flags, std::shared_ptr<void> &&keepAlive)
+{
+    {
+        SpinLock<>::ScopeLock lock(op->m_completionLock);
+        op->m_completions.push_back(Operation::Completion{ res, flags });
+        if (op->m_delivering)
+        {
+            //the pending delivery holds the owner and delivers this completion before it ends.
+            return;
+        }
+        op->m_delivering = true;
+    }
+    boost::asio::post(m_eventDescriptor.get_executor(), [this, op, keepAlive = std::move(keepAlive)]()
+        {
+            Deliver(op);
+        });
+}
+
+void IoUringService::Deliver(Operation *op)
+{
+    SubmitScope submitScope;
+    for (;;)
+    {
+        {
+            SpinLock<>::ScopeLock lock(op->m_completionLock);
+            if (op->m_completions.empty())
+            {
+                op->m_delivering = false;
+                break;
+            }
+            op->m_batch.swap(op->m_completions);
+        }
+        for (auto &completion : op->m_batch)
+        {
+            op->Complete(completion.m_res, completion.m_flags);
+        }
+        op->m_batch.clear();
+    }
+}
+
+#endif /* USE_IO_URING_CHANNEL */
\ No newline at end of file
@@ -0,0 +1,364 @@
+#ifndef IOURINGSERVICE_H
+#define IOURINGSERVICE_H
+
+#ifdef USE_IO_URING_CHANNEL
+
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <boost/asio.hpp>
+#include <linux/io_uring.h>
+#include <sys/socket.h>
+#include "../../Common/CommonHdr.h"
+#include "../../Log/Log4cplusCustomInc.h"
+#include "../../Concurrent/SpinLock.h"
+#include "../../Buffer/LinearBuffer.h"
+#include "IoUringSettings.h"
+
+/**
+ * The io_uring backend of stream channels,an asio service bound to the lifetime of its io_context.
+ *
+ * The service owns one ring and one ring of provided receive buffers shared by all channels of the io_context.Completions are
+ * signaled through an eventfd watched by the io_context,the reaped completions are posted to the pool per operation(in order for
+ * the same operation,in parallel for different channels),and operations submitted by completions or inside a @ref SubmitScope are
+ * submitted together by one system call at the end.
+ *
+ * @note If the ring can't be created(old kernel,seccomp filter...),@ref Available returns false and channels stay on the reactor.
+ */
+class UTILS_EXPORTS_API IoUringService :public boost::asio::execution_context::service
+{
+public:
+    /**
+     * An operation submitted to the ring(its address is the user data of the submission).
+     */
+    class UTILS_EXPORTS_API Operation
+    {
+    public:
+        /**
+         * Default constructor
+         */
+        Operation();
+
+        /**
+         * Called when the operation produces a completion.
+         *
+         * @param res Result of the completion(negative errno on error).
+         * @param flags Flags of the completion.
+         */
+        virtual void Complete(int res, unsigned int flags) = 0;
+
+    protected:
+        /**
+         * Destructor
+         */
+        ~Operation();
+
+    private:
+        friend class IoUringService;
+
+        /**
+         * A reaped completion not delivered yet.
+         */
+        struct Completion
+        {
+            int m_res;  /**< Result of the completion. */
+
+            unsigned int m_flags;   /**< Flags of the completion. */
+        };
+
+        std::shared_ptr<void> m_keepAlive;  /**< Owner kept alive until the operation completes finally. */
+
+        SpinLock<> m_completionLock;    /**< Lock of m_completions and m_delivering. */
+
+        std::vector<Completion> m_completions;  /**< Reaped completions not delivered yet. */
+
+        std::vector<Completion> m_batch;    /**< Completions being delivered(swapped with m_completions to keep both capacities). */
+
+        bool m_delivering;  /**< True if a delivery is posted or running. */
+
+        Operation *m_prev;  /**< Previous in-flight operation. */
+
+        Operation *m_next;  /**< Next in-flight operation. */
+
+        bool m_inFlight;    /**< True if the operation is in the in-flight list. */
+    };
+
+    /**
+     * Defers the submissions of the current thread to the end of the scope,so they are submitted together by one system call and
+     * not while the caller holds its locks(scopes may be nested,the outermost one submits).
+     */
+    class UTILS_EXPORTS_API SubmitScope
+    {
+    public:
+        /**
+         * Default constructor
+         */
+        SubmitScope();
+
+        /**
+         * Copy constructor(deleted)
+         */
+        SubmitScope(const SubmitScope&) = delete;
+
+        /**
+         * Destructor,submits the deferred entries.
+         */
+        ~SubmitScope();
+
+        /**
+         * Assignment operator(deleted)
+         *
+         * @return Equal to *this.
+         */
+        SubmitScope& operator=(const SubmitScope&) = delete;
+    };
+
+    static boost::asio::execution_context::id id;   /**< The service identifier. */
+
+    /**
+     * Constructor
+     *
+     * @param context The owner context.
+     */
+    explicit IoUringService(boost::asio::execution_context &context);
+
+    /**
+     * Copy constructor(deleted)
+     */
+    IoUringService(const IoUringService&) = delete;
+
+    /**
+     * Destructor
+     */
+    ~IoUringService();
+
+    /**
+     * Assignment operator(deleted)
+     *
+     * @return Equal to *this.
+     */
+    IoUringService& operator=(const IoUringService&) = delete;
+
+    /**
+     * Sets the settings used by services created after this call.
+     *
+     * @param settings The settings.
+     */
+    static void Configure(const IoUringSettings &settings);
+
+    /**
+     * Enables or disables the backend for channels attached after this call(enabled by default).
+     *
+     * @param enabled True to enable.
+     */
+    static void SetEnabled(bool enabled);
+
+    /**
+     * Query if the backend is enabled.
+     *
+     * @return True if enabled.
+     */
+    static bool Enabled();
+
+    /**
+     * Query if the ring was created successfully.
+     *
+     * @return True if available.
+     */
+    bool Available() const
+    {
+        return m_ringFd >= 0;
+    }
+
+    /**
+     * Submits a multishot receive which selects buffers from the provided buffer ring.
+     *
+     * @param fd The socket.
+     * @param op The operation.
+     * @param keepAlive Owner kept alive until the operation completes finally.
+     */
+    void SubmitRecvMultishot(int fd, Operation *op, std::shared_ptr<void> keepAlive);
+
+    /**
+     * Submits a receive into the caller's buffers.
+     *
+     * @param fd The socket.
+     * @param msg The message header(must stay valid until completion).
+     * @param op The operation.
+     * @param keepAlive Owner kept alive until the operation completes.
+     */
+    void SubmitRecvMsg(int fd, msghdr *msg, Operation *op, std::shared_ptr<void> keepAlive);
+
+    /**
+     * Submits a send.
+     *
+     * @param fd The socket.
+     * @param msg The message header(must stay valid until completion).
+     * @param op The operation.
+     * @param keepAlive Owner kept alive until the operation completes.
+     */
+    void SubmitSendMsg(int fd, const msghdr *msg, Operation *op, std::shared_ptr<void> keepAlive);
+
+    /**
+     * Submits a cancellation of all operations of an operation object(the cancelled ones complete with -ECANCELED).
+     *
+     * @param op The operation to be cancelled.
+     */
+    void SubmitCancel(Operation *op);
+
+    /**
+     * Gets a provided receive buffer.
+     *
+     * @param bid The buffer id.
+     *
+     * @return The buffer pointer.
+     */
+    us8* Buffer(unsigned short bid)
+    {
+        return m_bufferPtr + static_cast<size_t>(bid) * m_settings.m_bufferSize;
+    }
+
+    /**
+     * Gives a consumed receive buffer back to the kernel.
+     *
+     * @param bid The buffer id.
+     */
+    void ReturnBuffer(unsigned short bid);
+
+private:
+    /**
+     * {@inheritDoc}
+     */
+    virtual void shutdown() override;
+
+    /**
+     * Creates the ring,maps its queues and registers the eventfd and the provided buffer ring.
+     *
+     * @return True if succeeded.
+     */
+    bool Setup();
+
+    /**
+     * Releases the ring and the buffers.
+     */
+    void Teardown();
+
+    /**
+     * Gets a free submission queue entry and links the operation into the in-flight list(called with m_sqLock held),the entry is
+     * not visible to the kernel until @ref Publish.
+     *
+     * @param op The operation(null if the completion is ignored).
+     * @param keepAlive Owner kept alive until the operation completes finally.
+     *
+     * @return The entry(cleared).
+     */
+    io_uring_sqe* GetSqe(Operation *op, std::shared_ptr<void> &&keepAlive);
+
+    /**
+     * Publishes the entry got by the last @ref GetSqe after it is filled(called with m_sqLock held).
+     */
+    void Publish();
+
+    /**
+     * Submits the published entries(deferred to the end of the current @ref SubmitScope if any).
+     */
+    void Submit();
+
+    /**
+     * Calls io_uring_enter to submit all published entries.
+     */
+    void Enter();
+
+    /**
+     * Waits for the eventfd to be signaled.
+     */
+    void StartWait();
+
+    /**
+     * Reaps all completions and posts them to their operations.
+     */
+    void Reap();
+
+    /**
+     * Queues a reaped completion to its operation and posts a delivery if none is pending.
+     *
+     * @param op The operation.
+     * @param res Result of the completion.
+     * @param flags Flags of the completion.
+     * @param keepAlive Owner kept alive until the completion is delivered(by the pending delivery if any).
+     */
+    void Dispatch(Operation *op, int res, unsigned int flags, std::shared_ptr<void> &&keepAlive);
+
+    /**
+     * Delivers the queued completions of an operation in order(runs on a pool thread).
+     *
+     * @param op The operation.
+     */
+    void Deliver(Operation *op);
+
+    static log4cplus::Logger log;   /**< The logger. */
+
+    static IoUringSettings settings;    /**< Settings of services created later. */
+
+    static std::atomic<bool> enabled;   /**< True if the backend is enabled. */
+
+    IoUringSettings m_settings; /**< The settings. */
+
+    int m_ringFd;   /**< The ring,-1 if unavailable. */
+
+    int m_eventFd;  /**< The eventfd signaled on completions. */
+
+    boost::asio::posix::stream_descriptor m_eventDescriptor;    /**< The eventfd watched by the io_context. */
+
+    void *m_sqMap;  /**< Mapped submission queue ring. */
+
+    size_t m_sqMapSize; /**< Size of m_sqMap. */
+
+    void *m_cqMap;  /**< Mapped completion queue ring(same as m_sqMap if the kernel maps them together). */
+
+    size_t m_cqMapSize; /**< Size of m_cqMap. */
+
+    io_uring_sqe *m_sqes;   /**< Mapped submission queue entries. */
+
+    size_t m_sqesSize;  /**< Size of m_sqes. */
+
+    unsigned *m_sqHead; /**< Kernel owned head of the submission queue. */
+
+    unsigned *m_sqTail; /**< Tail of the submission queue. */
+
+    unsigned m_sqMask;  /**< Mask of the submission queue. */
+
+    unsigned m_sqEntries;   /**< Number of submission queue entries. */
+
+    unsigned *m_sqArray;    /**< Index array of the submission queue. */
+
+    unsigned m_sqLocalTail; /**< Tail including the not published entries. */
+
+    unsigned *m_cqHead; /**< Head of the completion queue. */
+
+    unsigned *m_cqTail; /**< Kernel owned tail of the completion queue. */
+
+    unsigned m_cqMask;  /**< Mask of the completion queue. */
+
+    io_uring_cqe *m_cqes;   /**< Mapped completion queue entries. */
+
+    io_uring_buf_ring *m_bufRing;   /**< The provided buffer ring. */
+
+    unsigned short m_bufTail;   /**< Tail of the provided buffer ring. */
+
+    std::shared_ptr<LinearBuffer> m_buffers;    /**< Memory of the provided buffers. */
+
+    us8 *m_bufferPtr;   /**< Beginning of the provided buffers. */
+
+    SpinLock<> m_sqLock;    /**< Lock of the submission queue and the in-flight list. */
+
+    SpinLock<> m_bufLock;   /**< Lock of the provided buffer ring. */
+
+    Operation *m_inFlightHead;  /**< Head of the in-flight operation list. */
+
+    std::atomic<bool> m_shutdown;   /**< True after shutdown. */
+};
+
+#endif /* USE_IO_URING_CHANNEL */
+
+#endif /* IOURINGSERVICE_H */
\ No newline at end of file
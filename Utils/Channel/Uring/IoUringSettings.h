@@ -0,0 +1,18 @@
+#ifndef IOURINGSETTINGS_H
+#define IOURINGSETTINGS_H
+
+#include <cstddef>
+
+/**
+ * Settings of the io_uring backend of stream channels.
+ */
+struct IoUringSettings
+{
+    unsigned int m_entries; /**< Number of submission queue entries(the completion queue is twice as large). */
+
+    unsigned int m_bufferCount; /**< Number of receive buffers shared by all channels(a power of 2,not greater than 32768). */
+
+    std::size_t m_bufferSize;   /**< Size of a receive buffer. */
+};
+
+#endif /* IOURINGSETTINGS_H */
\ No newline at end of file
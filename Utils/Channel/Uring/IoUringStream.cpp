@@ -0,0 +1,329 @@
+#ifdef USE_IO_URING_CHANNEL
+
+#include "IoUringStream.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <sys/socket.h>
+#include "../../Common/RunTimeLibraryHelper.h"
+
+IoUringStream::IoUringStream(boost::asio::io_context &context, IoUringService &service, int fd, const WriteHandler &writeHandler)
+    :std::enable_shared_from_this<IoUringStream>(), m_context(context), m_service(service), m_fd(fd), m_writeHandler(writeHandler)
+    , m_lock(), m_segments(), m_readBufs(), m_readHandler(), m_readCtx(nullptr), m_readError(), m_recvArmed(false), m_multishot(true)
+    , m_recvOp(this, &IoUringStream::EndRecv), m_directRecvOp(this, &IoUringStream::EndDirectRecv), m_recvIovs(), m_recvMsg()
+    , m_sendOp(this, &IoUringStream::EndSend), m_sendIovs(), m_sendIndex(0), m_sent(0), m_sendMsg(), m_writeOwner()
+{
+}
+
+IoUringStream::~IoUringStream()
+{
+    for (auto &segment : m_segments)
+    {
+        m_service.ReturnBuffer(segment.m_bid);
+    }
+}
+
+bool IoUringStream::IsStreamSocket(int fd)
+{
+    int type = 0;
+    socklen_t len = sizeof(type);
+    return getsockopt(fd, SOL_SOCKET, SO_TYPE, &type, &len) == 0 && type == SOCK_STREAM;
+}
+
+void IoUringStream::AsyncReadSome(BufDescriptor bufs[], size_t bufSize, const IAsyncChannelHandler::ptr_t &handler, void *ctx)
+{
+    size_t bytes = 0;
+    boost::system::error_code err;
+    bool arm = false;
+    {
+        SpinLock<>::ScopeLock lock(m_lock);
+        m_readBufs.assign(bufs, bufs + bufSize);
+        if (!m_segments.empty())
+        {
+            bytes = CopySegments();
+        }
+        else if (m_readError)
+        {
+            err = m_readError;
+        }
+        else
+        {
+            m_readHandler = handler;
+            m_readCtx = ctx;
+            arm = !m_recvArmed;
+            m_recvArmed = true;
+            if (!arm)
+            {
+                return;
+            }
+        }
+    }
+    if (arm)
+    {
+        StartRecv(!m_multishot);
+        return;
+    }
+    boost::asio::post(m_context, [handler = handler, err = err, bytes = bytes, ctx = ctx]()
+        {
+            handler->EndRead(err, bytes, ctx);
+        });
+}
+
+void IoUringStream::AsyncWrite(const void *data, size_t size, std::shared_ptr<void> owner)
+{
+    m_sendIovs.resize(1);
+    m_sendIovs[0].iov_base = const_cast<void*>(data);
+    m_sendIovs[0].iov_len = size;
+    m_sendIndex = 0;
+    m_sent = 0;
+    m_writeOwner = std::move(owner);
+    StartSend();
+}
+
+void IoUringStream::AsyncWrite(const BufferChain &chain, std::shared_ptr<void> owner)
+{
+    m_sendIovs.resize(chain.SliceCount());
+    for (size_t i = 0; i < chain.SliceCount(); ++i)
+    {
+        m_sendIovs[i].iov_base = const_cast<us8*>(chain[i].Data());
+        m_sendIovs[i].iov_len = chain[i].Size();
+    }
+    m_sendIndex = 0;
+    m_sent = 0;
+    m_writeOwner = std::move(owner);
+    StartSend();
+}
+
+void IoUringStream::Close()
+{
+    IAsyncChannelHandler::ptr_t handler;
+    void *ctx = nullptr;
+    bool armed;
+    {
+        SpinLock<>::ScopeLock lock(m_lock);
+        if (!m_readError)
+        {
+            m_readError = boost::asio::error::operation_aborted;
+        }
+        handler = std::move(m_readHandler);
+        ctx = m_readCtx;
+        armed = m_recvArmed;
+    }
+    if (armed)
+    {
+        m_service.SubmitCancel(&m_recvOp);
+        m_service.SubmitCancel(&m_directRecvOp);
+    }
+    if (handler)
+    {
+        boost::asio::post(m_context, [handler = std::move(handler), ctx = ctx]()
+            {
+                handler->EndRead(boost::asio::error::operation_aborted, 0, ctx);
+            });
+    }
+}
+
+size_t IoUringStream::CopySegments()
+{
+    size_t bytes = 0;
+    for (auto &buf : m_readBufs)
+    {
+        size_t offset = 0;
+        while (offset < buf.m_size && !m_segments.empty())
+        {
+            Segment &segment = m_segments.front();
+            size_t size = std::min(buf.m_size - offset, segment.m_size);
+            RunTimeLibraryHelper::MemCpy(buf.m_beg + offset, buf.m_size - offset, m_service.Buffer(segment.m_bid) + segment.m_offset, size);
+            offset += size;
+            segment.m_offset += size;
+            segment.m_size -= size;
+            if (segment.m_size == 0)
+            {
+                m_service.ReturnBuffer(segment.m_bid);
+                m_segments.pop_front();
+            }
+        }
+        bytes += offset;
+        if (m_segments.empty())
+        {
+            break;
+        }
+    }
+    return bytes;
+}
+
+void IoUringStream::StartRecv(bool direct)
+{
+    if (direct)
+    {
+        m_recvIovs.resize(m_readBufs.size());
+        for (size_t i = 0; i < m_readBufs.size(); ++i)
+        {
+            m_recvIovs[i].iov_base = m_readBufs[i].m_beg;
+            m_recvIovs[i].iov_len = m_readBufs[i].m_size;
+        }
+        m_recvMsg = msghdr();
+        m_recvMsg.msg_iov = m_recvIovs.data();
+        m_recvMsg.msg_iovlen = m_recvIovs.size();
+        m_service.SubmitRecvMsg(m_fd, &m_recvMsg, &m_directRecvOp, shared_from_this());
+    }
+    else
+    {
+        m_service.SubmitRecvMultishot(m_fd, &m_recvOp, shared_from_this());
+    }
+}
+
+void IoUringStream::EndRecv(int res, unsigned int flags)
+{
+    IAsyncChannelHandler::ptr_t handler;
+    void *ctx = nullptr;
+    size_t bytes = 0;
+    boost::system::error_code err;
+    bool rearm = false, direct = false;
+    {
+        SpinLock<>::ScopeLock lock(m_lock);
+        if (res > 0)
+        {
+            m_segments.push_back(Segment{ static_cast<unsigned short>(flags >> IORING_CQE_BUFFER_SHIFT), 0, static_cast<size_t>(res) });
+        }
+        else if (res == 0)
+        {
+            if (!m_readError)
+            {
+                m_readError = boost::asio::error::eof;
+            }
+        }
+        else if (res == -ENOBUFS || res == -EINVAL)
+        {
+            //provided buffers ran out,or multishot receive is not supported(the single receive reports a real EINVAL).
+            direct = true;
+            m_multishot = m_multishot && res == -ENOBUFS;
+        }
+        else if (!m_readError)
+        {
+            m_readError = ToError(res);
+        }
+        if (!(flags & IORING_CQE_F_MORE))
+        {
+            m_recvArmed = false;
+        }
+        if (m_readHandler)
+        {
+            if (!m_segments.empty())
+            {
+                bytes = CopySegments();
+                handler = std::move(m_readHandler);
+                ctx = m_readCtx;
+            }
+            else if (m_readError)
+            {
+                err = m_readError;
+                handler = std::move(m_readHandler);
+                ctx = m_readCtx;
+            }
+            else if (!m_recvArmed)
+            {
+                m_recvArmed = true;
+                rearm = true;
+            }
+        }
+    }
+    if (rearm)
+    {
+        StartRecv(direct || !m_multishot);
+    }
+    if (handler)
+    {
+        handler->EndRead(err, bytes, ctx);
+    }
+}
+
+void IoUringStream::EndDirectRecv(int res, unsigned int flags)
+{
+    IAsyncChannelHandler::ptr_t handler;
+    void *ctx = nullptr;
+    boost::system::error_code err;
+    {
+        SpinLock<>::ScopeLock lock(m_lock);
+        m_recvArmed = false;
+        if (res == 0 && !m_readError)
+        {
+            m_readError = boost::asio::error::eof;
+        }
+        else if (res < 0 && !m_readError)
+        {
+            m_readError = ToError(res);
+        }
+        if (res <= 0)
+        {
+            err = m_readError;
+        }
+        handler = std::move(m_readHandler);
+        ctx = m_readCtx;
+    }
+    if (handler)
+    {
+        handler->EndRead(err, res > 0 ? static_cast<size_t>(res) : 0, ctx);
+    }
+}
+
+void IoUringStream::StartSend()
+{
+    m_sendMsg = msghdr();
+    m_sendMsg.msg_iov = m_sendIovs.data() + m_sendIndex;
+    m_sendMsg.msg_iovlen = m_sendIovs.size() - m_sendIndex;
+    m_service.SubmitSendMsg(m_fd, &m_sendMsg, &m_sendOp, shared_from_this());
+}
+
+void IoUringStream::EndSend(int res, unsigned int flags)
+{
+    boost::system::error_code err;
+    if (res > 0)
+    {
+        m_sent += static_cast<size_t>(res);
+        for (size_t left = static_cast<size_t>(res); m_sendIndex < m_sendIovs.size(); ++m_sendIndex)
+        {
+            iovec &iov = m_sendIovs[m_sendIndex];
+            if (left < iov.iov_len)
+            {
+                iov.iov_base = static_cast<us8*>(iov.iov_base) + left;
+                iov.iov_len -= left;
+                break;
+            }
+            left -= iov.iov_len;
+        }
+        if (m_sendIndex < m_sendIovs.size())
+        {
+            StartSend();
+            return;
+        }
+    }
+    else if (res == 0)
+    {
+        for (size_t i = m_sendIndex; i < m_sendIovs.size(); ++i)
+        {
+            if (m_sendIovs[i].iov_len)
+            {
+                err = boost::asio::error::broken_pipe;
+                break;
+            }
+        }
+    }
+    else
+    {
+        err = ToError(res);
+    }
+    std::shared_ptr<void> owner(std::move(m_writeOwner));
+    m_writeHandler(err, m_sent);
+}
+
+boost::system::error_code IoUringStream::ToError(int res)
+{
+    if (res == -ECANCELED)
+    {
+        return boost::asio::error::operation_aborted;
+    }
+    return boost::system::error_code(-res, boost::system::system_category());
+}
+
+#endif /* USE_IO_URING_CHANNEL */
\ No newline at end of file
@@ -0,0 +1,258 @@
+#ifndef IOURINGSTREAM_H
+#define IOURINGSTREAM_H
+
+#ifdef USE_IO_URING_CHANNEL
+
+#include <deque>
+#include <functional>
+#include <memory>
+#include <vector>
+#include <sys/uio.h>
+#include "../../Buffer/BufferDescriptor.h"
+#include "../../Buffer/BufferSlice.h"
+#include "../Common/IAsyncChannelHandler.h"
+#include "IoUringService.h"
+
+/**
+ * The io_uring I/O of a connected stream socket.
+ *
+ * Reading arms one multishot receive which keeps filling buffers selected from the service's provided buffer ring,a read is
+ * served by copying the received data(no system call while data is queued).Falls back to a single receive into the caller's
+ * buffers when the provided buffers run out or the kernel doesn't support multishot receive.
+ *
+ * @note Must be owned by a std::shared_ptr,only one read and one write may be outstanding.
+ */
+class UTILS_EXPORTS_API IoUringStream :public std::enable_shared_from_this<IoUringStream>
+{
+public:
+
+    /**
+     * Defines an alias representing the pointer to self.
+     */
+    using ptr_t = std::shared_ptr<IoUringStream>;
+
+    /**
+     * Defines an alias representing the write completion handler.
+     */
+    using WriteHandler = std::function<void(const boost::system::error_code&, std::size_t)>;
+
+    /**
+     * Constructor
+     *
+     * @param context The context to which read handlers are posted.
+     * @param service The service.
+     * @param fd The socket.
+     * @param writeHandler The handler called when a write completes.
+     */
+    IoUringStream(boost::asio::io_context &context, IoUringService &service, int fd, const WriteHandler &writeHandler);
+
+    /**
+     * Copy constructor(deleted)
+     */
+    IoUringStream(const IoUringStream&) = delete;
+
+    /**
+     * Destructor
+     */
+    ~IoUringStream();
+
+    /**
+     * Assignment operator(deleted)
+     *
+     * @return Equal to *this.
+     */
+    IoUringStream& operator=(const IoUringStream&) = delete;
+
+    /**
+     * Query if a file descriptor is a stream socket.
+     *
+     * @param fd The file descriptor.
+     *
+     * @return True if it is.
+     */
+    static bool IsStreamSocket(int fd);
+
+    /**
+     * Gets the socket.
+     *
+     * @return The socket.
+     */
+    int NativeHandle() const
+    {
+        return m_fd;
+    }
+
+    /**
+     * Reads some data(same semantics as @ref IAsyncChannel::AsyncReadSome).
+     *
+     * @param bufs The read buf array(must stay valid until the handler is called).
+     * @param bufSize Size of the read buf array.
+     * @param handler The handler to be called when the read operation completes.
+     * @param ctx User defined context data.
+     */
+    void AsyncReadSome(BufDescriptor bufs[], size_t bufSize, const IAsyncChannelHandler::ptr_t &handler, void *ctx);
+
+    /**
+     * Writes all of a buffer.
+     *
+     * @param data The data(must stay valid until the write handler is called).
+     * @param size Byte count to be writen.
+     * @param owner Owner kept alive until the write handler is called.
+     */
+    void AsyncWrite(const void *data, size_t size, std::shared_ptr<void> owner);
+
+    /**
+     * Writes all of a slice chain.
+     *
+     * @param chain The slices(must stay valid until the write handler is called).
+     * @param owner Owner kept alive until the write handler is called.
+     */
+    void AsyncWrite(const BufferChain &chain, std::shared_ptr<void> owner);
+
+    /**
+     * Cancels the outstanding operations,the outstanding read and following reads complete with
+     * boost::asio::error::operation_aborted.
+     */
+    void Close();
+
+private:
+    /**
+     * An operation which forwards its completions to a member function.
+     */
+    struct Op :public IoUringService::Operation
+    {
+        IoUringStream *m_owner; /**< The owner. */
+
+        void (IoUringStream::*m_func)(int, unsigned int);   /**< The completion function. */
+
+        /**
+         * Constructor
+         *
+         * @param owner The owner.
+         * @param func The completion function.
+         */
+        Op(IoUringStream *owner, void (IoUringStream::*func)(int, unsigned int)) :m_owner(owner), m_func(func)
+        {
+        }
+
+        /**
+         * {@inheritDoc}
+         */
+        virtual void Complete(int res, unsigned int flags) override
+        {
+            (m_owner->*m_func)(res, flags);
+        }
+    };
+
+    /**
+     * Received data not read yet.
+     */
+    struct Segment
+    {
+        unsigned short m_bid;   /**< Id of the provided buffer. */
+
+        size_t m_offset;    /**< Offset of the data not read yet. */
+
+        size_t m_size;  /**< Size of the data not read yet. */
+    };
+
+    /**
+     * Copies queued data into the pending read buffers and gives emptied buffers back(called with m_lock held).
+     *
+     * @return Number of bytes copied.
+     */
+    size_t CopySegments();
+
+    /**
+     * Arms the receive(multishot,or a single receive into the pending read buffers).
+     *
+     * @param direct True to receive into the pending read buffers.
+     */
+    void StartRecv(bool direct);
+
+    /**
+     * Completion of the multishot receive.
+     *
+     * @param res Result of the completion.
+     * @param flags Flags of the completion.
+     */
+    void EndRecv(int res, unsigned int flags);
+
+    /**
+     * Completion of the single receive.
+     *
+     * @param res Result of the completion.
+     * @param flags Flags of the completion.
+     */
+    void EndDirectRecv(int res, unsigned int flags);
+
+    /**
+     * Submits a send of the data not sent yet.
+     */
+    void StartSend();
+
+    /**
+     * Completion of the send.
+     *
+     * @param res Result of the completion.
+     * @param flags Flags of the completion.
+     */
+    void EndSend(int res, unsigned int flags);
+
+    /**
+     * Converts a negative completion result to an error.
+     *
+     * @param res The result.
+     *
+     * @return The error.
+     */
+    static boost::system::error_code ToError(int res);
+
+    boost::asio::io_context &m_context; /**< The context to which read handlers are posted. */
+
+    IoUringService &m_service;  /**< The service. */
+
+    int m_fd;   /**< The socket. */
+
+    WriteHandler m_writeHandler;    /**< The write completion handler. */
+
+    SpinLock<> m_lock;  /**< Internal lock of the read state. */
+
+    std::deque<Segment> m_segments; /**< Received data not read yet. */
+
+    std::vector<BufDescriptor> m_readBufs;  /**< Buffers of the pending read. */
+
+    IAsyncChannelHandler::ptr_t m_readHandler;  /**< Handler of the pending read(null if no read is pending). */
+
+    void *m_readCtx;    /**< User defined context data of the pending read. */
+
+    boost::system::error_code m_readError;  /**< Error which ends the stream(reported to following reads). */
+
+    bool m_recvArmed;   /**< True if a receive is outstanding. */
+
+    bool m_multishot;   /**< False if the kernel doesn't support multishot receive. */
+
+    Op m_recvOp;    /**< The multishot receive. */
+
+    Op m_directRecvOp;  /**< The single receive. */
+
+    std::vector<iovec> m_recvIovs;  /**< Buffers of the single receive. */
+
+    msghdr m_recvMsg;   /**< Message header of the single receive. */
+
+    Op m_sendOp;    /**< The send. */
+
+    std::vector<iovec> m_sendIovs;  /**< Buffers of the write in progress. */
+
+    size_t m_sendIndex; /**< Index of the first buffer not sent completely. */
+
+    size_t m_sent;  /**< Number of bytes sent. */
+
+    msghdr m_sendMsg;   /**< Message header of the send. */
+
+    std::shared_ptr<void> m_writeOwner; /**< Owner of the write in progress. */
+};
+
+#endif /* USE_IO_URING_CHANNEL */
+
+#endif /* IOURINGSTREAM_H */
\ No newline at end of file
@@ -0,0 +1,80 @@
+#include "FutexWaitEvent.h"
+#if defined(__linux__)
+#include <climits>
+#include <ctime>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+FutexWaitEvent::FutexWaitEvent(Mode mode, unsigned spinCount) :m_mode(mode), m_spinCount(spinCount < 32 ? spinCount : 32), m_signaled(0)
+    , m_epoch(0), m_waiters(0), m_broadcasts(0), m_actionLock()
+{
+}
+
+void FutexWaitEvent::SignalAll()
+{
+    m_broadcasts.fetch_add(1, std::memory_order_seq_cst);
+    Wake(true);
+}
+
+#if defined(__linux__)
+
+void FutexWaitEvent::Wake(bool all)
+{
+    //no syscall when nobody is parked.
+    if (!m_waiters.load(std::memory_order_seq_cst))
+    {
+        return;
+    }
+    m_epoch.fetch_add(1, std::memory_order_seq_cst);
+    syscall(SYS_futex, reinterpret_cast<us32*>(&m_epoch), FUTEX_WAKE_PRIVATE, all ? INT_MAX : 1, nullptr, nullptr, 0);
+}
+
+void FutexWaitEvent::Park(us32 epoch, us32 milliSeconds)
+{
+    timespec timeout;
+    timeout.tv_sec = milliSeconds / 1000;
+    timeout.tv_nsec = milliSeconds % 1000 * 1000000;
+    //returns at once if the epoch has changed,EINTR and spurious wake ups are handled by the caller's loop.
+    syscall(SYS_futex, reinterpret_cast<us32*>(&m_epoch), FUTEX_WAIT_PRIVATE, epoch, milliSeconds == INFINITE_WAIT ? nullptr : &timeout
+        , nullptr, 0);
+}
+
+#else
+
+void FutexWaitEvent::Wake(bool all)
+{
+    if (!m_waiters.load(std::memory_order_seq_cst))
+    {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_parkMutex);
+        m_epoch.fetch_add(1, std::memory_order_seq_cst);
+    }
+    if (all)
+    {
+        m_parkCond.notify_all();
+    }
+    else
+    {
+        m_parkCond.notify_one();
+    }
+}
+
+void FutexWaitEvent::Park(us32 epoch, us32 milliSeconds)
+{
+    std::unique_lock<std::mutex> lock(m_parkMutex);
+    auto changed = [&]() { return m_epoch.load(std::memory_order_seq_cst) != epoch; };
+    if (milliSeconds == INFINITE_WAIT)
+    {
+        m_parkCond.wait(lock, changed);
+    }
+    else
+    {
+        m_parkCond.wait_for(lock, std::chrono::milliseconds(milliSeconds), changed);
+    }
+}
+
+#endif
@@ -0,0 +1,292 @@
+#ifndef FUTEXWAITEVENT_H
+#define FUTEXWAITEVENT_H
+
+#include <atomic>
+#include <chrono>
+#include <utility>
+#include "../Common/CommonHdr.h"
+#include "SpinLock.h"
+#include "WaitEvent.h"
+#if !defined(__linux__)
+#include <condition_variable>
+#include <mutex>
+#endif
+
+/**
+ * Eventcount based WaitEvent with the same Wait/TimedWait/Signal API.Signal is a few atomic operations when no thread is waiting,
+ * a waiter spins shortly before it parks on a futex(on the platforms without futex it parks on a condition variable),and the event
+ * supports auto-reset(like WaitEvent,a signal releases one waiter) and manual-reset(the event stays signaled until Reset) modes and
+ * SignalAll which releases all waiting threads.
+ *
+ * The pre/post actions are executed with an internal spin lock held,together with setting/consuming the signal,so they are atomic with
+ * respect to each other like the ones of WaitEvent.
+ */
+class UTILS_EXPORTS_API FutexWaitEvent
+{
+public:
+    /**
+     * Values that represent the reset modes.
+     */
+    enum Mode
+    {
+        AutoReset,  /**< A waiter consumes the signal. */
+        ManualReset /**< The event stays signaled until Reset. */
+    };
+
+    /**
+     * Constructor.
+     *
+     * @param mode (Optional) The reset mode.
+     * @param spinCount (Optional) Number of rounds(see DefaultBlackMagicFunc,at most 32) a waiter spins before it parks.
+     */
+    explicit FutexWaitEvent(Mode mode = AutoReset, unsigned spinCount = 16);
+
+    FutexWaitEvent(const FutexWaitEvent &) = delete;
+
+    FutexWaitEvent(FutexWaitEvent &&) = delete;
+
+    FutexWaitEvent &operator=(const FutexWaitEvent &) = delete;
+
+    FutexWaitEvent &operator=(FutexWaitEvent &&) = delete;
+
+    /**
+     * Waits until caller is signaled.
+     */
+    void Wait()
+    {
+        WaitFor(INFINITE_WAIT, [this]() { return TryConsume(); });
+    }
+
+    /**
+     * Waits until caller is signaled.
+     *
+     * @tparam T Action type which is executed after wait operation(void operator()()).
+     * @param postWaitAct function object which is executed before return to caller.
+     */
+    template<typename T> void Wait(T &&postWaitAct)
+    {
+        TimedWait(INFINITE_WAIT, [&](bool) { postWaitAct(); });
+    }
+
+    /**
+     * Waits until caller is signaled or timeout is elapsed.
+     *
+     * @param milliSeconds timeout value(in millisecond).
+     *
+     * @return True-successful wait the event,False-the time-out interval has elapsed.
+     */
+    bool TimedWait(us32 milliSeconds)
+    {
+        return WaitFor(milliSeconds, [this]() { return TryConsume(); });
+    }
+
+    /**
+     * Waits until caller is signaled or timeout is elapsed.
+     *
+     * @tparam T Action type which is executed after wait operation(void operator()(bool),same meaning as return value).
+     * @param milliSeconds timeout value(in millisecond).
+     * @param postWaitAct function object which is executed before return to caller.
+     *
+     * @return True-successful wait the event,False-the time-out interval has elapsed.
+     */
+    template<typename T> bool TimedWait(us32 milliSeconds, T &&postWaitAct);
+
+    /**
+     * Signals the event,releases one waiter in auto-reset mode and all waiters in manual-reset mode.
+     */
+    void Signal()
+    {
+        m_signaled.store(1, std::memory_order_seq_cst);
+        Wake(m_mode == ManualReset);
+    }
+
+    /**
+     * Signals the event.
+     *
+     * @tparam T Action type which is executed before signal operation(bool/void operator()(),signal operation will not be executed
+     *  when return false).
+     * @param preSignalAct function object which is executed before signal operation.
+     */
+    template<typename T> void Signal(T &&preSignalAct);
+
+    /**
+     * Releases all threads which are waiting when it is called(the waiters which started to wait before),the signal state is not
+     * changed.
+     */
+    void SignalAll();
+
+    /**
+     * Resets the event to normal status.
+     */
+    void Reset()
+    {
+        m_signaled.store(0, std::memory_order_seq_cst);
+    }
+
+    /**
+     * Resets the event to normal status.
+     *
+     * @tparam T Action type which is executed before reset operation(void operator()()).
+     * @param preResetAct function object which is executed before reset operation.
+     */
+    template<typename T> void Reset(T &&preResetAct)
+    {
+        SpinLock<>::ScopeLock lock(m_actionLock);
+        preResetAct();
+        Reset();
+    }
+
+    /**
+     * Query this wait evnet is error status(never fails).
+     *
+     * @return Always true.
+     */
+    operator bool() const
+    {
+        return true;
+    }
+
+    static const us32 INFINITE_WAIT = 0xFFFFFFFF;  /**< Timeout value which means waiting forever. */
+
+private:
+    /**
+     * Consumes the signal(auto-reset) or checks it(manual-reset).
+     *
+     * @return True if signaled.
+     */
+    bool TryConsume()
+    {
+        if (!m_signaled.load(std::memory_order_acquire))
+        {
+            return false;
+        }
+        if (m_mode == ManualReset)
+        {
+            return true;
+        }
+        us32 expected = 1;
+        return m_signaled.compare_exchange_strong(expected, 0, std::memory_order_acquire);
+    }
+
+    /**
+     * Spins and then parks until tryConsume succeeds,SignalAll is called or the timeout elapses.
+     *
+     * @tparam T Type of the consume function(bool operator()()).
+     * @param milliSeconds The timeout.
+     * @param tryConsume The consume function.
+     *
+     * @return True if consumed or released by SignalAll.
+     */
+    template<typename T> bool WaitFor(us32 milliSeconds, T &&tryConsume);
+
+    /**
+     * Wakes the parked waiters if any.
+     *
+     * @param all True to wake all waiters,otherwise one.
+     */
+    void Wake(bool all);
+
+    /**
+     * Parks the caller while m_epoch equals epoch.
+     *
+     * @param epoch The epoch read before the last check.
+     * @param milliSeconds The timeout,INFINITE_WAIT waits forever.
+     */
+    void Park(us32 epoch, us32 milliSeconds);
+
+    const Mode m_mode;  /**< The reset mode. */
+
+    const unsigned m_spinCount; /**< Number of spin rounds. */
+
+    std::atomic<us32> m_signaled;   /**< 1 if signaled. */
+
+    std::atomic<us32> m_epoch;  /**< The futex word,changed by every wake up. */
+
+    std::atomic<us32> m_waiters;    /**< Number of parked or parking waiters. */
+
+    std::atomic<us32> m_broadcasts; /**< Number of SignalAll calls. */
+
+    SpinLock<> m_actionLock;    /**< Lock of the pre/post actions. */
+
+#if !defined(__linux__)
+    std::mutex m_parkMutex; /**< Mutex of the parked waiters. */
+
+    std::condition_variable m_parkCond; /**< Condition variable of the parked waiters. */
+#endif
+};
+
+template<typename T> bool FutexWaitEvent::TimedWait(us32 milliSeconds, T &&postWaitAct)
+{
+    bool consumed = false;
+    bool ret = WaitFor(milliSeconds, [&]()
+    {
+        SpinLock<>::ScopeLock lock(m_actionLock);
+        if (!TryConsume())
+        {
+            return false;
+        }
+        postWaitAct(true);
+        consumed = true;
+        return true;
+    });
+    //a waiter released by SignalAll or timed out has not executed the action yet.
+    if (!consumed)
+    {
+        SpinLock<>::ScopeLock lock(m_actionLock);
+        postWaitAct(ret);
+    }
+    return ret;
+}
+
+template<typename T> void FutexWaitEvent::Signal(T &&preSignalAct)
+{
+    {
+        SpinLock<>::ScopeLock lock(m_actionLock);
+        if (!WaitEventExecPreAct(std::forward<T>(preSignalAct)))
+        {
+            return;
+        }
+        m_signaled.store(1, std::memory_order_seq_cst);
+    }
+    Wake(m_mode == ManualReset);
+}
+
+template<typename T> bool FutexWaitEvent::WaitFor(us32 milliSeconds, T &&tryConsume)
+{
+    us32 broadcasts = m_broadcasts.load(std::memory_order_seq_cst);
+    for (unsigned k = 0; k < m_spinCount; ++k)
+    {
+        if (tryConsume() || m_broadcasts.load(std::memory_order_acquire) != broadcasts)
+        {
+            return true;
+        }
+        DefaultBlackMagicFunc(k);
+    }
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(milliSeconds);
+    for (;;)
+    {
+        m_waiters.fetch_add(1, std::memory_order_seq_cst);
+        //the epoch is read before the check,so a wake up after the check changes it and Park returns at once.
+        us32 epoch = m_epoch.load(std::memory_order_seq_cst);
+        if (tryConsume() || m_broadcasts.load(std::memory_order_seq_cst) != broadcasts)
+        {
+            m_waiters.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+        us32 timeout = INFINITE_WAIT;
+        if (milliSeconds != INFINITE_WAIT)
+        {
+            auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now());
+            if (remaining.count() <= 0)
+            {
+                m_waiters.fetch_sub(1, std::memory_order_relaxed);
+                return false;
+            }
+            timeout = static_cast<us32>(remaining.count()) + 1;
+        }
+        Park(epoch, timeout);
+        m_waiters.fetch_sub(1, std::memory_order_relaxed);
+    }
+}
+
+#endif /* FUTEXWAITEVENT_H */
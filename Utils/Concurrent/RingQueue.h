@@ -0,0 +1,513 @@
+#ifndef RINGQUEUE_H
+#define RINGQUEUE_H
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include "WaitEvent.h"
+
+/**
+ * Size of the cache line,the hot indices of the queues are placed on their own lines to avoid false sharing.
+ */
+constexpr size_t RingQueueCacheLineSize = 64;
+
+/**
+ * Waiters of a RingQueue side(consumers waiting for an element or producers waiting for a slot).The side which succeeded notifies the
+ * other side only when it has waiters,so the queues do not touch the WaitEvent mutex on the lock free path.
+ */
+class RingQueueWaiters
+{
+public:
+    RingQueueWaiters() :m_count(0), m_signalPending(false), m_event()
+    {
+    }
+
+    RingQueueWaiters(const RingQueueWaiters&) = delete;
+
+    RingQueueWaiters& operator=(const RingQueueWaiters&) = delete;
+
+    /**
+     * Wakes a waiter if any.
+     */
+    void Notify()
+    {
+        //pairs with the fence of Wait,either the waiter sees the new state or this sees the waiter.
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        //the event stays signaled until a waiter wakes up,so the notifiers do not take its mutex again before that.
+        if (m_count.load(std::memory_order_relaxed) && !m_signalPending.exchange(true, std::memory_order_seq_cst))
+        {
+            m_event.Signal();
+        }
+    }
+
+    /**
+     * Retries an operation until it succeeds or the timeout elapses.
+     *
+     * @tparam T Type of the operation(bool operator()()).
+     * @param tryOp The operation.
+     * @param milliSeconds The timeout,INFINITE_WAIT waits forever.
+     *
+     * @return False if timed out.
+     */
+    template<typename T> bool Wait(T &&tryOp, us32 milliSeconds)
+    {
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(milliSeconds);
+        for (;;)
+        {
+            m_count.fetch_add(1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (tryOp())
+            {
+                m_count.fetch_sub(1, std::memory_order_relaxed);
+                //signals are not counted,so a woken waiter passes on the signals which may have been merged.
+                Notify();
+                return true;
+            }
+            if (milliSeconds == INFINITE_WAIT)
+            {
+                m_event.Wait();
+            }
+            else
+            {
+                auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now());
+                if (remaining.count() <= 0)
+                {
+                    m_count.fetch_sub(1, std::memory_order_relaxed);
+                    return false;
+                }
+                m_event.TimedWait(static_cast<us32>(remaining.count()) + 1);
+            }
+            m_signalPending.store(false, std::memory_order_seq_cst);
+            m_count.fetch_sub(1, std::memory_order_relaxed);
+        }
+    }
+
+    static const us32 INFINITE_WAIT = 0xFFFFFFFF;  /**< Timeout value which means waiting forever. */
+
+private:
+    std::atomic<us32> m_count;  /**< Number of waiters. */
+
+    std::atomic<bool> m_signalPending;  /**< True if the event has been signaled and no waiter has woken up since. */
+
+    WaitEvent m_event;  /**< Event the waiters sleep on. */
+};
+
+/**
+ * Bounded multi-producer/multi-consumer queue(D. Vyukov's array queue).Every cell carries a sequence number which tells whether it is
+ * ready for the producer or the consumer of a position,so a push or pop is a single CAS of the position in the common case.The capacity
+ * is rounded up to a power of 2.
+ *
+ * The Try functions never block,Push/Pop wait on a WaitEvent when the queue is full/empty.
+ *
+ * @tparam T Type of the elements.
+ */
+template<typename T> class MpmcRingQueue
+{
+public:
+    /**
+     * Constructor.
+     *
+     * @param capacity The capacity(rounded up to a power of 2,at least 2).
+     */
+    explicit MpmcRingQueue(size_t capacity) :m_mask(RoundUpCapacity(capacity) - 1), m_cells(new Cell[m_mask + 1]), m_enqueuePos(0)
+        , m_dequeuePos(0), m_popWaiters(), m_pushWaiters()
+    {
+        for (size_t i = 0; i <= m_mask; ++i)
+        {
+            m_cells[i].m_sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    MpmcRingQueue(const MpmcRingQueue&) = delete;
+
+    MpmcRingQueue& operator=(const MpmcRingQueue&) = delete;
+
+    /**
+     * Destructor,destroys the remaining elements.
+     */
+    ~MpmcRingQueue()
+    {
+        for (size_t pos = m_dequeuePos.load(std::memory_order_relaxed); pos != m_enqueuePos.load(std::memory_order_relaxed); ++pos)
+        {
+            reinterpret_cast<T*>(&m_cells[pos & m_mask].m_storage)->~T();
+        }
+    }
+
+    size_t Capacity() const
+    {
+        return m_mask + 1;
+    }
+
+    /**
+     * Gets the number of elements(may be out of date when returned).
+     *
+     * @return The number of elements.
+     */
+    size_t SizeApprox() const
+    {
+        size_t enqueuePos = m_enqueuePos.load(std::memory_order_relaxed);
+        size_t dequeuePos = m_dequeuePos.load(std::memory_order_relaxed);
+        return enqueuePos > dequeuePos ? enqueuePos - dequeuePos : 0;
+    }
+
+    /**
+     * Constructs an element at the end if the queue is not full.
+     *
+     * @return False if the queue is full.
+     */
+    template<typename... Args> bool TryEmplace(Args&&... args)
+    {
+        Cell *cell;
+        size_t pos = m_enqueuePos.load(std::memory_order_relaxed);
+        for (;;)
+        {
+            cell = &m_cells[pos & m_mask];
+            size_t sequence = cell->m_sequence.load(std::memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+            if (diff == 0)
+            {
+                if (m_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                {
+                    break;
+                }
+            }
+            else if (diff < 0)
+            {
+                return false;
+            }
+            else
+            {
+                pos = m_enqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+        new (&cell->m_storage) T(std::forward<Args>(args)...);
+        cell->m_sequence.store(pos + 1, std::memory_order_release);
+        m_popWaiters.Notify();
+        return true;
+    }
+
+    bool TryPush(const T &value)
+    {
+        return TryEmplace(value);
+    }
+
+    bool TryPush(T &&value)
+    {
+        return TryEmplace(std::move(value));
+    }
+
+    /**
+     * Removes the first element if the queue is not empty.
+     *
+     * @param [out] value The element.
+     *
+     * @return False if the queue is empty.
+     */
+    bool TryPop(T &value)
+    {
+        Cell *cell;
+        size_t pos = m_dequeuePos.load(std::memory_order_relaxed);
+        for (;;)
+        {
+            cell = &m_cells[pos & m_mask];
+            size_t sequence = cell->m_sequence.load(std::memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos + 1);
+            if (diff == 0)
+            {
+                if (m_dequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                {
+                    break;
+                }
+            }
+            else if (diff < 0)
+            {
+                return false;
+            }
+            else
+            {
+                pos = m_dequeuePos.load(std::memory_order_relaxed);
+            }
+        }
+        T *element = reinterpret_cast<T*>(&cell->m_storage);
+        value = std::move(*element);
+        element->~T();
+        cell->m_sequence.store(pos + m_mask + 1, std::memory_order_release);
+        m_pushWaiters.Notify();
+        return true;
+    }
+
+    /**
+     * Appends an element,waits while the queue is full.
+     *
+     * @param value The element.
+     */
+    void Push(T value)
+    {
+        m_pushWaiters.Wait([&]() { return TryEmplace(std::move(value)); }, RingQueueWaiters::INFINITE_WAIT);
+    }
+
+    /**
+     * Appends an element,waits while the queue is full.
+     *
+     * @param value The element.
+     * @param milliSeconds The timeout.
+     *
+     * @return False if timed out.
+     */
+    bool Push(T value, us32 milliSeconds)
+    {
+        return m_pushWaiters.Wait([&]() { return TryEmplace(std::move(value)); }, milliSeconds);
+    }
+
+    /**
+     * Removes the first element,waits while the queue is empty.
+     *
+     * @param [out] value The element.
+     */
+    void Pop(T &value)
+    {
+        m_popWaiters.Wait([&]() { return TryPop(value); }, RingQueueWaiters::INFINITE_WAIT);
+    }
+
+    /**
+     * Removes the first element,waits while the queue is empty.
+     *
+     * @param [out] value The element.
+     * @param milliSeconds The timeout.
+     *
+     * @return False if timed out.
+     */
+    bool Pop(T &value, us32 milliSeconds)
+    {
+        return m_popWaiters.Wait([&]() { return TryPop(value); }, milliSeconds);
+    }
+
+private:
+    /**
+     * A cell.
+     */
+    struct Cell
+    {
+        std::atomic<size_t> m_sequence; /**< Equals the position when the cell is free for the producer,position+1 when it is filled. */
+
+        typename std::aligned_storage<sizeof(T), alignof(T)>::type m_storage;   /**< The element. */
+    };
+
+    static size_t RoundUpCapacity(size_t capacity)
+    {
+        size_t ret = 2;
+        while (ret < capacity)
+        {
+            ret <<= 1;
+        }
+        return ret;
+    }
+
+    alignas(RingQueueCacheLineSize) const size_t m_mask;    /**< Capacity-1. */
+
+    const std::unique_ptr<Cell[]> m_cells;  /**< The cells. */
+
+    alignas(RingQueueCacheLineSize) std::atomic<size_t> m_enqueuePos;   /**< Position of the next push. */
+
+    alignas(RingQueueCacheLineSize) std::atomic<size_t> m_dequeuePos;   /**< Position of the next pop. */
+
+    alignas(RingQueueCacheLineSize) RingQueueWaiters m_popWaiters;  /**< Consumers waiting for an element. */
+
+    alignas(RingQueueCacheLineSize) RingQueueWaiters m_pushWaiters; /**< Producers waiting for a slot. */
+};
+
+/**
+ * Bounded single-producer/single-consumer queue.Each side owns its index and keeps a cached copy of the other side's index,so it reads
+ * the shared index only when the cached one says the queue is full/empty.The capacity is rounded up to a power of 2.
+ *
+ * Only one thread may push and only one thread may pop at the same time.
+ *
+ * @tparam T Type of the elements.
+ */
+template<typename T> class SpscRingQueue
+{
+public:
+    /**
+     * Constructor.
+     *
+     * @param capacity The capacity(rounded up to a power of 2,at least 2).
+     */
+    explicit SpscRingQueue(size_t capacity) :m_mask(RoundUpCapacity(capacity) - 1), m_slots(new Slot[m_mask + 1]), m_tail(0), m_cachedHead(0)
+        , m_head(0), m_cachedTail(0), m_popWaiters(), m_pushWaiters()
+    {
+    }
+
+    SpscRingQueue(const SpscRingQueue&) = delete;
+
+    SpscRingQueue& operator=(const SpscRingQueue&) = delete;
+
+    /**
+     * Destructor,destroys the remaining elements.
+     */
+    ~SpscRingQueue()
+    {
+        for (size_t pos = m_head.load(std::memory_order_relaxed); pos != m_tail.load(std::memory_order_relaxed); ++pos)
+        {
+            reinterpret_cast<T*>(&m_slots[pos & m_mask])->~T();
+        }
+    }
+
+    size_t Capacity() const
+    {
+        return m_mask + 1;
+    }
+
+    /**
+     * Gets the number of elements(may be out of date when returned).
+     *
+     * @return The number of elements.
+     */
+    size_t SizeApprox() const
+    {
+        //the head is read first,so it never passes the tail read later.
+        size_t head = m_head.load(std::memory_order_acquire);
+        return m_tail.load(std::memory_order_acquire) - head;
+    }
+
+    /**
+     * Constructs an element at the end if the queue is not full(producer only).
+     *
+     * @return False if the queue is full.
+     */
+    template<typename... Args> bool TryEmplace(Args&&... args)
+    {
+        size_t tail = m_tail.load(std::memory_order_relaxed);
+        if (tail - m_cachedHead > m_mask)
+        {
+            m_cachedHead = m_head.load(std::memory_order_acquire);
+            if (tail - m_cachedHead > m_mask)
+            {
+                return false;
+            }
+        }
+        new (&m_slots[tail & m_mask]) T(std::forward<Args>(args)...);
+        m_tail.store(tail + 1, std::memory_order_release);
+        m_popWaiters.Notify();
+        return true;
+    }
+
+    bool TryPush(const T &value)
+    {
+        return TryEmplace(value);
+    }
+
+    bool TryPush(T &&value)
+    {
+        return TryEmplace(std::move(value));
+    }
+
+    /**
+     * Removes the first element if the queue is not empty(consumer only).
+     *
+     * @param [out] value The element.
+     *
+     * @return False if the queue is empty.
+     */
+    bool TryPop(T &value)
+    {
+        size_t head = m_head.load(std::memory_order_relaxed);
+        if (head == m_cachedTail)
+        {
+            m_cachedTail = m_tail.load(std::memory_order_acquire);
+            if (head == m_cachedTail)
+            {
+                return false;
+            }
+        }
+        T *element = reinterpret_cast<T*>(&m_slots[head & m_mask]);
+        value = std::move(*element);
+        element->~T();
+        m_head.store(head + 1, std::memory_order_release);
+        m_pushWaiters.Notify();
+        return true;
+    }
+
+    /**
+     * Appends an element,waits while the queue is full(producer only).
+     *
+     * @param value The element.
+     */
+    void Push(T value)
+    {
+        m_pushWaiters.Wait([&]() { return TryEmplace(std::move(value)); }, RingQueueWaiters::INFINITE_WAIT);
+    }
+
+    /**
+     * Appends an element,waits while the queue is full(producer only).
+     *
+     * @param value The element.
+     * @param milliSeconds The timeout.
+     *
+     * @return False if timed out.
+     */
+    bool Push(T value, us32 milliSeconds)
+    {
+        return m_pushWaiters.Wait([&]() { return TryEmplace(std::move(value)); }, milliSeconds);
+    }
+
+    /**
+     * Removes the first element,waits while the queue is empty(consumer only).
+     *
+     * @param [out] value The element.
+     */
+    void Pop(T &value)
+    {
+        m_popWaiters.Wait([&]() { return TryPop(value); }, RingQueueWaiters::INFINITE_WAIT);
+    }
+
+    /**
+     * Removes the first element,waits while the queue is empty(consumer only).
+     *
+     * @param [out] value The element.
+     * @param milliSeconds The timeout.
+     *
+     * @return False if timed out.
+     */
+    bool Pop(T &value, us32 milliSeconds)
+    {
+        return m_popWaiters.Wait([&]() { return TryPop(value); }, milliSeconds);
+    }
+
+private:
+    /**
+     * Defines an alias representing the storage of an element.
+     */
+    using Slot = typename std::aligned_storage<sizeof(T), alignof(T)>::type;
+
+    static size_t RoundUpCapacity(size_t capacity)
+    {
+        size_t ret = 2;
+        while (ret < capacity)
+        {
+            ret <<= 1;
+        }
+        return ret;
+    }
+
+    alignas(RingQueueCacheLineSize) const size_t m_mask;    /**< Capacity-1. */
+
+    const std::unique_ptr<Slot[]> m_slots;  /**< The slots. */
+
+    alignas(RingQueueCacheLineSize) std::atomic<size_t> m_tail; /**< Position of the next push(written by the producer). */
+
+    size_t m_cachedHead;    /**< Producer's copy of m_head. */
+
+    alignas(RingQueueCacheLineSize) std::atomic<size_t> m_head; /**< Position of the next pop(written by the consumer). */
+
+    size_t m_cachedTail;    /**< Consumer's copy of m_tail. */
+
+    alignas(RingQueueCacheLineSize) RingQueueWaiters m_popWaiters;  /**< The consumer waiting for an element. */
+
+    alignas(RingQueueCacheLineSize) RingQueueWaiters m_pushWaiters; /**< The producer waiting for a slot. */
+};
+
+#endif /* RINGQUEUE_H */
@@ -0,0 +1,61 @@
+#ifndef AWAITABLETIMER_H
+#define AWAITABLETIMER_H
+
+#include <utility>
+#include <boost/asio/steady_timer.hpp>
+
+#if defined(BOOST_ASIO_HAS_CO_AWAIT)
+
+#include <boost/asio/use_awaitable.hpp>
+#include "../ThreadPool.h"
+
+/**
+ * Coroutine(C++20) timer,co_await timer.After(std::chrono::milliseconds(100)) suspends the coroutine for the duration.
+ *
+ * @note Cancelling the timer(or destroying it) completes the pending wait with boost::asio::error::operation_aborted.
+ */
+class AwaitableTimer
+{
+public:
+
+    /**
+     * Constructor
+     *
+     * @param [in,out] context The io context which runs the timer(the thread pool by default).
+     */
+    explicit AwaitableTimer(boost::asio::io_context &context = ThreadPool::Instance().Context()) :m_timer(context)
+    {
+    }
+
+    /**
+     * Waits for a duration.
+     *
+     * @tparam CompletionToken Type of the completion token.
+     * @param duration The duration.
+     * @param token The completion token,signature is void(boost::system::error_code).
+     *
+     * @return Depends on the token(boost::asio::awaitable<void> by default).
+     */
+    template<typename CompletionToken = boost::asio::use_awaitable_t<>> auto After(boost::asio::steady_timer::duration duration
+        , CompletionToken &&token = {})
+    {
+        m_timer.expires_after(duration);
+        return m_timer.async_wait(std::forward<CompletionToken>(token));
+    }
+
+    /**
+     * Cancels the pending wait.
+     */
+    void Cancel()
+    {
+        boost::system::error_code err;
+        m_timer.cancel(err);
+    }
+
+private:
+    boost::asio::steady_timer m_timer;  /**< The timer. */
+};
+
+#endif
+
+#endif /* AWAITABLETIMER_H */
@@ -1,5 +1,6 @@
 #if defined(USE_ODBC_DATABASE_UTILS) || defined(USE_OCI_DATABASE_UTILS)
 
+#include <exception>
 #include "ISqlDatabase.h"
 
 ISqlDatabase::ISqlDatabase()
@@ -10,4 +11,135 @@ ISqlDatabase::~ISqlDatabase()
 {
 }
 
+bool ISqlDatabase::PrepareStatement(SqlStatementId id, int bufferSize)
+{
+    const std::string *sql = SqlStatementRegistry::Find(id);
+    if (!sql)
+    {
+        SetLastError("准备SQL错误，语句ID不存在：" + std::to_string(id));
+        return false;
+    }
+    return Prepare(sql->c_str(), bufferSize);
+}
+
+bool ISqlDatabase::IsNull()
+{
+    return false;
+}
+
+int ISqlDatabase::FetchColumns(SqlColumnBatch &batch)
+{
+    size_t row = batch.RowCount();
+    size_t beg = row;
+    std::string value;
+    try
+    {
+        int eof = 0;
+        while (row < batch.Capacity() && !(eof = IsEOF()))
+        {
+            for (size_t i = 0; i < batch.ColumnCount(); ++i)
+            {
+                switch (batch.Type(i))
+                {
+                case SqlColumnType::Int32:
+                {
+                    int n;
+                    *this >> n;
+                    batch.Int32s(i)[row] = n;
+                    break;
+                }
+                case SqlColumnType::Int64:
+                {
+                    long int l;
+                    *this >> l;
+                    batch.Int64s(i)[row] = l;
+                    break;
+                }
+                case SqlColumnType::Double:
+                    *this >> batch.Doubles(i)[row];
+                    break;
+                case SqlColumnType::String:
+                    *this >> value;
+                    batch.SetString(i, row, value.data(), value.size());
+                    break;
+                case SqlColumnType::DateTime:
+                    *this >> batch.DateTimes(i)[row];
+                    break;
+                }
+                batch.SetNull(i, row, IsNull());
+            }
+            batch.SetRowCount(++row);
+        }
+        if (eof < 0)
+        {
+            return -1;
+        }
+    }
+    catch (const std::exception &ex)
+    {
+        SetLastError(std::string("批量读取错误，错误信息：").append(ex.what()));
+        return -1;
+    }
+    catch (...)
+    {
+        //operator>> has formatted the OTL exception into LastError() before it rethrew the exception.
+        SetLastError("批量读取错误，" + LastError());
+        return -1;
+    }
+    return static_cast<int>(row - beg);
+}
+
+bool ISqlDatabase::InsertColumns(const SqlColumnBatch &batch)
+{
+    try
+    {
+        for (size_t row = 0; row < batch.RowCount(); ++row)
+        {
+            for (size_t i = 0; i < batch.ColumnCount(); ++i)
+            {
+                if (batch.IsNull(i, row))
+                {
+                    *this << otl_null();
+                    continue;
+                }
+                switch (batch.Type(i))
+                {
+                case SqlColumnType::Int32:
+                    *this << static_cast<int>(batch.Int32s(i)[row]);
+                    break;
+                case SqlColumnType::Int64:
+                    *this << static_cast<long int>(batch.Int64s(i)[row]);
+                    break;
+                case SqlColumnType::Double:
+                    *this << batch.Doubles(i)[row];
+                    break;
+                case SqlColumnType::String:
+                    *this << batch.String(i, row);
+                    break;
+                case SqlColumnType::DateTime:
+                    *this << batch.DateTimes(i)[row];
+                    break;
+                }
+            }
+        }
+    }
+    catch (const std::exception &ex)
+    {
+        SetLastError(std::string("批量写入错误，错误信息：").append(ex.what()));
+        return false;
+    }
+    catch (...)
+    {
+        //operator<< has formatted the OTL exception into LastError() before it rethrew the exception.
+        SetLastError("批量写入错误，" + LastError());
+        return false;
+    }
+    return FlushBuffer();
+}
+
+SqlStatementCacheStats ISqlDatabase::StatementCacheStats()
+{
+    return SqlStatementCacheStats{ 0, 0, 0, 0 };
+}
+
 #endif
\ No newline at end of file
@@ -5,6 +5,22 @@
 #include "../../../Common/CommonHdr.h"
 #include "OTLHdr.h"
 #include "SqlDatabaseType.h"
+#include "SqlStatementRegistry.h"
+#include "SqlColumnBatch.h"
+
+/**
+ * Statistics of the prepared statement cache of a connection.
+ */
+struct SqlStatementCacheStats
+{
+    us64 m_hitCount;    /**< Number of prepares which reused a cached statement. */
+
+    us64 m_missCount;   /**< Number of prepares which opened a statement. */
+
+    us64 m_evictedCount;    /**< Number of statements closed by the LRU eviction. */
+
+    size_t m_size;  /**< Number of cached statements. */
+};
 
 class UTILS_EXPORTS_API ISqlDatabase
 {
@@ -25,6 +41,25 @@ public:
 
     virtual bool Prepare(const char *sql, int bufferSize, bool stayInPool = true, bool storedPorcReturnDataset = false) = 0;
 
+    /**
+     * Prepares an interned statement,the connection keeps the prepared statements in a LRU cache keyed by the ID and buffer size.
+     * Prepare never interns its text,use this for the fixed statements of the hot paths.The default implementation prepares the
+     * statement by its text.
+     *
+     * @param id The statement ID(see SqlStatementRegistry::Intern).
+     * @param bufferSize The buffer size.
+     *
+     * @return True if succeeded,false if failed or the ID is not interned.
+     */
+    virtual bool PrepareStatement(SqlStatementId id, int bufferSize);
+
+    /**
+     * Gets the statistics of the prepared statement cache.
+     *
+     * @return The statistics(all zero if the connection does not cache statements).
+     */
+    virtual SqlStatementCacheStats StatementCacheStats();
+
     virtual bool FlushBuffer() = 0;
 
     virtual bool Commit() = 0;
@@ -35,6 +70,37 @@ public:
 
     virtual const std::string& LastError() = 0;
 
+    /**
+     * Query if the last read value is null.
+     *
+     * @return True if null(the default implementation always returns false).
+     */
+    virtual bool IsNull();
+
+    /**
+     * Fetches the rows of the current select statement into a batch,from its RowCount() until it is full or the result set ends.The
+     * buffer size of the prepared statement is the number of rows fetched per round trip.The default implementation reads the values
+     * by operator>>(Int64 columns are read as long int).
+     *
+     * @param batch The batch whose column types match the select list.
+     *
+     * @return Number of fetched rows(0 if the result set ended),-1 if failed(see LastError,the batch keeps the complete rows).
+     */
+    virtual int FetchColumns(SqlColumnBatch &batch);
+
+    /**
+     * Writes the rows of a batch to the prepared statement(such as an insert statement whose bind variables match the batch columns)
+     * and flushes them.The values are copied row by row into the statement's OTL buffer,OTL executes the buffered rows at once as
+     * an ODBC parameter array or OCI array DML,so prepare the statement with a buffer size not less than RowCount() to send the batch
+     * in one round trip.The default implementation writes the values by operator<<(Int64 columns are written as long int).The work
+     * is not committed.
+     *
+     * @param batch The batch.
+     *
+     * @return True if succeeded.
+     */
+    virtual bool InsertColumns(const SqlColumnBatch &batch);
+
     virtual ISqlDatabase& operator<<(const unsigned char* s) = 0;
 
     virtual ISqlDatabase& operator<<(const char c) = 0;
@@ -86,6 +152,14 @@ public:
     virtual ISqlDatabase& operator >> (double& d) = 0;
 
     virtual ISqlDatabase& operator >> (otl_datetime& dt) = 0;
+
+protected:
+    /**
+     * Sets the error returned by LastError,used by the default implementations which do not own the error string.
+     *
+     * @param error The error.
+     */
+    virtual void SetLastError(const std::string &error) = 0;
 };
 
 #endif /* USE_DATABASE_UTILS */
\ No newline at end of file
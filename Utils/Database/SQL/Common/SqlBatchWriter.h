@@ -0,0 +1,180 @@
+#ifndef SQLBATCHWRITER_H
+#define SQLBATCHWRITER_H
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <string>
+#include <boost/thread.hpp>
+#include "../../../Log/Log4cplusCustomInc.h"
+#include "../../../Concurrent/SpinLock.h"
+#include "../../../Concurrent/WaitEvent.h"
+#include "SqlConnectionPool.h"
+
+/**
+ * Settings of a SqlBatchWriter.
+ */
+struct SqlBatchWriterSettings
+{
+    std::string m_poolName; /**< Name of the SqlConnectionPool which the writer borrows its connection from. */
+
+    int m_bufferSize;   /**< Buffer size passed to ISqlDatabase::Prepare,a group is written as soon as this number of rows is queued. */
+
+    std::chrono::milliseconds m_maxLatency; /**< Max time a row waits for its group to fill up. */
+};
+
+/**
+ * Statistics of a SqlBatchWriter.
+ */
+struct SqlBatchWriterStats
+{
+    us64 m_rows;    /**< Number of committed rows. */
+
+    us64 m_failedRows;  /**< Number of rows whose group failed(the group is rolled back). */
+
+    us64 m_groups;  /**< Number of groups(one commit per group). */
+
+    us64 m_totalWriteUs;    /**< Total time spent writing groups(prepare,bind,flush and commit,in microseconds). */
+
+    us64 m_totalCommitUs;   /**< Total commit time(in microseconds). */
+
+    us64 m_maxCommitUs; /**< Max commit time(in microseconds). */
+};
+
+/**
+ * Group commit writer of a prepared statement.Rows written by many producers are queued without lock,a writer thread which holds a
+ * pooled connection binds each group of rows to the statement,flushes the buffer whenever m_bufferSize rows are bound and commits once
+ * per group.A group is written when m_bufferSize rows are queued or m_maxLatency after its first row arrived.
+ *
+ * @tparam Row Type of the row.
+ *
+ * @note Include SqlBatchWriter.hpp to instantiate it.
+ */
+template<typename Row> class SqlBatchWriter
+{
+public:
+
+    /**
+     * Defines an alias representing the function which binds a row to the statement by ISqlDatabase::operator<<.
+     */
+    using BindFunc = std::function<void(ISqlDatabase &db, const Row &row)>;
+
+    /**
+     * Defines an alias representing the function which is called by the writer thread after a group is written.
+     */
+    using GroupCallback = std::function<void(size_t rowCount, bool succeeded, const std::string &error)>;
+
+    /**
+     * Constructor,starts the writer thread.
+     *
+     * @param sql The statement(such as an insert statement with OTL bind variables).
+     * @param settings The settings.
+     * @param bindFunc The bind function.
+     * @param groupCallback (Optional) The group callback.
+     */
+    SqlBatchWriter(const std::string &sql, const SqlBatchWriterSettings &settings, BindFunc bindFunc, GroupCallback groupCallback = GroupCallback());
+
+    /**
+     * Destructor,stops the writer.
+     */
+    ~SqlBatchWriter();
+
+    SqlBatchWriter(const SqlBatchWriter&) = delete;
+
+    SqlBatchWriter& operator=(const SqlBatchWriter&) = delete;
+
+    /**
+     * Queues a row(thread safe and lock free).
+     *
+     * @param row The row.
+     *
+     * @return False if the writer is stopped.
+     */
+    bool Write(Row row);
+
+    /**
+     * Stops accepting rows,writes the queued ones(every row whose Write returned true) and stops the writer thread.
+     */
+    void Stop();
+
+    /**
+     * Gets the number of queued rows.
+     *
+     * @return Number of rows.
+     */
+    size_t PendingRows() const
+    {
+        return m_pendingCount.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * Gets the statistics.
+     *
+     * @return The statistics.
+     */
+    SqlBatchWriterStats GetStats();
+
+private:
+    /**
+     * A queued row.
+     */
+    struct Node
+    {
+        Row m_row;  /**< The row. */
+
+        Node *m_next;   /**< Next node. */
+    };
+
+    std::string m_sql;  /**< The statement. */
+
+    SqlStatementId m_statementId;   /**< Interned ID of m_sql. */
+
+    SqlBatchWriterSettings m_settings;  /**< The settings. */
+
+    std::shared_ptr<SqlConnectionPool> m_pool;  /**< The connection pool. */
+
+    BindFunc m_bindFunc;    /**< The bind function. */
+
+    GroupCallback m_groupCallback;  /**< The group callback. */
+
+    std::atomic<Node*> m_head;  /**< Last queued row(the rows are linked in reverse order). */
+
+    std::atomic<size_t> m_pendingCount; /**< Number of queued rows. */
+
+    std::atomic<bool> m_stopped;    /**< True if stopped. */
+
+    std::atomic<size_t> m_activeWrites; /**< Number of Write calls which passed the stop check and are queueing their rows. */
+
+    WaitEvent m_wakeup; /**< Wakes the writer when the first row is queued,the buffer is full or the writer is stopped. */
+
+    SpinLock<> m_statsLock; /**< Lock of m_stats. */
+
+    SqlBatchWriterStats m_stats;    /**< The statistics. */
+
+    boost::thread m_writer; /**< The writer thread. */
+
+    /**
+     * Writer thread entry.
+     */
+    void WriterEntry();
+
+    /**
+     * Takes the queued rows and writes them as a group.
+     *
+     * @param db The connection of the writer(null if no connection is available,the group fails).
+     */
+    void WriteGroup(ISqlDatabase *db);
+
+    /**
+     * Gets the logger.
+     *
+     * @return The logger.
+     */
+    static log4cplus::Logger& Logger()
+    {
+        static log4cplus::Logger log = log4cplus::Logger::getInstance("SqlBatchWriter");
+        return log;
+    }
+};
+
+#endif /* SQLBATCHWRITER_H */
@@ -0,0 +1,204 @@
+#ifndef SQLBATCHWRITERIMPL_H
+#define SQLBATCHWRITERIMPL_H
+
+#include "SqlBatchWriter.h"
+
+template<typename Row> SqlBatchWriter<Row>::SqlBatchWriter(const std::string &sql, const SqlBatchWriterSettings &settings, BindFunc bindFunc
+    , GroupCallback groupCallback) :m_sql(sql), m_statementId(SqlStatementRegistry::Intern(sql)), m_settings(settings)
+    , m_pool(SqlConnectionPool::Find(settings.m_poolName)), m_bindFunc(std::move(bindFunc)), m_groupCallback(std::move(groupCallback))
+    , m_head(nullptr), m_pendingCount(0), m_stopped(false), m_activeWrites(0), m_wakeup(), m_statsLock(), m_stats{ 0, 0, 0, 0, 0, 0 }, m_writer()
+{
+    if (m_settings.m_bufferSize <= 0)
+    {
+        m_settings.m_bufferSize = 1;
+    }
+    if (!m_pool)
+    {
+        LOG4CPLUS_ERROR_FMT(Logger(), "批量写入连接池不存在，名称：%s", settings.m_poolName.c_str());
+    }
+    m_writer = boost::thread([this]() { WriterEntry(); });
+}
+
+template<typename Row> SqlBatchWriter<Row>::~SqlBatchWriter()
+{
+    Stop();
+}
+
+template<typename Row> bool SqlBatchWriter<Row>::Write(Row row)
+{
+    //announced before the stop check,so the writer thread waits for this row after it has seen the stop flag.
+    m_activeWrites.fetch_add(1, std::memory_order_seq_cst);
+    if (m_stopped.load(std::memory_order_seq_cst))
+    {
+        m_activeWrites.fetch_sub(1, std::memory_order_release);
+        return false;
+    }
+    Node *node = new Node{ std::move(row), nullptr };
+    //counted before the node is published,so WriteGroup never subtracts a row which is not counted yet.
+    size_t pending = m_pendingCount.fetch_add(1, std::memory_order_relaxed) + 1;
+    node->m_next = m_head.load(std::memory_order_relaxed);
+    while (!m_head.compare_exchange_weak(node->m_next, node, std::memory_order_release, std::memory_order_relaxed));
+    //only the first row of a group and the row which fills the buffer wake the writer.
+    if (pending == 1 || pending == static_cast<size_t>(m_settings.m_bufferSize))
+    {
+        m_wakeup.Signal();
+    }
+    m_activeWrites.fetch_sub(1, std::memory_order_release);
+    return true;
+}
+
+template<typename Row> void SqlBatchWriter<Row>::Stop()
+{
+    m_stopped.store(true, std::memory_order_seq_cst);
+    m_wakeup.Signal();
+    if (m_writer.joinable())
+    {
+        m_writer.join();
+    }
+}
+
+template<typename Row> SqlBatchWriterStats SqlBatchWriter<Row>::GetStats()
+{
+    SpinLock<>::ScopeLock lock(m_statsLock);
+    return m_stats;
+}
+
+template<typename Row> void SqlBatchWriter<Row>::WriterEntry()
+{
+    SqlConnectionPool::ptr_t db;
+    for (;;)
+    {
+        if (!m_pendingCount.load(std::memory_order_relaxed))
+        {
+            if (m_stopped.load(std::memory_order_seq_cst))
+            {
+                //the producers which passed the stop check before Stop queue their rows,they are written before the thread exits.
+                while (m_activeWrites.load(std::memory_order_seq_cst))
+                {
+                    boost::this_thread::yield();
+                }
+                if (!m_head.load(std::memory_order_acquire))
+                {
+                    break;
+                }
+            }
+            else
+            {
+                m_wakeup.TimedWait(100);
+                continue;
+            }
+        }
+        auto deadline = std::chrono::steady_clock::now() + m_settings.m_maxLatency;
+        while (m_pendingCount.load(std::memory_order_relaxed) < static_cast<size_t>(m_settings.m_bufferSize)
+            && !m_stopped.load(std::memory_order_acquire))
+        {
+            auto now = std::chrono::steady_clock::now();
+            if (now >= deadline)
+            {
+                break;
+            }
+            m_wakeup.TimedWait(static_cast<us32>(std::chrono::duration_cast<std::chrono::milliseconds>(deadline - now).count()) + 1);
+        }
+        if (!db && m_pool)
+        {
+            db = m_pool->Borrow();
+        }
+        WriteGroup(db.get());
+    }
+}
+
+template<typename Row> void SqlBatchWriter<Row>::WriteGroup(ISqlDatabase *db)
+{
+    Node *head = m_head.exchange(nullptr, std::memory_order_acquire);
+    if (!head)
+    {
+        return;
+    }
+    //the rows are linked in reverse order.
+    Node *first = nullptr;
+    size_t rowCount = 0;
+    while (head)
+    {
+        Node *next = head->m_next;
+        head->m_next = first;
+        first = head;
+        head = next;
+        ++rowCount;
+    }
+    m_pendingCount.fetch_sub(rowCount, std::memory_order_relaxed);
+
+    auto beg = std::chrono::steady_clock::now();
+    us64 commitUs = 0;
+    bool succeeded = db && db->PrepareStatement(m_statementId, m_settings.m_bufferSize);
+    if (succeeded)
+    {
+        try
+        {
+            int bufferedCount = 0;
+            for (Node *node = first; node && succeeded; node = node->m_next)
+            {
+                m_bindFunc(*db, node->m_row);
+                if (++bufferedCount == m_settings.m_bufferSize)
+                {
+                    succeeded = db->FlushBuffer();
+                    bufferedCount = 0;
+                }
+            }
+            if (succeeded && bufferedCount)
+            {
+                succeeded = db->FlushBuffer();
+            }
+        }
+        catch (...)
+        {
+            succeeded = false;
+        }
+        if (succeeded)
+        {
+            auto commitBeg = std::chrono::steady_clock::now();
+            succeeded = db->Commit();
+            commitUs = static_cast<us64>(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - commitBeg).count());
+        }
+    }
+    std::string error = db ? db->LastError() : std::string("获取数据库连接失败");
+    if (!succeeded)
+    {
+        if (db)
+        {
+            db->Rollback();
+        }
+        LOG4CPLUS_ERROR_FMT(Logger(), "批量写入失败，行数：%zu，错误信息：%s", rowCount, error.c_str());
+    }
+    us64 writeUs = static_cast<us64>(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - beg).count());
+    while (first)
+    {
+        Node *next = first->m_next;
+        delete first;
+        first = next;
+    }
+
+    {
+        SpinLock<>::ScopeLock lock(m_statsLock);
+        ++m_stats.m_groups;
+        if (succeeded)
+        {
+            m_stats.m_rows += rowCount;
+        }
+        else
+        {
+            m_stats.m_failedRows += rowCount;
+        }
+        m_stats.m_totalWriteUs += writeUs;
+        m_stats.m_totalCommitUs += commitUs;
+        if (commitUs > m_stats.m_maxCommitUs)
+        {
+            m_stats.m_maxCommitUs = commitUs;
+        }
+    }
+    if (m_groupCallback)
+    {
+        m_groupCallback(rowCount, succeeded, succeeded ? std::string() : error);
+    }
+}
+
+#endif /* SQLBATCHWRITERIMPL_H */
@@ -0,0 +1,208 @@
+#if defined(USE_ODBC_DATABASE_UTILS) || defined(USE_OCI_DATABASE_UTILS)
+
+#include <algorithm>
+#include "SqlCircuitBreaker.h"
+
+SpinLock<> SqlCircuitBreaker::breakersLock;
+
+std::unordered_map<std::string, std::shared_ptr<SqlCircuitBreaker>> SqlCircuitBreaker::breakers;
+
+SqlCircuitBreakerSettings SqlCircuitBreaker::defaultSettings{ 3, std::chrono::milliseconds(500), std::chrono::milliseconds(30000) };
+
+log4cplus::Logger SqlCircuitBreaker::log = log4cplus::Logger::getInstance("SqlCircuitBreaker");
+
+SqlCircuitBreaker::SqlCircuitBreaker(probe_t probe, const SqlCircuitBreakerSettings &settings) :m_probe(std::move(probe)), m_settings(settings)
+    , m_state(SqlCircuitState::Closed), m_failureCount(0), m_rejectedCount(0), m_lock(), m_tripCount(0), m_probeCount(0)
+    , m_backoff(settings.m_initialBackoff), m_nextProbe(), m_stopped(false), m_probeWakeup(), m_probeThread()
+{
+    if (!m_settings.m_failureThreshold)
+    {
+        m_settings.m_failureThreshold = 1;
+    }
+    if (m_settings.m_maxBackoff < m_settings.m_initialBackoff)
+    {
+        m_settings.m_maxBackoff = m_settings.m_initialBackoff;
+    }
+}
+
+SqlCircuitBreaker::~SqlCircuitBreaker()
+{
+    Stop();
+}
+
+std::shared_ptr<SqlCircuitBreaker> SqlCircuitBreaker::Get(const std::string &connStr, const probe_t &probe)
+{
+    SpinLock<>::ScopeLock lock(breakersLock);
+    auto target = breakers.find(connStr);
+    if (target != breakers.end())
+    {
+        return target->second;
+    }
+    auto ret = std::make_shared<SqlCircuitBreaker>(probe, defaultSettings);
+    breakers.emplace(connStr, ret);
+    return ret;
+}
+
+void SqlCircuitBreaker::SetDefaultSettings(const SqlCircuitBreakerSettings &settings)
+{
+    SpinLock<>::ScopeLock lock(breakersLock);
+    defaultSettings = settings;
+}
+
+SqlCircuitBreakerSettings SqlCircuitBreaker::DefaultSettings()
+{
+    SpinLock<>::ScopeLock lock(breakersLock);
+    return defaultSettings;
+}
+
+void SqlCircuitBreaker::DestoryAll()
+{
+    std::unordered_map<std::string, std::shared_ptr<SqlCircuitBreaker>> temp;
+    {
+        SpinLock<>::ScopeLock lock(breakersLock);
+        temp.swap(breakers);
+    }
+    for (auto &breaker : temp)
+    {
+        breaker.second->Stop();
+    }
+}
+
+void SqlCircuitBreaker::OnSuccess()
+{
+    if (!m_failureCount.load(std::memory_order_acquire))
+    {
+        return;
+    }
+    SpinLock<>::ScopeLock lock(m_lock);
+    if (m_state.load(std::memory_order_relaxed) == SqlCircuitState::Closed)
+    {
+        m_failureCount.store(0, std::memory_order_release);
+    }
+}
+
+void SqlCircuitBreaker::OnFailure()
+{
+    us32 failureCount;
+    {
+        SpinLock<>::ScopeLock lock(m_lock);
+        //the failures of the calls started before the breaker was opened are ignored.
+        if (m_state.load(std::memory_order_relaxed) != SqlCircuitState::Closed || m_stopped.load(std::memory_order_acquire))
+        {
+            return;
+        }
+        failureCount = m_failureCount.load(std::memory_order_relaxed) + 1;
+        m_failureCount.store(failureCount, std::memory_order_release);
+        if (failureCount < m_settings.m_failureThreshold)
+        {
+            return;
+        }
+        ++m_tripCount;
+        m_backoff = m_settings.m_initialBackoff;
+        m_nextProbe = std::chrono::steady_clock::now() + m_backoff;
+        m_state.store(SqlCircuitState::Open, std::memory_order_release);
+        if (!m_probeThread.joinable())
+        {
+            m_probeThread = boost::thread([this]() { ProbeEntry(); });
+        }
+    }
+    LOG4CPLUS_WARN_FMT(log, "数据库熔断器打开，连续失败次数：%u，探测间隔：%lld毫秒", failureCount
+        , static_cast<long long>(m_settings.m_initialBackoff.count()));
+    m_probeWakeup.Signal();
+}
+
+SqlCircuitBreakerStats SqlCircuitBreaker::GetStats()
+{
+    SpinLock<>::ScopeLock lock(m_lock);
+    return SqlCircuitBreakerStats{ m_state.load(std::memory_order_relaxed), m_failureCount.load(std::memory_order_relaxed), m_tripCount
+        , m_rejectedCount.load(std::memory_order_relaxed), m_probeCount, m_backoff };
+}
+
+void SqlCircuitBreaker::Stop()
+{
+    boost::thread probeThread;
+    {
+        //OnFailure starts the thread with the lock held,so it either sees m_stopped or its thread is moved here.
+        SpinLock<>::ScopeLock lock(m_lock);
+        m_stopped.store(true, std::memory_order_release);
+        probeThread = std::move(m_probeThread);
+    }
+    m_probeWakeup.Signal();
+    if (probeThread.joinable())
+    {
+        if (probeThread.get_id() == boost::this_thread::get_id())
+        {
+            probeThread.detach();
+        }
+        else
+        {
+            probeThread.join();
+        }
+    }
+}
+
+void SqlCircuitBreaker::ProbeEntry()
+{
+    while (!m_stopped.load(std::memory_order_acquire))
+    {
+        bool closed;
+        std::chrono::milliseconds remaining;
+        {
+            SpinLock<>::ScopeLock lock(m_lock);
+            closed = m_state.load(std::memory_order_relaxed) == SqlCircuitState::Closed;
+            remaining = std::chrono::duration_cast<std::chrono::milliseconds>(m_nextProbe - std::chrono::steady_clock::now());
+            if (!closed && remaining.count() <= 0)
+            {
+                m_state.store(SqlCircuitState::HalfOpen, std::memory_order_release);
+                ++m_probeCount;
+            }
+        }
+        if (closed)
+        {
+            m_probeWakeup.Wait();
+            continue;
+        }
+        if (remaining.count() > 0)
+        {
+            m_probeWakeup.TimedWait(static_cast<us32>(remaining.count()));
+            continue;
+        }
+
+        bool succeeded = false;
+        try
+        {
+            succeeded = m_probe();
+        }
+        catch (const std::exception &ex)
+        {
+            LOG4CPLUS_ERROR_FMT(log, "数据库熔断器探测捕获异常，异常：%s", ex.what());
+        }
+        std::chrono::milliseconds backoff;
+        {
+            SpinLock<>::ScopeLock lock(m_lock);
+            if (succeeded)
+            {
+                m_failureCount.store(0, std::memory_order_release);
+                m_backoff = m_settings.m_initialBackoff;
+                m_state.store(SqlCircuitState::Closed, std::memory_order_release);
+            }
+            else
+            {
+                m_backoff = (std::min)(m_backoff * 2, m_settings.m_maxBackoff);
+                m_nextProbe = std::chrono::steady_clock::now() + m_backoff;
+                m_state.store(SqlCircuitState::Open, std::memory_order_release);
+            }
+            backoff = m_backoff;
+        }
+        if (succeeded)
+        {
+            LOG4CPLUS_INFO(log, "数据库熔断器探测成功，恢复连接");
+        }
+        else
+        {
+            LOG4CPLUS_WARN_FMT(log, "数据库熔断器探测失败，下次探测间隔：%lld毫秒", static_cast<long long>(backoff.count()));
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,213 @@
+#ifndef SQLCIRCUITBREAKER_H
+#define SQLCIRCUITBREAKER_H
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <boost/thread.hpp>
+#include "../../../Common/CommonHdr.h"
+#include "../../../Log/Log4cplusCustomInc.h"
+#include "../../../Concurrent/SpinLock.h"
+#include "../../../Concurrent/WaitEvent.h"
+
+#if defined(_MSC_VER)
+    #pragma warning(push)
+    #pragma warning(disable : 4251)
+#endif
+
+/**
+ * Values that represent the states of a SqlCircuitBreaker.
+ */
+enum class SqlCircuitState :int
+{
+    Closed, /**< The database is reachable,connections are opened normally. */
+    Open,   /**< The database is down,connections fail fast until the next probe. */
+    HalfOpen    /**< The reconnect probe is running,connections still fail fast. */
+};
+
+/**
+ * Settings of a SqlCircuitBreaker.
+ */
+struct SqlCircuitBreakerSettings
+{
+    us32 m_failureThreshold;    /**< Number of consecutive connection failures which opens the breaker. */
+
+    std::chrono::milliseconds m_initialBackoff; /**< Delay of the first probe after the breaker is opened. */
+
+    std::chrono::milliseconds m_maxBackoff; /**< Max delay between the probes,the delay is doubled after each failed probe. */
+};
+
+/**
+ * Statistics of a SqlCircuitBreaker.
+ */
+struct SqlCircuitBreakerStats
+{
+    SqlCircuitState m_state;    /**< Current state. */
+
+    us32 m_failureCount;    /**< Current number of consecutive failures. */
+
+    us64 m_tripCount;   /**< Number of times the breaker was opened. */
+
+    us64 m_rejectedCount;   /**< Number of connection attempts which failed fast. */
+
+    us64 m_probeCount;  /**< Number of reconnect probes. */
+
+    std::chrono::milliseconds m_backoff;    /**< Current delay between the probes. */
+};
+
+/**
+ * Circuit breaker of a database shared by the connections with the same connection string.Connections report their connection
+ * failures and network errors by OnFailure,after m_failureThreshold consecutive failures the breaker opens and AllowRequest returns
+ * false,so the callers fail fast instead of waiting for the login timeout.While open a single background thread probes the database
+ * with exponential backoff(half-open while the probe is running),the breaker closes when a probe succeeds.
+ */
+class UTILS_EXPORTS_API SqlCircuitBreaker
+{
+public:
+    /**
+     * Defines an alias representing the probe,returns true if the database is reachable.
+     */
+    using probe_t = std::function<bool()>;
+
+    /**
+     * Constructor.
+     *
+     * @param probe The reconnect probe.
+     * @param settings The settings.
+     */
+    SqlCircuitBreaker(probe_t probe, const SqlCircuitBreakerSettings &settings);
+
+    SqlCircuitBreaker(const SqlCircuitBreaker&) = delete;
+
+    SqlCircuitBreaker& operator=(const SqlCircuitBreaker&) = delete;
+
+    /**
+     * Destructor,stops the probe.
+     */
+    ~SqlCircuitBreaker();
+
+    /**
+     * Gets the breaker of a connection string,the breaker is created with the default settings if not exists.
+     *
+     * @param connStr The connection string.
+     * @param probe The reconnect probe(used only when the breaker is created).
+     *
+     * @return The breaker.
+     */
+    static std::shared_ptr<SqlCircuitBreaker> Get(const std::string &connStr, const probe_t &probe);
+
+    /**
+     * Sets the settings of the breakers created later.
+     *
+     * @param settings The settings.
+     */
+    static void SetDefaultSettings(const SqlCircuitBreakerSettings &settings);
+
+    /**
+     * Gets the settings of the breakers created later.
+     *
+     * @return The settings.
+     */
+    static SqlCircuitBreakerSettings DefaultSettings();
+
+    /**
+     * Stops and removes all breakers.
+     */
+    static void DestoryAll();
+
+    /**
+     * Checks whether a connection may be opened,lock free when the breaker is closed.
+     *
+     * @return False if the breaker is open or half-open.
+     */
+    bool AllowRequest()
+    {
+        if (m_state.load(std::memory_order_acquire) == SqlCircuitState::Closed)
+        {
+            return true;
+        }
+        m_rejectedCount.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    /**
+     * Reports a successful connection,resets the consecutive failures.
+     */
+    void OnSuccess();
+
+    /**
+     * Reports a connection failure or network error,opens the breaker when the failures reach the threshold.
+     */
+    void OnFailure();
+
+    /**
+     * Gets the state.
+     *
+     * @return The state.
+     */
+    SqlCircuitState State() const
+    {
+        return m_state.load(std::memory_order_acquire);
+    }
+
+    /**
+     * Gets the statistics.
+     *
+     * @return The statistics.
+     */
+    SqlCircuitBreakerStats GetStats();
+
+    /**
+     * Stops the probe thread.
+     */
+    void Stop();
+
+private:
+    probe_t m_probe;    /**< The reconnect probe. */
+
+    SqlCircuitBreakerSettings m_settings;   /**< The settings. */
+
+    std::atomic<SqlCircuitState> m_state;   /**< Current state(written with m_lock held). */
+
+    std::atomic<us32> m_failureCount;   /**< Consecutive failures(written with m_lock held). */
+
+    std::atomic<us64> m_rejectedCount;  /**< Number of connection attempts which failed fast. */
+
+    SpinLock<> m_lock;  /**< Lock of the following members. */
+
+    us64 m_tripCount;   /**< Number of times the breaker was opened. */
+
+    us64 m_probeCount;  /**< Number of probes. */
+
+    std::chrono::milliseconds m_backoff;    /**< Current delay between the probes. */
+
+    std::chrono::steady_clock::time_point m_nextProbe;  /**< Time of the next probe. */
+
+    std::atomic<bool> m_stopped;    /**< True if stopped. */
+
+    WaitEvent m_probeWakeup;    /**< Wakes the probe thread when the breaker is opened or stopped. */
+
+    boost::thread m_probeThread;    /**< The probe thread,started when the breaker is opened the first time. */
+
+    static SpinLock<> breakersLock; /**< Lock of breakers and defaultSettings. */
+
+    static std::unordered_map<std::string, std::shared_ptr<SqlCircuitBreaker>> breakers;    /**< Breakers keyed by the connection string. */
+
+    static SqlCircuitBreakerSettings defaultSettings;   /**< Settings of the breakers created later. */
+
+    static log4cplus::Logger log;   /**< The logger. */
+
+    /**
+     * Probe thread entry,probes the database while the breaker is not closed.
+     */
+    void ProbeEntry();
+};
+
+#if defined(_MSC_VER)
+    #pragma warning(pop)
+#endif
+
+#endif /* SQLCIRCUITBREAKER_H */
@@ -0,0 +1,88 @@
+#if defined(USE_ODBC_DATABASE_UTILS) || defined(USE_OCI_DATABASE_UTILS)
+
+#include <algorithm>
+#include "SqlColumnBatch.h"
+
+SqlColumnBatch::SqlColumnBatch(const std::vector<SqlColumnType> &types, size_t capacity, size_t arenaChunkSize) :m_columns(types.size())
+    , m_capacity(capacity), m_rowCount(0), m_arenaChunkSize(arenaChunkSize), m_arenaChunks(), m_ownArenaChunks(), m_arena(nullptr)
+{
+    for (size_t i = 0; i < types.size(); ++i)
+    {
+        Column &column = m_columns[i];
+        column.m_type = types[i];
+        column.m_nulls.resize((capacity + 7) / 8);
+        switch (column.m_type)
+        {
+        case SqlColumnType::Int32:
+            column.m_int32s.resize(capacity);
+            break;
+        case SqlColumnType::Int64:
+            column.m_int64s.resize(capacity);
+            break;
+        case SqlColumnType::Double:
+            column.m_doubles.resize(capacity);
+            break;
+        case SqlColumnType::String:
+            column.m_strings.resize(capacity, "");
+            column.m_stringLengths.resize(capacity);
+            break;
+        case SqlColumnType::DateTime:
+            column.m_dateTimes.resize(capacity);
+            break;
+        }
+    }
+}
+
+void SqlColumnBatch::Clear()
+{
+    m_rowCount = 0;
+    if (!m_arenaChunks.empty())
+    {
+        m_arenaChunks.erase(m_arenaChunks.begin() + 1, m_arenaChunks.end());
+        m_ownArenaChunks.clear();
+        m_arena = m_arenaChunks.front().get();
+    }
+    else if (!m_ownArenaChunks.empty())
+    {
+        m_ownArenaChunks.erase(m_ownArenaChunks.begin() + 1, m_ownArenaChunks.end());
+        m_arena = m_ownArenaChunks.front().get();
+    }
+    if (m_arena)
+    {
+        m_arena->clear();
+    }
+}
+
+void SqlColumnBatch::SetString(size_t column, size_t row, const char *data, size_t size)
+{
+    char *dst = ArenaAlloc(size + 1);
+    std::copy(data, data + size, dst);
+    dst[size] = '\0';
+    m_columns[column].m_strings[row] = dst;
+    m_columns[column].m_stringLengths[row] = static_cast<us32>(size);
+}
+
+char* SqlColumnBatch::ArenaAlloc(size_t size)
+{
+    if (!m_arena || m_arena->capacity() - m_arena->size() < size)
+    {
+        size_t chunkSize = (std::max)(size, m_arenaChunkSize);
+        LinearBufferCache::ptr_t chunk = LinearBufferCache::Instance().Get(chunkSize);
+        if (chunk)
+        {
+            m_arena = chunk.get();
+            m_arenaChunks.push_back(std::move(chunk));
+        }
+        else
+        {
+            m_ownArenaChunks.emplace_back(new LinearBuffer(chunkSize));
+            m_arena = m_ownArenaChunks.back().get();
+        }
+    }
+    //the chunks never grow,so the returned memory stays valid until Clear.
+    char *ret = reinterpret_cast<char*>(m_arena->data() + m_arena->size());
+    m_arena->resize(m_arena->size() + size);
+    return ret;
+}
+
+#endif
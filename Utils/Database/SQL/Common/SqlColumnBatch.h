@@ -0,0 +1,217 @@
+#ifndef SQLCOLUMNBATCH_H
+#define SQLCOLUMNBATCH_H
+
+#include <memory>
+#include <vector>
+#include "../../../Buffer/LinearBufferCache.h"
+#include "OTLHdr.h"
+
+#if defined(_MSC_VER)
+    #pragma warning(push)
+    #pragma warning(disable : 4251)
+#endif
+
+/**
+ * Values that represent the column types of a SqlColumnBatch.
+ */
+enum class SqlColumnType :int
+{
+    Int32,  /**< s32. */
+    Int64,  /**< s64. */
+    Double, /**< double. */
+    String, /**< NUL terminated string stored in the string arena. */
+    DateTime    /**< otl_datetime. */
+};
+
+/**
+ * Columnar batch of rows used by the bulk fetch(ISqlDatabase::FetchColumns) and bulk insert paths.Each column owns a typed array and
+ * a null bitmap sized to the capacity,strings are copied to an arena made of LinearBufferCache chunks,so a reused batch does not
+ * allocate per row.
+ */
+class UTILS_EXPORTS_API SqlColumnBatch
+{
+public:
+    /**
+     * Constructor.
+     *
+     * @param types The column types.
+     * @param capacity Max number of rows.
+     * @param arenaChunkSize (Optional) Size of the string arena chunks taken from LinearBufferCache.
+     */
+    SqlColumnBatch(const std::vector<SqlColumnType> &types, size_t capacity, size_t arenaChunkSize = 64 * 1024);
+
+    SqlColumnBatch(const SqlColumnBatch&) = delete;
+
+    SqlColumnBatch& operator=(const SqlColumnBatch&) = delete;
+
+    size_t ColumnCount() const
+    {
+        return m_columns.size();
+    }
+
+    SqlColumnType Type(size_t column) const
+    {
+        return m_columns[column].m_type;
+    }
+
+    size_t Capacity() const
+    {
+        return m_capacity;
+    }
+
+    size_t RowCount() const
+    {
+        return m_rowCount;
+    }
+
+    bool Full() const
+    {
+        return m_rowCount == m_capacity;
+    }
+
+    /**
+     * Sets the number of valid rows(the values of the rows must be set by the caller).
+     *
+     * @param rowCount Number of rows(not greater than the capacity).
+     */
+    void SetRowCount(size_t rowCount)
+    {
+        m_rowCount = rowCount;
+    }
+
+    /**
+     * Removes all rows and releases the string arena except its first chunk.
+     */
+    void Clear();
+
+    s32* Int32s(size_t column)
+    {
+        return m_columns[column].m_int32s.data();
+    }
+
+    const s32* Int32s(size_t column) const
+    {
+        return m_columns[column].m_int32s.data();
+    }
+
+    s64* Int64s(size_t column)
+    {
+        return m_columns[column].m_int64s.data();
+    }
+
+    const s64* Int64s(size_t column) const
+    {
+        return m_columns[column].m_int64s.data();
+    }
+
+    double* Doubles(size_t column)
+    {
+        return m_columns[column].m_doubles.data();
+    }
+
+    const double* Doubles(size_t column) const
+    {
+        return m_columns[column].m_doubles.data();
+    }
+
+    otl_datetime* DateTimes(size_t column)
+    {
+        return m_columns[column].m_dateTimes.data();
+    }
+
+    const otl_datetime* DateTimes(size_t column) const
+    {
+        return m_columns[column].m_dateTimes.data();
+    }
+
+    /**
+     * Gets a string value.
+     *
+     * @param column The column index.
+     * @param row The row index.
+     *
+     * @return NUL terminated string(empty if null).
+     */
+    const char* String(size_t column, size_t row) const
+    {
+        return m_columns[column].m_strings[row];
+    }
+
+    size_t StringLength(size_t column, size_t row) const
+    {
+        return m_columns[column].m_stringLengths[row];
+    }
+
+    /**
+     * Copies a string value to the arena.
+     *
+     * @param column The column index.
+     * @param row The row index.
+     * @param data The string.
+     * @param size The string length.
+     */
+    void SetString(size_t column, size_t row, const char *data, size_t size);
+
+    bool IsNull(size_t column, size_t row) const
+    {
+        return (m_columns[column].m_nulls[row >> 3] & (1 << (row & 7))) != 0;
+    }
+
+    void SetNull(size_t column, size_t row, bool null)
+    {
+        us8 &bits = m_columns[column].m_nulls[row >> 3];
+        bits = null ? static_cast<us8>(bits | (1 << (row & 7))) : static_cast<us8>(bits & ~(1 << (row & 7)));
+    }
+
+private:
+    /**
+     * A column,only the array of its type is allocated.
+     */
+    struct Column
+    {
+        SqlColumnType m_type;   /**< The type. */
+
+        std::vector<s32> m_int32s;  /**< Int32 values. */
+
+        std::vector<s64> m_int64s;  /**< Int64 values. */
+
+        std::vector<double> m_doubles;  /**< Double values. */
+
+        std::vector<otl_datetime> m_dateTimes;  /**< DateTime values. */
+
+        std::vector<const char*> m_strings; /**< String values(point to the arena). */
+
+        std::vector<us32> m_stringLengths;  /**< String lengths. */
+
+        std::vector<us8> m_nulls;   /**< Null bitmap(bit set means null). */
+    };
+
+    std::vector<Column> m_columns;  /**< The columns. */
+
+    size_t m_capacity;  /**< Max number of rows. */
+
+    size_t m_rowCount;  /**< Number of valid rows. */
+
+    size_t m_arenaChunkSize;    /**< Size of the arena chunks. */
+
+    std::vector<LinearBufferCache::ptr_t> m_arenaChunks;    /**< Arena chunks taken from LinearBufferCache,the last one is current. */
+
+    std::vector<std::unique_ptr<LinearBuffer>> m_ownArenaChunks;    /**< Arena chunks used when LinearBufferCache has no buffer of the size. */
+
+    LinearBuffer *m_arena;  /**< Current arena chunk. */
+
+    /**
+     * Allocates memory from the arena.
+     *
+     * @param size The size.
+     *
+     * @return The memory.
+     */
+    char* ArenaAlloc(size_t size);
+};
+
+#if defined(_MSC_VER)
+    #pragma warning(pop)
+#endif
+
+#endif /* SQLCOLUMNBATCH_H */
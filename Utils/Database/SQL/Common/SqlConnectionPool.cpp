@@ -0,0 +1,441 @@
+#if defined(USE_ODBC_DATABASE_UTILS) || defined(USE_OCI_DATABASE_UTILS)
+
+#include <vector>
+#include "SqlConnectionPool.h"
+#include "SqlDatabasePool.h"
+
+SpinLock<> SqlConnectionPool::poolsLock;
+
+std::unordered_map<std::string, std::shared_ptr<SqlConnectionPool>> SqlConnectionPool::pools;
+
+log4cplus::Logger SqlConnectionPool::log = log4cplus::Logger::getInstance("SqlConnectionPool");
+
+void SqlConnectionPool::ConnectionDeleter::operator()(ISqlDatabase *db)
+{
+    if (m_pool)
+    {
+        m_pool->Return(db);
+    }
+    else
+    {
+        delete db;
+    }
+}
+
+SqlConnectionPool::SqlConnectionPool(const SqlConnectionPoolSettings &settings) :m_settings(settings), m_lock(), m_idle(), m_totalCount(0)
+    , m_waiterCount(0), m_stats(), m_stopped(false), m_warmedUp(false), m_available(), m_warmUpDone(), m_maintenanceWakeup(), m_maintenance()
+{
+    if (m_settings.m_maxSize < m_settings.m_minSize)
+    {
+        m_settings.m_maxSize = m_settings.m_minSize;
+    }
+    if (!m_settings.m_maxSize)
+    {
+        m_settings.m_maxSize = 1;
+    }
+    m_maintenance = boost::thread([this]() { MaintenanceEntry(); });
+}
+
+SqlConnectionPool::~SqlConnectionPool()
+{
+    Stop();
+}
+
+std::shared_ptr<SqlConnectionPool> SqlConnectionPool::Create(const SqlConnectionPoolSettings &settings)
+{
+    std::shared_ptr<SqlConnectionPool> ret(new SqlConnectionPool(settings));
+    {
+        SpinLock<>::ScopeLock lock(poolsLock);
+        if (pools.emplace(settings.m_name, ret).second)
+        {
+            return ret;
+        }
+    }
+    LOG4CPLUS_ERROR_FMT(log, "连接池已存在，名称：%s", settings.m_name.c_str());
+    ret->Stop();
+    return std::shared_ptr<SqlConnectionPool>();
+}
+
+std::shared_ptr<SqlConnectionPool> SqlConnectionPool::Find(const std::string &name)
+{
+    SpinLock<>::ScopeLock lock(poolsLock);
+    auto target = pools.find(name);
+    return target == pools.end() ? std::shared_ptr<SqlConnectionPool>() : target->second;
+}
+
+void SqlConnectionPool::Destory(const std::string &name)
+{
+    std::shared_ptr<SqlConnectionPool> pool;
+    {
+        SpinLock<>::ScopeLock lock(poolsLock);
+        auto target = pools.find(name);
+        if (target == pools.end())
+        {
+            return;
+        }
+        pool = std::move(target->second);
+        pools.erase(target);
+    }
+    pool->Stop();
+}
+
+void SqlConnectionPool::DestoryAll()
+{
+    std::unordered_map<std::string, std::shared_ptr<SqlConnectionPool>> temp;
+    {
+        SpinLock<>::ScopeLock lock(poolsLock);
+        temp.swap(pools);
+    }
+    for (auto &pool : temp)
+    {
+        pool.second->Stop();
+    }
+}
+
+SqlConnectionPool::ptr_t SqlConnectionPool::Borrow(std::chrono::milliseconds timeout)
+{
+    auto deadline = std::chrono::steady_clock::now() + timeout;
+    bool waiting = false;
+    for (;;)
+    {
+        ISqlDatabase *db = nullptr;
+        std::chrono::steady_clock::time_point validatedTime;
+        bool open = false;
+        bool wakeNext = false;
+        {
+            SpinLock<>::ScopeLock lock(m_lock);
+            if (waiting)
+            {
+                --m_waiterCount;
+                waiting = false;
+            }
+            if (m_stopped.load(std::memory_order_acquire))
+            {
+                wakeNext = m_waiterCount != 0;
+            }
+            else if (!m_idle.empty())
+            {
+                db = m_idle.back().m_db;
+                validatedTime = m_idle.back().m_validatedTime;
+                m_idle.pop_back();
+                //the event keeps one signal only,so pass it on if more connections are idle.
+                wakeNext = !m_idle.empty() && m_waiterCount;
+            }
+            else if (m_totalCount < m_settings.m_maxSize)
+            {
+                ++m_totalCount;
+                open = true;
+            }
+            else if (std::chrono::steady_clock::now() < deadline)
+            {
+                ++m_waiterCount;
+                waiting = true;
+            }
+            else
+            {
+                ++m_stats.m_timeoutCount;
+            }
+        }
+        if (wakeNext)
+        {
+            m_available.Signal();
+        }
+        if (db)
+        {
+            if (m_settings.m_validateOnBorrow && std::chrono::steady_clock::now() - validatedTime >= m_settings.m_validationInterval
+                && !Validate(db))
+            {
+                Close(db);
+                continue;
+            }
+        }
+        else if (open)
+        {
+            db = Open();
+        }
+        else if (waiting)
+        {
+            auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now());
+            m_available.TimedWait(remaining.count() > 0 ? static_cast<us32>(remaining.count()) + 1 : 1);
+            continue;
+        }
+        if (!db)
+        {
+            return ptr_t();
+        }
+        {
+            SpinLock<>::ScopeLock lock(m_lock);
+            ++m_stats.m_borrowCount;
+        }
+        return ptr_t(db, ConnectionDeleter(shared_from_this()));
+    }
+}
+
+bool SqlConnectionPool::WaitWarmUp(us32 milliSeconds)
+{
+    //pass the signal on to the other waiting threads.
+    if (!m_warmedUp.load(std::memory_order_acquire) && m_warmUpDone.TimedWait(milliSeconds))
+    {
+        m_warmUpDone.Signal();
+    }
+    return m_warmedUp.load(std::memory_order_acquire);
+}
+
+void SqlConnectionPool::Stop()
+{
+    m_stopped.store(true, std::memory_order_release);
+    m_maintenanceWakeup.Signal();
+    if (m_maintenance.joinable() && m_maintenance.get_id() != boost::this_thread::get_id())
+    {
+        m_maintenance.join();
+    }
+    std::deque<IdleConnection> idle;
+    {
+        SpinLock<>::ScopeLock lock(m_lock);
+        idle.swap(m_idle);
+    }
+    for (auto &conn : idle)
+    {
+        Close(conn.m_db);
+    }
+    m_available.Signal();
+}
+
+SqlConnectionPoolStats SqlConnectionPool::GetStats()
+{
+    SpinLock<>::ScopeLock lock(m_lock);
+    SqlConnectionPoolStats ret = m_stats;
+    ret.m_totalCount = m_totalCount;
+    ret.m_idleCount = m_idle.size();
+    ret.m_waiterCount = m_waiterCount;
+    return ret;
+}
+
+void SqlConnectionPool::MaintenanceEntry()
+{
+    for (;;)
+    {
+        {
+            SpinLock<>::ScopeLock lock(m_lock);
+            if (m_stopped.load(std::memory_order_acquire) || m_totalCount >= m_settings.m_minSize)
+            {
+                break;
+            }
+            ++m_totalCount;
+        }
+        ISqlDatabase *db = Open();
+        if (!db)
+        {
+            break;
+        }
+        auto now = std::chrono::steady_clock::now();
+        PutIdle(db, now, now);
+    }
+    LOG4CPLUS_INFO_FMT(log, "连接池预热完成，名称：%s，连接数：%zu", m_settings.m_name.c_str(), GetStats().m_totalCount);
+    m_warmedUp.store(true, std::memory_order_release);
+    m_warmUpDone.Signal();
+
+    while (!m_stopped.load(std::memory_order_acquire))
+    {
+        m_maintenanceWakeup.TimedWait(static_cast<us32>(m_settings.m_maintenanceInterval.count()));
+        if (m_stopped.load(std::memory_order_acquire))
+        {
+            break;
+        }
+        try
+        {
+            Maintain();
+        }
+        catch (const std::exception &ex)
+        {
+            LOG4CPLUS_ERROR_FMT(log, "连接池维护捕获异常，名称：%s，异常：%s", m_settings.m_name.c_str(), ex.what());
+        }
+    }
+}
+
+void SqlConnectionPool::Maintain()
+{
+    auto now = std::chrono::steady_clock::now();
+    std::vector<ISqlDatabase*> evicted;
+    std::vector<IdleConnection> toValidate;
+    {
+        SpinLock<>::ScopeLock lock(m_lock);
+        for (auto it = m_idle.begin(); it != m_idle.end();)
+        {
+            if (m_settings.m_idleTimeout.count() && m_totalCount - evicted.size() > m_settings.m_minSize
+                && now - it->m_idleSince >= m_settings.m_idleTimeout)
+            {
+                evicted.push_back(it->m_db);
+                it = m_idle.erase(it);
+            }
+            else if (!m_settings.m_validationSql.empty() && now - it->m_validatedTime >= m_settings.m_validationInterval)
+            {
+                toValidate.push_back(*it);
+                it = m_idle.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+    }
+    for (auto db : evicted)
+    {
+        Close(db);
+    }
+    if (!evicted.empty())
+    {
+        LOG4CPLUS_DEBUG_FMT(log, "连接池关闭空闲连接，名称：%s，个数：%zu", m_settings.m_name.c_str(), evicted.size());
+    }
+    for (auto &conn : toValidate)
+    {
+        if (Validate(conn.m_db))
+        {
+            PutIdle(conn.m_db, conn.m_idleSince, std::chrono::steady_clock::now());
+        }
+        else
+        {
+            Close(conn.m_db);
+        }
+    }
+
+    //refill the invalid or closed connections.
+    for (;;)
+    {
+        {
+            SpinLock<>::ScopeLock lock(m_lock);
+            if (m_stopped.load(std::memory_order_acquire) || m_totalCount >= m_settings.m_minSize)
+            {
+                break;
+            }
+            ++m_totalCount;
+        }
+        ISqlDatabase *db = Open();
+        if (!db)
+        {
+            break;
+        }
+        now = std::chrono::steady_clock::now();
+        PutIdle(db, now, now);
+    }
+}
+
+ISqlDatabase* SqlConnectionPool::Open()
+{
+    ISqlDatabase *db = nullptr;
+    try
+    {
+        db = SqlDatabaseFactory::Create(m_settings.m_dbType, m_settings.m_connStr.c_str());
+    }
+    catch (const std::exception &ex)
+    {
+        LOG4CPLUS_ERROR_FMT(log, "连接池创建连接捕获异常，名称：%s，异常：%s", m_settings.m_name.c_str(), ex.what());
+    }
+    if (db && !Validate(db))
+    {
+        delete db;
+        db = nullptr;
+    }
+    bool wake;
+    {
+        SpinLock<>::ScopeLock lock(m_lock);
+        if (db)
+        {
+            ++m_stats.m_createdCount;
+        }
+        else
+        {
+            --m_totalCount;
+        }
+        wake = !db && m_waiterCount;
+    }
+    if (wake)
+    {
+        m_available.Signal();
+    }
+    if (!db)
+    {
+        LOG4CPLUS_ERROR_FMT(log, "连接池创建连接失败，名称：%s", m_settings.m_name.c_str());
+    }
+    return db;
+}
+
+void SqlConnectionPool::Close(ISqlDatabase *db)
+{
+    delete db;
+    bool wake;
+    {
+        SpinLock<>::ScopeLock lock(m_lock);
+        --m_totalCount;
+        ++m_stats.m_closedCount;
+        wake = m_waiterCount != 0;
+    }
+    if (wake)
+    {
+        m_available.Signal();
+    }
+}
+
+bool SqlConnectionPool::Validate(ISqlDatabase *db)
+{
+    if (m_settings.m_validationSql.empty())
+    {
+        return true;
+    }
+    bool ret = db->Prepare(m_settings.m_validationSql.c_str(), 1) && db->FlushBuffer();
+    if (!ret)
+    {
+        LOG4CPLUS_WARN_FMT(log, "连接池验证连接失败，名称：%s，错误信息：%s", m_settings.m_name.c_str(), db->LastError().c_str());
+        SpinLock<>::ScopeLock lock(m_lock);
+        ++m_stats.m_validationFailedCount;
+    }
+    db->Rollback();
+    return ret;
+}
+
+void SqlConnectionPool::PutIdle(ISqlDatabase *db, std::chrono::steady_clock::time_point idleSince, std::chrono::steady_clock::time_point validatedTime)
+{
+    bool wake;
+    {
+        SpinLock<>::ScopeLock lock(m_lock);
+        //Stop sets m_stopped before it takes the idle list under m_lock,so a connection put after that is closed here.
+        if (!m_stopped.load(std::memory_order_acquire))
+        {
+            m_idle.push_back({ db, idleSince, validatedTime });
+            db = nullptr;
+        }
+        wake = m_waiterCount != 0;
+    }
+    if (db)
+    {
+        Close(db);
+    }
+    else if (wake)
+    {
+        m_available.Signal();
+    }
+}
+
+void SqlConnectionPool::Return(ISqlDatabase *db)
+{
+    if (!db)
+    {
+        return;
+    }
+    if (m_stopped.load(std::memory_order_acquire))
+    {
+        Close(db);
+    }
+    else if (!db->Rollback())
+    {
+        LOG4CPLUS_WARN_FMT(log, "连接池回滚归还的连接失败，名称：%s，错误信息：%s", m_settings.m_name.c_str(), db->LastError().c_str());
+        Close(db);
+    }
+    else
+    {
+        auto now = std::chrono::steady_clock::now();
+        PutIdle(db, now, now);
+    }
+}
+
+#endif
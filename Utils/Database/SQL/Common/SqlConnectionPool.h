@@ -0,0 +1,300 @@
+#ifndef SQLCONNECTIONPOOL_H
+#define SQLCONNECTIONPOOL_H
+
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <boost/thread.hpp>
+#include "../../../Log/Log4cplusCustomInc.h"
+#include "../../../Concurrent/SpinLock.h"
+#include "../../../Concurrent/WaitEvent.h"
+#include "SqlDatabaseType.h"
+#include "ISqlDatabase.h"
+
+#if defined(_MSC_VER)
+    #pragma warning(push)
+    #pragma warning(disable : 4251)
+#endif
+
+/**
+ * Settings of a SqlConnectionPool.
+ */
+struct SqlConnectionPoolSettings
+{
+    std::string m_name; /**< Name of the pool. */
+
+    SqlDatabaseType m_dbType;   /**< Type of the connections. */
+
+    std::string m_connStr;  /**< Connection string. */
+
+    size_t m_minSize;   /**< Number of connections opened by the warm-up and kept when idle. */
+
+    size_t m_maxSize;   /**< Max number of connections(idle and borrowed). */
+
+    std::string m_validationSql;    /**< Statement used to validate a connection(such as "select 1"),empty means no validation. */
+
+    bool m_validateOnBorrow;    /**< True to validate a connection which has been idle longer than m_validationInterval when it is borrowed. */
+
+    std::chrono::milliseconds m_validationInterval; /**< Idle connections are validated by the maintenance after this interval. */
+
+    std::chrono::milliseconds m_idleTimeout;    /**< Connections above m_minSize are closed after being idle for this time,0 means never. */
+
+    std::chrono::milliseconds m_borrowTimeout;  /**< Default time Borrow waits for a connection when the pool is exhausted. */
+
+    std::chrono::milliseconds m_maintenanceInterval;    /**< Interval of the maintenance(eviction,validation and refill). */
+};
+
+/**
+ * Statistics of a SqlConnectionPool.
+ */
+struct SqlConnectionPoolStats
+{
+    size_t m_totalCount;    /**< Number of connections(idle,borrowed and opening). */
+
+    size_t m_idleCount; /**< Number of idle connections. */
+
+    size_t m_waiterCount;   /**< Number of threads waiting for a connection. */
+
+    us64 m_borrowCount; /**< Number of successful borrows. */
+
+    us64 m_timeoutCount;    /**< Number of borrows which timed out. */
+
+    us64 m_createdCount;    /**< Number of opened connections. */
+
+    us64 m_closedCount; /**< Number of closed connections(evicted,invalid or rolled back with error). */
+
+    us64 m_validationFailedCount;   /**< Number of failed validations. */
+};
+
+/**
+ * Health checked connection pool.The pool opens m_minSize connections on a maintenance thread when it is created and grows on demand
+ * up to m_maxSize,a connection is opened by the borrowing thread outside the lock.When the pool is exhausted Borrow waits until a
+ * connection is returned or the timeout elapses.Returned connections are rolled back(closed if the rollback fails),idle connections
+ * are validated and the ones above m_minSize are closed after m_idleTimeout.
+ *
+ * Pools are registered by name,so components with different connection strings can share the process.
+ */
+class UTILS_EXPORTS_API SqlConnectionPool :public std::enable_shared_from_this<SqlConnectionPool>
+{
+public:
+
+    /**
+     * Deleter of ptr_t which returns the connection to its pool.
+     */
+    class UTILS_EXPORTS_API ConnectionDeleter
+    {
+    public:
+        ConnectionDeleter() = default;
+
+        explicit ConnectionDeleter(std::shared_ptr<SqlConnectionPool> pool) :m_pool(std::move(pool))
+        {
+        }
+
+        void operator()(ISqlDatabase *db);
+
+    private:
+        std::shared_ptr<SqlConnectionPool> m_pool;  /**< The pool(keeps the pool alive while the connection is borrowed). */
+    };
+
+    /**
+     * Defines an alias representing the borrowed connection.
+     */
+    using ptr_t = std::unique_ptr<ISqlDatabase, ConnectionDeleter>;
+
+    SqlConnectionPool(const SqlConnectionPool&) = delete;
+
+    SqlConnectionPool& operator=(const SqlConnectionPool&) = delete;
+
+    /**
+     * Destructor,closes the idle connections.
+     */
+    ~SqlConnectionPool();
+
+    /**
+     * Creates a pool and registers it by m_name,the warm-up is started on the maintenance thread.
+     *
+     * @param settings The settings.
+     *
+     * @return The pool,null if a pool with the same name exists.
+     */
+    static std::shared_ptr<SqlConnectionPool> Create(const SqlConnectionPoolSettings &settings);
+
+    /**
+     * Finds a registered pool.
+     *
+     * @param name The name.
+     *
+     * @return The pool,null if not found.
+     */
+    static std::shared_ptr<SqlConnectionPool> Find(const std::string &name);
+
+    /**
+     * Stops and unregisters a pool.Borrowed connections are closed when they are returned.
+     *
+     * @param name The name.
+     */
+    static void Destory(const std::string &name);
+
+    /**
+     * Stops and unregisters all pools.
+     */
+    static void DestoryAll();
+
+    /**
+     * Borrows a connection,waits m_borrowTimeout at most if the pool is exhausted.
+     *
+     * @return The connection,null if timed out,stopped or failed to open a connection.
+     */
+    ptr_t Borrow()
+    {
+        return Borrow(m_settings.m_borrowTimeout);
+    }
+
+    /**
+     * Borrows a connection.
+     *
+     * @param timeout Max time to wait if the pool is exhausted.
+     *
+     * @return The connection,null if timed out,stopped or failed to open a connection.
+     */
+    ptr_t Borrow(std::chrono::milliseconds timeout);
+
+    /**
+     * Waits until the warm-up is finished.
+     *
+     * @param milliSeconds The timeout.
+     *
+     * @return False if timed out.
+     */
+    bool WaitWarmUp(us32 milliSeconds);
+
+    /**
+     * Stops the maintenance and closes the idle connections,the waiting borrowers get null.
+     */
+    void Stop();
+
+    /**
+     * Gets the settings.
+     *
+     * @return The settings.
+     */
+    const SqlConnectionPoolSettings& Settings() const
+    {
+        return m_settings;
+    }
+
+    /**
+     * Gets the statistics.
+     *
+     * @return The statistics.
+     */
+    SqlConnectionPoolStats GetStats();
+
+private:
+    /**
+     * An idle connection.
+     */
+    struct IdleConnection
+    {
+        ISqlDatabase *m_db; /**< The connection. */
+
+        std::chrono::steady_clock::time_point m_idleSince;  /**< Time when the connection was returned. */
+
+        std::chrono::steady_clock::time_point m_validatedTime;  /**< Time when the connection was validated or used. */
+    };
+
+    SqlConnectionPoolSettings m_settings;   /**< The settings. */
+
+    SpinLock<> m_lock;  /**< Lock of the following members. */
+
+    std::deque<IdleConnection> m_idle;  /**< Idle connections,the most recently returned one is at the back. */
+
+    size_t m_totalCount;    /**< Number of connections(idle,borrowed and opening). */
+
+    size_t m_waiterCount;   /**< Number of waiting borrowers. */
+
+    SqlConnectionPoolStats m_stats; /**< The statistics counters. */
+
+    std::atomic<bool> m_stopped;    /**< True if stopped. */
+
+    std::atomic<bool> m_warmedUp;   /**< True if the warm-up is finished. */
+
+    WaitEvent m_available;  /**< Wakes a waiting borrower when a connection is returned or a slot is freed. */
+
+    WaitEvent m_warmUpDone; /**< Signaled when the warm-up is finished. */
+
+    WaitEvent m_maintenanceWakeup;  /**< Wakes the maintenance thread when stopped. */
+
+    boost::thread m_maintenance;    /**< The maintenance thread. */
+
+    static SpinLock<> poolsLock;    /**< Lock of pools. */
+
+    static std::unordered_map<std::string, std::shared_ptr<SqlConnectionPool>> pools;   /**< Registered pools. */
+
+    static log4cplus::Logger log;   /**< The logger. */
+
+    /**
+     * Constructor.
+     *
+     * @param settings The settings.
+     */
+    explicit SqlConnectionPool(const SqlConnectionPoolSettings &settings);
+
+    /**
+     * Maintenance thread entry,does the warm-up and then the periodical maintenance.
+     */
+    void MaintenanceEntry();
+
+    /**
+     * Closes the idle connections which timed out,validates the idle connections and opens connections up to m_minSize.
+     */
+    void Maintain();
+
+    /**
+     * Opens a connection(the slot must be reserved in m_totalCount).
+     *
+     * @return The connection,null if failed(the slot is released).
+     */
+    ISqlDatabase* Open();
+
+    /**
+     * Closes a connection and releases its slot.
+     *
+     * @param db The connection.
+     */
+    void Close(ISqlDatabase *db);
+
+    /**
+     * Validates a connection by m_validationSql.
+     *
+     * @param db The connection.
+     *
+     * @return True if valid.
+     */
+    bool Validate(ISqlDatabase *db);
+
+    /**
+     * Puts a connection to the idle list and wakes a waiting borrower,or closes it if the pool is stopped.
+     *
+     * @param db The connection.
+     * @param idleSince Time when the connection became idle.
+     * @param validatedTime Time when the connection was validated or used.
+     */
+    void PutIdle(ISqlDatabase *db, std::chrono::steady_clock::time_point idleSince, std::chrono::steady_clock::time_point validatedTime);
+
+    /**
+     * Returns a borrowed connection.
+     *
+     * @param db The connection.
+     */
+    void Return(ISqlDatabase *db);
+};
+
+#if defined(_MSC_VER)
+    #pragma warning(pop)
+#endif
+
+#endif /* SQLCONNECTIONPOOL_H */
@@ -7,19 +7,26 @@
 
 const char SqlDatabasePoolLoggerName[] = "SqlDatabasePool";
 
+SqlDatabaseFactory SqlDatabaseFactory::Instance = { nullptr };
+
 ISqlDatabase* SqlDatabaseFactory::CreateObj(SqlDatabaseType type)
+{
+    return Create(type, SqlDatabaseFactory::Instance.m_connStr);
+}
+
+ISqlDatabase* SqlDatabaseFactory::Create(SqlDatabaseType type, const char *connStr)
 {
     ISqlDatabase *ret = 0;
     switch(type)
     {
     case SqlDatabaseType::ODBC:
 #if defined(USE_ODBC_DATABASE_UTILS)
-        ret = new ODBCSqlDatabase(SqlDatabaseFactory::Instance.m_connStr, true);
+        ret = new ODBCSqlDatabase(connStr, true);
 #endif
         break;
     case SqlDatabaseType::OCI:
 #if defined(USE_OCI_DATABASE_UTILS)
-        ret = new OCISqlDatabase(SqlDatabaseFactory::Instance.m_connStr, true);
+        ret = new OCISqlDatabase(connStr, true);
 #endif
         break;
     }
@@ -31,6 +38,32 @@ void SqlDatabaseFactory::FreeObj(ISqlDatabase *obj)
     delete obj;
 }
 
+template class UTILS_DEF_API ObjectPoolBase
+<
+    SqlDatabaseType
+    , ISqlDatabase
+    , SqlDatabaseElementTrait
+    , SqlDatabsePool
+    , SqlDatabaseFactory
+    , SqlDatabaseRollbackClearFunc
+    , SqlDatabasePoolLoggerName
+    , std::equal_to<SqlDatabaseType>
+    , std::equal_to<SqlDatabaseType>
+>;
+
+template class UTILS_DEF_API ObjectPoolElemDeleter
+<
+    SqlDatabaseType
+    , ISqlDatabase
+    , SqlDatabaseElementTrait
+    , SqlDatabsePool
+    , SqlDatabaseFactory
+    , SqlDatabaseRollbackClearFunc
+    , SqlDatabasePoolLoggerName
+    , std::equal_to<SqlDatabaseType>
+    , std::equal_to<SqlDatabaseType>
+>;
+
 class OtlInitialize
 {
 public:
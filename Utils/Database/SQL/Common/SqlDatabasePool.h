@@ -7,11 +7,18 @@
 
 extern const char SqlDatabasePoolLoggerName[];
 
-class SqlDatabaseDummyClearFunc
+/**
+ * Rolls back the uncommitted work of a connection returned to the pool.
+ */
+class SqlDatabaseRollbackClearFunc
 {
 public:
     inline void operator()(ISqlDatabase *obj)
     {
+        if (obj)
+        {
+            obj->Rollback();
+        }
     }
 };
 
@@ -27,13 +34,53 @@ public:
 class SqlDatabaseFactory
 {
 public:
+    /**
+     * Creates a connection.
+     *
+     * @param type The connection type.
+     * @param connStr The connection string.
+     *
+     * @return The connection(connected,check LastError if the connecting failed),null if the type is not enabled.
+     */
+    static ISqlDatabase* Create(SqlDatabaseType type, const char *connStr);
+
     ISqlDatabase* CreateObj(SqlDatabaseType type);
 
     void FreeObj(ISqlDatabase *obj);
 
     const char *m_connStr;
+
+    static SqlDatabaseFactory Instance; /**< Global factory settings(m_connStr is used by the connections created by the pool). */
 };
 
+class SqlDatabsePool;
+
+extern template class UTILS_DECL_API ObjectPoolBase
+<
+    SqlDatabaseType
+    , ISqlDatabase
+    , SqlDatabaseElementTrait
+    , SqlDatabsePool
+    , SqlDatabaseFactory
+    , SqlDatabaseRollbackClearFunc
+    , SqlDatabasePoolLoggerName
+    , std::equal_to<SqlDatabaseType>
+    , std::equal_to<SqlDatabaseType>
+>;
+
+extern template class UTILS_DECL_API ObjectPoolElemDeleter
+<
+    SqlDatabaseType
+    , ISqlDatabase
+    , SqlDatabaseElementTrait
+    , SqlDatabsePool
+    , SqlDatabaseFactory
+    , SqlDatabaseRollbackClearFunc
+    , SqlDatabasePoolLoggerName
+    , std::equal_to<SqlDatabaseType>
+    , std::equal_to<SqlDatabaseType>
+>;
+
 class UTILS_EXPORTS_API SqlDatabsePool :public ObjectPoolBase
     <
     SqlDatabaseType,
@@ -41,7 +88,7 @@ class UTILS_EXPORTS_API SqlDatabsePool :public ObjectPoolBase
     SqlDatabaseElementTrait,
     SqlDatabsePool,
     SqlDatabaseFactory, 
-    SqlDatabaseDummyClearFunc,
+    SqlDatabaseRollbackClearFunc,
     SqlDatabasePoolLoggerName,
     std::equal_to<SqlDatabaseType>,
     std::equal_to<SqlDatabaseType>
@@ -54,7 +101,7 @@ class UTILS_EXPORTS_API SqlDatabsePool :public ObjectPoolBase
         SqlDatabaseElementTrait,
         SqlDatabsePool,
         SqlDatabaseFactory, 
-        SqlDatabaseDummyClearFunc,
+        SqlDatabaseRollbackClearFunc,
         SqlDatabasePoolLoggerName,
         std::equal_to<SqlDatabaseType>,
         std::equal_to<SqlDatabaseType>
@@ -0,0 +1,191 @@
+#if defined(USE_ODBC_DATABASE_UTILS) || defined(USE_OCI_DATABASE_UTILS)
+
+#include "SqlExecutor.h"
+#include "../../../Concurrent/ThreadPool.h"
+
+log4cplus::Logger SqlExecutor::log = log4cplus::Logger::getInstance("SqlExecutor");
+
+/**
+ * The connection of the current worker thread.
+ */
+static thread_local SqlConnectionPool::ptr_t *WorkerDatabase = nullptr;
+
+SqlExecutor::SqlExecutor(const SqlExecutorSettings &settings) :m_settings(settings), m_pool(SqlConnectionPool::Find(settings.m_poolName)), m_context(), m_workGuard(boost::asio::make_work_guard(m_context))
+    , m_workers(), m_queueDepth(0), m_stopped(false), m_submitLock(), m_statsLock(), m_stats()
+{
+    if (!m_pool)
+    {
+        LOG4CPLUS_ERROR_FMT(log, "SQL执行器连接池不存在，名称：%s", settings.m_poolName.c_str());
+    }
+    m_workers.reserve(settings.m_workerCount);
+    for (unsigned int i = 0; i < settings.m_workerCount; ++i)
+    {
+        try
+        {
+            m_workers.emplace_back([this]() { WorkerEntry(); });
+        }
+        catch (const std::exception &ex)
+        {
+            LOG4CPLUS_ERROR_FMT(log, "SQL执行器创建线程捕获异常：%s", ex.what());
+        }
+    }
+}
+
+SqlExecutor::~SqlExecutor()
+{
+    Stop();
+}
+
+bool SqlExecutor::AsyncExecute(const std::string &statement, Work work, Callback callback)
+{
+    SpinLock<>::ScopeLock lock(m_submitLock);
+    if (!AcquireSlot())
+    {
+        return false;
+    }
+    boost::asio::post(m_context, [this, statement = statement, work = std::move(work), callback = std::move(callback)
+        , queuedTime = std::chrono::steady_clock::now()]()
+        {
+            SqlResult result = Run(statement, work, queuedTime);
+            m_queueDepth.fetch_sub(1, std::memory_order_relaxed);
+            QueueThreadPoolWorkItem([callback = std::move(callback), result = std::move(result)]() { callback(result); });
+        });
+    return true;
+}
+
+std::future<SqlResult> SqlExecutor::Execute(const std::string &statement, Work work)
+{
+    std::shared_ptr<std::promise<SqlResult>> promise = std::make_shared<std::promise<SqlResult>>();
+    std::future<SqlResult> ret = promise->get_future();
+    SpinLock<>::ScopeLock lock(m_submitLock);
+    if (!AcquireSlot())
+    {
+        promise->set_value(SqlResult{ false, true, std::string() });
+        return ret;
+    }
+    boost::asio::post(m_context, [this, statement = statement, work = std::move(work), promise, queuedTime = std::chrono::steady_clock::now()]()
+        {
+            SqlResult result = Run(statement, work, queuedTime);
+            m_queueDepth.fetch_sub(1, std::memory_order_relaxed);
+            promise->set_value(std::move(result));
+        });
+    return ret;
+}
+
+void SqlExecutor::Stop()
+{
+    {
+        //the works posted before are run by the workers before they leave run().
+        SpinLock<>::ScopeLock lock(m_submitLock);
+        m_stopped.store(true, std::memory_order_release);
+    }
+    m_workGuard.reset();
+    for (auto &worker : m_workers)
+    {
+        if (worker.joinable())
+        {
+            worker.join();
+        }
+    }
+}
+
+std::unordered_map<std::string, SqlStatementStats> SqlExecutor::GetStatementStats()
+{
+    SpinLock<>::ScopeLock lock(m_statsLock);
+    return m_stats;
+}
+
+void SqlExecutor::WorkerEntry()
+{
+    SqlConnectionPool::ptr_t db;
+    WorkerDatabase = &db;
+    for (;;)
+    {
+        try
+        {
+            m_context.run();
+            break;
+        }
+        catch (const std::exception &ex)
+        {
+            LOG4CPLUS_ERROR_FMT(log, "SQL执行器线程捕获异常：%s", ex.what());
+        }
+        catch (...)
+        {
+            LOG4CPLUS_ERROR(log, "SQL执行器线程捕获未知异常。");
+        }
+    }
+    WorkerDatabase = nullptr;
+}
+
+SqlResult SqlExecutor::Run(const std::string &statement, const Work &work, std::chrono::steady_clock::time_point queuedTime)
+{
+    SqlResult ret{ false, false, std::string() };
+    auto beg = std::chrono::steady_clock::now();
+    SqlConnectionPool::ptr_t &db = *WorkerDatabase;
+    if (!db && m_pool)
+    {
+        db = m_pool->Borrow();
+    }
+    if (!db)
+    {
+        ret.m_error = "获取数据库连接失败";
+    }
+    else
+    {
+        try
+        {
+            ret.m_succeeded = work(*db);
+        }
+        catch (const std::exception &ex)
+        {
+            ret.m_error = ex.what();
+        }
+        catch (...)
+        {
+        }
+        if (!ret.m_succeeded && ret.m_error.empty())
+        {
+            ret.m_error = db->LastError();
+        }
+    }
+    auto end = std::chrono::steady_clock::now();
+    us64 queueUs = static_cast<us64>(std::chrono::duration_cast<std::chrono::microseconds>(beg - queuedTime).count());
+    us64 execUs = static_cast<us64>(std::chrono::duration_cast<std::chrono::microseconds>(end - beg).count());
+    if (!ret.m_succeeded)
+    {
+        LOG4CPLUS_DEBUG_FMT(log, "SQL执行失败，语句：%s，错误信息：%s", statement.c_str(), ret.m_error.c_str());
+    }
+
+    SpinLock<>::ScopeLock lock(m_statsLock);
+    SqlStatementStats &stats = m_stats[statement];
+    ++stats.m_count;
+    if (!ret.m_succeeded)
+    {
+        ++stats.m_failedCount;
+    }
+    stats.m_totalQueueUs += queueUs;
+    stats.m_totalExecUs += execUs;
+    if (execUs > stats.m_maxExecUs)
+    {
+        stats.m_maxExecUs = execUs;
+    }
+    return ret;
+}
+
+bool SqlExecutor::AcquireSlot()
+{
+    if (m_stopped.load(std::memory_order_acquire))
+    {
+        return false;
+    }
+    size_t depth = m_queueDepth.fetch_add(1, std::memory_order_relaxed);
+    if (m_settings.m_maxQueueDepth && depth >= m_settings.m_maxQueueDepth)
+    {
+        m_queueDepth.fetch_sub(1, std::memory_order_relaxed);
+        return false;
+    }
+    return true;
+}
+
+#endif
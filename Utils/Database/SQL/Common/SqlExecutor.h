@@ -0,0 +1,193 @@
+#ifndef SQLEXECUTOR_H
+#define SQLEXECUTOR_H
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <future>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <boost/asio.hpp>
+#include <boost/thread.hpp>
+#include "../../../Log/Log4cplusCustomInc.h"
+#include "../../../Concurrent/SpinLock.h"
+#include "SqlConnectionPool.h"
+
+#if defined(_MSC_VER)
+    #pragma warning(push)
+    #pragma warning(disable : 4251)
+#endif
+
+/**
+ * Result of an executed statement.
+ */
+struct SqlResult
+{
+    bool m_succeeded;   /**< True if the statement work succeeded. */
+
+    bool m_rejected;    /**< True if the statement was not queued(the queue was full or the executor was stopped). */
+
+    std::string m_error;    /**< Error message(ISqlDatabase::LastError of the worker's connection) if failed. */
+};
+
+/**
+ * Latency statistics of a statement key.
+ */
+struct SqlStatementStats
+{
+    us64 m_count;   /**< Number of executions. */
+
+    us64 m_failedCount; /**< Number of failed executions. */
+
+    us64 m_totalQueueUs;    /**< Total time waited in the queue(in microseconds). */
+
+    us64 m_totalExecUs; /**< Total execution time(in microseconds). */
+
+    us64 m_maxExecUs;   /**< Max execution time(in microseconds). */
+};
+
+/**
+ * Settings of a SqlExecutor.
+ */
+struct SqlExecutorSettings
+{
+    std::string m_poolName; /**< Name of the SqlConnectionPool which the workers borrow connections from. */
+
+    unsigned int m_workerCount; /**< Number of worker threads(each one holds a connection). */
+
+    size_t m_maxQueueDepth; /**< Max number of statements waiting or executing,0 means no limit. */
+};
+
+/**
+ * Executes blocking ISqlDatabase work on a dedicated bounded set of worker threads,so the asio handlers on ThreadPool are not stalled
+ * by database round trips.Each worker borrows a connection from a SqlConnectionPool on its first statement and keeps it until the executor stops,the
+ * results are posted back to ThreadPool.
+ */
+class UTILS_EXPORTS_API SqlExecutor
+{
+public:
+
+    /**
+     * Defines an alias representing the statement work,which is called on a worker thread with the worker's connection.It returns
+     * true if succeeded,the exceptions thrown by ISqlDatabase are caught and reported as failures.
+     */
+    using Work = std::function<bool(ISqlDatabase &db)>;
+
+    /**
+     * Defines an alias representing the completion callback(called on ThreadPool).
+     */
+    using Callback = std::function<void(const SqlResult &result)>;
+
+    /**
+     * Constructor,starts the worker threads.
+     *
+     * @param settings The settings.
+     */
+    explicit SqlExecutor(const SqlExecutorSettings &settings);
+
+    /**
+     * Destructor,stops the executor.
+     */
+    ~SqlExecutor();
+
+    SqlExecutor(const SqlExecutor&) = delete;
+
+    SqlExecutor& operator=(const SqlExecutor&) = delete;
+
+    /**
+     * Queues a statement work.
+     *
+     * @param statement The statement key used by the latency statistics(such as the normalized SQL text or a statement name).
+     * @param work The statement work.
+     * @param callback The callback which is posted to ThreadPool when the work is finished(not called if rejected).
+     *
+     * @return False if the queue is full or the executor is stopped.
+     */
+    bool AsyncExecute(const std::string &statement, Work work, Callback callback);
+
+    /**
+     * Queues a statement work.
+     *
+     * @param statement The statement key used by the latency statistics(such as the normalized SQL text or a statement name).
+     * @param work The statement work.
+     *
+     * @return The future of the result(ready with m_rejected set if the queue is full or the executor is stopped).
+     */
+    std::future<SqlResult> Execute(const std::string &statement, Work work);
+
+    /**
+     * Stops accepting statements,waits for the queued ones to finish and stops the worker threads.
+     */
+    void Stop();
+
+    /**
+     * Gets the number of statements waiting or executing.
+     *
+     * @return Queue depth.
+     */
+    size_t QueueDepth() const
+    {
+        return m_queueDepth.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * Gets the latency statistics of all statement keys.
+     *
+     * @return Statistics keyed by the statement key.
+     */
+    std::unordered_map<std::string, SqlStatementStats> GetStatementStats();
+
+private:
+    SqlExecutorSettings m_settings; /**< The settings. */
+
+    std::shared_ptr<SqlConnectionPool> m_pool;  /**< The connection pool. */
+
+    boost::asio::io_context m_context;  /**< The queue of statement works. */
+
+    boost::asio::executor_work_guard<boost::asio::io_context::executor_type> m_workGuard;   /**< io_context's work guard. */
+
+    std::vector<boost::thread> m_workers;   /**< The worker threads. */
+
+    std::atomic<size_t> m_queueDepth;   /**< Number of statements waiting or executing. */
+
+    std::atomic<bool> m_stopped;    /**< True if stopped. */
+
+    SpinLock<> m_submitLock;    /**< Lock of the slot reservation and the post of a work,Stop sets m_stopped under it. */
+
+    SpinLock<> m_statsLock; /**< Lock of m_stats. */
+
+    std::unordered_map<std::string, SqlStatementStats> m_stats;   /**< Latency statistics. */
+
+    static log4cplus::Logger log;   /**< The logger. */
+
+    /**
+     * Worker thread entry.
+     */
+    void WorkerEntry();
+
+    /**
+     * Executes a statement work on the current worker thread.
+     *
+     * @param statement The statement key.
+     * @param work The statement work.
+     * @param queuedTime The time when the work was queued.
+     *
+     * @return The result.
+     */
+    SqlResult Run(const std::string &statement, const Work &work, std::chrono::steady_clock::time_point queuedTime);
+
+    /**
+     * Reserves a queue slot(called with m_submitLock held).
+     *
+     * @return False if the queue is full or the executor is stopped.
+     */
+    bool AcquireSlot();
+};
+
+#if defined(_MSC_VER)
+    #pragma warning(pop)
+#endif
+
+#endif /* SQLEXECUTOR_H */
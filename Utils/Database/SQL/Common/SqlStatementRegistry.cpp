@@ -0,0 +1,59 @@
+#if defined(USE_ODBC_DATABASE_UTILS) || defined(USE_OCI_DATABASE_UTILS)
+
+#include "SqlStatementRegistry.h"
+
+SpinLock<> SqlStatementRegistry::lock;
+
+std::unordered_map<std::string, SqlStatementId> SqlStatementRegistry::ids;
+
+std::deque<std::string> SqlStatementRegistry::texts;
+
+SqlStatementId SqlStatementRegistry::Intern(const std::string &sql)
+{
+    SpinLock<>::ScopeLock scopeLock(lock);
+    auto result = ids.emplace(sql, static_cast<SqlStatementId>(texts.size()));
+    if (result.second)
+    {
+        texts.push_back(sql);
+    }
+    return result.first->second;
+}
+
+SqlStatementId SqlStatementRegistry::TryIntern(const std::string &sql, size_t maxSize)
+{
+    SpinLock<>::ScopeLock scopeLock(lock);
+    auto target = ids.find(sql);
+    if (target != ids.end())
+    {
+        return target->second;
+    }
+    if (texts.size() >= maxSize)
+    {
+        return SqlInvalidStatementId;
+    }
+    SqlStatementId id = static_cast<SqlStatementId>(texts.size());
+    ids.emplace(sql, id);
+    texts.push_back(sql);
+    return id;
+}
+
+const std::string& SqlStatementRegistry::Text(SqlStatementId id)
+{
+    //deque keeps the references of its elements when growing at the end,the lock protects its internal map.
+    SpinLock<>::ScopeLock scopeLock(lock);
+    return texts.at(id);
+}
+
+const std::string* SqlStatementRegistry::Find(SqlStatementId id)
+{
+    SpinLock<>::ScopeLock scopeLock(lock);
+    return id < texts.size() ? &texts[id] : nullptr;
+}
+
+size_t SqlStatementRegistry::Size()
+{
+    SpinLock<>::ScopeLock scopeLock(lock);
+    return texts.size();
+}
+
+#endif
@@ -0,0 +1,89 @@
+#ifndef SQLSTATEMENTREGISTRY_H
+#define SQLSTATEMENTREGISTRY_H
+
+#include <deque>
+#include <string>
+#include <unordered_map>
+#include "../../../Common/CommonHdr.h"
+#include "../../../Concurrent/SpinLock.h"
+
+#if defined(_MSC_VER)
+    #pragma warning(push)
+    #pragma warning(disable : 4251)
+#endif
+
+/**
+ * Defines an alias representing the interned statement ID.
+ */
+using SqlStatementId = us32;
+
+/**
+ * ID which never refers to a statement.
+ */
+const SqlStatementId SqlInvalidStatementId = 0xFFFFFFFF;
+
+/**
+ * Process wide registry which interns SQL text to dense statement IDs,so the hot paths hash the text once and prepare the statement
+ * by its ID(see ISqlDatabase::PrepareStatement).IDs are never released,so intern the fixed statements of the application only(never
+ * the text with literals).
+ */
+class UTILS_EXPORTS_API SqlStatementRegistry
+{
+public:
+    /**
+     * Interns a statement.
+     *
+     * @param sql The SQL text.
+     *
+     * @return The ID(same text gets the same ID).
+     */
+    static SqlStatementId Intern(const std::string &sql);
+
+    /**
+     * Interns a statement if it is interned already or the registry has less than maxSize statements.
+     *
+     * @param sql The SQL text.
+     * @param maxSize Max number of interned statements.
+     *
+     * @return The ID,SqlInvalidStatementId if the registry is full.
+     */
+    static SqlStatementId TryIntern(const std::string &sql, size_t maxSize);
+
+    /**
+     * Gets the SQL text of a statement(throws std::out_of_range if the ID is not interned).
+     *
+     * @param id The ID returned by Intern.
+     *
+     * @return The SQL text(the reference stays valid).
+     */
+    static const std::string& Text(SqlStatementId id);
+
+    /**
+     * Finds the SQL text of a statement.
+     *
+     * @param id The statement ID.
+     *
+     * @return The SQL text(the pointer stays valid),nullptr if the ID is not interned.
+     */
+    static const std::string* Find(SqlStatementId id);
+
+    /**
+     * Gets the number of interned statements.
+     *
+     * @return The number.
+     */
+    static size_t Size();
+
+private:
+    static SpinLock<> lock; /**< Lock of ids and texts. */
+
+    static std::unordered_map<std::string, SqlStatementId> ids; /**< IDs keyed by the text. */
+
+    static std::deque<std::string> texts;   /**< Texts indexed by the ID. */
+};
+
+#if defined(_MSC_VER)
+    #pragma warning(pop)
+#endif
+
+#endif /* SQLSTATEMENTREGISTRY_H */
@@ -0,0 +1,266 @@
+#if defined(USE_ODBC_DATABASE_UTILS) || defined(USE_OCI_DATABASE_UTILS)
+
+#include <cctype>
+#include <cmath>
+#include "SqlStatementTracer.h"
+
+namespace
+{
+    const char *PhaseNames[] = { "Prepare", "Flush", "Commit", "Fetch" };
+}
+
+const char *const SqlStatementTracer::OtherStatements = "(other statements)";
+
+std::atomic<bool> SqlStatementTracer::enabled(true);
+
+std::atomic<us64> SqlStatementTracer::slowThreshold(1000 * 1000);
+
+std::atomic<us32> SqlStatementTracer::maxSlowLogsPerSecond(10);
+
+std::atomic<SqlStatementTracer::StatementCounters*> SqlStatementTracer::chunks[ChunkCount];
+
+SpinLock<> SqlStatementTracer::chunksLock;
+
+std::atomic<us64> SqlStatementTracer::slowQueryCount(0);
+
+std::atomic<us64> SqlStatementTracer::slowLogCount(0);
+
+std::atomic<s64> SqlStatementTracer::slowLogSecond(0);
+
+std::atomic<us32> SqlStatementTracer::slowLogsInSecond(0);
+
+log4cplus::Logger SqlStatementTracer::log = log4cplus::Logger::getInstance("SqlSlowQuery");
+
+us64 SqlLatencyHistogram::Percentile(double percentile) const
+{
+    if (!m_count)
+    {
+        return 0;
+    }
+    us64 target = static_cast<us64>(std::ceil(percentile * m_count));
+    us64 sum = 0;
+    for (size_t i = 0; i < BucketCount; ++i)
+    {
+        sum += m_buckets[i];
+        if (sum >= target && sum)
+        {
+            return i + 1 == BucketCount ? m_maxMicros : (static_cast<us64>(1) << i);
+        }
+    }
+    return m_maxMicros;
+}
+
+void SqlStatementTracer::SetSettings(const SqlStatementTracerSettings &settings)
+{
+    slowThreshold.store(static_cast<us64>(settings.m_slowThreshold.count()), std::memory_order_relaxed);
+    maxSlowLogsPerSecond.store(settings.m_maxSlowLogsPerSecond, std::memory_order_relaxed);
+    enabled.store(settings.m_enabled, std::memory_order_relaxed);
+}
+
+SqlStatementTracerSettings SqlStatementTracer::Settings()
+{
+    return SqlStatementTracerSettings{ enabled.load(std::memory_order_relaxed)
+        , std::chrono::microseconds(slowThreshold.load(std::memory_order_relaxed)), maxSlowLogsPerSecond.load(std::memory_order_relaxed) };
+}
+
+void SqlStatementTracer::Record(SqlStatementId id, SqlPhase phase, us64 micros, us32 bindCount, s64 rows)
+{
+    StatementCounters *counters = Counters(id, true);
+    if (!counters)
+    {
+        return;
+    }
+    size_t bucket = 0;
+    for (us64 temp = micros; temp && bucket + 1 < SqlLatencyHistogram::BucketCount; temp >>= 1)
+    {
+        ++bucket;
+    }
+    PhaseCounters &target = counters->m_phases[static_cast<size_t>(phase)];
+    target.m_count.fetch_add(1, std::memory_order_relaxed);
+    target.m_totalMicros.fetch_add(micros, std::memory_order_relaxed);
+    target.m_buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+    us64 max = target.m_maxMicros.load(std::memory_order_relaxed);
+    while (micros > max && !target.m_maxMicros.compare_exchange_weak(max, micros, std::memory_order_relaxed))
+    {
+    }
+    if (micros >= slowThreshold.load(std::memory_order_relaxed))
+    {
+        LogSlowQuery(id, phase, micros, bindCount, rows);
+    }
+}
+
+bool SqlStatementTracer::Snapshot(SqlStatementId id, SqlStatementTrace &trace)
+{
+    StatementCounters *counters = Counters(id, false);
+    if (!counters)
+    {
+        return false;
+    }
+    us64 total = 0;
+    for (size_t i = 0; i < static_cast<size_t>(SqlPhase::Count); ++i)
+    {
+        PhaseCounters &src = counters->m_phases[i];
+        SqlLatencyHistogram &dst = trace.m_phases[i];
+        dst.m_count = src.m_count.load(std::memory_order_relaxed);
+        dst.m_totalMicros = src.m_totalMicros.load(std::memory_order_relaxed);
+        dst.m_maxMicros = src.m_maxMicros.load(std::memory_order_relaxed);
+        for (size_t j = 0; j < SqlLatencyHistogram::BucketCount; ++j)
+        {
+            dst.m_buckets[j] = src.m_buckets[j].load(std::memory_order_relaxed);
+        }
+        total += dst.m_count;
+    }
+    if (!total)
+    {
+        return false;
+    }
+    trace.m_id = id;
+    trace.m_sql = SqlStatementRegistry::Text(id);
+    return true;
+}
+
+std::vector<SqlStatementTrace> SqlStatementTracer::SnapshotAll()
+{
+    std::vector<SqlStatementTrace> ret;
+    SqlStatementTrace trace;
+    for (size_t i = 0; i < ChunkCount; ++i)
+    {
+        if (!chunks[i].load(std::memory_order_acquire))
+        {
+            continue;
+        }
+        for (size_t j = 0; j < ChunkSize; ++j)
+        {
+            if (Snapshot(static_cast<SqlStatementId>(i * ChunkSize + j), trace))
+            {
+                ret.push_back(trace);
+            }
+        }
+    }
+    return ret;
+}
+
+void SqlStatementTracer::Reset()
+{
+    for (size_t i = 0; i < ChunkCount; ++i)
+    {
+        StatementCounters *chunk = chunks[i].load(std::memory_order_acquire);
+        for (size_t j = 0; chunk && j < ChunkSize; ++j)
+        {
+            for (auto &phase : chunk[j].m_phases)
+            {
+                phase.m_count.store(0, std::memory_order_relaxed);
+                phase.m_totalMicros.store(0, std::memory_order_relaxed);
+                phase.m_maxMicros.store(0, std::memory_order_relaxed);
+                for (auto &bucket : phase.m_buckets)
+                {
+                    bucket.store(0, std::memory_order_relaxed);
+                }
+            }
+        }
+    }
+    slowQueryCount.store(0, std::memory_order_relaxed);
+    slowLogCount.store(0, std::memory_order_relaxed);
+}
+
+us64 SqlStatementTracer::SlowQueryCount(us64 *logged)
+{
+    if (logged)
+    {
+        *logged = slowLogCount.load(std::memory_order_relaxed);
+    }
+    return slowQueryCount.load(std::memory_order_relaxed);
+}
+
+std::string SqlStatementTracer::Normalize(const char *sql)
+{
+    std::string ret;
+    for (const char *cur = sql; *cur;)
+    {
+        unsigned char c = static_cast<unsigned char>(*cur);
+        if (std::isspace(c))
+        {
+            while (std::isspace(static_cast<unsigned char>(*cur)))
+            {
+                ++cur;
+            }
+            if (!ret.empty() && *cur)
+            {
+                ret.push_back(' ');
+            }
+        }
+        else if (c == '\'')
+        {
+            //'' is an escaped quote inside the literal.
+            for (++cur; *cur; ++cur)
+            {
+                if (*cur == '\'' && *++cur != '\'')
+                {
+                    break;
+                }
+            }
+            ret.push_back('?');
+        }
+        else if (std::isdigit(c) && (ret.empty() || !(std::isalnum(static_cast<unsigned char>(ret.back())) || ret.back() == '_')))
+        {
+            while (std::isalnum(static_cast<unsigned char>(*cur)) || *cur == '.')
+            {
+                ++cur;
+            }
+            ret.push_back('?');
+        }
+        else
+        {
+            ret.push_back(*cur++);
+        }
+    }
+    return ret;
+}
+
+SqlStatementId SqlStatementTracer::TraceId(const char *sql)
+{
+    SqlStatementId id = SqlStatementRegistry::TryIntern(Normalize(sql), MaxStatements);
+    return id == SqlInvalidStatementId ? SqlStatementRegistry::Intern(OtherStatements) : id;
+}
+
+SqlStatementTracer::StatementCounters* SqlStatementTracer::Counters(SqlStatementId id, bool create)
+{
+    size_t index = id / ChunkSize;
+    if (index >= ChunkCount)
+    {
+        return nullptr;
+    }
+    StatementCounters *chunk = chunks[index].load(std::memory_order_acquire);
+    if (!chunk && create)
+    {
+        SpinLock<>::ScopeLock lock(chunksLock);
+        chunk = chunks[index].load(std::memory_order_acquire);
+        if (!chunk)
+        {
+            //value initialization zeroes the atomic counters.
+            chunk = new StatementCounters[ChunkSize]();
+            chunks[index].store(chunk, std::memory_order_release);
+        }
+    }
+    return chunk ? chunk + id % ChunkSize : nullptr;
+}
+
+void SqlStatementTracer::LogSlowQuery(SqlStatementId id, SqlPhase phase, us64 micros, us32 bindCount, s64 rows)
+{
+    slowQueryCount.fetch_add(1, std::memory_order_relaxed);
+    s64 second = std::chrono::duration_cast<std::chrono::seconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    s64 windowSecond = slowLogSecond.load(std::memory_order_relaxed);
+    if (second != windowSecond && slowLogSecond.compare_exchange_strong(windowSecond, second, std::memory_order_relaxed))
+    {
+        slowLogsInSecond.store(0, std::memory_order_relaxed);
+    }
+    if (slowLogsInSecond.fetch_add(1, std::memory_order_relaxed) >= maxSlowLogsPerSecond.load(std::memory_order_relaxed))
+    {
+        return;
+    }
+    slowLogCount.fetch_add(1, std::memory_order_relaxed);
+    LOG4CPLUS_WARN_FMT(log, "慢SQL，阶段：%s，耗时：%llu微秒，绑定参数个数：%u，影响行数：%lld，sql语句：%s", PhaseNames[static_cast<size_t>(phase)]
+        , static_cast<unsigned long long>(micros), bindCount, static_cast<long long>(rows), SqlStatementRegistry::Text(id).c_str());
+}
+
+#endif
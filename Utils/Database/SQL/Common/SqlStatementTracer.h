@@ -0,0 +1,260 @@
+#ifndef SQLSTATEMENTTRACER_H
+#define SQLSTATEMENTTRACER_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <vector>
+#include "../../../Common/CommonHdr.h"
+#include "../../../Log/Log4cplusCustomInc.h"
+#include "../../../Concurrent/SpinLock.h"
+#include "SqlStatementRegistry.h"
+
+#if defined(_MSC_VER)
+    #pragma warning(push)
+    #pragma warning(disable : 4251)
+#endif
+
+/**
+ * Values that represent the traced phases of a statement.
+ */
+enum class SqlPhase :int
+{
+    Prepare,    /**< Prepare(including the logon and the execution of a select without input variables). */
+    Flush,  /**< Execution of the buffered rows. */
+    Commit, /**< Commit,traced as the last prepared statement. */
+    Fetch,  /**< Total time spent fetching the result set of one execution. */
+    Count   /**< Number of phases. */
+};
+
+/**
+ * Snapshot of the latency histogram of a phase.Bucket 0 counts the latencies under 1us,bucket i counts [2^(i-1),2^i)us,the last
+ * bucket counts all longer latencies.
+ */
+struct UTILS_EXPORTS_API SqlLatencyHistogram
+{
+    static const size_t BucketCount = 32;   /**< Number of buckets. */
+
+    us64 m_count;   /**< Number of samples. */
+
+    us64 m_totalMicros; /**< Sum of the latencies(us). */
+
+    us64 m_maxMicros;   /**< Max latency(us). */
+
+    std::array<us64, BucketCount> m_buckets;    /**< The buckets. */
+
+    /**
+     * Gets the upper bound of the bucket containing a percentile.
+     *
+     * @param percentile The percentile(0-1).
+     *
+     * @return The latency(us),0 if there is no sample.
+     */
+    us64 Percentile(double percentile) const;
+};
+
+/**
+ * Snapshot of the traces of a statement.
+ */
+struct SqlStatementTrace
+{
+    SqlStatementId m_id;    /**< The statement ID. */
+
+    std::string m_sql;  /**< The statement text. */
+
+    std::array<SqlLatencyHistogram, static_cast<size_t>(SqlPhase::Count)> m_phases; /**< Histograms indexed by SqlPhase. */
+};
+
+/**
+ * Settings of SqlStatementTracer.
+ */
+struct SqlStatementTracerSettings
+{
+    bool m_enabled; /**< True to trace the statements. */
+
+    std::chrono::microseconds m_slowThreshold;  /**< Phases which take longer are logged to the slow query logger. */
+
+    us32 m_maxSlowLogsPerSecond;    /**< Max number of slow queries logged per second,the others are counted only. */
+};
+
+/**
+ * Process wide per statement latency histograms of the SQL layer,keyed by the interned statement ID(statements prepared by text are
+ * keyed by their normalized text,see TraceId).Record is lock free(a few relaxed atomic adds),the counters of the statements are
+ * allocated in chunks which are never released.
+ *
+ * Phases which take longer than m_slowThreshold are sampled to the "SqlSlowQuery" logger with the bind count and the affected rows.
+ */
+class UTILS_EXPORTS_API SqlStatementTracer
+{
+public:
+    /**
+     * Checks whether the tracing is enabled.
+     *
+     * @return True if enabled.
+     */
+    static bool Enabled()
+    {
+        return enabled.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * Sets the settings.
+     *
+     * @param settings The settings.
+     */
+    static void SetSettings(const SqlStatementTracerSettings &settings);
+
+    /**
+     * Gets the settings.
+     *
+     * @return The settings.
+     */
+    static SqlStatementTracerSettings Settings();
+
+    /**
+     * Records the latency of a phase.
+     *
+     * @param id The statement ID(ignored if SqlInvalidStatementId).
+     * @param phase The phase.
+     * @param micros The latency(us).
+     * @param bindCount (Optional) Number of values bound to the statement.
+     * @param rows (Optional) Number of affected or fetched rows,-1 if unknown.
+     */
+    static void Record(SqlStatementId id, SqlPhase phase, us64 micros, us32 bindCount = 0, s64 rows = -1);
+
+    /**
+     * Gets the latency since a time point.
+     *
+     * @param beg The time point.
+     *
+     * @return The latency(us).
+     */
+    static us64 ElapsedMicros(std::chrono::steady_clock::time_point beg)
+    {
+        return static_cast<us64>(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - beg).count());
+    }
+
+    /**
+     * Gets the traces of a statement.
+     *
+     * @param id The statement ID.
+     * @param [out] trace The traces.
+     *
+     * @return False if the statement has never been traced.
+     */
+    static bool Snapshot(SqlStatementId id, SqlStatementTrace &trace);
+
+    /**
+     * Gets the traces of all traced statements.
+     *
+     * @return The traces.
+     */
+    static std::vector<SqlStatementTrace> SnapshotAll();
+
+    /**
+     * Clears all histograms.
+     */
+    static void Reset();
+
+    /**
+     * Gets the number of slow queries.
+     *
+     * @param [out] logged (Optional) Number of the slow queries written to the logger.
+     *
+     * @return Number of the slow queries(logged or dropped by the rate limit).
+     */
+    static us64 SlowQueryCount(us64 *logged = nullptr);
+
+    /**
+     * Normalizes a statement by replacing the string and numeric literals with '?' and collapsing the white spaces.
+     *
+     * @param sql The statement.
+     *
+     * @return The normalized statement.
+     */
+    static std::string Normalize(const char *sql);
+
+    /**
+     * Gets the trace ID of a statement prepared by text:its normalized text is interned while the registry has less than
+     * MaxStatements statements,later new statements share the OtherStatements ID,so the registry and the counters stay bounded.
+     * It takes the registry lock,so cache the result per prepared statement.
+     *
+     * @param sql The statement.
+     *
+     * @return The ID.
+     */
+    static SqlStatementId TraceId(const char *sql);
+
+    static const size_t MaxStatements = 4096;   /**< Max number of registry statements which TraceId interns new statements into. */
+
+    static const char *const OtherStatements;   /**< Text of the ID shared by the statements over MaxStatements. */
+
+private:
+    /**
+     * Counters of a phase.
+     */
+    struct PhaseCounters
+    {
+        std::atomic<us64> m_count;  /**< Number of samples. */
+
+        std::atomic<us64> m_totalMicros;    /**< Sum of the latencies. */
+
+        std::atomic<us64> m_maxMicros;  /**< Max latency. */
+
+        std::atomic<us64> m_buckets[SqlLatencyHistogram::BucketCount];  /**< The buckets. */
+    };
+
+    /**
+     * Counters of a statement.
+     */
+    struct StatementCounters
+    {
+        PhaseCounters m_phases[static_cast<size_t>(SqlPhase::Count)];   /**< Counters indexed by SqlPhase. */
+    };
+
+    static const size_t ChunkSize = 256;    /**< Number of statements of a chunk. */
+
+    static const size_t ChunkCount = 4096;  /**< Max number of chunks. */
+
+    static std::atomic<bool> enabled;   /**< True if enabled. */
+
+    static std::atomic<us64> slowThreshold; /**< Slow query threshold(us). */
+
+    static std::atomic<us32> maxSlowLogsPerSecond;  /**< Max number of slow queries logged per second. */
+
+    static std::atomic<StatementCounters*> chunks[ChunkCount];  /**< Chunks of the counters indexed by ID/ChunkSize. */
+
+    static SpinLock<> chunksLock;   /**< Lock of the chunk allocation. */
+
+    static std::atomic<us64> slowQueryCount;    /**< Number of slow queries. */
+
+    static std::atomic<us64> slowLogCount;  /**< Number of logged slow queries. */
+
+    static std::atomic<s64> slowLogSecond;  /**< Second of the current rate limit window. */
+
+    static std::atomic<us32> slowLogsInSecond;  /**< Number of slow queries logged in the current window. */
+
+    static log4cplus::Logger log;   /**< The slow query logger. */
+
+    /**
+     * Gets the counters of a statement.
+     *
+     * @param id The statement ID.
+     * @param create True to allocate the chunk if not exists.
+     *
+     * @return The counters,null if not exists or the ID is out of range.
+     */
+    static StatementCounters* Counters(SqlStatementId id, bool create);
+
+    /**
+     * Logs a slow query if the rate limit allows.
+     */
+    static void LogSlowQuery(SqlStatementId id, SqlPhase phase, us64 micros, us32 bindCount, s64 rows);
+};
+
+#if defined(_MSC_VER)
+    #pragma warning(pop)
+#endif
+
+#endif /* SQLSTATEMENTTRACER_H */
@@ -174,6 +174,11 @@ const std::string& OracleSqlDatabase::LastError()
     return m_lastError;
 }
 
+void OracleSqlDatabase::SetLastError(const std::string &error)
+{
+    m_lastError = error;
+}
+
 ISqlDatabase& OracleSqlDatabase::operator<<(const unsigned char* s)
 {
     try
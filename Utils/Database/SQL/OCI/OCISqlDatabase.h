@@ -89,6 +89,9 @@ public:
 
     virtual ISqlDatabase& operator >> (otl_datetime& dt);
 
+protected:
+    virtual void SetLastError(const std::string &error);
+
 private:
     OracleSqlDatabase(const OracleSqlDatabase&) = delete;
 
@@ -2,26 +2,25 @@
 
 #include "ODBCSqlDatabase.h"
 
-ODBCSqlDatabase::ODBCSqlDatabase(const char *connStr, bool connect, int cmdPoolSize) :m_connection(), m_cmd(), m_connStr(connStr)
+ODBCSqlDatabase::ODBCSqlDatabase(const char *connStr, bool connect, int cmdPoolSize) :m_connection(), m_uncachedCmd(), m_cmd(&m_uncachedCmd)
+, m_statements(), m_statementIndex(), m_textIndex(), m_textKey(), m_statementCacheSize(cmdPoolSize > 0 ? cmdPoolSize : 1), m_cacheStats{ 0, 0, 0, 0 }, m_fetchString(), m_connStr(connStr)
+, m_breaker(), m_statementId(SqlInvalidStatementId), m_bindCount(0), m_fetchArraySize(1), m_fetchNanos(0), m_fetchRows(0), m_fetchTraced(false), m_fetchEnded(false)
 , m_lastError(), m_cmdStayInPool(true)
 {
     m_lastError.reserve(4096);
     m_connection.set_stream_pool_size(cmdPoolSize);
+    std::string probeConnStr = m_connStr;
+    m_breaker = SqlCircuitBreaker::Get(m_connStr, [probeConnStr]() { return Probe(probeConnStr); });
     if (connect)
     {
-        try
-        {
-            m_connection.rlogon(m_connStr.c_str(), false);
-        }
-        catch (const odbc::otl_exception &err)
-        {
-            FormatExceptionMsg(err, m_lastError, "构造连接错误", true);
-        }
+        Connect("构造连接错误");
     }
 }
 
 ODBCSqlDatabase::~ODBCSqlDatabase()
 {
+    FinishFetchTrace();
+    ClearStatementCache();
 }
 
 SqlDatabaseType ODBCSqlDatabase::Type()
@@ -31,43 +30,172 @@ SqlDatabaseType ODBCSqlDatabase::Type()
 
 bool ODBCSqlDatabase::Prepare(const char *sql, int bufferSize, bool stayInPool, bool storedPorcReturnDataset)
 {
+    FinishFetchTrace();
+    auto beg = TraceBegin();
+    m_statementId = SqlInvalidStatementId;
+    m_bindCount = 0;
+    m_fetchArraySize = bufferSize > 0 ? bufferSize + 1 : 1;
+    m_fetchEnded = false;
+    if (!Connect("准备SQL错误"))
+    {
+        return false;
+    }
     bool ret = true;
+    if (stayInPool && !storedPorcReturnDataset)
+    {
+        ret = PrepareCached(SqlInvalidStatementId, sql, bufferSize);
+        TraceEnd(SqlPhase::Prepare, beg);
+        return ret;
+    }
+    //the statements prepared by text may contain literals,so they are traced by the normalized text.
+    if (SqlStatementTracer::Enabled())
+    {
+        m_statementId = SqlStatementTracer::TraceId(sql);
+    }
     try
     {
-        if (!m_connection.connected)
+        CloseUncachedCmd();
+        m_uncachedCmd.open(bufferSize + 1, sql, m_connection, storedPorcReturnDataset ? otl_implicit_select : otl_explicit_select);//otl在buffer满时会自动flush，所以这里加1，防止最后一条记录放入buffer后自动执行
+        m_cmdStayInPool = stayInPool;
+        m_uncachedCmd.set_commit(false);
+        m_uncachedCmd.set_flush(false);
+        m_cmd = &m_uncachedCmd;
+    }
+    catch (const odbc::otl_exception &err)
+    {
+        ret = false;
+        FormatExceptionMsg(err, m_lastError, "准备SQL错误");
+        HandleNetworkError(err);
+    }
+    TraceEnd(SqlPhase::Prepare, beg);
+    return ret;
+}
+
+bool ODBCSqlDatabase::PrepareStatement(SqlStatementId id, int bufferSize)
+{
+    const std::string *sql = SqlStatementRegistry::Find(id);
+    if (!sql)
+    {
+        SetLastError("准备SQL错误，语句ID不存在：" + std::to_string(id));
+        return false;
+    }
+    FinishFetchTrace();
+    auto beg = TraceBegin();
+    m_statementId = id;
+    m_bindCount = 0;
+    m_fetchArraySize = bufferSize > 0 ? bufferSize + 1 : 1;
+    m_fetchEnded = false;
+    if (!Connect("准备SQL错误"))
+    {
+        return false;
+    }
+    bool ret = PrepareCached(id, sql->c_str(), bufferSize);
+    TraceEnd(SqlPhase::Prepare, beg);
+    return ret;
+}
+
+bool ODBCSqlDatabase::PrepareCached(SqlStatementId id, const char *sql, int bufferSize)
+{
+    try
+    {
+        CloseUncachedCmd();
+        us64 key = (static_cast<us64>(id) << 32) | static_cast<us32>(bufferSize);
+        std::list<CachedStatement>::iterator target = m_statements.end();
+        if (id != SqlInvalidStatementId)
         {
-            m_connection.rlogon(m_connStr.c_str(), false);
+            auto found = m_statementIndex.find(key);
+            if (found != m_statementIndex.end())
+            {
+                target = found->second;
+            }
         }
-        if (m_cmd.good())
+        else
         {
-            try
+            //the reused key keeps its capacity,so a cache hit does not allocate.
+            m_textKey.assign(reinterpret_cast<const char*>(&bufferSize), sizeof(bufferSize)).append(sql);
+            auto found = m_textIndex.find(m_textKey);
+            if (found != m_textIndex.end())
             {
-                m_cmd.close(m_cmdStayInPool);
+                target = found->second;
             }
-            catch (...)
+        }
+        if (target != m_statements.end())
+        {
+            m_statements.splice(m_statements.begin(), m_statements, target);
+            CachedStatement &statement = m_statements.front();
+            m_cmd = statement.m_stream.get();
+            ++m_cacheStats.m_hitCount;
+            //the trace ID is computed once per cached statement,a statement cached while the tracing was disabled gets it here.
+            if (statement.m_traceId == SqlInvalidStatementId && SqlStatementTracer::Enabled())
             {
+                statement.m_traceId = SqlStatementTracer::TraceId(sql);
             }
+            m_statementId = statement.m_traceId;
+            //re-executes the statement without input variables and discards the rows buffered by the last use.
+            m_cmd->rewind();
+            return true;
         }
-        m_cmd.open(bufferSize + 1, sql, m_connection, storedPorcReturnDataset ? otl_implicit_select : otl_explicit_select);//otl在buffer满时会自动flush，所以这里加1，防止最后一条记录放入buffer后自动执行
-        m_cmdStayInPool = stayInPool;
-        m_cmd.set_commit(false);
-        m_cmd.set_flush(false);
+
+        ++m_cacheStats.m_missCount;
+        if (m_statements.size() >= m_statementCacheSize)
+        {
+            CachedStatement &evicted = m_statements.back();
+            CloseStatement(evicted);
+            if (evicted.m_textKey.empty())
+            {
+                m_statementIndex.erase(evicted.m_key);
+            }
+            else
+            {
+                m_textIndex.erase(evicted.m_textKey);
+            }
+            m_statements.pop_back();
+            ++m_cacheStats.m_evictedCount;
+        }
+        std::unique_ptr<odbc::otl_stream> stream(new odbc::otl_stream());
+        stream->open(bufferSize + 1, sql, m_connection, otl_explicit_select);//otl在buffer满时会自动flush，所以这里加1，防止最后一条记录放入buffer后自动执行
+        stream->set_commit(false);
+        stream->set_flush(false);
+        m_cmd = stream.get();
+        if (id != SqlInvalidStatementId)
+        {
+            m_statements.push_front(CachedStatement{ key, std::string(), id, std::move(stream) });
+            m_statementIndex.emplace(key, m_statements.begin());
+        }
+        else
+        {
+            SqlStatementId traceId = SqlStatementTracer::Enabled() ? SqlStatementTracer::TraceId(sql) : SqlInvalidStatementId;
+            m_statements.push_front(CachedStatement{ key, m_textKey, traceId, std::move(stream) });
+            m_textIndex.emplace(m_textKey, m_statements.begin());
+        }
+        m_statementId = m_statements.front().m_traceId;
     }
     catch (const odbc::otl_exception &err)
     {
-        ret = false;
+        m_cmd = &m_uncachedCmd;
         FormatExceptionMsg(err, m_lastError, "准备SQL错误");
         HandleNetworkError(err);
+        return false;
     }
+    return true;
+}
+
+SqlStatementCacheStats ODBCSqlDatabase::StatementCacheStats()
+{
+    SqlStatementCacheStats ret = m_cacheStats;
+    ret.m_size = m_statements.size();
     return ret;
 }
 
 bool ODBCSqlDatabase::FlushBuffer()
 {
     bool ret = true;
+    auto beg = TraceBegin();
+    s64 rows = -1;
     try
     {
-        m_cmd.flush();
+        m_cmd->flush();
+        rows = m_cmd->get_rpc();
     }
     catch (const odbc::otl_exception &err)
     {
@@ -75,12 +203,15 @@ bool ODBCSqlDatabase::FlushBuffer()
         FormatExceptionMsg(err, m_lastError, "执行SQL错误");
         HandleNetworkError(err);
     }
+    TraceEnd(SqlPhase::Flush, beg, rows);
+    m_bindCount = 0;
     return ret;
 }
 
 bool ODBCSqlDatabase::Commit()
 {
     bool ret = true;
+    auto beg = TraceBegin();
     try
     {
         m_connection.commit();
@@ -91,6 +222,7 @@ bool ODBCSqlDatabase::Commit()
         FormatExceptionMsg(err, m_lastError, "提交SQL错误");
         HandleNetworkError(err);
     }
+    TraceEnd(SqlPhase::Commit, beg);
     return ret;
 }
 
@@ -112,31 +244,97 @@ bool ODBCSqlDatabase::Rollback()
 
 int ODBCSqlDatabase::IsEOF()
 {
+    int ret = -1;
+    bool traced = !m_fetchEnded && SqlStatementTracer::Enabled();
+    //eof fetches the next array of rows only when the buffered rows are consumed,so only the calls which may fetch are timed.
+    auto beg = traced && m_fetchRows % m_fetchArraySize == 0 ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point();
     try
     {
-        return m_cmd.eof();
+        ret = m_cmd->eof();
     }
     catch (const odbc::otl_exception &err)
     {
         FormatExceptionMsg(err, m_lastError, "获取查询结束标志错误");
         HandleNetworkError(err);
     }
-    return -1;
+    if (traced)
+    {
+        //every false result is followed by reading a row.
+        TraceFetch(beg, ret == 0 ? 1 : 0);
+    }
+    if (traced && ret)
+    {
+        FinishFetchTrace();
+        m_fetchEnded = true;
+    }
+    return ret;
+}
+
+void ODBCSqlDatabase::TraceEnd(SqlPhase phase, std::chrono::steady_clock::time_point beg, s64 rows)
+{
+    if (beg != std::chrono::steady_clock::time_point())
+    {
+        SqlStatementTracer::Record(m_statementId, phase, SqlStatementTracer::ElapsedMicros(beg), m_bindCount, rows);
+    }
+}
+
+void ODBCSqlDatabase::TraceFetch(std::chrono::steady_clock::time_point beg, s64 rows)
+{
+    if (beg != std::chrono::steady_clock::time_point())
+    {
+        //accumulated in nanoseconds,an eof which does not fetch takes less than 1us.
+        m_fetchNanos += static_cast<us64>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - beg).count());
+    }
+    m_fetchRows += rows;
+    m_fetchTraced = true;
+}
+
+void ODBCSqlDatabase::FinishFetchTrace()
+{
+    if (m_fetchTraced)
+    {
+        SqlStatementTracer::Record(m_statementId, SqlPhase::Fetch, m_fetchNanos / 1000, 0, m_fetchRows);
+        m_fetchNanos = 0;
+        m_fetchRows = 0;
+        m_fetchTraced = false;
+    }
+}
+
+bool ODBCSqlDatabase::Connect(const char *context)
+{
+    if (m_connection.connected)
+    {
+        return true;
+    }
+    if (!m_breaker->AllowRequest())
+    {
+        m_lastError.assign(context).append("，错误信息：数据库连接已熔断，等待后台探测恢复");
+        return false;
+    }
+    try
+    {
+        m_connection.rlogon(m_connStr.c_str(), false);
+    }
+    catch (const odbc::otl_exception &err)
+    {
+        FormatExceptionMsg(err, m_lastError, context, true);
+        m_breaker->OnFailure();
+        return false;
+    }
+    m_breaker->OnSuccess();
+    return true;
 }
 
 void ODBCSqlDatabase::HandleNetworkError(const odbc::otl_exception &err)
 {
     if (IsNetworkError(err))
     {
+        m_breaker->OnFailure();
         try
         {
-            try
-            {
-                m_cmd.close(m_cmdStayInPool);
-            }
-            catch (...)
-            {
-            }
+            CloseUncachedCmd();
+            //the cached statements belong to the broken connection.
+            ClearStatementCache();
             m_connection.logoff();
         }
         catch (const odbc::otl_exception&)
@@ -145,16 +343,175 @@ void ODBCSqlDatabase::HandleNetworkError(const odbc::otl_exception &err)
     }
 }
 
+void ODBCSqlDatabase::CloseUncachedCmd()
+{
+    if (m_uncachedCmd.good())
+    {
+        try
+        {
+            m_uncachedCmd.close(m_cmdStayInPool);
+        }
+        catch (...)
+        {
+        }
+    }
+}
+
+void ODBCSqlDatabase::CloseStatement(CachedStatement &statement)
+{
+    try
+    {
+        statement.m_stream->close(false);
+    }
+    catch (...)
+    {
+    }
+}
+
+void ODBCSqlDatabase::ClearStatementCache()
+{
+    m_cmd = &m_uncachedCmd;
+    for (auto &statement : m_statements)
+    {
+        CloseStatement(statement);
+    }
+    m_statements.clear();
+    m_statementIndex.clear();
+    m_textIndex.clear();
+}
+
 const std::string& ODBCSqlDatabase::LastError()
 {
     return m_lastError;
 }
 
+void ODBCSqlDatabase::SetLastError(const std::string &error)
+{
+    m_lastError = error;
+}
+
+bool ODBCSqlDatabase::IsNull()
+{
+    return m_cmd->is_null();
+}
+
+int ODBCSqlDatabase::FetchColumns(SqlColumnBatch &batch)
+{
+    size_t row = batch.RowCount();
+    size_t beg = row;
+    auto traceBeg = m_fetchEnded ? std::chrono::steady_clock::time_point() : TraceBegin();
+    odbc::otl_stream &cmd = *m_cmd;
+    try
+    {
+        while (row < batch.Capacity() && !cmd.eof())
+        {
+            for (size_t i = 0; i < batch.ColumnCount(); ++i)
+            {
+                switch (batch.Type(i))
+                {
+                case SqlColumnType::Int32:
+                {
+                    int n;
+                    cmd >> n;
+                    batch.Int32s(i)[row] = n;
+                    break;
+                }
+                case SqlColumnType::Int64:
+                    cmd >> batch.Int64s(i)[row];
+                    break;
+                case SqlColumnType::Double:
+                    cmd >> batch.Doubles(i)[row];
+                    break;
+                case SqlColumnType::String:
+                    cmd >> m_fetchString;
+                    batch.SetString(i, row, m_fetchString.data(), m_fetchString.size());
+                    break;
+                case SqlColumnType::DateTime:
+                    cmd >> batch.DateTimes(i)[row];
+                    break;
+                }
+                batch.SetNull(i, row, cmd.is_null());
+            }
+            batch.SetRowCount(++row);
+        }
+    }
+    catch (const odbc::otl_exception &err)
+    {
+        FormatExceptionMsg(err, m_lastError, "读取查询结果错误");
+        HandleNetworkError(err);
+        return -1;
+    }
+    if (traceBeg != std::chrono::steady_clock::time_point())
+    {
+        TraceFetch(traceBeg, static_cast<s64>(row - beg));
+        //the loop ends before the batch is full only at the end of the result set.
+        if (row < batch.Capacity())
+        {
+            FinishFetchTrace();
+            m_fetchEnded = true;
+        }
+    }
+    return static_cast<int>(row - beg);
+}
+
+bool ODBCSqlDatabase::InsertColumns(const SqlColumnBatch &batch)
+{
+    bool ret = true;
+    auto beg = TraceBegin();
+    s64 rows = -1;
+    m_bindCount += static_cast<us32>(batch.RowCount() * batch.ColumnCount());
+    odbc::otl_stream &cmd = *m_cmd;
+    try
+    {
+        for (size_t row = 0; row < batch.RowCount(); ++row)
+        {
+            for (size_t i = 0; i < batch.ColumnCount(); ++i)
+            {
+                if (batch.IsNull(i, row))
+                {
+                    cmd << otl_null();
+                    continue;
+                }
+                switch (batch.Type(i))
+                {
+                case SqlColumnType::Int32:
+                    cmd << static_cast<int>(batch.Int32s(i)[row]);
+                    break;
+                case SqlColumnType::Int64:
+                    cmd << batch.Int64s(i)[row];
+                    break;
+                case SqlColumnType::Double:
+                    cmd << batch.Doubles(i)[row];
+                    break;
+                case SqlColumnType::String:
+                    cmd << batch.String(i, row);
+                    break;
+                case SqlColumnType::DateTime:
+                    cmd << batch.DateTimes(i)[row];
+                    break;
+                }
+            }
+        }
+        cmd.flush();
+        rows = cmd.get_rpc();
+    }
+    catch (const odbc::otl_exception &err)
+    {
+        ret = false;
+        FormatExceptionMsg(err, m_lastError, "批量写入错误");
+        HandleNetworkError(err);
+    }
+    TraceEnd(SqlPhase::Flush, beg, rows);
+    m_bindCount = 0;
+    return ret;
+}
+
 ISqlDatabase& ODBCSqlDatabase::operator<<(const unsigned char* s)
 {
+    ++m_bindCount;
     try
     {
-        m_cmd << s;
+        *m_cmd << s;
         return *this;
     }
     catch (const odbc::otl_exception &err)
@@ -167,9 +524,10 @@ ISqlDatabase& ODBCSqlDatabase::operator<<(const unsigned char* s)
 
 ISqlDatabase& ODBCSqlDatabase::operator<<(const char c)
 {
+    ++m_bindCount;
     try
     {
-        m_cmd << c;
+        *m_cmd << c;
         return *this;
     }
     catch (const odbc::otl_exception &err)
@@ -182,9 +540,10 @@ ISqlDatabase& ODBCSqlDatabase::operator<<(const char c)
 
 ISqlDatabase& ODBCSqlDatabase::operator<<(const char* s)
 {
+    ++m_bindCount;
     try
     {
-        m_cmd << s;
+        *m_cmd << s;
         return *this;
     }
     catch (const odbc::otl_exception &err)
@@ -197,9 +556,10 @@ ISqlDatabase& ODBCSqlDatabase::operator<<(const char* s)
 
 ISqlDatabase& ODBCSqlDatabase::operator<<(const otl_long_string& d)
 {
+    ++m_bindCount;
     try
     {
-        m_cmd << d;
+        *m_cmd << d;
         return *this;
     }
     catch (const odbc::otl_exception &err)
@@ -212,9 +572,10 @@ ISqlDatabase& ODBCSqlDatabase::operator<<(const otl_long_string& d)
 
 ISqlDatabase& ODBCSqlDatabase::operator<<(const std::string& s)
 {
+    ++m_bindCount;
     try
     {
-        m_cmd << s;
+        *m_cmd << s;
         return *this;
     }
     catch (const odbc::otl_exception &err)
@@ -227,9 +588,10 @@ ISqlDatabase& ODBCSqlDatabase::operator<<(const std::string& s)
 
 ISqlDatabase& ODBCSqlDatabase::operator<<(const int n)
 {
+    ++m_bindCount;
     try
     {
-        m_cmd << n;
+        *m_cmd << n;
         return *this;
     }
     catch (const odbc::otl_exception &err)
@@ -242,9 +604,10 @@ ISqlDatabase& ODBCSqlDatabase::operator<<(const int n)
 
 ISqlDatabase& ODBCSqlDatabase::operator<<(const unsigned int u)
 {
+    ++m_bindCount;
     try
     {
-        m_cmd << u;
+        *m_cmd << u;
         return *this;
     }
     catch (const odbc::otl_exception &err)
@@ -257,9 +620,10 @@ ISqlDatabase& ODBCSqlDatabase::operator<<(const unsigned int u)
 
 ISqlDatabase& ODBCSqlDatabase::operator<<(const short sh)
 {
+    ++m_bindCount;
     try
     {
-        m_cmd << sh;
+        *m_cmd << sh;
         return *this;
     }
     catch (const odbc::otl_exception &err)
@@ -272,9 +636,10 @@ ISqlDatabase& ODBCSqlDatabase::operator<<(const short sh)
 
 ISqlDatabase& ODBCSqlDatabase::operator<<(const long int l)
 {
+    ++m_bindCount;
     try
     {
-        m_cmd << l;
+        *m_cmd << l;
         return *this;
     }
     catch (const odbc::otl_exception &err)
@@ -287,9 +652,10 @@ ISqlDatabase& ODBCSqlDatabase::operator<<(const long int l)
 
 ISqlDatabase& ODBCSqlDatabase::operator<<(const us64 l)
 {
+    ++m_bindCount;
     try
     {
-        m_cmd << l;
+        *m_cmd << l;
         return *this;
     }
     catch (const odbc::otl_exception &err)
@@ -302,9 +668,10 @@ ISqlDatabase& ODBCSqlDatabase::operator<<(const us64 l)
 
 ISqlDatabase& ODBCSqlDatabase::operator<<(const s64 l)
 {
+    ++m_bindCount;
     try
     {
-        m_cmd << l;
+        *m_cmd << l;
         return *this;
     }
     catch (const odbc::otl_exception &err)
@@ -317,9 +684,10 @@ ISqlDatabase& ODBCSqlDatabase::operator<<(const s64 l)
 
 ISqlDatabase& ODBCSqlDatabase::operator<<(const float f)
 {
+    ++m_bindCount;
     try
     {
-        m_cmd << f;
+        *m_cmd << f;
         return *this;
     }
     catch (const odbc::otl_exception &err)
@@ -332,9 +700,10 @@ ISqlDatabase& ODBCSqlDatabase::operator<<(const float f)
 
 ISqlDatabase& ODBCSqlDatabase::operator<<(const double d)
 {
+    ++m_bindCount;
     try
     {
-        m_cmd << d;
+        *m_cmd << d;
         return *this;
     }
     catch (const odbc::otl_exception &err)
@@ -347,9 +716,10 @@ ISqlDatabase& ODBCSqlDatabase::operator<<(const double d)
 
 ISqlDatabase& ODBCSqlDatabase::operator<<(const otl_null &n)
 {
+    ++m_bindCount;
     try
     {
-        m_cmd << n;
+        *m_cmd << n;
         return *this;
     }
     catch (const odbc::otl_exception &err)
@@ -362,9 +732,10 @@ ISqlDatabase& ODBCSqlDatabase::operator<<(const otl_null &n)
 
 ISqlDatabase& ODBCSqlDatabase::operator<<(const otl_datetime& dt)
 {
+    ++m_bindCount;
     try
     {
-        m_cmd << dt;
+        *m_cmd << dt;
         return *this;
     }
     catch (const odbc::otl_exception &err)
@@ -379,7 +750,7 @@ ISqlDatabase& ODBCSqlDatabase::operator >> (unsigned char* s)
 {
     try
     {
-        m_cmd >> s;
+        *m_cmd >> s;
         return *this;
     }
     catch (const odbc::otl_exception &err)
@@ -394,7 +765,7 @@ ISqlDatabase& ODBCSqlDatabase::operator >> (char& c)
 {
     try
     {
-        m_cmd >> c;
+        *m_cmd >> c;
         return *this;
     }
     catch (const odbc::otl_exception &err)
@@ -409,7 +780,7 @@ ISqlDatabase& ODBCSqlDatabase::operator >> (unsigned char& c)
 {
     try
     {
-        m_cmd >> c;
+        *m_cmd >> c;
         return *this;
     }
     catch (const odbc::otl_exception &err)
@@ -424,7 +795,7 @@ ISqlDatabase& ODBCSqlDatabase::operator >> (char* s)
 {
     try
     {
-        m_cmd >> s;
+        *m_cmd >> s;
         return *this;
     }
     catch (const odbc::otl_exception &err)
@@ -439,7 +810,7 @@ ISqlDatabase& ODBCSqlDatabase::operator >> (otl_long_string& s)
 {
     try
     {
-        m_cmd >> s;
+        *m_cmd >> s;
         return *this;
     }
     catch (const odbc::otl_exception &err)
@@ -454,7 +825,7 @@ ISqlDatabase& ODBCSqlDatabase::operator >> (std::string& s)
 {
     try
     {
-        m_cmd >> s;
+        *m_cmd >> s;
         return *this;
     }
     catch (const odbc::otl_exception &err)
@@ -469,7 +840,7 @@ ISqlDatabase& ODBCSqlDatabase::operator >> (int& n)
 {
     try
     {
-        m_cmd >> n;
+        *m_cmd >> n;
         return *this;
     }
     catch (const odbc::otl_exception &err)
@@ -484,7 +855,7 @@ ISqlDatabase& ODBCSqlDatabase::operator >> (unsigned int& u)
 {
     try
     {
-        m_cmd >> u;
+        *m_cmd >> u;
         return *this;
     }
     catch (const odbc::otl_exception &err)
@@ -499,7 +870,7 @@ ISqlDatabase& ODBCSqlDatabase::operator >> (short& sh)
 {
     try
     {
-        m_cmd >> sh;
+        *m_cmd >> sh;
         return *this;
     }
     catch (const odbc::otl_exception &err)
@@ -514,7 +885,7 @@ ISqlDatabase& ODBCSqlDatabase::operator >> (long int& l)
 {
     try
     {
-        m_cmd >> l;
+        *m_cmd >> l;
         return *this;
     }
     catch (const odbc::otl_exception &err)
@@ -529,7 +900,7 @@ ISqlDatabase& ODBCSqlDatabase::operator >> (float& f)
 {
     try
     {
-        m_cmd >> f;
+        *m_cmd >> f;
         return *this;
     }
     catch (const odbc::otl_exception &err)
@@ -544,7 +915,7 @@ ISqlDatabase& ODBCSqlDatabase::operator >> (double& d)
 {
     try
     {
-        m_cmd >> d;
+        *m_cmd >> d;
         return *this;
     }
     catch (const odbc::otl_exception &err)
@@ -559,7 +930,7 @@ ISqlDatabase& ODBCSqlDatabase::operator >> (otl_datetime& dt)
 {
     try
     {
-        m_cmd >> dt;
+        *m_cmd >> dt;
         return *this;
     }
     catch (const odbc::otl_exception &err)
@@ -595,4 +966,19 @@ bool ODBCSqlDatabase::IsNetworkError(const odbc::otl_exception &ex)
         ;
 }
 
+bool ODBCSqlDatabase::Probe(const std::string &connStr)
+{
+    try
+    {
+        odbc::otl_connect connection;
+        connection.rlogon(connStr.c_str(), false);
+        connection.logoff();
+        return true;
+    }
+    catch (const odbc::otl_exception&)
+    {
+        return false;
+    }
+}
+
 #endif /* USE_ODBC_DATABASE_UTILS */
\ No newline at end of file
@@ -8,8 +8,17 @@
     #pragma warning(disable : 4251)
 #endif
 
+#include <list>
+#include <memory>
+#include <unordered_map>
 #include "../Common/ISqlDatabase.h"
+#include "../Common/SqlCircuitBreaker.h"
+#include "../Common/SqlStatementTracer.h"
 
+/**
+ * ODBC database.The connections with the same connection string share a SqlCircuitBreaker,while the database is down the breaker opens
+ * and the statements fail fast instead of reconnecting.The phases of the statements are traced by SqlStatementTracer.
+ */
 class UTILS_EXPORTS_API ODBCSqlDatabase :public ISqlDatabase
 {
 public:
@@ -19,8 +28,43 @@ public:
 
     virtual SqlDatabaseType Type();
 
+    /**
+     * Prepares a statement by its text.If stayInPool is true(and it is not a stored procedure returning a dataset),the statement is
+     * kept in the LRU cache of PrepareStatement keyed by the text and buffer size(the text is not interned,the tracing interns its
+     * normalized text once per cached statement,see SqlStatementTracer::TraceId).
+     *
+     * @param sql The SQL text.
+     * @param bufferSize The buffer size.
+     * @param stayInPool (Optional) True to cache the statement.
+     * @param storedPorcReturnDataset (Optional) True if the statement is a stored procedure returning a dataset.
+     *
+     * @return True if succeeded.
+     */
     virtual bool Prepare(const char *sql, int bufferSize, bool stayInPool = true, bool storedPorcReturnDataset = false);
 
+    /**
+     * Prepares an interned statement.The opened statements(up to cmdPoolSize of the constructor) stay open in a LRU cache keyed by the
+     * statement ID and buffer size,a cached statement is rewound instead of being reopened.
+     *
+     * @param id The statement ID.
+     * @param bufferSize The buffer size.
+     *
+     * @return True if succeeded.
+     */
+    virtual bool PrepareStatement(SqlStatementId id, int bufferSize);
+
+    virtual SqlStatementCacheStats StatementCacheStats();
+
+    /**
+     * Gets the circuit breaker of the connection string.
+     *
+     * @return The breaker.
+     */
+    const std::shared_ptr<SqlCircuitBreaker>& CircuitBreaker() const
+    {
+        return m_breaker;
+    }
+
     virtual bool FlushBuffer();
 
     virtual bool Commit();
@@ -31,6 +75,28 @@ public:
 
     virtual const std::string& LastError();
 
+    virtual bool IsNull();
+
+    /**
+     * Fetches the rows into a batch by reading the OTL stream directly(without the virtual operator>> per value),OTL fetches the rows
+     * in arrays of the buffer size of the prepared statement.
+     *
+     * @param batch The batch.
+     *
+     * @return Number of fetched rows(0 if the result set ended),-1 if failed.
+     */
+    virtual int FetchColumns(SqlColumnBatch &batch);
+
+    /**
+     * Writes the rows of a batch to the OTL stream directly(without the virtual call,bind counting and exception handling of
+     * operator<< per value) and flushes them,OTL executes the buffered rows as one ODBC parameter array.
+     *
+     * @param batch The batch.
+     *
+     * @return True if succeeded.
+     */
+    virtual bool InsertColumns(const SqlColumnBatch &batch);
+
     virtual ISqlDatabase& operator<<(const unsigned char* s);
 
     virtual ISqlDatabase& operator<<(const char c);
@@ -87,6 +153,17 @@ public:
 
     virtual ISqlDatabase& operator >> (otl_datetime& dt);
 
+protected:
+    virtual void SetLastError(const std::string &error);
+
+    /**
+     * Reports a network error(such as a dropped connection) to the circuit breaker and drops the statements and the connection,so
+     * the next statement logs on again.
+     *
+     * @param err The error,ignored if it is not a network error.
+     */
+    void HandleNetworkError(const odbc::otl_exception &err);
+
 private:
     ODBCSqlDatabase(const ODBCSqlDatabase&) = delete;
 
@@ -96,18 +173,130 @@ private:
 
     ODBCSqlDatabase& operator=(ODBCSqlDatabase&&) = delete;
 
-    void HandleNetworkError(const odbc::otl_exception &err);
+    /**
+     * A cached statement.
+     */
+    struct CachedStatement
+    {
+        us64 m_key; /**< Statement ID(high 32 bits) and buffer size(low 32 bits) of an interned statement. */
+
+        std::string m_textKey;  /**< Buffer size and text of a statement prepared by Prepare(empty for an interned statement). */
+
+        SqlStatementId m_traceId;   /**< ID of the statement in the traces(the normalized text of a statement prepared by Prepare). */
+
+        std::unique_ptr<odbc::otl_stream> m_stream; /**< The opened stream. */
+    };
+
+    /**
+     * Logs on if not connected,fails fast if the circuit breaker is open.
+     *
+     * @param context The context of the error message.
+     *
+     * @return True if connected.
+     */
+    bool Connect(const char *context);
+
+    /**
+     * Rewinds a cached statement or opens and caches it(evicts the least recently used one if the cache is full).
+     *
+     * @param id The statement ID,SqlInvalidStatementId to key the statement by its text.
+     * @param sql The SQL text.
+     * @param bufferSize The buffer size.
+     *
+     * @return True if succeeded.
+     */
+    bool PrepareCached(SqlStatementId id, const char *sql, int bufferSize);
+
+    /**
+     * Gets the start time of a traced phase.
+     *
+     * @return The time,the default value if the tracing is disabled.
+     */
+    static std::chrono::steady_clock::time_point TraceBegin()
+    {
+        return SqlStatementTracer::Enabled() ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point();
+    }
+
+    /**
+     * Records a phase of the current statement.
+     *
+     * @param phase The phase.
+     * @param beg The start time returned by TraceBegin.
+     * @param rows (Optional) Number of affected rows,-1 if unknown.
+     */
+    void TraceEnd(SqlPhase phase, std::chrono::steady_clock::time_point beg, s64 rows = -1);
+
+    /**
+     * Accumulates the fetch time of the current statement,which is recorded when the result set ends or the next statement is
+     * prepared.
+     *
+     * @param beg The start time of a timed call,the default value if the call is not timed(only the rows are counted).
+     * @param rows Number of fetched rows.
+     */
+    void TraceFetch(std::chrono::steady_clock::time_point beg, s64 rows);
+
+    /**
+     * Records the accumulated fetch time of the current statement.
+     */
+    void FinishFetchTrace();
+
+    void CloseUncachedCmd();
+
+    static void CloseStatement(CachedStatement &statement);
+
+    void ClearStatementCache();
 
     static void FormatExceptionMsg(const odbc::otl_exception &ex, std::string &msg, const char *context, bool onlyMsg = false);
 
     static bool IsNetworkError(const odbc::otl_exception &ex);
 
+    /**
+     * Reconnect probe of the circuit breaker.
+     *
+     * @param connStr The connection string.
+     *
+     * @return True if logged on.
+     */
+    static bool Probe(const std::string &connStr);
+
     odbc::otl_connect m_connection;
 
-    odbc::otl_stream m_cmd;
+    odbc::otl_stream m_uncachedCmd;    /**< Stream of the statements which are not cached(stored procedures or stayInPool is false). */
+
+    odbc::otl_stream *m_cmd;    /**< Current stream. */
+
+    std::list<CachedStatement> m_statements;    /**< Cached statements,the most recently used one is at the front. */
+
+    std::unordered_map<us64, std::list<CachedStatement>::iterator> m_statementIndex;    /**< Cached statements keyed by m_key. */
+
+    std::unordered_map<std::string, std::list<CachedStatement>::iterator> m_textIndex;  /**< Cached statements keyed by m_textKey. */
+
+    std::string m_textKey;  /**< Reused lookup key of m_textIndex. */
+
+    size_t m_statementCacheSize;    /**< Max number of cached statements. */
+
+    SqlStatementCacheStats m_cacheStats;    /**< Cache statistics. */
+
+    std::string m_fetchString;  /**< Reused string value of FetchColumns. */
 
     std::string m_connStr;
 
+    std::shared_ptr<SqlCircuitBreaker> m_breaker;   /**< Circuit breaker shared by the connections with the same connection string. */
+
+    SqlStatementId m_statementId;   /**< ID of the current statement in the traces. */
+
+    us32 m_bindCount;   /**< Number of values bound since the last flush. */
+
+    s64 m_fetchArraySize;   /**< Number of rows fetched by a round trip of the current statement. */
+
+    us64 m_fetchNanos;  /**< Fetch time of the current statement(ns). */
+
+    s64 m_fetchRows;    /**< Rows fetched by the current statement. */
+
+    bool m_fetchTraced; /**< True if the fetch time of the current statement has not been recorded. */
+
+    bool m_fetchEnded;  /**< True if the result set of the current statement has ended(its fetch time is recorded). */
+
     std::string m_lastError;
 
     bool m_cmdStayInPool;